@@ -198,6 +198,17 @@ void registerVeloxMetrics() {
   DEFINE_METRIC(
       kMetricMemoryCacheNumStaleEntries, facebook::velox::StatType::COUNT);
 
+  // Number of new AsyncDataCache entries that the admission filter marked for
+  // early eviction, since last counter retrieval.
+  DEFINE_METRIC(
+      kMetricMemoryCacheNumAdmissionRejects, facebook::velox::StatType::SUM);
+
+  // Number of AsyncDataCache entries that the admission filter did not write
+  // to SSD cache, since last counter retrieval.
+  DEFINE_METRIC(
+      kMetricMemoryCacheNumSsdAdmissionRejects,
+      facebook::velox::StatType::SUM);
+
   /// ================== SsdCache Counters ==================
 
   // Number of regions currently cached by SSD.
@@ -652,6 +663,19 @@ void registerVeloxMetrics() {
   // Tracks the averaged table scan output batch size in bytes.
   DEFINE_METRIC(kMetricTableScanBatchBytes, facebook::velox::StatType::AVG);
 
+  /// ================== Regex Cache Counters =================
+  // The number of lookups in the process-wide regex cache that found a
+  // compiled regular expression or LIKE pattern.
+  DEFINE_METRIC(kMetricRegexCacheNumHits, facebook::velox::StatType::COUNT);
+
+  // The number of lookups in the process-wide regex cache that compiled a new
+  // regular expression or LIKE pattern.
+  DEFINE_METRIC(kMetricRegexCacheNumMisses, facebook::velox::StatType::COUNT);
+
+  // The number of entries evicted from the process-wide regex cache to make
+  // space.
+  DEFINE_METRIC(kMetricRegexCacheNumEvictions, facebook::velox::StatType::SUM);
+
   /// ================== Storage Counters =================
 
   // The time distribution of storage IO throttled duration in range of [0, 30s]
@@ -258,6 +258,12 @@ constexpr folly::StringPiece kMetricMemoryCacheNumAgedOutEntries{
 constexpr folly::StringPiece kMetricMemoryCacheNumStaleEntries{
     "velox.memory_cache_num_stale_entries"};
 
+constexpr folly::StringPiece kMetricMemoryCacheNumAdmissionRejects{
+    "velox.memory_cache_num_admission_rejects"};
+
+constexpr folly::StringPiece kMetricMemoryCacheNumSsdAdmissionRejects{
+    "velox.memory_cache_num_ssd_admission_rejects"};
+
 constexpr folly::StringPiece kMetricSsdCacheCachedRegions{
     "velox.ssd_cache_cached_regions"};
 
@@ -381,6 +387,15 @@ constexpr folly::StringPiece kMetricIndexLookupWaitTimeMs{
 constexpr folly::StringPiece kMetricIndexLookupBlockedWaitTimeMs{
     "velox.index_lookup_blocked_wait_time_ms"};
 
+constexpr folly::StringPiece kMetricRegexCacheNumHits{
+    "velox.regex_cache_num_hits"};
+
+constexpr folly::StringPiece kMetricRegexCacheNumMisses{
+    "velox.regex_cache_num_misses"};
+
+constexpr folly::StringPiece kMetricRegexCacheNumEvictions{
+    "velox.regex_cache_num_evictions"};
+
 constexpr folly::StringPiece kMetricTableScanBatchProcessTimeMs{
     "velox.table_scan_batch_process_time_ms"};
 
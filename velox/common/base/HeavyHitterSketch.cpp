@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/base/HeavyHitterSketch.h"
+
+#include <algorithm>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::common {
+
+HeavyHitterSketch::HeavyHitterSketch(uint32_t capacity)
+    : capacity_(capacity) {
+  VELOX_CHECK_GT(capacity_, 0);
+  counters_.reserve(capacity_);
+}
+
+void HeavyHitterSketch::add(uint64_t key, uint64_t count) {
+  total_ += count;
+  auto it = counters_.find(key);
+  if (it != counters_.end()) {
+    it->second.count += count;
+    return;
+  }
+  if (counters_.size() < capacity_) {
+    counters_.emplace(key, Counter{count, 0});
+    return;
+  }
+  // Replace the least frequent key. Its count bounds how often 'key' may
+  // have been seen while not tracked.
+  auto min = findMin();
+  const auto minCount = min->second.count;
+  counters_.erase(min);
+  counters_.emplace(key, Counter{minCount + count, minCount});
+}
+
+folly::F14FastMap<uint64_t, HeavyHitterSketch::Counter>::iterator
+HeavyHitterSketch::findMin() {
+  return std::min_element(
+      counters_.begin(), counters_.end(), [](const auto& a, const auto& b) {
+        return a.second.count < b.second.count;
+      });
+}
+
+std::vector<HeavyHitterSketch::HeavyHitter> HeavyHitterSketch::heavyHitters(
+    uint64_t minCount) const {
+  std::vector<HeavyHitter> result;
+  for (const auto& [key, counter] : counters_) {
+    const auto guaranteedCount = counter.count - counter.error;
+    if (guaranteedCount >= minCount) {
+      result.push_back({key, counter.count, guaranteedCount});
+    }
+  }
+  std::sort(result.begin(), result.end(), [](const auto& a, const auto& b) {
+    return a.count > b.count;
+  });
+  return result;
+}
+
+void HeavyHitterSketch::clear() {
+  counters_.clear();
+  total_ = 0;
+}
+
+} // namespace facebook::velox::common
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/container/F14Map.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace facebook::velox::common {
+
+/// Streaming frequency sketch over 64-bit keys, typically key hashes, that
+/// finds the most frequent keys in bounded memory. Implements the Space-Saving
+/// algorithm: at most 'capacity' keys are tracked and a new key replaces the
+/// least frequent tracked key, inheriting its count as the error bound.
+///
+/// Every key whose true count exceeds total() / capacity is tracked. For a
+/// tracked key, 'count' over-estimates the true count by at most 'error'.
+class HeavyHitterSketch {
+ public:
+  explicit HeavyHitterSketch(uint32_t capacity);
+
+  /// Adds 'count' occurrences of 'key'.
+  void add(uint64_t key, uint64_t count = 1);
+
+  /// Returns the total count added so far.
+  uint64_t total() const {
+    return total_;
+  }
+
+  /// Returns the number of tracked keys.
+  size_t size() const {
+    return counters_.size();
+  }
+
+  struct HeavyHitter {
+    uint64_t key;
+    /// Upper bound of the true count.
+    uint64_t count;
+    /// 'count' minus the error bound, i.e. a lower bound of the true count.
+    uint64_t guaranteedCount;
+  };
+
+  /// Returns the tracked keys whose true count is guaranteed to be at least
+  /// 'minCount', ordered by decreasing count.
+  std::vector<HeavyHitter> heavyHitters(uint64_t minCount) const;
+
+  /// Forgets all keys and counts.
+  void clear();
+
+ private:
+  struct Counter {
+    uint64_t count;
+    uint64_t error;
+  };
+
+  // Returns the tracked key with the smallest count.
+  folly::F14FastMap<uint64_t, Counter>::iterator findMin();
+
+  const uint32_t capacity_;
+  folly::F14FastMap<uint64_t, Counter> counters_;
+  uint64_t total_{0};
+};
+
+} // namespace facebook::velox::common
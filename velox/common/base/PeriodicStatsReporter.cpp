@@ -175,6 +175,12 @@ void PeriodicStatsReporter::reportCacheStats() {
       kMetricMemoryCacheNumAgedOutEntries, deltaCacheStats.numAgedOut);
   REPORT_IF_NOT_ZERO(
       kMetricMemoryCacheSumEvictScore, deltaCacheStats.sumEvictScore);
+  REPORT_IF_NOT_ZERO(
+      kMetricMemoryCacheNumAdmissionRejects,
+      deltaCacheStats.numAdmissionRejects);
+  REPORT_IF_NOT_ZERO(
+      kMetricMemoryCacheNumSsdAdmissionRejects,
+      deltaCacheStats.numSsdAdmissionRejects);
 
   // SSD cache snapshot stats.
   if (cacheStats.ssdStats != nullptr) {
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/base/HeavyHitterSketch.h"
+
+#include <gtest/gtest.h>
+
+#include "folly/Random.h"
+#include "velox/common/base/tests/GTestUtils.h"
+
+namespace facebook::velox::common::test {
+
+TEST(HeavyHitterSketchTest, exactBelowCapacity) {
+  HeavyHitterSketch sketch(8);
+  for (auto i = 0; i < 4; ++i) {
+    sketch.add(i, i + 1);
+  }
+  ASSERT_EQ(sketch.total(), 10);
+  ASSERT_EQ(sketch.size(), 4);
+
+  const auto hitters = sketch.heavyHitters(3);
+  ASSERT_EQ(hitters.size(), 2);
+  ASSERT_EQ(hitters[0].key, 3);
+  ASSERT_EQ(hitters[0].count, 4);
+  ASSERT_EQ(hitters[0].guaranteedCount, 4);
+  ASSERT_EQ(hitters[1].key, 2);
+  ASSERT_EQ(hitters[1].count, 3);
+}
+
+TEST(HeavyHitterSketchTest, findsHotKeys) {
+  HeavyHitterSketch sketch(32);
+  folly::Random::DefaultGenerator rng(1);
+  constexpr int kNumRows = 100'000;
+  // Key 7 is 30% and key 11 is 10% of the rows, the rest are spread over 1M
+  // distinct keys.
+  for (auto i = 0; i < kNumRows; ++i) {
+    const auto dice = folly::Random::rand32(100, rng);
+    if (dice < 30) {
+      sketch.add(7);
+    } else if (dice < 40) {
+      sketch.add(11);
+    } else {
+      sketch.add(100 + folly::Random::rand32(1'000'000, rng));
+    }
+  }
+  ASSERT_EQ(sketch.total(), kNumRows);
+  ASSERT_LE(sketch.size(), 32);
+
+  const auto hitters = sketch.heavyHitters(kNumRows / 20);
+  ASSERT_EQ(hitters.size(), 2);
+  ASSERT_EQ(hitters[0].key, 7);
+  ASSERT_EQ(hitters[1].key, 11);
+  for (const auto& hitter : hitters) {
+    ASSERT_LE(hitter.guaranteedCount, hitter.count);
+  }
+  ASSERT_GE(hitters[0].count, kNumRows * 28 / 100);
+  ASSERT_LE(hitters[0].guaranteedCount, kNumRows * 32 / 100);
+
+  sketch.clear();
+  ASSERT_EQ(sketch.total(), 0);
+  ASSERT_TRUE(sketch.heavyHitters(0).empty());
+}
+
+TEST(HeavyHitterSketchTest, uniformHasNoHeavyHitters) {
+  HeavyHitterSketch sketch(16);
+  for (auto i = 0; i < 10'000; ++i) {
+    sketch.add(i % 1'000);
+  }
+  ASSERT_TRUE(sketch.heavyHitters(10'000 / 16).empty());
+}
+
+TEST(HeavyHitterSketchTest, zeroCapacity) {
+  VELOX_ASSERT_THROW(HeavyHitterSketch(0), "");
+}
+
+} // namespace facebook::velox::common::test
@@ -483,6 +483,10 @@ TEST_F(PeriodicStatsReporterTest, basic) {
     ASSERT_EQ(counterMap.count(kMetricMemoryCacheNumAllocClocks.str()), 0);
     ASSERT_EQ(counterMap.count(kMetricMemoryCacheNumAgedOutEntries.str()), 0);
     ASSERT_EQ(counterMap.count(kMetricMemoryCacheSumEvictScore.str()), 0);
+    ASSERT_EQ(
+        counterMap.count(kMetricMemoryCacheNumAdmissionRejects.str()), 0);
+    ASSERT_EQ(
+        counterMap.count(kMetricMemoryCacheNumSsdAdmissionRejects.str()), 0);
     ASSERT_EQ(counterMap.count(kMetricSsdCacheReadEntries.str()), 0);
     ASSERT_EQ(counterMap.count(kMetricSsdCacheReadBytes.str()), 0);
     ASSERT_EQ(counterMap.count(kMetricSsdCacheWrittenEntries.str()), 0);
@@ -542,6 +546,8 @@ TEST_F(PeriodicStatsReporterTest, basic) {
        .numEvictChecks = 10,
        .numWaitExclusive = 10,
        .numAgedOut = 10,
+       .numAdmissionRejects = 10,
+       .numSsdAdmissionRejects = 10,
        .allocClocks = 10,
        .sumEvictScore = 10,
        .ssdStats = newSsdStats});
@@ -566,6 +572,10 @@ TEST_F(PeriodicStatsReporterTest, basic) {
     ASSERT_EQ(counterMap.count(kMetricMemoryCacheNumAllocClocks.str()), 1);
     ASSERT_EQ(counterMap.count(kMetricMemoryCacheNumAgedOutEntries.str()), 1);
     ASSERT_EQ(counterMap.count(kMetricMemoryCacheSumEvictScore.str()), 1);
+    ASSERT_EQ(
+        counterMap.count(kMetricMemoryCacheNumAdmissionRejects.str()), 1);
+    ASSERT_EQ(
+        counterMap.count(kMetricMemoryCacheNumSsdAdmissionRejects.str()), 1);
     ASSERT_EQ(counterMap.count(kMetricSsdCacheReadEntries.str()), 1);
     ASSERT_EQ(counterMap.count(kMetricSsdCacheReadBytes.str()), 1);
     ASSERT_EQ(counterMap.count(kMetricSsdCacheWrittenEntries.str()), 1);
@@ -588,7 +598,7 @@ TEST_F(PeriodicStatsReporterTest, basic) {
     ASSERT_EQ(counterMap.count(kMetricSsdCacheAgedOutRegions.str()), 1);
     ASSERT_EQ(counterMap.count(kMetricSsdCacheRecoveredEntries.str()), 1);
     ASSERT_EQ(counterMap.count(kMetricSsdCacheReadWithoutChecksum.str()), 1);
-    ASSERT_EQ(counterMap.size(), 55);
+    ASSERT_EQ(counterMap.size(), 57);
   }
 }
 
@@ -182,6 +182,14 @@ CachePin CacheShard::findOrCreate(
       }
 
       if (foundEntry->size() >= size) {
+        if (sketch_ != nullptr && !foundEntry->isFirstUse_) {
+          // A repeated access, not the first read after a load.
+          sketch_->increment(std::hash<RawFileCacheKey>()(key));
+          if (!foundEntry->admitted_) {
+            foundEntry->admitted_ = true;
+            --numRejectedEntries_;
+          }
+        }
         foundEntry->touch();
         // The entry is in a readable state. Add a pin.
         if (foundEntry->isPrefetch()) {
@@ -212,10 +220,23 @@ CachePin CacheShard::findOrCreate(
       entryMap_.erase(it);
     }
 
+    bool admitted = true;
+    if (sketch_ != nullptr) {
+      const auto keyHash = std::hash<RawFileCacheKey>()(key);
+      sketch_->ensureCapacity(entries_.size());
+      sketch_->increment(keyHash);
+      admitted = shouldAdmit(keyHash, size);
+      if (!admitted) {
+        ++numAdmissionRejects_;
+        ++numRejectedEntries_;
+      }
+    }
+
     auto newEntry = getFreeEntry();
     // Initialize the members that must be set inside 'mutex_'.
     newEntry->numPins_ = AsyncDataCacheEntry::kExclusive;
     newEntry->promise_ = nullptr;
+    newEntry->admitted_ = admitted;
     entryToInit = newEntry.get();
     entryMap_[key] = newEntry.get();
     if (emptySlots_.empty()) {
@@ -348,6 +369,10 @@ void CacheShard::removeEntryLocked(AsyncDataCacheEntry* entry) {
     entry->key_.fileNum.clear();
   }
   entry->setSsdFile(nullptr, 0);
+  if (!entry->admitted_) {
+    entry->admitted_ = true;
+    --numRejectedEntries_;
+  }
   if (entry->isPrefetch()) {
     entry->setPrefetch(false);
   }
@@ -385,11 +410,19 @@ uint64_t CacheShard::evict(
     if (size == 0) {
       return 0;
     }
+    // With the admission filter, a first round evicts only the entries that
+    // were not admitted, so that one-off entries make room for more of their
+    // kind before retained entries do. Admitted entries are evicted in the
+    // second round if the first does not free 'bytesToFree'.
+    const bool rejectedFirst =
+        sketch_ != nullptr && !evictAllUnpinned && numRejectedEntries_ > 0;
+    const size_t numSteps = rejectedFirst ? 2 * size : size;
     int32_t counter = 0;
     int32_t numChecked = 0;
     auto entryIndex = (clockHand_ % size);
     auto iter = entries_.begin() + entryIndex;
-    while (++counter <= size) {
+    while (++counter <= numSteps) {
+      const bool rejectedOnly = rejectedFirst && counter <= size;
       if (++iter == entries_.end()) {
         iter = entries_.begin();
         entryIndex = 0;
@@ -417,7 +450,9 @@ uint64_t CacheShard::evict(
       int32_t score = 0;
       if (candidate->numPins_ == 0 &&
           (!candidate->key_.fileNum.hasValue() || evictAllUnpinned ||
-           (score = candidate->score(now)) >= evictionThreshold_)) {
+           (!candidate->admitted_ && !candidate->isPrefetch_) ||
+           (!rejectedOnly &&
+            (score = candidate->score(now)) >= evictionThreshold_))) {
         if (skipSsdSaveable && candidate->ssdSaveable() && !evictAllUnpinned) {
           ++evictSaveableSkipped;
           continue;
@@ -513,6 +548,44 @@ void CacheShard::calibrateThreshold() {
       80);
 }
 
+bool CacheShard::shouldAdmit(uint64_t keyHash, uint64_t size) {
+  auto* allocator = cache_->allocator();
+  const auto capacityPages =
+      memory::AllocationTraits::numPages(allocator->capacity());
+  const auto numAllocated =
+      allocator->numAllocated() + memory::AllocationTraits::numPages(size);
+  if (numAllocated < capacityPages &&
+      capacityPages - numAllocated > capacityPages * kAdmissionFreeRatio) {
+    return true;
+  }
+  // The victim is the unpinned entry with the highest score among the next
+  // few that the clock hand passes.
+  const auto now = accessTime();
+  const AsyncDataCacheEntry* victim = nullptr;
+  int32_t victimScore = 0;
+  const auto numSamples =
+      std::min<size_t>(kNumAdmissionSamples, entries_.size());
+  for (size_t i = 0; i < numSamples; ++i) {
+    const auto* entry = entries_[(clockHand_ + i) % entries_.size()].get();
+    if (entry == nullptr || entry->numPins_ != 0 ||
+        !entry->key_.fileNum.hasValue() || !entry->admitted_) {
+      continue;
+    }
+    const auto score = entry->score(now);
+    if (victim == nullptr || score > victimScore) {
+      victim = entry;
+      victimScore = score;
+    }
+  }
+  if (victim == nullptr) {
+    return true;
+  }
+  const RawFileCacheKey victimKey{
+      victim->key_.fileNum.id(), victim->key_.offset};
+  return sketch_->frequency(keyHash) >
+      sketch_->frequency(std::hash<RawFileCacheKey>()(victimKey));
+}
+
 void CacheShard::updateStats(CacheStats& stats) {
   std::lock_guard<std::mutex> l(mutex_);
   for (auto& entry : entries_) {
@@ -553,6 +626,8 @@ void CacheShard::updateStats(CacheStats& stats) {
   stats.numWaitExclusive += numWaitExclusive_;
   stats.numAgedOut += numAgedOut_;
   stats.numStales += numStales_;
+  stats.numAdmissionRejects += numAdmissionRejects_;
+  stats.numSsdAdmissionRejects += numSsdAdmissionRejects_;
   stats.sumEvictScore += sumEvictScore_;
   stats.allocClocks += allocClocks_;
 }
@@ -570,6 +645,16 @@ void CacheShard::appendSsdSaveable(bool saveAll, std::vector<CachePin>& pins) {
   for (auto& entry : entries_) {
     if (entry && (entry->ssdFile_ == nullptr) && !entry->isExclusive() &&
         entry->ssdSaveable()) {
+      if (!saveAll && sketch_ != nullptr) {
+        const RawFileCacheKey key{
+            entry->key_.fileNum.id(), entry->key_.offset};
+        if (sketch_->frequency(std::hash<RawFileCacheKey>()(key)) <
+            kMinSsdAdmissionFrequency) {
+          // The entry stays saveable and is reconsidered in the next batch.
+          ++numSsdAdmissionRejects_;
+          continue;
+        }
+      }
       CachePin pin;
       ++entry->numPins_;
       pin.setEntry(entry.get());
@@ -642,6 +727,9 @@ CacheStats CacheStats::operator-(const CacheStats& other) const {
   result.numWaitExclusive = numWaitExclusive - other.numWaitExclusive;
   result.numAgedOut = numAgedOut - other.numAgedOut;
   result.numStales = numStales - other.numStales;
+  result.numAdmissionRejects = numAdmissionRejects - other.numAdmissionRejects;
+  result.numSsdAdmissionRejects =
+      numSsdAdmissionRejects - other.numSsdAdmissionRejects;
   result.allocClocks = allocClocks - other.allocClocks;
   result.sumEvictScore = sumEvictScore - other.sumEvictScore;
   if (ssdStats != nullptr) {
@@ -669,7 +757,8 @@ AsyncDataCache::AsyncDataCache(
       ssdCache_(std::move(ssdCache)),
       cachedPages_(0) {
   for (auto i = 0; i < kNumShards; ++i) {
-    shards_.push_back(std::make_unique<CacheShard>(this, opts_.maxWriteRatio));
+    shards_.push_back(std::make_unique<CacheShard>(
+        this, opts_.maxWriteRatio, opts_.admissionFilter));
   }
 }
 
@@ -1010,6 +1099,8 @@ std::string CacheStats::toString() const {
       << " savable eviction: " << numSavableEvict
       << " eviction checks: " << numEvictChecks << " aged out: " << numAgedOut
       << " stales: " << numStales
+      << " admission rejects: " << numAdmissionRejects
+      << " ssd admission rejects: " << numSsdAdmissionRejects
       << "\n"
       // Cache prefetch stats.
       << "Prefetch entries: " << numPrefetch
@@ -1030,18 +1121,34 @@ CoalesceIoStats readPins(
         int32_t begin,
         int32_t end,
         uint64_t offset,
-        const std::vector<folly::Range<char*>>& buffers)> readFunc) {
+        const std::vector<folly::Range<char*>>& buffers)> readFunc,
+    std::function<folly::Range<char*>(int32_t index)> stagingFunc) {
+  auto staging = [&](int32_t index) {
+    return stagingFunc == nullptr ? folly::Range<char*>() : stagingFunc(index);
+  };
   return coalesceIo<CachePin, folly::Range<char*>>(
       pins,
       maxGap,
       rangesPerIo,
       std::move(offsetFunc),
-      [&](int32_t index) { return pins[index].checkedEntry()->size(); },
+      [&](int32_t index) -> uint64_t {
+        const auto range = staging(index);
+        return range.empty() ? pins[index].checkedEntry()->size()
+                             : range.size();
+      },
       [&](int32_t index) {
+        if (!staging(index).empty()) {
+          return 1;
+        }
         return std::max<int32_t>(
             1, pins[index].checkedEntry()->data().numRuns());
       },
       [&](const CachePin& pin, std::vector<folly::Range<char*>>& ranges) {
+        const auto range = staging(&pin - pins.data());
+        if (!range.empty()) {
+          ranges.push_back(range);
+          return;
+        }
         auto* entry = pin.checkedEntry();
         auto& data = entry->data();
         uint64_t offsetInRuns = 0;
@@ -29,6 +29,7 @@
 #include "velox/common/base/Portability.h"
 #include "velox/common/base/SelectivityInfo.h"
 #include "velox/common/caching/FileGroupStats.h"
+#include "velox/common/caching/FrequencySketch.h"
 #include "velox/common/caching/ScanTracker.h"
 #include "velox/common/caching/StringIdMap.h"
 #include "velox/common/file/File.h"
@@ -334,6 +335,11 @@ class AsyncDataCacheEntry {
   // True if this should be saved to SSD.
   std::atomic<bool> ssdSaveable_{false};
 
+  // False if the admission filter found 'this' less worth retaining than the
+  // entries it would displace. Such an entry is evictable regardless of its
+  // score until it is hit again. Set inside the shard mutex.
+  bool admitted_{true};
+
   friend class CacheShard;
   friend class CachePin;
   friend class test::AsyncDataCacheEntryTestHelper;
@@ -535,6 +541,12 @@ struct CacheStats {
   /// Total number of entries that are stale because of cache request size
   /// mismatch.
   int64_t numStales{0};
+  /// Number of new entries that the admission filter found less worth
+  /// retaining than the entries they would displace.
+  int64_t numAdmissionRejects{0};
+  /// Number of times the admission filter left an entry out of an SSD write
+  /// batch because the entry had not been accessed repeatedly.
+  int64_t numSsdAdmissionRejects{0};
   /// Cumulative clocks spent in allocating or freeing memory for backing cache
   /// entries.
   uint64_t allocClocks{0};
@@ -556,8 +568,14 @@ struct CacheStats {
 /// and other housekeeping.
 class CacheShard {
  public:
-  CacheShard(AsyncDataCache* cache, double maxWriteRatio)
-      : cache_(cache), maxWriteRatio_(maxWriteRatio) {}
+  CacheShard(
+      AsyncDataCache* cache,
+      double maxWriteRatio,
+      bool admissionFilter = false)
+      : cache_(cache),
+        maxWriteRatio_(maxWriteRatio),
+        sketch_(
+            admissionFilter ? std::make_unique<FrequencySketch>() : nullptr) {}
 
   /// See AsyncDataCache::findOrCreate.
   CachePin findOrCreate(
@@ -629,9 +647,24 @@ class CacheShard {
  private:
   static constexpr uint32_t kMaxFreeEntries = 1 << 10;
   static constexpr int32_t kNoThreshold = std::numeric_limits<int32_t>::max();
+  // Number of eviction candidates whose frequency is compared with a new
+  // entry's by the admission filter.
+  static constexpr int32_t kNumAdmissionSamples = 8;
+  // Minimum estimated access count for an entry to be written to SSD when the
+  // admission filter is enabled.
+  static constexpr int32_t kMinSsdAdmissionFrequency = 2;
+  // The admission filter applies when less than this fraction of the memory
+  // allocator's capacity is free.
+  static constexpr double kAdmissionFreeRatio = 0.125;
 
   void calibrateThreshold();
 
+  // Returns true if a new entry of 'size' bytes whose key hashes to 'keyHash'
+  // should be retained in place of existing entries. This is the case if
+  // memory is not nearly full or if the key is accessed more often than the
+  // likely next eviction victim.
+  bool shouldAdmit(uint64_t keyHash, uint64_t size);
+
   void removeEntryLocked(AsyncDataCacheEntry* entry);
 
   // Returns an unused entry if found.
@@ -690,6 +723,16 @@ class CacheShard {
   // Tracker of cumulative time spent in allocating/freeing MemoryAllocator
   // space for backing cached data.
   std::atomic<uint64_t> allocClocks_{0};
+  // Access frequencies of recently used keys, including evicted ones. Set if
+  // the admission filter is enabled.
+  const std::unique_ptr<FrequencySketch> sketch_;
+  // Cumulative count of new entries rejected by the admission filter.
+  uint64_t numAdmissionRejects_{0};
+  // Number of entries in 'entries_' that were rejected by the admission filter
+  // and have not been hit since.
+  int32_t numRejectedEntries_{0};
+  // Cumulative count of SSD saveable entries skipped by the admission filter.
+  uint64_t numSsdAdmissionRejects_{0};
 
   friend class test::CacheShardTestHelper;
 };
@@ -700,10 +743,12 @@ class AsyncDataCache : public memory::Cache {
     Options(
         double _maxWriteRatio = 0.7,
         double _ssdSavableRatio = 0.125,
-        int32_t _minSsdSavableBytes = 1 << 24)
+        int32_t _minSsdSavableBytes = 1 << 24,
+        bool _admissionFilter = false)
         : maxWriteRatio(_maxWriteRatio),
           ssdSavableRatio(_ssdSavableRatio),
-          minSsdSavableBytes(_minSsdSavableBytes) {}
+          minSsdSavableBytes(_minSsdSavableBytes),
+          admissionFilter(_admissionFilter) {}
 
     /// The max ratio of the number of in-memory cache entries being written to
     /// SSD cache over the total number of cache entries. This is to control SSD
@@ -722,6 +767,12 @@ class AsyncDataCache : public memory::Cache {
     /// NOTE: we only write to SSD cache when both above conditions satisfy. The
     /// default is 16MB.
     int32_t minSsdSavableBytes;
+
+    /// If true, a TinyLFU admission filter protects frequently used entries
+    /// from one-off accesses such as large scans. When memory is full, a new
+    /// entry that is accessed less often than the entries it would displace is
+    /// evicted first. Entries are only written to SSD after repeated access.
+    bool admissionFilter;
   };
 
   AsyncDataCache(
@@ -956,6 +1007,12 @@ T percentile(Next next, int32_t numSamples, int percent) {
 /// memory ranges to fill by ReadFile::preadv or a similar function. The caller
 /// is responsible for calling setValid on the pins after a successful read.
 ///
+/// If 'stagingFunc' is set and returns a non-empty range for the pin at the
+/// given index, the data of the pin is read into that range instead of the
+/// memory of the entry. The size of the range is the size of the data in the
+/// file. This is used for data that is transformed after reading, e.g.
+/// decompressed.
+///
 /// Returns the number of distinct IOs, the number of bytes loaded into pins
 /// and the number of extra bytes read.
 CoalesceIoStats readPins(
@@ -968,7 +1025,8 @@ CoalesceIoStats readPins(
         int32_t begin,
         int32_t end,
         uint64_t offset,
-        const std::vector<folly::Range<char*>>& buffers)> readFunc);
+        const std::vector<folly::Range<char*>>& buffers)> readFunc,
+    std::function<folly::Range<char*>(int32_t index)> stagingFunc = nullptr);
 
 } // namespace facebook::velox::cache
 
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/FrequencySketch.h"
+
+#include <algorithm>
+
+#include "velox/common/base/BitUtil.h"
+
+namespace facebook::velox::cache {
+namespace {
+// Odd multipliers for deriving one index per row from a single hash.
+constexpr uint64_t kRowSeeds[] = {
+    0xc3a5c85c97cb3127ULL,
+    0xb492b66fbe98f273ULL,
+    0x9ae16a3b2f90404fULL,
+    0xcbf29ce484222325ULL};
+
+// Mask for the low 3 bits of each 4-bit counter, used when halving.
+constexpr uint64_t kHalfMask = 0x7777777777777777ULL;
+} // namespace
+
+FrequencySketch::FrequencySketch(uint64_t maxEntries) {
+  ensureCapacity(maxEntries);
+}
+
+void FrequencySketch::ensureCapacity(uint64_t maxEntries) {
+  const auto capacity =
+      bits::nextPowerOfTwo(std::max<uint64_t>(kMinCapacity, maxEntries));
+  if (capacity <= this->capacity()) {
+    return;
+  }
+  std::vector<uint64_t> table(capacity, 0);
+  if (!table_.empty()) {
+    // Indices are the high bits of a product, so counter 'index' of the new
+    // table covers the keys of counter 'index >> growthShift' of the old one.
+    // The old counts are copied and halved, like in age(), since each old
+    // counter now stands for fewer keys.
+    const auto growthShift = __builtin_ctzll(capacity / table_.size());
+    for (uint64_t index = 0; index < capacity * kCountersPerWord; ++index) {
+      const auto oldIndex = index >> growthShift;
+      const auto oldCount = (table_[oldIndex / kCountersPerWord] >>
+                             (oldIndex % kCountersPerWord) * 4) &
+          0xf;
+      table[index / kCountersPerWord] |= (oldCount >> 1)
+          << (index % kCountersPerWord) * 4;
+    }
+  }
+  table_ = std::move(table);
+  indexShift_ = 64 - __builtin_ctzll(capacity * kCountersPerWord);
+  // Ages after about 10 accesses per key of capacity, like the TinyLFU paper.
+  sampleSize_ = capacity * 10;
+  numIncrements_ /= 2;
+}
+
+uint64_t FrequencySketch::counterIndex(uint64_t hash, int32_t row) const {
+  // The high bits of the product depend on all bits of 'hash'. The low bits
+  // of cache key hashes select the shard and are the same for all keys of a
+  // shard.
+  return ((hash ^ kRowSeeds[row]) * kRowSeeds[row]) >> indexShift_;
+}
+
+void FrequencySketch::increment(uint64_t hash) {
+  bool incremented = false;
+  for (auto row = 0; row < kNumRows; ++row) {
+    const auto index = counterIndex(hash, row);
+    auto& word = table_[index / kCountersPerWord];
+    const auto shift = (index % kCountersPerWord) * 4;
+    if (((word >> shift) & 0xf) < kMaxFrequency) {
+      word += 1ULL << shift;
+      incremented = true;
+    }
+  }
+  if (incremented && ++numIncrements_ >= sampleSize_) {
+    age();
+  }
+}
+
+int32_t FrequencySketch::frequency(uint64_t hash) const {
+  int32_t result = kMaxFrequency;
+  for (auto row = 0; row < kNumRows; ++row) {
+    const auto index = counterIndex(hash, row);
+    const auto shift = (index % kCountersPerWord) * 4;
+    result = std::min<int32_t>(
+        result, (table_[index / kCountersPerWord] >> shift) & 0xf);
+  }
+  return result;
+}
+
+void FrequencySketch::age() {
+  for (auto& word : table_) {
+    word = (word >> 1) & kHalfMask;
+  }
+  numIncrements_ /= 2;
+  ++numAgings_;
+}
+
+} // namespace facebook::velox::cache
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace facebook::velox::cache {
+
+/// Approximate access frequency of keys, used as a TinyLFU admission filter.
+/// This is a count-min sketch of 4-bit counters with 4 rows. Counters
+/// saturate at 15 and all counters are halved after every 'sampleSize()'
+/// increments, so that the sketch reflects recent history. Keys are given as
+/// hashes. Not thread safe, synchronization is the caller's responsibility.
+class FrequencySketch {
+ public:
+  static constexpr int32_t kMaxFrequency = 15;
+
+  /// Creates a sketch sized for about 'maxEntries' distinct keys.
+  explicit FrequencySketch(uint64_t maxEntries = 0);
+
+  /// Grows the sketch if it is sized for fewer than 'maxEntries' keys. The
+  /// counts are kept and halved when the sketch grows.
+  void ensureCapacity(uint64_t maxEntries);
+
+  /// Records one access to the key with 'hash'.
+  void increment(uint64_t hash);
+
+  /// Returns the estimated number of recent accesses to the key with 'hash',
+  /// between 0 and kMaxFrequency.
+  int32_t frequency(uint64_t hash) const;
+
+  /// Number of distinct keys the sketch is sized for. Each key has 16
+  /// counters on average.
+  uint64_t capacity() const {
+    return table_.size();
+  }
+
+  /// Number of increments after which the counters are halved.
+  uint64_t sampleSize() const {
+    return sampleSize_;
+  }
+
+  /// Number of times the counters have been halved.
+  uint64_t numAgings() const {
+    return numAgings_;
+  }
+
+ private:
+  static constexpr int32_t kCountersPerWord = 16;
+  static constexpr int32_t kNumRows = 4;
+  static constexpr uint64_t kMinCapacity = 1 << 10;
+
+  // Returns the index of the counter for 'hash' in 'row'.
+  uint64_t counterIndex(uint64_t hash, int32_t row) const;
+
+  // Halves all counters.
+  void age();
+
+  // Each word holds 16 4-bit counters. There is one word per key of
+  // capacity.
+  std::vector<uint64_t> table_;
+  // Right shift that maps a 64-bit product to a counter index.
+  int32_t indexShift_{64};
+  uint64_t sampleSize_{0};
+  // Number of increments since the last aging.
+  uint64_t numIncrements_{0};
+  uint64_t numAgings_{0};
+};
+
+} // namespace facebook::velox::cache
@@ -67,6 +67,52 @@ uint32_t numIoVectorsFromEntry(AsyncDataCacheEntry& entry) {
   }
   return entry.data().numRuns();
 }
+
+void addBufferToIovecs(const folly::IOBuf& buffer, std::vector<iovec>& iovecs) {
+  for (const auto& range : buffer) {
+    iovecs.push_back(
+        {const_cast<uint8_t*>(range.data()), static_cast<size_t>(range.size())});
+  }
+}
+
+// Returns a chain of buffers referencing the data of 'entry' without copying.
+std::unique_ptr<folly::IOBuf> wrapEntry(AsyncDataCacheEntry& entry) {
+  if (entry.tinyData() != nullptr) {
+    return folly::IOBuf::wrapBuffer(entry.tinyData(), entry.size());
+  }
+  std::unique_ptr<folly::IOBuf> result;
+  const auto& data = entry.data();
+  int64_t bytesLeft = entry.size();
+  for (auto i = 0; i < data.numRuns() && bytesLeft > 0; ++i) {
+    const auto run = data.runAt(i);
+    const auto size = std::min<int64_t>(bytesLeft, run.numBytes());
+    auto buffer = folly::IOBuf::wrapBuffer(run.data<char>(), size);
+    if (result == nullptr) {
+      result = std::move(buffer);
+    } else {
+      result->prependChain(std::move(buffer));
+    }
+    bytesLeft -= size;
+  }
+  return result;
+}
+
+// Copies the first entry.size() bytes of 'data' into 'entry'.
+void copyToEntry(const char* data, AsyncDataCacheEntry& entry) {
+  if (entry.tinyData() != nullptr) {
+    ::memcpy(entry.tinyData(), data, entry.size());
+    return;
+  }
+  const auto& allocation = entry.data();
+  int64_t bytesLeft = entry.size();
+  for (auto i = 0; i < allocation.numRuns() && bytesLeft > 0; ++i) {
+    const auto run = allocation.runAt(i);
+    const auto size = std::min<int64_t>(bytesLeft, run.numBytes());
+    ::memcpy(run.data<char>(), data, size);
+    data += size;
+    bytesLeft -= size;
+  }
+}
 } // namespace
 
 SsdPin::SsdPin(SsdFile& file, SsdRun run) : file_(&file), run_(run) {
@@ -112,6 +158,10 @@ SsdFile::SsdFile(const Config& config)
       checksumReadVerificationEnabled_(
           config.checksumEnabled && config.checksumReadVerificationEnabled),
       shardId_(config.shardId),
+      compressionKind_(config.compressionKind),
+      codec_(
+          compressionEnabled() ? common::compressionKindToCodec(compressionKind_)
+                               : nullptr),
       fs_(filesystems::getFileSystem(fileName_, nullptr)),
       checkpointIntervalBytes_(config.checkpointIntervalBytes),
       executor_(config.executor) {
@@ -196,18 +246,26 @@ CoalesceIoStats SsdFile::load(
     return CoalesceIoStats();
   }
   size_t totalPayloadBytes = 0;
+  // Compressed entries are read into these buffers and then decompressed.
+  std::vector<std::unique_ptr<char[]>> compressedData(pins.size());
+  bool hasCompressed = false;
   for (auto i = 0; i < pins.size(); ++i) {
-    const auto runSize = ssdPins[i].run().size();
+    const auto& run = ssdPins[i].run();
+    const auto runSize = run.size();
     auto* entry = pins[i].checkedEntry();
-    if (FOLLY_UNLIKELY(runSize < entry->size())) {
+    if (FOLLY_UNLIKELY(run.uncompressedSize() < entry->size())) {
       ++stats_.readSsdErrors;
       VELOX_FAIL(
           "IOERR: SSD cache cache entry {} short than requested range {}",
-          succinctBytes(runSize),
+          succinctBytes(run.uncompressedSize()),
           succinctBytes(entry->size()));
     }
+    if (run.compressed()) {
+      compressedData[i] = std::make_unique<char[]>(runSize);
+      hasCompressed = true;
+    }
     totalPayloadBytes += entry->size();
-    regionRead(regionIndex(ssdPins[i].run().offset()), runSize);
+    regionRead(regionIndex(run.offset()), runSize);
     ++stats_.entriesRead;
     stats_.bytesRead += entry->size();
   }
@@ -229,8 +287,28 @@ CoalesceIoStats SsdFile::load(
           uint64_t offset,
           const std::vector<folly::Range<char*>>& buffers) {
         read(offset, buffers);
+      },
+      [&](int32_t index) {
+        if (compressedData[index] == nullptr) {
+          return folly::Range<char*>();
+        }
+        return folly::Range<char*>(
+            compressedData[index].get(), ssdPins[index].run().size());
       });
 
+  if (hasCompressed) {
+    for (auto i = 0; i < pins.size(); ++i) {
+      if (compressedData[i] != nullptr) {
+        decompressEntry(
+            folly::StringPiece(
+                compressedData[i].get(), ssdPins[i].run().size()),
+            ssdPins[i].run(),
+            *pins[i].checkedEntry());
+        compressedData[i].reset();
+      }
+    }
+  }
+
   for (auto i = 0; i < ssdPins.size(); ++i) {
     pins[i].checkedEntry()->setSsdFile(this, ssdPins[i].run().offset());
     auto* entry = pins[i].checkedEntry();
@@ -247,8 +325,48 @@ void SsdFile::read(
   readFile_->preadv(offset, buffers);
 }
 
+void SsdFile::decompressEntry(
+    folly::StringPiece data,
+    const SsdRun& run,
+    AsyncDataCacheEntry& entry) {
+  // A codec is not thread safe and loads run concurrently. Making a codec is
+  // cheap compared to the IO.
+  auto codec = common::compressionKindToCodec(compressionKind_);
+  std::string uncompressed;
+  try {
+    uncompressed = codec->uncompress(data, run.uncompressedSize());
+  } catch (const std::exception& e) {
+    ++stats_.readSsdCorruptions;
+    VELOX_FAIL(
+        "IOERR: Corrupt compressed SSD cache entry - File: {}, Offset: {}, Size: {}: {}",
+        fileName_,
+        run.offset(),
+        run.size(),
+        e.what());
+  }
+  VELOX_CHECK_EQ(uncompressed.size(), run.uncompressedSize());
+  copyToEntry(uncompressed.data(), entry);
+}
+
+std::vector<std::unique_ptr<folly::IOBuf>> SsdFile::compressEntries(
+    const std::vector<CachePin>& pins) {
+  process::TraceContext trace("SsdFile::compressEntries");
+  std::vector<std::unique_ptr<folly::IOBuf>> result(pins.size());
+  for (auto i = 0; i < pins.size(); ++i) {
+    auto* entry = pins[i].checkedEntry();
+    const auto input = wrapEntry(*entry);
+    auto compressed = codec_->compress(input.get());
+    const auto compressedSize = compressed->computeChainDataLength();
+    if (compressedSize > 0 &&
+        compressedSize <= entry->size() * kMaxCompressedSizePct / 100) {
+      result[i] = std::move(compressed);
+    }
+  }
+  return result;
+}
+
 std::optional<std::pair<uint64_t, int32_t>> SsdFile::getSpace(
-    const std::vector<CachePin>& pins,
+    const std::vector<uint32_t>& sizes,
     int32_t begin) {
   int32_t next = begin;
   std::lock_guard<std::shared_mutex> l(mutex_);
@@ -263,13 +381,12 @@ std::optional<std::pair<uint64_t, int32_t>> SsdFile::getSpace(
     const auto offset = regionSizes_[region];
     auto available = kRegionSize - offset;
     int64_t toWrite = 0;
-    for (; next < pins.size(); ++next) {
-      auto* entry = pins[next].checkedEntry();
-      if (entry->size() > available) {
+    for (; next < sizes.size(); ++next) {
+      if (sizes[next] > available) {
         break;
       }
-      available -= entry->size();
-      toWrite += entry->size();
+      available -= sizes[next];
+      toWrite += sizes[next];
     }
     if (toWrite > 0) {
       // At least some pins got space from this region. If the region is full
@@ -353,9 +470,25 @@ void SsdFile::write(std::vector<CachePin>& pins) {
     VELOX_CHECK_NULL(entry->ssdFile());
   }
 
+  // The entries are compressed up front since the space to allocate depends
+  // on the compressed sizes.
+  std::vector<std::unique_ptr<folly::IOBuf>> compressed;
+  if (compressionEnabled()) {
+    compressed = compressEntries(pins);
+  }
+  std::vector<uint32_t> sizes(pins.size());
+  for (auto i = 0; i < pins.size(); ++i) {
+    sizes[i] = !compressed.empty() && compressed[i] != nullptr
+        ? compressed[i]->computeChainDataLength()
+        : pins[i].checkedEntry()->size();
+  }
+  auto compressedAt = [&](int32_t index) -> const folly::IOBuf* {
+    return compressed.empty() ? nullptr : compressed[index].get();
+  };
+
   int32_t writeIndex = 0;
   while (writeIndex < pins.size()) {
-    auto space = getSpace(pins, writeIndex);
+    auto space = getSpace(sizes, writeIndex);
     if (!space.has_value()) {
       // No space can be reclaimed. The pins are freed when the caller is freed.
       ++stats_.writeSsdDropped;
@@ -369,8 +502,11 @@ void SsdFile::write(std::vector<CachePin>& pins) {
     std::vector<iovec> writeIovecs;
     for (auto i = writeIndex; i < pins.size(); ++i) {
       auto* entry = pins[i].checkedEntry();
-      const auto entrySize = entry->size();
-      const auto numIovecs = numIoVectorsFromEntry(*entry);
+      const auto* compressedData = compressedAt(i);
+      const int64_t entrySize = sizes[i];
+      const auto numIovecs = compressedData != nullptr
+          ? compressedData->countChainElements()
+          : numIoVectorsFromEntry(*entry);
       VELOX_CHECK_LE(numIovecs, IOV_MAX);
       if (writeIovecs.size() + numIovecs > IOV_MAX) {
         // Writes out the accumulated iovecs if it exceeds IOV_MAX limit.
@@ -387,7 +523,11 @@ void SsdFile::write(std::vector<CachePin>& pins) {
       if (writeLength + entrySize > available) {
         break;
       }
-      addEntryToIovecs(*entry, writeIovecs);
+      if (compressedData != nullptr) {
+        addBufferToIovecs(*compressedData, writeIovecs);
+      } else {
+        addEntryToIovecs(*entry, writeIovecs);
+      }
       writeLength += entrySize;
       ++numWrittenEntries;
     }
@@ -409,16 +549,23 @@ void SsdFile::write(std::vector<CachePin>& pins) {
         auto* entry = pins[i].checkedEntry();
         VELOX_CHECK_NULL(entry->ssdFile());
         entry->setSsdFile(this, offset);
-        const auto size = entry->size();
+        const auto size = sizes[i];
+        const bool isCompressed = compressedAt(i) != nullptr;
         FileCacheKey key = {
             entry->key().fileNum, static_cast<uint64_t>(entry->offset())};
         uint32_t checksum = 0;
         if (checksumEnabled_) {
           checksum = checksumEntry(*entry);
         }
-        entries_[std::move(key)] = SsdRun(offset, size, checksum);
+        const SsdRun run(
+            offset, size, checksum, isCompressed ? entry->size() : 0);
+        entries_[std::move(key)] = run;
         if (FLAGS_velox_ssd_verify_write) {
-          verifyWrite(*entry, SsdRun(offset, size, checksum));
+          verifyWrite(*entry, run);
+        }
+        if (isCompressed) {
+          ++stats_.entriesCompressed;
+          stats_.bytesSavedByCompression += entry->size() - size;
         }
         offset += size;
         ++stats_.entriesWritten;
@@ -465,10 +612,18 @@ int32_t indexOfFirstMismatch(char* x, char* y, int n) {
 
 void SsdFile::verifyWrite(AsyncDataCacheEntry& entry, SsdRun ssdRun) {
   process::TraceContext trace("SsdFile::verifyWrite");
-  auto testData = std::make_unique<char[]>(entry.size());
+  auto testData = std::make_unique<char[]>(ssdRun.size());
   const auto rc =
-      readFile_->pread(ssdRun.offset(), entry.size(), testData.get());
-  VELOX_CHECK_EQ(rc.size(), entry.size());
+      readFile_->pread(ssdRun.offset(), ssdRun.size(), testData.get());
+  VELOX_CHECK_EQ(rc.size(), ssdRun.size());
+  if (ssdRun.compressed()) {
+    const auto uncompressed = codec_->uncompress(
+        folly::StringPiece(testData.get(), ssdRun.size()),
+        ssdRun.uncompressedSize());
+    VELOX_CHECK_EQ(uncompressed.size(), entry.size());
+    testData = std::make_unique<char[]>(entry.size());
+    ::memcpy(testData.get(), uncompressed.data(), entry.size());
+  }
   if (entry.tinyData() != nullptr) {
     if (::memcmp(testData.get(), entry.tinyData(), entry.size()) != 0) {
       VELOX_FAIL("bad read back");
@@ -510,6 +665,8 @@ void SsdFile::updateStats(SsdCacheStats& stats) const {
   stats.entriesAgedOut += stats_.entriesAgedOut;
   stats.regionsAgedOut += stats_.regionsAgedOut;
   stats.regionsEvicted += stats_.regionsEvicted;
+  stats.entriesCompressed += stats_.entriesCompressed;
+  stats.bytesSavedByCompression += stats_.bytesSavedByCompression;
   for (auto pins : regionPins_) {
     stats.numPins += pins;
   }
@@ -755,12 +912,15 @@ void SsdFile::checkpoint(bool force) {
       truncateFile(checkpointWriteFile_.get());
       // The checkpoint state file contains:
       // int32_t The 4 bytes of checkpoint version,
+      // int32_t compression kind if the version has compression,
       // int32_t maxRegions,
       // int32_t numRegions,
       // regionScores from the 'tracker_',
       // {fileId, fileName} pairs,
       // kMapMarker,
-      // {fileId, offset, SSdRun} triples,
+      // {fileId, offset, SSdRun} triples, where SsdRun is the offset and
+      // size, followed by the checksum and the uncompressed size if the
+      // version has these,
       // kEndMarker.
       allocateCheckpointBuffer();
       SCOPE_EXIT {
@@ -768,6 +928,9 @@ void SsdFile::checkpoint(bool force) {
       };
       const auto version = checkpointVersion();
       appendToCheckpointBuffer(checkpointVersion());
+      if (compressionEnabled()) {
+        appendToCheckpointBuffer(static_cast<int32_t>(compressionKind_));
+      }
       appendToCheckpointBuffer(maxRegions_);
       appendToCheckpointBuffer(numRegions_);
 
@@ -796,6 +959,11 @@ void SsdFile::checkpoint(bool force) {
           const auto checksum = pair.second.checksum();
           appendToCheckpointBuffer(checksum);
         }
+        if (compressionEnabled()) {
+          const uint32_t uncompressedSize =
+              pair.second.compressed() ? pair.second.uncompressedSize() : 0;
+          appendToCheckpointBuffer(uncompressedSize);
+        }
       }
 
       // NOTE: we need to ensure cache file data sync update completes before
@@ -897,12 +1065,12 @@ void SsdFile::maybeVerifyChecksum(
   if (!checksumReadVerificationEnabled_) {
     return;
   }
-  VELOX_DCHECK_EQ(ssdRun.size(), entry.size());
-  if (ssdRun.size() != entry.size()) {
+  VELOX_DCHECK_EQ(ssdRun.uncompressedSize(), entry.size());
+  if (ssdRun.uncompressedSize() != entry.size()) {
     ++stats_.readWithoutChecksumChecks;
     VELOX_CACHE_LOG_EVERY_MS(WARNING, 1'000)
         << "SSD read without checksum due to cache request size mismatch, SSD cache size "
-        << ssdRun.size() << " request size " << entry.size()
+        << ssdRun.uncompressedSize() << " request size " << entry.size()
         << ", cache request: " << entry.toString();
     return;
   }
@@ -987,6 +1155,21 @@ void SsdFile::readCheckpoint() {
         checkpointPath);
     return;
   }
+  const auto checkpointHasCompression =
+      isCompressionEnabledOnCheckpointVersion(versionMagic);
+  if (checkpointHasCompression) {
+    const auto compressionKind =
+        static_cast<common::CompressionKind>(readNumber<int32_t>(stream.get()));
+    if (compressionKind != compressionKind_) {
+      VELOX_SSD_CACHE_LOG(WARNING) << fmt::format(
+          "Starting shard {} without checkpoint: the checkpoint has entries compressed with {} but the compression is {}, checkpoint file {}",
+          shardId_,
+          common::compressionKindToString(compressionKind),
+          common::compressionKindToString(compressionKind_),
+          checkpointPath);
+      return;
+    }
+  }
 
   const auto maxRegions = readNumber<int32_t>(stream.get());
   VELOX_CHECK_EQ(
@@ -1034,7 +1217,11 @@ void SsdFile::readCheckpoint() {
     if (checkpoinHasChecksum) {
       checksum = readNumber<uint32_t>(stream.get());
     }
-    const auto run = SsdRun(fileBits, checksum);
+    uint32_t uncompressedSize = 0;
+    if (checkpointHasCompression) {
+      uncompressedSize = readNumber<uint32_t>(stream.get());
+    }
+    const auto run = SsdRun(fileBits, checksum, uncompressedSize);
     const auto region = regionIndex(run.offset());
     // Check that the recovered entry does not fall in an evicted region.
     if (evictedMap.find(region) != evictedMap.end()) {
@@ -1079,7 +1266,7 @@ void SsdFile::readCheckpoint() {
     cachedBytes += regionSize;
   }
   VELOX_SSD_CACHE_LOG(INFO) << fmt::format(
-      "Starting shard {} from checkpoint with {} entries, {} cached data, {} regions with {} free, with checksum write {}, read verification {}, checkpoint file {}",
+      "Starting shard {} from checkpoint with {} entries, {} cached data, {} regions with {} free, with checksum write {}, read verification {}, compression {}, checkpoint file {}",
       shardId_,
       entries_.size(),
       succinctBytes(cachedBytes),
@@ -1087,6 +1274,7 @@ void SsdFile::readCheckpoint() {
       writableRegions_.size(),
       checksumEnabled_ ? "enabled" : "disabled",
       checksumReadVerificationEnabled_ ? "enabled" : "disabled",
+      common::compressionKindToString(compressionKind_),
       checkpointFilePath());
 }
 
@@ -21,6 +21,7 @@
 
 #include "velox/common/caching/AsyncDataCache.h"
 #include "velox/common/caching/SsdFileTracker.h"
+#include "velox/common/compression/Compression.h"
 #include "velox/common/file/File.h"
 #include "velox/common/file/FileInputStream.h"
 #include "velox/common/file/FileSystems.h"
@@ -34,21 +35,31 @@ class SsdCacheTestHelper;
 
 /// A 64 bit word describing a SSD cache entry in an SsdFile. The low 23 bits
 /// are the size, for a maximum entry size of 8MB. The high bits are the offset.
+/// If the entry is stored compressed, the size is the compressed size and
+/// 'uncompressedSize' is the size of the data in memory.
 class SsdRun {
  public:
   static constexpr int32_t kSizeBits = 23;
 
   SsdRun() : fileBits_(0) {}
 
-  SsdRun(uint64_t offset, uint32_t size, uint32_t checksum)
-      : fileBits_((offset << kSizeBits) | ((size - 1))), checksum_(checksum) {
+  SsdRun(
+      uint64_t offset,
+      uint32_t size,
+      uint32_t checksum,
+      uint32_t uncompressedSize = 0)
+      : fileBits_((offset << kSizeBits) | ((size - 1))),
+        checksum_(checksum),
+        uncompressedSize_(uncompressedSize) {
     VELOX_CHECK_LT(offset, 1L << (64 - kSizeBits));
     VELOX_CHECK_NE(size, 0);
     VELOX_CHECK_LE(size, 1 << kSizeBits);
   }
 
-  SsdRun(uint64_t fileBits, uint32_t checksum)
-      : fileBits_(fileBits), checksum_(checksum) {}
+  SsdRun(uint64_t fileBits, uint32_t checksum, uint32_t uncompressedSize = 0)
+      : fileBits_(fileBits),
+        checksum_(checksum),
+        uncompressedSize_(uncompressedSize) {}
 
   SsdRun(const SsdRun& other) = default;
   SsdRun(SsdRun&& other) = default;
@@ -56,11 +67,13 @@ class SsdRun {
   void operator=(const SsdRun& other) {
     fileBits_ = other.fileBits_;
     checksum_ = other.checksum_;
+    uncompressedSize_ = other.uncompressedSize_;
   }
 
   void operator=(SsdRun&& other) {
     fileBits_ = other.fileBits_;
     checksum_ = other.checksum_;
+    uncompressedSize_ = other.uncompressedSize_;
   }
 
   uint64_t offset() const {
@@ -71,7 +84,19 @@ class SsdRun {
     return (fileBits_ & ((1 << kSizeBits) - 1)) + 1;
   }
 
-  /// Returns the checksum computed with crc32.
+  /// Returns true if the entry is stored compressed.
+  bool compressed() const {
+    return uncompressedSize_ != 0;
+  }
+
+  /// Returns the size of the entry after decompression. This is size() for
+  /// an entry that is not compressed.
+  uint32_t uncompressedSize() const {
+    return compressed() ? uncompressedSize_ : size();
+  }
+
+  /// Returns the checksum computed with crc32. The checksum is over the
+  /// uncompressed data.
   uint32_t checksum() const {
     return checksum_;
   }
@@ -85,6 +110,8 @@ class SsdRun {
   // Contains the file offset and size.
   uint64_t fileBits_;
   uint32_t checksum_;
+  // Size of the data in memory if stored compressed, 0 otherwise.
+  uint32_t uncompressedSize_{0};
 };
 
 /// Represents an SsdFile entry that is planned for load or being loaded. This
@@ -156,6 +183,8 @@ struct SsdCacheStats {
     entriesAgedOut = tsanAtomicValue(other.entriesAgedOut);
     regionsAgedOut = tsanAtomicValue(other.regionsAgedOut);
     regionsEvicted = tsanAtomicValue(other.regionsEvicted);
+    entriesCompressed = tsanAtomicValue(other.entriesCompressed);
+    bytesSavedByCompression = tsanAtomicValue(other.bytesSavedByCompression);
     numPins = tsanAtomicValue(other.numPins);
 
     openFileErrors = tsanAtomicValue(other.openFileErrors);
@@ -185,6 +214,9 @@ struct SsdCacheStats {
     result.entriesAgedOut = entriesAgedOut - other.entriesAgedOut;
     result.regionsAgedOut = regionsAgedOut - other.regionsAgedOut;
     result.regionsEvicted = regionsEvicted - other.regionsEvicted;
+    result.entriesCompressed = entriesCompressed - other.entriesCompressed;
+    result.bytesSavedByCompression =
+        bytesSavedByCompression - other.bytesSavedByCompression;
     result.openFileErrors = openFileErrors - other.openFileErrors;
     result.openCheckpointErrors =
         openCheckpointErrors - other.openCheckpointErrors;
@@ -226,6 +258,10 @@ struct SsdCacheStats {
   tsan_atomic<uint64_t> entriesAgedOut{0};
   tsan_atomic<uint64_t> regionsAgedOut{0};
   tsan_atomic<uint64_t> regionsEvicted{0};
+  /// Number of entries written in compressed form.
+  tsan_atomic<uint64_t> entriesCompressed{0};
+  /// Sum of the uncompressed minus the written size of compressed entries.
+  tsan_atomic<uint64_t> bytesSavedByCompression{0};
   tsan_atomic<uint32_t> openFileErrors{0};
   tsan_atomic<uint32_t> openCheckpointErrors{0};
   tsan_atomic<uint32_t> openLogErrors{0};
@@ -257,7 +293,8 @@ class SsdFile {
         bool _disableFileCow = false,
         bool _checksumEnabled = false,
         bool _checksumReadVerificationEnabled = false,
-        folly::Executor* _executor = nullptr)
+        folly::Executor* _executor = nullptr,
+        common::CompressionKind _compressionKind = common::CompressionKind_NONE)
         : fileName(_fileName),
           shardId(_shardId),
           maxRegions(_maxRegions),
@@ -266,7 +303,8 @@ class SsdFile {
           checksumEnabled(_checksumEnabled),
           checksumReadVerificationEnabled(
               _checksumEnabled && _checksumReadVerificationEnabled),
-          executor(_executor){};
+          executor(_executor),
+          compressionKind(_compressionKind){};
 
     /// Name of cache file, used as prefix for checkpoint files.
     const std::string fileName;
@@ -292,6 +330,10 @@ class SsdFile {
 
     /// Executor for async fsync in checkpoint.
     folly::Executor* executor;
+
+    /// Compression for the entries written to the file. An entry is written
+    /// uncompressed if compression does not make it substantially smaller.
+    common::CompressionKind compressionKind;
   };
 
   static constexpr uint64_t kRegionSize = 1 << 26; // 64MB
@@ -388,6 +430,10 @@ class SsdFile {
 
   static constexpr int kMaxErasedSizePct = 50;
 
+  // An entry is written compressed only if it compresses to at most this
+  // percentage of its size.
+  static constexpr int kMaxCompressedSizePct = 90;
+
   // Updates the read count of a region.
   void regionRead(int32_t region, int32_t size) {
     tracker_.regionRead(region, size);
@@ -404,25 +450,44 @@ class SsdFile {
   }
 
   // The first 4 bytes of a checkpoint file contains version string to indicate
-  // if checksum write is enabled or not.
+  // if checksum write and compression are enabled or not.
   std::string checkpointVersion() const {
+    if (compressionEnabled()) {
+      return checksumEnabled_ ? "CPZ2" : "CPZ1";
+    }
     return checksumEnabled_ ? "CPT2" : "CPT1";
   }
 
+  bool compressionEnabled() const {
+    return compressionKind_ != common::CompressionKind_NONE;
+  }
+
   // Increments the pin count of the region of 'offset'. Caller must hold
   // 'mutex_'.
   void pinRegionLocked(uint64_t offset) {
     ++regionPins_[regionIndex(offset)];
   }
 
-  // Returns [offset, size] of contiguous space for storing data of a number of
-  // contiguous 'pins' starting with the pin at index 'begin'.  Returns nullopt
-  // if there is no space. The space does not necessarily cover all the pins, so
-  // multiple calls starting at the first unwritten pin may be needed.
+  // Returns [offset, size] of contiguous space for storing a number of
+  // contiguous entries of 'sizes' starting with the entry at index 'begin'.
+  // Returns nullopt if there is no space. The space does not necessarily cover
+  // all the entries, so multiple calls starting at the first unwritten entry
+  // may be needed.
   std::optional<std::pair<uint64_t, int32_t>> getSpace(
-      const std::vector<CachePin>& pins,
+      const std::vector<uint32_t>& sizes,
       int32_t begin);
 
+  // Compresses the entries of 'pins'. Returns the compressed data for each
+  // entry or nullptr if the entry is to be written uncompressed.
+  std::vector<std::unique_ptr<folly::IOBuf>> compressEntries(
+      const std::vector<CachePin>& pins);
+
+  // Decompresses 'data' of 'run' into 'entry'.
+  void decompressEntry(
+      folly::StringPiece data,
+      const SsdRun& run,
+      AsyncDataCacheEntry& entry);
+
   // Removes all 'entries_' that reference data in regions described by
   // 'regionIndices'.
   void clearRegionEntriesLocked(const std::vector<int32_t>& regions);
@@ -523,7 +588,14 @@ class SsdFile {
   // Returns true if checksum write is enabled for the given version.
   static bool isChecksumEnabledOnCheckpointVersion(
       const std::string& checkpointVersion) {
-    return checkpointVersion == "CPT2";
+    return checkpointVersion == "CPT2" || checkpointVersion == "CPZ2";
+  }
+
+  // Returns true if the checkpoint of the given version may have compressed
+  // entries.
+  static bool isCompressionEnabledOnCheckpointVersion(
+      const std::string& checkpointVersion) {
+    return checkpointVersion.compare(0, 3, "CPZ") == 0;
   }
 
   static constexpr const char* kLogExtension = ".log";
@@ -548,6 +620,13 @@ class SsdFile {
   // Shard index within 'cache_'.
   const int32_t shardId_;
 
+  // Compression for new entries.
+  const common::CompressionKind compressionKind_;
+
+  // Codec for 'compressionKind_' used by write(). Loads make their own codec
+  // since they may run concurrently.
+  const std::unique_ptr<folly::compression::Codec> codec_;
+
   // Serializes access to all private data members.
   mutable std::shared_mutex mutex_;
 
@@ -943,12 +943,14 @@ TEST_P(AsyncDataCacheTest, cacheStats) {
   stats.allocClocks = 1320;
   stats.sumEvictScore = 123;
   stats.numStales = 100;
+  stats.numAdmissionRejects = 7;
+  stats.numSsdAdmissionRejects = 3;
   ASSERT_EQ(
       stats.toString(),
       "Cache size: 2.56KB tinySize: 257B large size: 2.31KB\n"
       "Cache entries: 100 read pins: 30 write pins: 20 pinned shared: 10.00MB pinned exclusive: 10.00MB\n"
       " num write wait: 244 empty entries: 20\n"
-      "Cache access miss: 2041 hit: 46 hit bytes: 1.34KB eviction: 463 savable eviction: 0 eviction checks: 348 aged out: 10 stales: 100\n"
+      "Cache access miss: 2041 hit: 46 hit bytes: 1.34KB eviction: 463 savable eviction: 0 eviction checks: 348 aged out: 10 stales: 100 admission rejects: 7 ssd admission rejects: 3\n"
       "Prefetch entries: 30 bytes: 100B\n"
       "Alloc Megaclocks 0");
 
@@ -975,6 +977,8 @@ TEST_P(AsyncDataCacheTest, cacheStats) {
   ASSERT_EQ(statsDelta.allocClocks, 0);
   ASSERT_EQ(statsDelta.sumEvictScore, 0);
   ASSERT_EQ(statsDelta.numStales, 0);
+  ASSERT_EQ(statsDelta.numAdmissionRejects, 0);
+  ASSERT_EQ(statsDelta.numSsdAdmissionRejects, 0);
 
   constexpr uint64_t kRamBytes = 32 << 20;
   constexpr uint64_t kSsdBytes = 512UL << 20;
@@ -984,7 +988,7 @@ TEST_P(AsyncDataCacheTest, cacheStats) {
       "Cache size: 0B tinySize: 0B large size: 0B\n"
       "Cache entries: 0 read pins: 0 write pins: 0 pinned shared: 0B pinned exclusive: 0B\n"
       " num write wait: 0 empty entries: 0\n"
-      "Cache access miss: 0 hit: 0 hit bytes: 0B eviction: 0 savable eviction: 0 eviction checks: 0 aged out: 0 stales: 0\n"
+      "Cache access miss: 0 hit: 0 hit bytes: 0B eviction: 0 savable eviction: 0 eviction checks: 0 aged out: 0 stales: 0 admission rejects: 0 ssd admission rejects: 0\n"
       "Prefetch entries: 0 bytes: 0B\n"
       "Alloc Megaclocks 0\n"
       "Allocated pages: 0 cached pages: 0\n"
@@ -1008,7 +1012,7 @@ TEST_P(AsyncDataCacheTest, cacheStats) {
       "Cache size: 0B tinySize: 0B large size: 0B\n"
       "Cache entries: 0 read pins: 0 write pins: 0 pinned shared: 0B pinned exclusive: 0B\n"
       " num write wait: 0 empty entries: 0\n"
-      "Cache access miss: 0 hit: 0 hit bytes: 0B eviction: 0 savable eviction: 0 eviction checks: 0 aged out: 0 stales: 0\n"
+      "Cache access miss: 0 hit: 0 hit bytes: 0B eviction: 0 savable eviction: 0 eviction checks: 0 aged out: 0 stales: 0 admission rejects: 0 ssd admission rejects: 0\n"
       "Prefetch entries: 0 bytes: 0B\n"
       "Alloc Megaclocks 0\n"
       "Allocated pages: 0 cached pages: 0\n";
@@ -1031,7 +1035,7 @@ TEST_P(AsyncDataCacheTest, cacheStatsWithSsd) {
   ASSERT_EQ(deltaStats.ssdStats->bytesWritten, 1);
   ASSERT_EQ(deltaStats.ssdStats->bytesRead, 1);
   const std::string expectedDeltaCacheStats =
-      "Cache size: 0B tinySize: 0B large size: 0B\nCache entries: 0 read pins: 0 write pins: 0 pinned shared: 0B pinned exclusive: 0B\n num write wait: 0 empty entries: 0\nCache access miss: 0 hit: 234 hit bytes: 0B eviction: 1024 savable eviction: 0 eviction checks: 0 aged out: 0 stales: 0\nPrefetch entries: 0 bytes: 0B\nAlloc Megaclocks 0";
+      "Cache size: 0B tinySize: 0B large size: 0B\nCache entries: 0 read pins: 0 write pins: 0 pinned shared: 0B pinned exclusive: 0B\n num write wait: 0 empty entries: 0\nCache access miss: 0 hit: 234 hit bytes: 0B eviction: 1024 savable eviction: 0 eviction checks: 0 aged out: 0 stales: 0 admission rejects: 0 ssd admission rejects: 0\nPrefetch entries: 0 bytes: 0B\nAlloc Megaclocks 0";
   ASSERT_EQ(deltaStats.toString(), expectedDeltaCacheStats);
 }
 
@@ -1442,6 +1446,55 @@ TEST_P(AsyncDataCacheTest, makeEvictable) {
   }
 }
 
+TEST_P(AsyncDataCacheTest, admissionFilter) {
+  constexpr uint64_t kRamBytes = 16UL << 20;
+  constexpr int32_t kEntrySize = 64 << 10;
+  constexpr int32_t kNumHot = 64;
+  // Scans 4x the cache capacity.
+  constexpr int32_t kNumScan = 4 * kRamBytes / kEntrySize;
+  for (const bool admissionFilter : {false, true}) {
+    SCOPED_TRACE(fmt::format("admissionFilter: {}", admissionFilter));
+    AsyncDataCache::Options options;
+    options.admissionFilter = admissionFilter;
+    initializeCache(kRamBytes, 0, 0, false, options);
+
+    // Reads an entry the way CacheInputStream does.
+    auto read = [&](int32_t index) {
+      auto pin = cache_->findOrCreate(
+          RawFileCacheKey{filenames_[0].id(), uint64_t(index) * kEntrySize},
+          kEntrySize);
+      ASSERT_FALSE(pin.empty());
+      auto* entry = pin.checkedEntry();
+      if (entry->isExclusive()) {
+        entry->setExclusiveToShared();
+      }
+      entry->getAndClearFirstUseFlag();
+    };
+    for (auto i = 0; i < 4; ++i) {
+      for (auto hot = 0; hot < kNumHot; ++hot) {
+        read(hot);
+      }
+    }
+    for (auto i = 0; i < kNumScan; ++i) {
+      read(kNumHot + i);
+    }
+
+    int32_t numHotCached = 0;
+    for (auto hot = 0; hot < kNumHot; ++hot) {
+      numHotCached += cache_->exists(
+          RawFileCacheKey{filenames_[0].id(), uint64_t(hot) * kEntrySize});
+    }
+    const auto stats = cache_->refreshStats();
+    if (admissionFilter) {
+      ASSERT_GT(stats.numAdmissionRejects, kNumScan / 2);
+      ASSERT_GE(numHotCached, kNumHot * 3 / 4);
+    } else {
+      ASSERT_EQ(stats.numAdmissionRejects, 0);
+    }
+    ASSERT_EQ(stats.numSsdAdmissionRejects, 0);
+  }
+}
+
 TEST_P(AsyncDataCacheTest, ssdWriteOptions) {
   constexpr uint64_t kRamBytes = 16UL << 20; // 16 MB
   constexpr uint64_t kSsdBytes = 64UL << 20; // 64 MB
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/FrequencySketch.h"
+#include "velox/common/base/BitUtil.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox;
+using namespace facebook::velox::cache;
+
+namespace {
+uint64_t keyHash(uint64_t key) {
+  // Like cache keys, all hashes of a shard share the low bits.
+  return bits::hashMix(key, 17) << 2;
+}
+} // namespace
+
+TEST(FrequencySketchTest, basic) {
+  FrequencySketch sketch(1'000);
+  EXPECT_EQ(sketch.capacity(), 1'024);
+  EXPECT_EQ(sketch.frequency(keyHash(1)), 0);
+  for (auto i = 0; i < 5; ++i) {
+    sketch.increment(keyHash(1));
+  }
+  sketch.increment(keyHash(2));
+  EXPECT_EQ(sketch.frequency(keyHash(1)), 5);
+  EXPECT_EQ(sketch.frequency(keyHash(2)), 1);
+  EXPECT_EQ(sketch.frequency(keyHash(3)), 0);
+
+  // Counters saturate.
+  for (auto i = 0; i < 100; ++i) {
+    sketch.increment(keyHash(1));
+  }
+  EXPECT_EQ(sketch.frequency(keyHash(1)), FrequencySketch::kMaxFrequency);
+}
+
+TEST(FrequencySketchTest, accuracy) {
+  constexpr int32_t kNumKeys = 4'000;
+  FrequencySketch sketch(kNumKeys);
+  // Key i is accessed i % 8 times.
+  for (auto key = 0; key < kNumKeys; ++key) {
+    for (auto i = 0; i < key % 8; ++i) {
+      sketch.increment(keyHash(key));
+    }
+  }
+  ASSERT_EQ(sketch.numAgings(), 0);
+  int32_t numExact = 0;
+  for (auto key = 0; key < kNumKeys; ++key) {
+    const auto frequency = sketch.frequency(keyHash(key));
+    // A count-min sketch never underestimates.
+    ASSERT_GE(frequency, key % 8);
+    numExact += frequency == key % 8;
+  }
+  EXPECT_GT(numExact, kNumKeys * 9 / 10);
+}
+
+TEST(FrequencySketchTest, aging) {
+  FrequencySketch sketch;
+  for (auto i = 0; i < 8; ++i) {
+    sketch.increment(keyHash(0));
+  }
+  // Touches distinct keys until the counters are halved.
+  uint64_t key = 1;
+  while (sketch.numAgings() == 0) {
+    sketch.increment(keyHash(key++));
+  }
+  EXPECT_LE(key, sketch.sampleSize() + 1);
+  // Collisions with other keys may add to the halved count of 8.
+  EXPECT_GE(sketch.frequency(keyHash(0)), 4);
+  EXPECT_LE(sketch.frequency(keyHash(0)), 7);
+}
+
+TEST(FrequencySketchTest, ensureCapacity) {
+  FrequencySketch sketch;
+  EXPECT_EQ(sketch.capacity(), 1'024);
+  for (auto i = 0; i < 6; ++i) {
+    sketch.increment(keyHash(1));
+  }
+  sketch.increment(keyHash(2));
+  sketch.ensureCapacity(100);
+  EXPECT_EQ(sketch.frequency(keyHash(1)), 6);
+
+  // Growing keeps the history at half the counts.
+  sketch.ensureCapacity(5'000);
+  EXPECT_EQ(sketch.capacity(), 8'192);
+  EXPECT_EQ(sketch.sampleSize(), 81'920);
+  EXPECT_EQ(sketch.frequency(keyHash(1)), 3);
+  EXPECT_EQ(sketch.frequency(keyHash(2)), 0);
+  EXPECT_EQ(sketch.frequency(keyHash(3)), 0);
+
+  // Counts of many keys survive repeated growth without underestimates.
+  constexpr int32_t kNumKeys = 2'000;
+  FrequencySketch growing;
+  for (auto key = 0; key < kNumKeys; ++key) {
+    for (auto i = 0; i < 2 * (key % 4); ++i) {
+      growing.increment(keyHash(key));
+    }
+  }
+  ASSERT_EQ(growing.numAgings(), 0);
+  growing.ensureCapacity(4 * kNumKeys);
+  for (auto key = 0; key < kNumKeys; ++key) {
+    ASSERT_GE(growing.frequency(keyHash(key)), key % 4);
+  }
+}
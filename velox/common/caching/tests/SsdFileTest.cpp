@@ -23,6 +23,7 @@
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 
 #include <fcntl.h>
+#include <folly/Random.h>
 #include <folly/executors/IOThreadPoolExecutor.h>
 #include <folly/executors/QueuedImmediateExecutor.h>
 #include <glog/logging.h>
@@ -74,7 +75,8 @@ class SsdFileTest : public testing::Test {
       bool checksumEnabled = false,
       bool checksumReadVerificationEnabled = false,
       bool disableFileCow = false,
-      bool enableFaultInjection = false) {
+      bool enableFaultInjection = false,
+      common::CompressionKind compressionKind = common::CompressionKind_NONE) {
     // tmpfs does not support O_DIRECT, so turn this off for testing.
     FLAGS_velox_ssd_odirect = false;
     cache_ = AsyncDataCache::create(memory::memoryManager()->allocator());
@@ -88,7 +90,8 @@ class SsdFileTest : public testing::Test {
         checkpointIntervalBytes,
         checksumEnabled,
         checksumReadVerificationEnabled,
-        disableFileCow);
+        disableFileCow,
+        compressionKind);
   }
 
   void initializeSsdFile(
@@ -96,7 +99,8 @@ class SsdFileTest : public testing::Test {
       uint64_t checkpointIntervalBytes = 0,
       bool checksumEnabled = false,
       bool checksumReadVerificationEnabled = false,
-      bool disableFileCow = false) {
+      bool disableFileCow = false,
+      common::CompressionKind compressionKind = common::CompressionKind_NONE) {
     SsdFile::Config config(
         fmt::format("{}/ssdtest", tempDirectory_->getPath()),
         0, // shardId
@@ -105,7 +109,8 @@ class SsdFileTest : public testing::Test {
         disableFileCow,
         checksumEnabled,
         checksumReadVerificationEnabled,
-        ssdExecutor());
+        ssdExecutor(),
+        compressionKind);
     ssdFile_ = std::make_unique<SsdFile>(config);
     if (ssdFile_ != nullptr) {
       ssdFileHelper_ =
@@ -172,6 +177,34 @@ class SsdFileTest : public testing::Test {
     }
   }
 
+  // Copies 'data' into the memory of 'entry'.
+  static void setContents(AsyncDataCacheEntry& entry, std::string_view data) {
+    ASSERT_EQ(entry.size(), data.size());
+    ASSERT_EQ(entry.tinyData(), nullptr);
+    const auto& allocation = entry.data();
+    uint64_t offset = 0;
+    for (auto i = 0; i < allocation.numRuns() && offset < data.size(); ++i) {
+      const auto run = allocation.runAt(i);
+      const auto size = std::min<uint64_t>(run.numBytes(), data.size() - offset);
+      ::memcpy(run.data<char>(), data.data() + offset, size);
+      offset += size;
+    }
+  }
+
+  // Returns a copy of the memory of 'entry'.
+  static std::string getContents(const AsyncDataCacheEntry& entry) {
+    std::string result;
+    const auto& allocation = entry.data();
+    for (auto i = 0; i < allocation.numRuns() && result.size() < entry.size();
+         ++i) {
+      const auto run = allocation.runAt(i);
+      result.append(
+          run.data<char>(),
+          std::min<uint64_t>(run.numBytes(), entry.size() - result.size()));
+    }
+    return result;
+  }
+
   static folly::IOThreadPoolExecutor* ssdExecutor() {
     static std::unique_ptr<folly::IOThreadPoolExecutor> ssdExecutor =
         std::make_unique<folly::IOThreadPoolExecutor>(20);
@@ -820,6 +853,98 @@ TEST_F(SsdFileTest, ssdReadWithoutChecksumCheck) {
 #endif
 }
 
+TEST_F(SsdFileTest, compression) {
+  constexpr int64_t kSsdSize = 4 * SsdFile::kRegionSize;
+  const uint64_t checkpointIntervalBytes = 3 * SsdFile::kRegionSize;
+  constexpr uint64_t kRandomOffset = 1UL << 32;
+  constexpr int32_t kRandomSize = 64 << 10;
+  FLAGS_velox_ssd_verify_write = true;
+  initializeCache(
+      kSsdSize,
+      checkpointIntervalBytes,
+      /*checksumEnabled=*/true,
+      /*checksumReadVerificationEnabled=*/true,
+      /*disableFileCow=*/false,
+      /*enableFaultInjection=*/false,
+      common::CompressionKind_ZSTD);
+
+  auto pins = makePins(fileName_.id(), 0, 4096, 2048 * 1025, 62 * kMB);
+  std::vector<TestEntry> allEntries;
+  uint64_t uncompressedBytes = 0;
+  for (auto& pin : pins) {
+    allEntries.emplace_back(
+        pin.entry()->key(), pin.entry()->ssdOffset(), pin.entry()->size());
+    uncompressedBytes += pin.entry()->size();
+  }
+  // Random bytes do not compress and are written as is.
+  std::string randomData(kRandomSize, '\0');
+  folly::Random::DefaultGenerator rng(1);
+  for (auto& c : randomData) {
+    c = folly::Random::rand32(rng);
+  }
+  pins.push_back(cache_->findOrCreate(
+      RawFileCacheKey{fileName_.id(), kRandomOffset}, kRandomSize, nullptr));
+  setContents(*pins.back().entry(), randomData);
+  ssdFile_->write(pins);
+
+  SsdCacheStats stats;
+  ssdFile_->updateStats(stats);
+  ASSERT_EQ(stats.entriesWritten, allEntries.size() + 1);
+  ASSERT_EQ(stats.entriesCompressed, allEntries.size());
+  ASSERT_GT(stats.bytesSavedByCompression, uncompressedBytes / 4);
+  ASSERT_EQ(
+      stats.bytesCached,
+      uncompressedBytes + kRandomSize - stats.bytesSavedByCompression);
+  for (const auto& [key, run] : ssdFileHelper_->eEntries()) {
+    ASSERT_EQ(run.compressed(), key.offset != kRandomOffset);
+  }
+
+  auto checkRandomEntry = [&]() {
+    std::vector<CachePin> randomPins;
+    randomPins.push_back(cache_->findOrCreate(
+        RawFileCacheKey{fileName_.id(), kRandomOffset}, kRandomSize, nullptr));
+    ASSERT_TRUE(randomPins.back().entry()->isExclusive());
+    std::vector<SsdPin> ssdPins;
+    ssdPins.push_back(
+        ssdFile_->find(RawFileCacheKey{fileName_.id(), kRandomOffset}));
+    ASSERT_FALSE(ssdPins.back().empty());
+    ssdFile_->load(ssdPins, randomPins);
+    ASSERT_EQ(getContents(*randomPins.back().entry()), randomData);
+  };
+
+  // Entries are decompressed on load.
+  pins.clear();
+  cache_->clear();
+  ASSERT_EQ(checkEntries(allEntries), allEntries.size());
+  cache_->clear();
+  checkRandomEntry();
+
+  // The compressed entries are recovered from a checkpoint.
+  ssdFile_->checkpoint(true);
+  initializeSsdFile(
+      kSsdSize,
+      checkpointIntervalBytes,
+      true,
+      true,
+      false,
+      common::CompressionKind_ZSTD);
+  SsdCacheStats statsAfterRecovery;
+  ssdFile_->updateStats(statsAfterRecovery);
+  ASSERT_EQ(statsAfterRecovery.entriesCached, allEntries.size() + 1);
+  ASSERT_EQ(statsAfterRecovery.bytesCached, stats.bytesCached);
+  cache_->clear();
+  ASSERT_EQ(checkEntries(allEntries), allEntries.size());
+  cache_->clear();
+  checkRandomEntry();
+
+  // A checkpoint with entries compressed differently is not recovered.
+  ssdFile_->checkpoint(true);
+  initializeSsdFile(kSsdSize, checkpointIntervalBytes, true, true);
+  statsAfterRecovery.clear();
+  ssdFile_->updateStats(statsAfterRecovery);
+  ASSERT_EQ(statsAfterRecovery.entriesCached, 0);
+}
+
 TEST_F(SsdFileTest, dataFileErrorInjection) {
   constexpr int64_t kSsdSize = 16 * SsdFile::kRegionSize;
   initializeCache(kSsdSize, 0, false, false, false, true);
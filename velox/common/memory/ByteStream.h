@@ -210,18 +210,32 @@ class ByteInputStream {
 
   virtual std::string toString() const = 0;
 
+  /// Returns an object that keeps the memory of the stream alive, or null if
+  /// the stream does not own its memory. Readers may hold on to this to keep
+  /// views over the stream memory, e.g. from nextView(), valid after the
+  /// stream is destroyed.
+  const std::shared_ptr<void>& memoryOwner() const {
+    return memoryOwner_;
+  }
+
  protected:
   // Points to the current buffered byte range.
   ByteRange* current_{nullptr};
+
+  std::shared_ptr<void> memoryOwner_;
 };
 
 /// Read-only input stream backed by a set of buffers.
 class BufferInputStream : public ByteInputStream {
  public:
-  explicit BufferInputStream(std::vector<ByteRange> ranges) {
+  /// If 'memoryOwner' is not null, it keeps the memory of 'ranges' alive.
+  explicit BufferInputStream(
+      std::vector<ByteRange> ranges,
+      std::shared_ptr<void> memoryOwner = nullptr) {
     VELOX_CHECK(!ranges.empty(), "Empty BufferInputStream");
     ranges_ = std::move(ranges);
     current_ = &ranges_[0];
+    memoryOwner_ = std::move(memoryOwner);
   }
 
   BufferInputStream(const BufferInputStream&) = delete;
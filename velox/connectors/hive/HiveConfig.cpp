@@ -230,6 +230,13 @@ bool HiveConfig::readStatsBasedFilterReorderDisabled(
       config_->get<bool>(kReadStatsBasedFilterReorderDisabled, false));
 }
 
+bool HiveConfig::preserveStringDictionaries(
+    const config::ConfigBase* session) const {
+  return session->get<bool>(
+      kPreserveStringDictionariesSession,
+      config_->get<bool>(kPreserveStringDictionaries, false));
+}
+
 std::string HiveConfig::hiveLocalDataPath() const {
   return config_->get<std::string>(kLocalDataPath, "");
 }
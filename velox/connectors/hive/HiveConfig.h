@@ -184,6 +184,13 @@ class HiveConfig {
   static constexpr const char* kReadStatsBasedFilterReorderDisabledSession =
       "stats_based_filter_reorder_disabled";
 
+  /// Whether dictionary encoded string columns are read as dictionary vectors
+  /// over the file dictionary even if a flat vector would be smaller.
+  static constexpr const char* kPreserveStringDictionaries =
+      "hive.reader.preserve-string-dictionaries";
+  static constexpr const char* kPreserveStringDictionariesSession =
+      "hive.reader.preserve_string_dictionaries";
+
   static constexpr const char* kLocalDataPath = "hive_local_data_path";
   static constexpr const char* kLocalFileFormat = "hive_local_file_format";
 
@@ -258,6 +265,8 @@ class HiveConfig {
   bool readStatsBasedFilterReorderDisabled(
       const config::ConfigBase* session) const;
 
+  bool preserveStringDictionaries(const config::ConfigBase* session) const;
+
   /// Returns the file system path containing local data. If non-empty,
   /// initializes LocalHiveConnectorMetadata to provide metadata for the tables
   /// in the directory.
@@ -43,6 +43,7 @@ TEST(HiveConfigTest, defaultConfig) {
       hiveConfig.maxCoalescedDistanceBytes(emptySession.get()), 512 << 10);
   ASSERT_FALSE(
       hiveConfig.readStatsBasedFilterReorderDisabled(emptySession.get()));
+  ASSERT_FALSE(hiveConfig.preserveStringDictionaries(emptySession.get()));
   ASSERT_EQ(hiveConfig.numCacheFileHandles(), 20'000);
   ASSERT_TRUE(hiveConfig.isFileHandleCacheEnabled());
   ASSERT_EQ(hiveConfig.sortWriterMaxOutputRows(emptySession.get()), 1024);
@@ -74,6 +75,7 @@ TEST(HiveConfigTest, overrideConfig) {
       {HiveConfig::kSortWriterMaxOutputBytes, "100MB"},
       {HiveConfig::kSortWriterFinishTimeSliceLimitMs, "400"},
       {HiveConfig::kReadStatsBasedFilterReorderDisabled, "true"},
+      {HiveConfig::kPreserveStringDictionaries, "true"},
       {HiveConfig::kLoadQuantum, std::to_string(4 << 20)},
       {HiveConfig::kMaxBucketCount, std::to_string(100'000)}};
   HiveConfig hiveConfig(
@@ -104,6 +106,7 @@ TEST(HiveConfigTest, overrideConfig) {
       hiveConfig.sortWriterFinishTimeSliceLimitMs(emptySession.get()), 400);
   ASSERT_TRUE(
       hiveConfig.readStatsBasedFilterReorderDisabled(emptySession.get()));
+  ASSERT_TRUE(hiveConfig.preserveStringDictionaries(emptySession.get()));
   ASSERT_EQ(hiveConfig.loadQuantum(emptySession.get()), 4 << 20);
   ASSERT_EQ(hiveConfig.maxBucketCount(emptySession.get()), 100'000);
 }
@@ -123,6 +126,7 @@ TEST(HiveConfigTest, overrideSession) {
       {HiveConfig::kAllowNullPartitionKeysSession, "false"},
       {HiveConfig::kIgnoreMissingFilesSession, "true"},
       {HiveConfig::kReadStatsBasedFilterReorderDisabledSession, "true"},
+      {HiveConfig::kPreserveStringDictionariesSession, "true"},
       {HiveConfig::kLoadQuantumSession, std::to_string(4 << 20)}};
   const auto session =
       std::make_unique<config::ConfigBase>(std::move(sessionOverride));
@@ -148,5 +152,6 @@ TEST(HiveConfigTest, overrideSession) {
   ASSERT_FALSE(hiveConfig.allowNullPartitionKeys(session.get()));
   ASSERT_TRUE(hiveConfig.ignoreMissingFiles(session.get()));
   ASSERT_TRUE(hiveConfig.readStatsBasedFilterReorderDisabled(session.get()));
+  ASSERT_TRUE(hiveConfig.preserveStringDictionaries(session.get()));
   ASSERT_EQ(hiveConfig.loadQuantum(session.get()), 4 << 20);
 }
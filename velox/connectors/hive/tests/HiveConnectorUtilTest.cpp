@@ -348,6 +348,43 @@ TEST_F(HiveConnectorUtilTest, configureRowReaderOptions) {
   float_features->setFlatMapFeatureSelection({"1", "3"});
 }
 
+TEST_F(HiveConnectorUtilTest, configurePreserveStringDictionaries) {
+  auto hiveSplit =
+      std::make_shared<hive::HiveConnectorSplit>("", "", FileFormat::DWRF);
+  const auto configure =
+      [&](const std::shared_ptr<hive::HiveConfig>& hiveConfig,
+          const config::ConfigBase& sessionProperties) {
+        dwio::common::RowReaderOptions rowReaderOpts;
+        configureRowReaderOptions(
+            /*tableParameters=*/{},
+            /*scanSpec=*/nullptr,
+            /*metadataFilter=*/nullptr,
+            /*rowType=*/nullptr,
+            /*hiveSplit=*/hiveSplit,
+            /*hiveConfig=*/hiveConfig,
+            /*sessionProperties=*/&sessionProperties,
+            /*rowReaderOptions=*/rowReaderOpts);
+        return rowReaderOpts.preserveStringDictionaries();
+      };
+
+  const auto defaultConfig = std::make_shared<hive::HiveConfig>(
+      std::make_shared<config::ConfigBase>(
+          std::unordered_map<std::string, std::string>()));
+  const auto enabledConfig = std::make_shared<hive::HiveConfig>(
+      std::make_shared<config::ConfigBase>(
+          std::unordered_map<std::string, std::string>{
+              {hive::HiveConfig::kPreserveStringDictionaries, "true"}}));
+  const config::ConfigBase noSession({});
+  const config::ConfigBase disabledSession(
+      {{hive::HiveConfig::kPreserveStringDictionariesSession, "false"}});
+  const config::ConfigBase enabledSession(
+      {{hive::HiveConfig::kPreserveStringDictionariesSession, "true"}});
+  EXPECT_FALSE(configure(defaultConfig, noSession));
+  EXPECT_TRUE(configure(enabledConfig, noSession));
+  EXPECT_TRUE(configure(defaultConfig, enabledSession));
+  EXPECT_FALSE(configure(enabledConfig, disabledSession));
+}
+
 TEST_F(HiveConnectorUtilTest, configureSstRowReaderOptions) {
   dwio::common::RowReaderOptions rowReaderOpts;
   auto hiveSplit =
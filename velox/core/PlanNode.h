@@ -2221,6 +2221,13 @@ class PartitionFunction {
   virtual std::optional<uint32_t> partition(
       const RowVector& input,
       std::vector<uint32_t>& partitions) = 0;
+
+  /// Returns the rows of the input to the last partition() call that must be
+  /// sent to every partition. The entries of 'partitions' for these rows are
+  /// to be ignored. Returns nullptr if no row is replicated.
+  virtual const SelectivityVector* replicatedRows() const {
+    return nullptr;
+  }
 };
 
 /// Factory class for creating PartitionFunction instances.
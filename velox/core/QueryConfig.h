@@ -88,6 +88,28 @@ class QueryConfig {
   static constexpr const char* kExprMaxCompiledRegexes =
       "expression.max_compiled_regexes";
 
+  /// Whether to evaluate trees of arithmetic and comparison calls over columns
+  /// and constants in one pass per block of rows, without materializing the
+  /// results of the intermediate calls. Only functions registered with
+  /// exec::registerFusedFunction are fused.
+  static constexpr const char* kExprFusedEvaluationEnabled =
+      "expression.fused_evaluation_enabled";
+
+  /// Whether to evaluate the calls that extract different paths from the same
+  /// column, e.g. json_extract_scalar(c0, '$.a') and
+  /// json_extract_scalar(c0, '$.b'), together so that each value of the column
+  /// is parsed once. Only functions registered with
+  /// exec::registerMultiPathFunction are grouped.
+  static constexpr const char* kExprMultiPathExtractEnabled =
+      "expression.multi_path_extract_enabled";
+
+  /// Whether to stop scanning string function inputs for asciiness after
+  /// they were not all ASCII in several consecutive batches. Such inputs are
+  /// then scanned only periodically, and every batch again once they are all
+  /// ASCII.
+  static constexpr const char* kExprAdaptiveAsciiScanEnabled =
+      "expression.adaptive_ascii_scan_enabled";
+
   /// Used for backpressure to block local exchange producers when the local
   /// exchange buffer reaches or exceeds this size.
   static constexpr const char* kMaxLocalExchangeBufferSize =
@@ -158,6 +180,20 @@ class QueryConfig {
   static constexpr const char* kMinExchangeOutputBatchBytes =
       "min_exchange_output_batch_bytes";
 
+  /// If true, the Exchange operator deserializes Presto pages without copying
+  /// the values of fixed-width columns without nulls and the string payloads
+  /// where the page memory allows. The result vectors then reference the
+  /// received pages, which stay in memory for as long as the vectors do.
+  static constexpr const char* kExchangeZeroCopyDeserializationEnabled =
+      "exchange.zero_copy_deserialization_enabled";
+
+  /// If true, the exchange client sizes the data requests to each source
+  /// proportionally to the throughput observed for the source and requests
+  /// the slowest sources first. Otherwise, sources are requested in FIFO
+  /// order for all the data they have as long as it fits in the buffer.
+  static constexpr const char* kExchangeAdaptiveFetchSizingEnabled =
+      "exchange.adaptive_fetch_sizing_enabled";
+
   static constexpr const char* kMaxPartialAggregationMemory =
       "max_partial_aggregation_memory";
 
@@ -188,6 +224,14 @@ class QueryConfig {
   static constexpr const char* kMaxPartitionedOutputBufferSize =
       "max_page_partitioning_buffer_size";
 
+  /// Minimum number of destinations for PartitionedOutput to reorder its
+  /// input by destination before serializing. Each column is gathered once
+  /// in destination order, so that the rows of each destination are
+  /// serialized from a contiguous range instead of from rows scattered over
+  /// the input. Only applies to columnar serdes. 0 disables the reordering.
+  static constexpr const char* kPartitionedOutputScatterMinDestinations =
+      "partitioned_output_scatter_min_destinations";
+
   /// The maximum size in bytes for the task's buffered output.
   ///
   /// The producer Drivers are blocked when the buffered size exceeds
@@ -266,6 +310,13 @@ class QueryConfig {
   /// LocalMerge spilling flag, only applies if "spill_enabled" flag is set.
   static constexpr const char* kLocalMergeSpillEnabled = "local_merge_enabled";
 
+  /// Output buffer spilling flag, only applies if "spill_enabled" flag is set.
+  /// If true, the pages buffered for a destination that holds most of the
+  /// output buffer are spilled to disk instead of blocking the producers, and
+  /// the memory arbitrator can reclaim memory from the output buffer.
+  static constexpr const char* kOutputBufferSpillEnabled =
+      "output_buffer_spill_enabled";
+
   /// Specify the max number of local sources to merge at a time.
   static constexpr const char* kLocalMergeMaxNumMergeSources =
       "local_merge_max_num_merge_sources";
@@ -596,6 +647,14 @@ class QueryConfig {
   static constexpr const char* kShuffleCompressionKind =
       "shuffle_compression_codec";
 
+  /// If true, shuffle compression is decided per page from sampled per column
+  /// compression ratios, and flat string columns with few distinct values are
+  /// dictionary encoded. Pages that are predicted not to compress are sent
+  /// without running the codec. Only applies to the Presto serde and if
+  /// 'shuffle_compression_codec' is set.
+  static constexpr const char* kShuffleAdaptiveCompressionEnabled =
+      "shuffle_adaptive_compression_enabled";
+
   /// If a key is found in multiple given maps, by default that key's value in
   /// the resulting map comes from the last one of those maps. When true, throw
   /// exception on duplicate map key.
@@ -751,6 +810,10 @@ class QueryConfig {
     return get<uint64_t>(kMaxPartitionedOutputBufferSize, kDefault);
   }
 
+  uint32_t partitionedOutputScatterMinDestinations() const {
+    return get<uint32_t>(kPartitionedOutputScatterMinDestinations, 256);
+  }
+
   uint64_t maxOutputBufferSize() const {
     static constexpr uint64_t kDefault = 32UL << 20;
     return get<uint64_t>(kMaxOutputBufferSize, kDefault);
@@ -803,6 +866,14 @@ class QueryConfig {
     return get<uint64_t>(kMinExchangeOutputBatchBytes, kDefault);
   }
 
+  bool exchangeZeroCopyDeserializationEnabled() const {
+    return get<bool>(kExchangeZeroCopyDeserializationEnabled, false);
+  }
+
+  bool exchangeAdaptiveFetchSizingEnabled() const {
+    return get<bool>(kExchangeAdaptiveFetchSizingEnabled, false);
+  }
+
   uint64_t preferredOutputBatchBytes() const {
     static constexpr uint64_t kDefault = 10UL << 20;
     return get<uint64_t>(kPreferredOutputBatchBytes, kDefault);
@@ -859,6 +930,18 @@ class QueryConfig {
     return get<uint64_t>(kExprMaxCompiledRegexes, 100);
   }
 
+  bool exprFusedEvaluationEnabled() const {
+    return get<bool>(kExprFusedEvaluationEnabled, false);
+  }
+
+  bool exprAdaptiveAsciiScanEnabled() const {
+    return get<bool>(kExprAdaptiveAsciiScanEnabled, true);
+  }
+
+  bool exprMultiPathExtractEnabled() const {
+    return get<bool>(kExprMultiPathExtractEnabled, false);
+  }
+
   bool adjustTimestampToTimezone() const {
     return get<bool>(kAdjustTimestampToTimezone, false);
   }
@@ -911,6 +994,10 @@ class QueryConfig {
     return get<bool>(kLocalMergeSpillEnabled, false);
   }
 
+  bool outputBufferSpillEnabled() const {
+    return get<bool>(kOutputBufferSpillEnabled, false);
+  }
+
   uint32_t localMergeMaxNumMergeSources() const {
     const auto maxNumMergeSources = get<uint32_t>(
         kLocalMergeMaxNumMergeSources, std::numeric_limits<uint32_t>::max());
@@ -1162,6 +1249,10 @@ class QueryConfig {
     return get<std::string>(kShuffleCompressionKind, "none");
   }
 
+  bool shuffleAdaptiveCompressionEnabled() const {
+    return get<bool>(kShuffleAdaptiveCompressionEnabled, false);
+  }
+
   int32_t requestDataSizesMaxWaitSec() const {
     return get<int32_t>(kRequestDataSizesMaxWaitSec, 10);
   }
@@ -259,6 +259,7 @@ class ExecCtx {
           !queryConfig.debugDisableExpressionsWithLazyInputs();
       maxSharedSubexprResultsCached =
           queryConfig.maxSharedSubexprResultsCached();
+      adaptiveAsciiScanEnabled = queryConfig.exprAdaptiveAsciiScanEnabled();
     }
 
     /// True if caches in expression evaluation used for performance are
@@ -281,6 +282,10 @@ class ExecCtx {
     /// The maximum number of distinct inputs to cache results in a
     /// given shared subexpression during experssion evaluation.
     uint32_t maxSharedSubexprResultsCached;
+    /// True if string inputs that were not all ASCII in the last few batches
+    /// are scanned for asciiness only periodically during expression
+    /// evaluation.
+    bool adaptiveAsciiScanEnabled;
   };
 
   velox::memory::MemoryPool* pool() const {
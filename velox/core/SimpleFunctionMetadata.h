@@ -17,6 +17,7 @@
 
 #include <boost/algorithm/string.hpp>
 #include <folly/Likely.h>
+#include <folly/Range.h>
 #include <optional>
 
 #include "velox/common/base/Exceptions.h"
@@ -694,6 +695,7 @@ class UDFHolder {
   DECLARE_METHOD_RESOLVER(callNullable_method_resolver, callNullable);
   DECLARE_METHOD_RESOLVER(callNullFree_method_resolver, callNullFree);
   DECLARE_METHOD_RESOLVER(callAscii_method_resolver, callAscii);
+  DECLARE_METHOD_RESOLVER(callBatch_method_resolver, callBatch);
   DECLARE_METHOD_RESOLVER(initialize_method_resolver, initialize);
 
   // Check which flavor of the call()/callNullable()/callNullFree() method is
@@ -713,7 +715,24 @@ class UDFHolder {
   // Optionally, UDFs can also provide the following methods:
   //
   // - bool|void callAscii(...)
+  // - bool|void callBatch(...)
   // - void initialize(...)
+  //
+  // callBatch() takes the results and the arguments of a batch of rows as
+  // ranges of values, e.g. for a function of two BIGINT arguments:
+  //
+  //   void callBatch(
+  //       folly::Range<int64_t*> result,
+  //       folly::Range<const int64_t*> a,
+  //       folly::Range<const int64_t*> b);
+  //
+  // It allows functions to use loops the compiler can vectorize, or explicit
+  // SIMD. It is called only for fixed-width, non-boolean result and argument
+  // types, and only when all arguments are flat and have no nulls. It must
+  // produce the same results as call() and must not throw; returning false
+  // means that the batch needs to be evaluated one row at a time, e.g.
+  // because some row produces an error. 'result' may share memory with an
+  // argument unless callBatch() returns bool.
 
   // call():
   static constexpr bool udf_has_call_return_bool = util::has_method<
@@ -829,6 +848,22 @@ class UDFHolder {
         (udf_has_callAscii_return_void && udf_has_call_return_bool)),
       "The return type for callAscii() must match the return type for call().");
 
+  // callBatch():
+  static constexpr bool udf_has_callBatch_return_bool = util::has_method<
+      Fun,
+      callBatch_method_resolver,
+      bool,
+      folly::Range<exec_return_type*>,
+      folly::Range<const exec_arg_type<TArgs>*>...>::value;
+  static constexpr bool udf_has_callBatch_return_void = util::has_method<
+      Fun,
+      callBatch_method_resolver,
+      void,
+      folly::Range<exec_return_type*>,
+      folly::Range<const exec_arg_type<TArgs>*>...>::value;
+  static constexpr bool udf_has_callBatch =
+      udf_has_callBatch_return_bool | udf_has_callBatch_return_void;
+
   // initialize():
   static constexpr bool udf_has_initialize = util::has_method<
       Fun,
@@ -978,6 +1013,19 @@ class UDFHolder {
     }
   }
 
+  // Returns false if the batch needs to be evaluated one row at a time.
+  FOLLY_ALWAYS_INLINE bool callBatch(
+      folly::Range<exec_return_type*> out,
+      folly::Range<const exec_arg_type<TArgs>*>... args) {
+    static_assert(udf_has_callBatch);
+    if constexpr (udf_has_callBatch_return_bool) {
+      return instance_.callBatch(out, args...);
+    } else {
+      instance_.callBatch(out, args...);
+      return true;
+    }
+  }
+
   FOLLY_ALWAYS_INLINE Status callNullFree(
       exec_return_type& out,
       bool& notNull,
@@ -282,11 +282,12 @@ bool CacheInputStream::loadFromSsd(
     return false;
   }
 
-  if (ssdPin.run().size() < entry.size()) {
+  // A compressed entry takes less space on SSD than in memory.
+  if (ssdPin.run().uncompressedSize() < entry.size()) {
     LOG(INFO) << fmt::format(
         "IOERR: Ssd entry for {} shorter than requested {}",
         entry.toString(),
-        ssdPin.run().size());
+        ssdPin.run().uncompressedSize());
     return false;
   }
 
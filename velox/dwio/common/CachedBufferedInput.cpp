@@ -192,9 +192,11 @@ void CachedBufferedInput::load(const LogType /*unused*/) {
       }
       if (ssdFile != nullptr) {
         part->ssdPin = ssdFile->find(part->key);
-        if (!part->ssdPin.empty() && part->ssdPin.run().size() < part->size) {
+        if (!part->ssdPin.empty() &&
+            part->ssdPin.run().uncompressedSize() < part->size) {
           LOG(INFO) << "IOERR: Ignoring SSD shorter than requested: "
-                    << part->ssdPin.run().size() << " vs " << part->size;
+                    << part->ssdPin.run().uncompressedSize() << " vs "
+                    << part->size;
           part->ssdPin.clear();
         }
         if (!part->ssdPin.empty()) {
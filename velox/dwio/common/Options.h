@@ -410,6 +410,18 @@ class RowReaderOptions {
     timestampPrecision_ = precision;
   }
 
+  /// Whether readers return dictionary encoded string columns as dictionary
+  /// vectors over the file dictionary even if a flat vector of the selected
+  /// rows would be smaller. Expressions over such vectors are evaluated once
+  /// per distinct value and their results can be reused across batches.
+  bool preserveStringDictionaries() const {
+    return preserveStringDictionaries_;
+  }
+
+  void setPreserveStringDictionaries(bool preserveStringDictionaries) {
+    preserveStringDictionaries_ = preserveStringDictionaries;
+  }
+
   const std::shared_ptr<FormatSpecificOptions>& formatSpecificOptions() const {
     return formatSpecificOptions_;
   }
@@ -484,6 +496,8 @@ class RowReaderOptions {
 
   TimestampPrecision timestampPrecision_ = TimestampPrecision::kMilliseconds;
 
+  bool preserveStringDictionaries_{false};
+
   std::shared_ptr<FormatSpecificOptions> formatSpecificOptions_;
 };
 
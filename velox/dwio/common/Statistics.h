@@ -536,6 +536,10 @@ struct ColumnReaderStatistics {
   // Number of rows returned by string dictionary reader that is flattened
   // instead of keeping dictionary encoding.
   int64_t flattenStringDictionaryValues{0};
+
+  // Number of data pages whose decompression and decoding was skipped because
+  // none of their rows were read.
+  int64_t skippedPages{0};
 };
 
 struct RuntimeStatistics {
@@ -592,6 +596,10 @@ struct RuntimeStatistics {
           "flattenStringDictionaryValues",
           RuntimeCounter(columnReaderStatistics.flattenStringDictionaryValues));
     }
+    if (columnReaderStatistics.skippedPages > 0) {
+      result.emplace(
+          "skippedPages", RuntimeCounter(columnReaderStatistics.skippedPages));
+    }
     return result;
   }
 };
@@ -186,6 +186,45 @@ inline StreamKind toStreamKind(proto::orc::Stream_Kind kind) {
   }
 }
 
+// Maps the stream kinds produced by the column writers to the ORC spec. DWRF
+// only stream kinds (in-dictionary, stride dictionary, in-map and the DWRF
+// bloom filter) have no ORC counterpart and are rejected.
+inline proto::orc::Stream_Kind toOrcStreamKind(StreamKind kind) {
+  switch (kind) {
+    case StreamKind::StreamKind_PRESENT:
+    case StreamKind::StreamKindOrc_PRESENT:
+      return proto::orc::Stream_Kind_PRESENT;
+
+    case StreamKind::StreamKind_DATA:
+    case StreamKind::StreamKindOrc_DATA:
+      return proto::orc::Stream_Kind_DATA;
+
+    case StreamKind::StreamKind_LENGTH:
+    case StreamKind::StreamKindOrc_LENGTH:
+      return proto::orc::Stream_Kind_LENGTH;
+
+    case StreamKind::StreamKind_DICTIONARY_DATA:
+    case StreamKind::StreamKindOrc_DICTIONARY_DATA:
+      return proto::orc::Stream_Kind_DICTIONARY_DATA;
+
+    case StreamKind::StreamKind_DICTIONARY_COUNT:
+    case StreamKind::StreamKindOrc_DICTIONARY_COUNT:
+      return proto::orc::Stream_Kind_DICTIONARY_COUNT;
+
+    // DWRF's NANO_DATA has the same meaning and value as ORC's SECONDARY.
+    case StreamKind::StreamKind_NANO_DATA:
+    case StreamKind::StreamKindOrc_SECONDARY:
+      return proto::orc::Stream_Kind_SECONDARY;
+
+    case StreamKind::StreamKind_ROW_INDEX:
+    case StreamKind::StreamKindOrc_ROW_INDEX:
+      return proto::orc::Stream_Kind_ROW_INDEX;
+
+    default:
+      DWIO_RAISE("Stream kind has no ORC equivalent: ", kind);
+  }
+}
+
 inline bool isIndexStream(StreamKind kind) {
   return kind == StreamKind::StreamKind_ROW_INDEX ||
       kind == StreamKind::StreamKind_BLOOM_FILTER_UTF8 ||
@@ -60,6 +60,13 @@ class Config : public config::ConfigBase {
   static Entry<const std::vector<std::vector<std::string>>>
       MAP_FLAT_COLS_STRUCT_KEYS;
   static Entry<uint32_t> MAP_FLAT_MAX_KEYS;
+  /// Ids of the schema nodes whose integer streams (lengths, dictionary
+  /// indices, timestamps and ORC integer data) are written with RLEv2 instead
+  /// of RLEv1.
+  static Entry<const std::vector<uint32_t>> RLE_V2_COLS;
+  /// Whether ORC files write all integer streams with RLEv2, as ORC 0.12
+  /// writers do. When false, only the columns in RLE_V2_COLS use RLEv2.
+  static Entry<bool> ORC_RLE_V2;
   static Entry<uint64_t> MAX_DICTIONARY_SIZE;
   static Entry<bool> INTEGER_DICTIONARY_ENCODING_ENABLED;
   static Entry<bool> STRING_DICTIONARY_ENCODING_ENABLED;
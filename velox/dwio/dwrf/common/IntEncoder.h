@@ -201,11 +201,6 @@ class IntEncoder {
     writeVuHugeInt(ZigZag::encodeInt128(val));
   }
 
- private:
-  template <typename T>
-  uint64_t
-  addImpl(const T* data, const common::Ranges& ranges, const uint64_t* nulls);
-
   FOLLY_ALWAYS_INLINE void writeBuffer(char* start, char* end) {
     int32_t valsToWrite = end - start;
     while (valsToWrite) {
@@ -223,6 +218,11 @@ class IntEncoder {
     }
   }
 
+ private:
+  template <typename T>
+  uint64_t
+  addImpl(const T* data, const common::Ranges& ranges, const uint64_t* nulls);
+
   template <int32_t size>
   FOLLY_ALWAYS_INLINE static int32_t writeVarint(uint64_t value, char* buffer);
   FOLLY_ALWAYS_INLINE static int32_t write64Varint(
@@ -18,6 +18,8 @@
 #include "velox/dwio/common/SeekableInputStream.h"
 #include "velox/dwio/dwrf/common/Common.h"
 
+#include <folly/lang/Bits.h>
+
 namespace facebook::velox::dwrf {
 
 using memory::MemoryPool;
@@ -107,6 +109,38 @@ inline uint32_t getClosestFixedBits(uint32_t n) {
   }
 }
 
+inline uint32_t encodeBitWidth(uint32_t n) {
+  n = getClosestFixedBits(n);
+  if (n <= 24) {
+    return n - 1;
+  } else if (n == 26) {
+    return FixedBitSizes::TWENTYSIX;
+  } else if (n == 28) {
+    return FixedBitSizes::TWENTYEIGHT;
+  } else if (n == 30) {
+    return FixedBitSizes::THIRTY;
+  } else if (n == 32) {
+    return FixedBitSizes::THIRTYTWO;
+  } else if (n == 40) {
+    return FixedBitSizes::FORTY;
+  } else if (n == 48) {
+    return FixedBitSizes::FORTYEIGHT;
+  } else if (n == 56) {
+    return FixedBitSizes::FIFTYSIX;
+  } else {
+    return FixedBitSizes::SIXTYFOUR;
+  }
+}
+
+// Number of significant bits in 'value', negative values need all 64.
+inline uint32_t numSignificantBits(int64_t value) {
+  return value == 0 ? 0 : 64 - __builtin_clzll(static_cast<uint64_t>(value));
+}
+
+inline uint32_t findClosestNumBits(int64_t value) {
+  return getClosestFixedBits(numSignificantBits(value));
+}
+
 template <bool isSigned>
 int64_t RleDecoderV2<isSigned>::readLongBE(uint64_t bsz) {
   int64_t ret = 0, val;
@@ -624,4 +658,489 @@ template int64_t RleDecoderV2<true>::readValue();
 
 template int64_t RleDecoderV2<false>::readValue();
 
+template <bool isSigned>
+void RleEncoderV2<isSigned>::write(int64_t value) {
+  if (numLiterals_ == 0) {
+    initializeLiterals(value);
+    return;
+  }
+
+  if (numLiterals_ == 1) {
+    lastRepeated_ = value == literals_[0];
+    literals_[numLiterals_++] = value;
+    if (value == literals_[0]) {
+      fixedRunLength_ = 2;
+      variableRunLength_ = 0;
+    } else {
+      fixedRunLength_ = 0;
+      variableRunLength_ = 2;
+    }
+    return;
+  }
+
+  const bool repeated = value == literals_[numLiterals_ - 1];
+  if (lastRepeated_ && repeated) {
+    literals_[numLiterals_++] = value;
+    // Repeats at the tail of a variable run start a fixed run of 2.
+    if (variableRunLength_ > 0) {
+      fixedRunLength_ = 2;
+    }
+    ++fixedRunLength_;
+
+    // Once the repeats are long enough for a run of their own, write out the
+    // variable run before them and move them to the start of the buffer.
+    if (fixedRunLength_ >= RLE_MINIMUM_REPEAT && variableRunLength_ > 0) {
+      numLiterals_ -= RLE_MINIMUM_REPEAT;
+      EncodingOption option;
+      determineEncoding(option);
+      writeValues(option);
+      std::fill(
+          literals_.begin(), literals_.begin() + RLE_MINIMUM_REPEAT, value);
+      numLiterals_ = RLE_MINIMUM_REPEAT;
+      fixedRunLength_ = RLE_MINIMUM_REPEAT;
+      lastRepeated_ = true;
+    }
+
+    if (numLiterals_ == kMaxLiterals) {
+      EncodingOption option;
+      option.encoding = DELTA;
+      option.isFixedDelta = true;
+      writeValues(option);
+    }
+    return;
+  }
+
+  // The value ends a run of repeats. Write it out if it is long enough,
+  // otherwise the repeats become the start of a variable run.
+  if (fixedRunLength_ >= RLE_MINIMUM_REPEAT) {
+    EncodingOption option;
+    if (fixedRunLength_ <= kMaxShortRepeat) {
+      option.encoding = SHORT_REPEAT;
+    } else {
+      option.encoding = DELTA;
+      option.isFixedDelta = true;
+    }
+    writeValues(option);
+  } else if (fixedRunLength_ > 0 && !repeated) {
+    variableRunLength_ = fixedRunLength_;
+    fixedRunLength_ = 0;
+  }
+
+  if (numLiterals_ == 0) {
+    initializeLiterals(value);
+    return;
+  }
+
+  lastRepeated_ = repeated;
+  literals_[numLiterals_++] = value;
+  ++variableRunLength_;
+  if (numLiterals_ == kMaxLiterals) {
+    EncodingOption option;
+    determineEncoding(option);
+    writeValues(option);
+  }
+}
+
+template void RleEncoderV2<true>::write(int64_t value);
+template void RleEncoderV2<false>::write(int64_t value);
+
+template <bool isSigned>
+void RleEncoderV2<isSigned>::writeLiterals() {
+  if (numLiterals_ == 0) {
+    return;
+  }
+  EncodingOption option;
+  if (variableRunLength_ > 0 || fixedRunLength_ < RLE_MINIMUM_REPEAT) {
+    determineEncoding(option);
+  } else if (fixedRunLength_ <= kMaxShortRepeat) {
+    option.encoding = SHORT_REPEAT;
+  } else {
+    option.encoding = DELTA;
+    option.isFixedDelta = true;
+  }
+  writeValues(option);
+}
+
+template void RleEncoderV2<true>::writeLiterals();
+template void RleEncoderV2<false>::writeLiterals();
+
+template <bool isSigned>
+void RleEncoderV2<isSigned>::determineEncoding(EncodingOption& option) {
+  // Short runs are not worth the analysis.
+  if (numLiterals_ <= RLE_MINIMUM_REPEAT) {
+    prepareDirect(option);
+    return;
+  }
+
+  bool isIncreasing = true;
+  bool isDecreasing = true;
+  bool overflow = false;
+  option.isFixedDelta = true;
+  option.min = literals_[0];
+  int64_t max = literals_[0];
+  int64_t initialDelta;
+  overflow |= __builtin_sub_overflow(literals_[1], literals_[0], &initialDelta);
+  adjacentDeltas_[0] = initialDelta;
+  uint64_t deltaMax = 0;
+  for (int32_t i = 1; i < numLiterals_; ++i) {
+    const int64_t current = literals_[i];
+    const int64_t previous = literals_[i - 1];
+    int64_t delta;
+    overflow |= __builtin_sub_overflow(current, previous, &delta);
+    option.min = std::min(option.min, current);
+    max = std::max(max, current);
+    isIncreasing &= previous <= current;
+    isDecreasing &= previous >= current;
+    option.isFixedDelta &= delta == initialDelta;
+    if (i > 1) {
+      const uint64_t absDelta =
+          delta < 0 ? 0 - static_cast<uint64_t>(delta) : delta;
+      adjacentDeltas_[i - 1] = static_cast<int64_t>(absDelta);
+      deltaMax = std::max(deltaMax, absDelta);
+    }
+  }
+
+  // DIRECT is the only encoding that does not subtract one literal from
+  // another.
+  int64_t range;
+  if (overflow || __builtin_sub_overflow(max, option.min, &range)) {
+    prepareDirect(option);
+    return;
+  }
+
+  if (option.isFixedDelta) {
+    option.encoding = DELTA;
+    option.fixedDelta = initialDelta;
+    return;
+  }
+
+  // The sign of the first delta gives the direction of a monotonic run, so it
+  // must not be 0.
+  if (initialDelta != 0 && (isIncreasing || isDecreasing)) {
+    option.encoding = DELTA;
+    option.bitsDeltaMax = findClosestNumBits(static_cast<int64_t>(deltaMax));
+    return;
+  }
+
+  // Patch the values if the widest 10% need more than one bit over the rest.
+  // PATCHED_BASE stores the base as sign and magnitude, which cannot
+  // represent the magnitude of INT64_MIN.
+  prepareDirect(option);
+  const uint32_t zigzagBits90p =
+      percentileBits(zigzagLiterals_.data(), 0.9, true);
+  if (option.zigzagBits100p - zigzagBits90p <= 1 ||
+      option.min == std::numeric_limits<int64_t>::min()) {
+    return;
+  }
+
+  for (int32_t i = 0; i < numLiterals_; ++i) {
+    baseReducedLiterals_[i] = literals_[i] - option.min;
+  }
+  option.baseReducedBits95p = percentileBits(baseReducedLiterals_.data(), 0.95);
+  option.baseReducedBits100p =
+      percentileBits(baseReducedLiterals_.data(), 1.0, true);
+  // Nothing to patch if the outliers fit in the width of the other values
+  // after subtracting the base.
+  if (option.baseReducedBits100p != option.baseReducedBits95p) {
+    option.encoding = PATCHED_BASE;
+    preparePatchedBase(option);
+  }
+}
+
+template void RleEncoderV2<true>::determineEncoding(EncodingOption& option);
+template void RleEncoderV2<false>::determineEncoding(EncodingOption& option);
+
+template <bool isSigned>
+void RleEncoderV2<isSigned>::prepareDirect(EncodingOption& option) {
+  option.encoding = DIRECT;
+  if constexpr (isSigned) {
+    for (int32_t i = 0; i < numLiterals_; ++i) {
+      zigzagLiterals_[i] = static_cast<int64_t>(ZigZag::encode(literals_[i]));
+    }
+  } else {
+    std::copy(
+        literals_.begin(),
+        literals_.begin() + numLiterals_,
+        zigzagLiterals_.begin());
+  }
+  option.zigzagBits100p = percentileBits(zigzagLiterals_.data(), 1.0);
+}
+
+template void RleEncoderV2<true>::prepareDirect(EncodingOption& option);
+template void RleEncoderV2<false>::prepareDirect(EncodingOption& option);
+
+template <bool isSigned>
+void RleEncoderV2<isSigned>::preparePatchedBase(EncodingOption& option) {
+  option.patchWidth = getClosestFixedBits(
+      option.baseReducedBits100p - option.baseReducedBits95p);
+  // Gap and patch must fit in 64 bits together.
+  if (option.patchWidth == 64) {
+    option.patchWidth = 56;
+    option.baseReducedBits95p = 8;
+  }
+  const int64_t mask =
+      (static_cast<int64_t>(1) << option.baseReducedBits95p) - 1;
+
+  // Values above 'mask' keep their low bits in place and have the high bits
+  // stored in the patch list together with the distance from the previous
+  // patched value. Gaps over 255 are split into entries of 255 with an empty
+  // patch.
+  option.patchLength = 0;
+  int32_t maxGap = 0;
+  int32_t previous = 0;
+  for (int32_t i = 0; i < numLiterals_; ++i) {
+    if (baseReducedLiterals_[i] <= mask) {
+      continue;
+    }
+    int32_t gap = i - previous;
+    previous = i;
+    const uint64_t patch =
+        static_cast<uint64_t>(baseReducedLiterals_[i]) >>
+        option.baseReducedBits95p;
+    baseReducedLiterals_[i] &= mask;
+    while (gap > 255) {
+      VELOX_DCHECK_LT(option.patchLength, kMaxPatchLength);
+      gapVsPatchList_[option.patchLength++] =
+          static_cast<int64_t>(static_cast<uint64_t>(255) << option.patchWidth);
+      gap -= 255;
+      maxGap = 255;
+    }
+    VELOX_DCHECK_LT(option.patchLength, kMaxPatchLength);
+    gapVsPatchList_[option.patchLength++] = static_cast<int64_t>(
+        (static_cast<uint64_t>(gap) << option.patchWidth) | patch);
+    maxGap = std::max(maxGap, gap);
+  }
+  option.patchGapWidth = findClosestNumBits(maxGap);
+}
+
+template void RleEncoderV2<true>::preparePatchedBase(EncodingOption& option);
+template void RleEncoderV2<false>::preparePatchedBase(EncodingOption& option);
+
+template <bool isSigned>
+void RleEncoderV2<isSigned>::writeValues(EncodingOption& option) {
+  switch (option.encoding) {
+    case SHORT_REPEAT:
+      writeShortRepeatValues();
+      break;
+    case DIRECT:
+      writeDirectValues(option);
+      break;
+    case PATCHED_BASE:
+      writePatchedBaseValues(option);
+      break;
+    case DELTA:
+      writeDeltaValues(option);
+      break;
+    default:
+      VELOX_UNREACHABLE();
+  }
+  numLiterals_ = 0;
+  lastRepeated_ = false;
+  fixedRunLength_ = 0;
+  variableRunLength_ = 0;
+}
+
+template void RleEncoderV2<true>::writeValues(EncodingOption& option);
+template void RleEncoderV2<false>::writeValues(EncodingOption& option);
+
+template <bool isSigned>
+void RleEncoderV2<isSigned>::writeHeader(
+    EncodingType encoding,
+    uint32_t bitWidth) {
+  // Run lengths are one off and take 9 bits, the 5 bits in between hold the
+  // encoded bit width.
+  const uint32_t length = numLiterals_ - 1;
+  IntEncoder<isSigned>::writeByte(static_cast<char>(
+      (encoding << 6) | (bitWidth << 1) | ((length >> 8) & 0x01)));
+  IntEncoder<isSigned>::writeByte(static_cast<char>(length & 0xff));
+}
+
+template void RleEncoderV2<true>::writeHeader(
+    EncodingType encoding,
+    uint32_t bitWidth);
+template void RleEncoderV2<false>::writeHeader(
+    EncodingType encoding,
+    uint32_t bitWidth);
+
+template <bool isSigned>
+void RleEncoderV2<isSigned>::writeShortRepeatValues() {
+  VELOX_DCHECK_GE(numLiterals_, RLE_MINIMUM_REPEAT);
+  VELOX_DCHECK_LE(numLiterals_, kMaxShortRepeat);
+  uint64_t value = literals_[0];
+  if constexpr (isSigned) {
+    value = ZigZag::encode(literals_[0]);
+  }
+  const uint32_t numBytes =
+      std::max<uint32_t>(1, (numSignificantBits(value) + 7) / 8);
+  IntEncoder<isSigned>::writeByte(static_cast<char>(
+      (SHORT_REPEAT << 6) | ((numBytes - 1) << 3) |
+      (numLiterals_ - RLE_MINIMUM_REPEAT)));
+  for (int32_t i = numBytes - 1; i >= 0; --i) {
+    IntEncoder<isSigned>::writeByte(static_cast<char>(value >> (i * 8)));
+  }
+}
+
+template void RleEncoderV2<true>::writeShortRepeatValues();
+template void RleEncoderV2<false>::writeShortRepeatValues();
+
+template <bool isSigned>
+void RleEncoderV2<isSigned>::writeDirectValues(const EncodingOption& option) {
+  writeHeader(DIRECT, encodeBitWidth(option.zigzagBits100p));
+  writeInts(zigzagLiterals_.data(), numLiterals_, option.zigzagBits100p);
+}
+
+template void RleEncoderV2<true>::writeDirectValues(
+    const EncodingOption& option);
+template void RleEncoderV2<false>::writeDirectValues(
+    const EncodingOption& option);
+
+template <bool isSigned>
+void RleEncoderV2<isSigned>::writePatchedBaseValues(
+    const EncodingOption& option) {
+  writeHeader(PATCHED_BASE, encodeBitWidth(option.baseReducedBits95p));
+
+  // The base is stored big endian as sign and magnitude, with the sign in
+  // the most significant bit.
+  const bool isNegative = option.min < 0;
+  uint64_t base = isNegative ? 0 - static_cast<uint64_t>(option.min)
+                             : static_cast<uint64_t>(option.min);
+  const uint32_t baseBytes = numSignificantBits(base) / 8 + 1;
+  if (isNegative) {
+    base |= static_cast<uint64_t>(1) << (baseBytes * 8 - 1);
+  }
+  IntEncoder<isSigned>::writeByte(static_cast<char>(
+      ((baseBytes - 1) << 5) | encodeBitWidth(option.patchWidth)));
+  IntEncoder<isSigned>::writeByte(static_cast<char>(
+      ((option.patchGapWidth - 1) << 5) | option.patchLength));
+  for (int32_t i = baseBytes - 1; i >= 0; --i) {
+    IntEncoder<isSigned>::writeByte(static_cast<char>(base >> (i * 8)));
+  }
+
+  writeInts(
+      baseReducedLiterals_.data(), numLiterals_, option.baseReducedBits95p);
+  writeInts(
+      gapVsPatchList_.data(),
+      option.patchLength,
+      getClosestFixedBits(option.patchGapWidth + option.patchWidth));
+}
+
+template void RleEncoderV2<true>::writePatchedBaseValues(
+    const EncodingOption& option);
+template void RleEncoderV2<false>::writePatchedBaseValues(
+    const EncodingOption& option);
+
+template <bool isSigned>
+void RleEncoderV2<isSigned>::writeDeltaValues(const EncodingOption& option) {
+  uint32_t bitWidth = 0;
+  if (option.isFixedDelta) {
+    // A bit width of 0 marks a fixed delta run.
+    writeHeader(DELTA, 0);
+  } else {
+    // Deltas of 1 bit are widened to 2 so the width cannot be mistaken for a
+    // fixed delta.
+    bitWidth = std::max<uint32_t>(option.bitsDeltaMax, 2);
+    writeHeader(DELTA, encodeBitWidth(bitWidth));
+  }
+
+  if constexpr (isSigned) {
+    IntEncoder<isSigned>::writeVslong(literals_[0]);
+  } else {
+    IntEncoder<isSigned>::writeVulong(literals_[0]);
+  }
+  if (option.isFixedDelta) {
+    IntEncoder<isSigned>::writeVslong(option.fixedDelta);
+  } else {
+    // The first delta is signed and gives the direction of the run, the
+    // remaining ones are absolute values.
+    IntEncoder<isSigned>::writeVslong(adjacentDeltas_[0]);
+    writeInts(adjacentDeltas_.data() + 1, numLiterals_ - 2, bitWidth);
+  }
+}
+
+template void RleEncoderV2<true>::writeDeltaValues(
+    const EncodingOption& option);
+template void RleEncoderV2<false>::writeDeltaValues(
+    const EncodingOption& option);
+
+template <bool isSigned>
+uint32_t RleEncoderV2<isSigned>::percentileBits(
+    const int64_t* data,
+    double p,
+    bool reuseHistogram) {
+  VELOX_DCHECK(p > 0.0 && p <= 1.0);
+  if (!reuseHistogram) {
+    histogram_.fill(0);
+    for (int32_t i = 0; i < numLiterals_; ++i) {
+      ++histogram_[encodeBitWidth(findClosestNumBits(data[i]))];
+    }
+  }
+  int32_t numAbove = static_cast<int32_t>(numLiterals_ * (1.0 - p));
+  for (int32_t i = kNumBitWidths - 1; i >= 0; --i) {
+    numAbove -= histogram_[i];
+    if (numAbove < 0) {
+      return decodeBitWidth(i);
+    }
+  }
+  return 0;
+}
+
+template uint32_t RleEncoderV2<true>::percentileBits(
+    const int64_t* data,
+    double p,
+    bool reuseHistogram);
+template uint32_t RleEncoderV2<false>::percentileBits(
+    const int64_t* data,
+    double p,
+    bool reuseHistogram);
+
+template <bool isSigned>
+void RleEncoderV2<isSigned>::writeInts(
+    const int64_t* values,
+    int32_t numValues,
+    uint32_t bitWidth) {
+  VELOX_DCHECK(bitWidth > 0 && bitWidth <= 64);
+  // Values are shifted into a 128 bit accumulator that is drained 64 bits at
+  // a time with a single big endian store, instead of assembling the output
+  // a byte at a time.
+  constexpr int32_t kBufferSize = 1024;
+  char buffer[kBufferSize];
+  char* out = buffer;
+  const uint64_t mask =
+      bitWidth == 64 ? ~0ULL : (static_cast<uint64_t>(1) << bitWidth) - 1;
+  uint128_t pending = 0;
+  uint32_t numPendingBits = 0;
+  for (int32_t i = 0; i < numValues; ++i) {
+    pending = (pending << bitWidth) | (static_cast<uint64_t>(values[i]) & mask);
+    numPendingBits += bitWidth;
+    if (numPendingBits >= 64) {
+      numPendingBits -= 64;
+      const uint64_t word =
+          folly::Endian::big(static_cast<uint64_t>(pending >> numPendingBits));
+      memcpy(out, &word, sizeof(word));
+      out += sizeof(word);
+      if (out + sizeof(word) > buffer + kBufferSize) {
+        IntEncoder<isSigned>::writeBuffer(buffer, out);
+        out = buffer;
+      }
+    }
+  }
+  while (numPendingBits >= 8) {
+    numPendingBits -= 8;
+    *out++ = static_cast<char>(pending >> numPendingBits);
+  }
+  if (numPendingBits > 0) {
+    *out++ = static_cast<char>(pending << (8 - numPendingBits));
+  }
+  IntEncoder<isSigned>::writeBuffer(buffer, out);
+}
+
+template void RleEncoderV2<true>::writeInts(
+    const int64_t* values,
+    int32_t numValues,
+    uint32_t bitWidth);
+template void RleEncoderV2<false>::writeInts(
+    const int64_t* values,
+    int32_t numValues,
+    uint32_t bitWidth);
+
 } // namespace facebook::velox::dwrf
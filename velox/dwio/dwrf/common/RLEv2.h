@@ -21,11 +21,199 @@
 #include "velox/dwio/common/DataBuffer.h"
 #include "velox/dwio/common/IntDecoder.h"
 #include "velox/dwio/common/exception/Exception.h"
+#include "velox/dwio/dwrf/common/IntEncoder.h"
 
+#include <array>
 #include <vector>
 
 namespace facebook::velox::dwrf {
 
+/// Writes integers in the ORC RLEv2 format read by RleDecoderV2. Values are
+/// buffered in groups of up to 512 and each group is written with the
+/// cheapest of the four RLEv2 sub-encodings: SHORT_REPEAT for short runs of
+/// one value, DELTA for fixed-delta and monotonic runs, PATCHED_BASE for runs
+/// whose bit width is inflated by a few outliers and DIRECT otherwise. RLEv2
+/// defines its own bit-packed and varint layouts, so the 'useVInts' and
+/// 'numBytes' settings of IntEncoder do not apply.
+template <bool isSigned>
+class RleEncoderV2 : public IntEncoder<isSigned> {
+ public:
+  explicit RleEncoderV2(std::unique_ptr<BufferedOutputStream> outStream)
+      : IntEncoder<isSigned>{
+            std::move(outStream),
+            /*useVInts=*/true,
+            dwio::common::LONG_BYTE_SIZE} {}
+
+  uint64_t add(
+      const int64_t* data,
+      const common::Ranges& ranges,
+      const uint64_t* nulls) override {
+    return addImpl(data, ranges, nulls);
+  }
+
+  uint64_t add(
+      const int32_t* data,
+      const common::Ranges& ranges,
+      const uint64_t* nulls) override {
+    return addImpl(data, ranges, nulls);
+  }
+
+  uint64_t add(
+      const uint32_t* data,
+      const common::Ranges& ranges,
+      const uint64_t* nulls) override {
+    return addImpl(data, ranges, nulls);
+  }
+
+  uint64_t add(
+      const int16_t* data,
+      const common::Ranges& ranges,
+      const uint64_t* nulls) override {
+    return addImpl(data, ranges, nulls);
+  }
+
+  uint64_t add(
+      const uint16_t* data,
+      const common::Ranges& ranges,
+      const uint64_t* nulls) override {
+    return addImpl(data, ranges, nulls);
+  }
+
+  void writeValue(int64_t value) override {
+    write(value);
+  }
+
+  void writeHugeInt(int128_t /* value */) override {
+    VELOX_UNSUPPORTED("Huge int encoding not supported for RLEv2.");
+  }
+
+  uint64_t flush() override {
+    writeLiterals();
+    return IntEncoder<isSigned>::flush();
+  }
+
+  void recordPosition(PositionRecorder& recorder, int32_t strideIndex = -1)
+      const override {
+    IntEncoder<isSigned>::recordPosition(recorder, strideIndex);
+    recorder.add(static_cast<uint64_t>(numLiterals_), strideIndex);
+  }
+
+ private:
+  enum EncodingType {
+    SHORT_REPEAT = 0,
+    DIRECT = 1,
+    PATCHED_BASE = 2,
+    DELTA = 3
+  };
+
+  // Sub-encoding picked for the buffered literals and its parameters.
+  struct EncodingOption {
+    EncodingType encoding{DIRECT};
+    // Used by DELTA.
+    bool isFixedDelta{false};
+    int64_t fixedDelta{0};
+    uint32_t bitsDeltaMax{0};
+    // Used by DIRECT.
+    uint32_t zigzagBits100p{0};
+    // Used by PATCHED_BASE.
+    int64_t min{0};
+    uint32_t baseReducedBits95p{0};
+    uint32_t baseReducedBits100p{0};
+    uint32_t patchWidth{0};
+    uint32_t patchGapWidth{0};
+    int32_t patchLength{0};
+  };
+
+  static constexpr int32_t kMaxLiterals = 512;
+  static constexpr int32_t kMaxShortRepeat = 10;
+  // Number of bit widths RLEv2 can encode in its 5 bit width fields.
+  static constexpr int32_t kNumBitWidths = 32;
+  // At most 5% of a run are patched, plus up to 2 entries that split gaps
+  // longer than 255. The header has 5 bits for the patch list length.
+  static constexpr int32_t kMaxPatchLength = 31;
+
+  template <typename T>
+  uint64_t
+  addImpl(const T* data, const common::Ranges& ranges, const uint64_t* nulls);
+
+  void write(int64_t value);
+
+  void initializeLiterals(int64_t value) {
+    literals_[0] = value;
+    numLiterals_ = 1;
+    fixedRunLength_ = 1;
+    variableRunLength_ = 1;
+  }
+
+  // Writes out all buffered literals.
+  void writeLiterals();
+
+  void determineEncoding(EncodingOption& option);
+
+  void prepareDirect(EncodingOption& option);
+
+  void preparePatchedBase(EncodingOption& option);
+
+  void writeValues(EncodingOption& option);
+
+  void writeShortRepeatValues();
+
+  void writeDirectValues(const EncodingOption& option);
+
+  void writePatchedBaseValues(const EncodingOption& option);
+
+  void writeDeltaValues(const EncodingOption& option);
+
+  void writeHeader(EncodingType encoding, uint32_t bitWidth);
+
+  // Returns the bit width needed by the 'p' percentile of the first
+  // 'numLiterals_' values of 'data'. Reuses the histogram of the previous
+  // call if 'reuseHistogram' is true.
+  uint32_t
+  percentileBits(const int64_t* data, double p, bool reuseHistogram = false);
+
+  // Packs 'numValues' values of 'bitWidth' bits each, most significant bit
+  // first, and pads the last byte with zeros.
+  void writeInts(const int64_t* values, int32_t numValues, uint32_t bitWidth);
+
+  std::array<int64_t, kMaxLiterals> literals_;
+  std::array<int64_t, kMaxLiterals> zigzagLiterals_;
+  std::array<int64_t, kMaxLiterals> baseReducedLiterals_;
+  std::array<int64_t, kMaxLiterals> adjacentDeltas_;
+  std::array<int64_t, kMaxPatchLength> gapVsPatchList_;
+  std::array<int32_t, kNumBitWidths> histogram_;
+  int32_t numLiterals_{0};
+  // Whether the last literal repeats the one before it.
+  bool lastRepeated_{false};
+  // Length of the run of repeated values at the tail of the literals.
+  int32_t fixedRunLength_{0};
+  // Length of the run of non repeated values, 0 while repeating.
+  int32_t variableRunLength_{0};
+};
+
+template <bool isSigned>
+template <typename T>
+uint64_t RleEncoderV2<isSigned>::addImpl(
+    const T* data,
+    const common::Ranges& ranges,
+    const uint64_t* nulls) {
+  uint64_t count = 0;
+  if (nulls) {
+    for (auto& pos : ranges) {
+      if (!bits::isBitNull(nulls, pos)) {
+        write(data[pos]);
+        ++count;
+      }
+    }
+  } else {
+    for (auto& pos : ranges) {
+      write(data[pos]);
+      ++count;
+    }
+  }
+  return count;
+}
+
 template <bool isSigned>
 class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
  public:
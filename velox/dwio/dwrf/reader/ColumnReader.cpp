@@ -52,7 +52,8 @@ void fillTimestamps(
     const uint64_t* nullsPtr,
     const int64_t* secondsPtr,
     const uint64_t* nanosPtr,
-    vector_size_t numValues) {
+    vector_size_t numValues,
+    int64_t epochOffset) {
   for (vector_size_t i = 0; i < numValues; i++) {
     if (!nullsPtr || !bits::isBitNull(nullsPtr, i)) {
       auto nanos = nanosPtr[i];
@@ -63,7 +64,7 @@ void fillTimestamps(
           nanos *= 10;
         }
       }
-      auto seconds = secondsPtr[i] + dwio::common::EPOCH_OFFSET;
+      auto seconds = secondsPtr[i] + epochOffset;
       if (seconds < 0 && nanos != 0) {
         seconds -= 1;
       }
@@ -800,6 +801,7 @@ class TimestampColumnReader : public ColumnReader {
 
   BufferPtr secondsBuffer_;
   BufferPtr nanosBuffer_;
+  const int64_t epochOffset_;
 
  public:
   TimestampColumnReader(
@@ -824,7 +826,8 @@ TimestampColumnReader::TimestampColumnReader(
           std::move(fileType),
           stripe,
           streamLabels,
-          std::move(flatMapContext)) {
+          std::move(flatMapContext)),
+      epochOffset_{stripe.timestampEpochOffset()} {
   EncodingKey encodingKey{fileType_->id(), flatMapContext_.sequence};
   RleVersion vers = convertRleVersion(stripe, encodingKey);
   auto data = StripeStreamsUtil::getStreamForKind(
@@ -898,7 +901,7 @@ void TimestampColumnReader::next(
   nano->next(reinterpret_cast<int64_t*>(nanosData), numValues, nullsPtr);
   auto* valuesPtr = values->asMutable<Timestamp>();
   detail::fillTimestamps(
-      valuesPtr, nullsPtr, secondsData, nanosData, numValues);
+      valuesPtr, nullsPtr, secondsData, nanosData, numValues, epochOffset_);
 }
 
 template <class T>
@@ -186,13 +186,15 @@ inline void resetIfNotWritable(VectorPtr& result, T&... buffer) {
   }
 }
 
-// Helper method to build timestamps based on nulls/seconds/nanos
+// Helper method to build timestamps based on nulls/seconds/nanos. 'seconds'
+// are relative to 'epochOffset' seconds after the UNIX epoch.
 void fillTimestamps(
     Timestamp* timestamps,
     const uint64_t* nulls,
     const int64_t* seconds,
     const uint64_t* nanos,
-    vector_size_t numValues);
+    vector_size_t numValues,
+    int64_t epochOffset);
 
 } // namespace detail
 } // namespace facebook::velox::dwrf
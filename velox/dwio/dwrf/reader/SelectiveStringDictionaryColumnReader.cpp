@@ -29,7 +29,10 @@ SelectiveStringDictionaryColumnReader::SelectiveStringDictionaryColumnReader(
     : SelectiveColumnReader(fileType->type(), fileType, params, scanSpec),
       lastStrideIndex_(-1),
       provider_(params.stripeStreams().getStrideIndexProvider()),
-      statistics_(params.runtimeStatistics()) {
+      statistics_(params.runtimeStatistics()),
+      preserveDictionaries_(params.stripeStreams()
+                                .rowReaderOptions()
+                                .preserveStringDictionaries()) {
   auto& stripe = params.stripeStreams();
   EncodingKey encodingKey{fileType_->id(), params.flatMapContext().sequence};
   version_ = convertRleVersion(stripe, encodingKey);
@@ -152,6 +155,7 @@ void SelectiveStringDictionaryColumnReader::loadStrideDictionary() {
   // get stride dictionary size and load it if needed
   auto& positions =
       formatData_->as<DwrfData>().index().entry(nextStride).positions();
+  const bool hadStrideDictionary = scanState_.dictionary2.numValues > 0;
   scanState_.dictionary2.numValues = positions.Get(strideDictSizeOffset_);
   if (scanState_.dictionary2.numValues > 0) {
     // seek stride dictionary related streams
@@ -165,7 +169,11 @@ void SelectiveStringDictionaryColumnReader::loadStrideDictionary() {
         *strideDictStream_, *strideDictLengthDecoder_, scanState_.dictionary2);
   }
   lastStrideIndex_ = nextStride;
-  dictionaryValues_ = nullptr;
+  // Strides without a stride dictionary share the base vector over the stripe
+  // dictionary, so that results memoized for it stay valid.
+  if (hadStrideDictionary || scanState_.dictionary2.numValues > 0) {
+    dictionaryValues_ = nullptr;
+  }
 
   if (DictionaryValues::hasFilter(scanSpec_->filter())) {
     scanState_.filterCache.resize(
@@ -300,7 +308,8 @@ void SelectiveStringDictionaryColumnReader::getValues(
   flatSize = std::max<double>(flatSize, rows.size());
   auto dictSize =
       scanState_.dictionary.numValues + scanState_.dictionary2.numValues;
-  if (scanSpec_->makeFlat() || (!dictionaryValues_ && flatSize < dictSize)) {
+  if (scanSpec_->makeFlat() ||
+      (!preserveDictionaries_ && !dictionaryValues_ && flatSize < dictSize)) {
     makeFlat(result);
     return;
   }
@@ -97,6 +97,8 @@ class SelectiveStringDictionaryColumnReader
 
   const StrideIndexProvider& provider_;
   dwio::common::ColumnReaderStatistics& statistics_;
+  // Return dictionary vectors even if a flat vector would be smaller.
+  const bool preserveDictionaries_;
 
   // lazy load the dictionary
   std::unique_ptr<dwio::common::IntDecoder</*isSigned*/ false>> lengthDecoder_;
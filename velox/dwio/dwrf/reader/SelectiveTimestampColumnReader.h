@@ -52,6 +52,8 @@ class SelectiveTimestampColumnReader
       const uint64_t* rawNulls);
 
   const TimestampPrecision precision_;
+  // Seconds from the UNIX epoch to the base of the stored seconds.
+  const int64_t epochOffset_;
 
   std::unique_ptr<dwio::common::IntDecoder</*isSigned*/ true>> seconds_;
   std::unique_ptr<dwio::common::IntDecoder</*isSigned*/ false>> nano_;
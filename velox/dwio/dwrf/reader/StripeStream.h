@@ -18,6 +18,7 @@
 
 #include "velox/common/base/BitSet.h"
 #include "velox/dwio/common/ColumnSelector.h"
+#include "velox/dwio/common/IntCodecCommon.h"
 #include "velox/dwio/common/Options.h"
 #include "velox/dwio/common/SeekableInputStream.h"
 #include "velox/dwio/dwrf/common/Common.h"
@@ -117,6 +118,12 @@ class StripeStreams {
   /// Get row reader options
   virtual const dwio::common::RowReaderOptions& rowReaderOptions() const = 0;
 
+  /// Seconds from the UNIX epoch to the base timestamp seconds in this stripe
+  /// are stored relative to. DWRF uses 2015-01-01 00:00:00 in Los Angeles.
+  virtual int64_t timestampEpochOffset() const {
+    return dwio::common::EPOCH_OFFSET;
+  }
+
   /// Get the encoding for the given column for this dwrf stripe.
   virtual const proto::ColumnEncoding& getEncoding(
       const EncodingKey&) const = 0;
@@ -264,6 +271,20 @@ class StripeStreamsImpl : public StripeStreamsBase {
     return opts_;
   }
 
+  int64_t timestampEpochOffset() const override {
+    // ORC stores seconds relative to 2015-01-01 00:00:00 in the writer time
+    // zone. Only UTC is honored; other zones keep the DWRF epoch.
+    if (format() == DwrfFormat::kOrc) {
+      const auto& timezone = readState_->stripeMetadata->footer
+                                 ->getStripeFooterOrc()
+                                 .writertimezone();
+      if (timezone == "UTC" || timezone == "GMT") {
+        return dwio::common::UTC_EPOCH_OFFSET;
+      }
+    }
+    return dwio::common::EPOCH_OFFSET;
+  }
+
   const proto::ColumnEncoding& getEncoding(
       const EncodingKey& encodingKey) const override {
     auto index = encodings_.find(encodingKey);
@@ -2523,6 +2523,62 @@ TEST_F(TestReader, readStringDictionaryAsFlat) {
   ASSERT_EQ(stats.columnReaderStatistics.flattenStringDictionaryValues, 1);
 }
 
+TEST_F(TestReader, preserveStringDictionaries) {
+  constexpr int kNumRows = 1'000;
+  constexpr int kStride = 100;
+  // Each value repeats in every stride, so there are no stride dictionaries.
+  auto batch = makeRowVector({
+      makeFlatVector<std::string>(
+          kNumRows,
+          [](auto row) { return fmt::format("value {:030}", row % 250); }),
+      makeFlatVector<int64_t>(kNumRows, [](auto row) { return row % 10; }),
+  });
+  auto config = std::make_shared<dwrf::Config>();
+  config->set(dwrf::Config::ROW_INDEX_STRIDE, static_cast<uint32_t>(kStride));
+  auto [writer, reader] = createWriterReader(
+      {batch},
+      pool(),
+      config,
+      E2EWriterTestUtil::simpleFlushPolicyFactory(false));
+  auto rowType = reader->rowType();
+
+  for (const bool preserve : {false, true}) {
+    SCOPED_TRACE(fmt::format("preserve {}", preserve));
+    // With 1 row in 10 selected, a flat vector of the selected rows of the
+    // stripe is smaller than the dictionary of 250 values.
+    auto spec = std::make_shared<common::ScanSpec>("<root>");
+    spec->addAllChildFields(*rowType);
+    spec->childByName("c1")->setFilter(
+        std::make_unique<common::BigintRange>(0, 0, false));
+    RowReaderOptions rowReaderOpts;
+    rowReaderOpts.setScanSpec(spec);
+    rowReaderOpts.setPreserveStringDictionaries(preserve);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    auto actual = BaseVector::create(rowType, 0, pool());
+    const BaseVector* base = nullptr;
+    for (int stride = 0; stride < kNumRows / kStride; ++stride) {
+      ASSERT_EQ(rowReader->next(kStride, actual), kStride);
+      ASSERT_EQ(actual->size(), kStride / 10);
+      auto* c0 = actual->as<RowVector>()->childAt(0)->loadedVector();
+      if (!preserve) {
+        ASSERT_EQ(c0->encoding(), VectorEncoding::Simple::FLAT);
+        continue;
+      }
+      // The base stays the same across strides.
+      ASSERT_EQ(c0->encoding(), VectorEncoding::Simple::DICTIONARY);
+      if (base == nullptr) {
+        base = c0->valueVector().get();
+      }
+      ASSERT_EQ(c0->valueVector().get(), base);
+      for (auto i = 0; i < c0->size(); ++i) {
+        ASSERT_EQ(
+            c0->asUnchecked<SimpleVector<StringView>>()->valueAt(i).str(),
+            fmt::format("value {:030}", (stride * kStride + i * 10) % 250));
+      }
+    }
+  }
+}
+
 // A primitive subfield is missing in file, and result is not reused.
 TEST_F(TestReader, missingSubfieldsNoResultReusing) {
   constexpr int kSize = 10;
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Compares encode speed and encoded size of RLEv1 and RLEv2 on integer data
+// of different shapes. Sizes are printed before the benchmarks run.
+
+#include <folly/Benchmark.h>
+#include <folly/Random.h>
+#include <folly/Varint.h>
+#include <folly/init/Init.h>
+#include "velox/common/memory/Memory.h"
+#include "velox/dwio/common/DataBufferHolder.h"
+#include "velox/dwio/common/Range.h"
+#include "velox/dwio/dwrf/common/EncoderUtil.h"
+
+using namespace facebook::velox::dwio::common;
+using namespace facebook::velox;
+using namespace facebook::velox::dwrf;
+
+namespace {
+
+constexpr int64_t kNumValues = 100'000;
+
+std::vector<int64_t> sequence;
+std::vector<int64_t> runs;
+std::vector<int64_t> smallRandom;
+std::vector<int64_t> outliers;
+std::vector<int64_t> wideRandom;
+
+void makeData() {
+  folly::Random::DefaultGenerator rng(1);
+  int64_t value = 1'000'000;
+  for (auto i = 0; i < kNumValues; ++i) {
+    sequence.push_back(value);
+    value += folly::Random::rand32(10, rng);
+    runs.push_back(i / 100);
+    smallRandom.push_back(folly::Random::rand32(1'000, rng));
+    outliers.push_back(
+        i % 100 == 0 ? folly::Random::rand64(rng) >> 8
+                     : folly::Random::rand32(1'000, rng));
+    wideRandom.push_back(folly::Random::rand64(rng));
+  }
+}
+
+size_t encode(RleVersion version, const std::vector<int64_t>& data) {
+  auto pool = memory::memoryManager()->addLeafPool();
+  DataBufferHolder holder{*pool, data.size() * folly::kMaxVarintLength64};
+  auto encoder = createRleEncoder</*isSigned=*/true>(
+      version,
+      std::make_unique<BufferedOutputStream>(holder),
+      /*useVInts=*/true,
+      LONG_BYTE_SIZE);
+  encoder->add(data.data(), common::Ranges::of(0, data.size()), nullptr);
+  return encoder->flush();
+}
+
+void printSizes() {
+  const std::vector<std::pair<const char*, const std::vector<int64_t>*>>
+      shapes = {
+          {"sequence", &sequence},
+          {"runs", &runs},
+          {"smallRandom", &smallRandom},
+          {"outliers", &outliers},
+          {"wideRandom", &wideRandom}};
+  for (const auto& [name, data] : shapes) {
+    LOG(INFO) << name << ": RLEv1 " << encode(RleVersion_1, *data)
+              << " bytes, RLEv2 " << encode(RleVersion_2, *data) << " bytes";
+  }
+}
+
+} // namespace
+
+#define RLE_BENCHMARKS(data)                              \
+  BENCHMARK(data##V1) {                                   \
+    folly::doNotOptimizeAway(encode(RleVersion_1, data)); \
+  }                                                       \
+  BENCHMARK_RELATIVE(data##V2) {                          \
+    folly::doNotOptimizeAway(encode(RleVersion_2, data)); \
+  }                                                       \
+  BENCHMARK_DRAW_LINE();
+
+RLE_BENCHMARKS(sequence)
+RLE_BENCHMARKS(runs)
+RLE_BENCHMARKS(smallRandom)
+RLE_BENCHMARKS(outliers)
+RLE_BENCHMARKS(wideRandom)
+
+int32_t main(int32_t argc, char* argv[]) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize(memory::MemoryManager::Options{});
+  makeData();
+  printSizes();
+  folly::runBenchmarks();
+  return 0;
+}
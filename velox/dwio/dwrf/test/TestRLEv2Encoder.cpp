@@ -0,0 +1,259 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/base/Nulls.h"
+#include "velox/dwio/common/PositionProvider.h"
+#include "velox/dwio/dwrf/common/EncoderUtil.h"
+#include "velox/dwio/dwrf/common/RLEv1.h"
+#include "velox/dwio/dwrf/common/RLEv2.h"
+#include "velox/dwio/dwrf/test/OrcTest.h"
+
+#include <folly/Random.h>
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::dwio::common;
+
+namespace facebook::velox::dwrf {
+
+class RleEncoderV2Test : public testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance(memory::MemoryManager::Options{});
+  }
+
+  // Encodes 'data' with RLEv2, skipping positions that are null in 'nulls',
+  // and checks that RleDecoderV2 returns the same values. Returns the encoded
+  // size.
+  template <bool isSigned>
+  uint64_t roundTrip(
+      const std::vector<int64_t>& data,
+      const uint64_t* nulls = nullptr) {
+    MemorySink memSink(kMemStreamSize, {.pool = pool_.get()});
+    DataBufferHolder holder{
+        *pool_, kBlockSize, 0, DEFAULT_PAGE_GROW_RATIO, &memSink};
+    RleEncoderV2<isSigned> encoder(
+        std::make_unique<BufferedOutputStream>(holder));
+    encoder.add(data.data(), common::Ranges::of(0, data.size()), nulls);
+    encoder.flush();
+
+    RleDecoderV2<isSigned> decoder(
+        std::make_unique<SeekableArrayInputStream>(
+            memSink.data(), memSink.size()),
+        *pool_);
+    std::vector<int64_t> decoded(data.size());
+    // Read in uneven batches to stop in the middle of runs. With nulls,
+    // batches start at word boundaries of 'nulls'.
+    uint64_t offset = 0;
+    while (offset < data.size()) {
+      const auto batchSize = nulls ? 64 * (1 + offset / 64 % 3)
+                                   : 1 + offset % 97;
+      const auto numValues =
+          std::min<uint64_t>(batchSize, data.size() - offset);
+      decoder.next(
+          decoded.data() + offset,
+          numValues,
+          nulls ? nulls + offset / 64 : nullptr);
+      offset += numValues;
+    }
+    for (auto i = 0; i < data.size(); ++i) {
+      if (!nulls || !bits::isBitNull(nulls, i)) {
+        EXPECT_EQ(data[i], decoded[i]) << "at " << i;
+      }
+    }
+    return memSink.size();
+  }
+
+  static constexpr uint64_t kMemStreamSize = 1024 * 1024;
+  static constexpr uint64_t kBlockSize = 1024;
+
+  std::shared_ptr<memory::MemoryPool> pool_{
+      memory::memoryManager()->addLeafPool()};
+};
+
+TEST_F(RleEncoderV2Test, shortRepeat) {
+  std::vector<int64_t> data;
+  for (auto length = 3; length <= 10; ++length) {
+    data.insert(data.end(), length, length * 1'000);
+    data.insert(data.end(), length, -length);
+  }
+  roundTrip<true>(data);
+  for (auto& value : data) {
+    value = std::abs(value);
+  }
+  roundTrip<false>(data);
+}
+
+TEST_F(RleEncoderV2Test, fixedDelta) {
+  std::vector<int64_t> data;
+  for (auto i = 0; i < 2'000; ++i) {
+    data.push_back(100 + i * 7);
+  }
+  for (auto i = 0; i < 1'000; ++i) {
+    data.push_back(5);
+  }
+  for (auto i = 0; i < 1'000; ++i) {
+    data.push_back(-3 * i);
+  }
+  // Fixed deltas take a few bytes per run of 512 values.
+  EXPECT_LT(roundTrip<true>(data), 100);
+}
+
+TEST_F(RleEncoderV2Test, monotonic) {
+  std::vector<int64_t> data;
+  int64_t value = 1'000'000;
+  for (auto i = 0; i < 5'000; ++i) {
+    value += folly::Random::rand32(100);
+    data.push_back(value);
+  }
+  roundTrip<true>(data);
+  roundTrip<false>(data);
+  for (auto i = 0; i < 5'000; ++i) {
+    value -= folly::Random::rand32(3);
+    data.push_back(value);
+  }
+  roundTrip<true>(data);
+}
+
+TEST_F(RleEncoderV2Test, direct) {
+  std::vector<int64_t> data;
+  for (auto i = 0; i < 5'000; ++i) {
+    data.push_back(
+        static_cast<int64_t>(folly::Random::rand32()) - (1LL << 31));
+  }
+  roundTrip<true>(data);
+}
+
+TEST_F(RleEncoderV2Test, patchedBase) {
+  for (int64_t base : {0L, -10'000L, 1L << 40}) {
+    std::vector<int64_t> data;
+    for (auto i = 0; i < 5'000; ++i) {
+      // A few wide values among narrow ones are patched, including gaps
+      // between patches longer than 255.
+      const bool outlier = i % 50 == 0 || (i > 3'000 && i % 400 == 0);
+      data.push_back(
+          base +
+          (outlier ? static_cast<int64_t>(folly::Random::rand64() >> 20)
+                   : folly::Random::rand32(1'000)));
+    }
+    const auto v2Size = roundTrip<true>(data);
+
+    MemorySink memSink(kMemStreamSize, {.pool = pool_.get()});
+    DataBufferHolder holder{
+        *pool_, kBlockSize, 0, DEFAULT_PAGE_GROW_RATIO, &memSink};
+    RleEncoderV1<true> v1(
+        std::make_unique<BufferedOutputStream>(holder), true, 8);
+    v1.add(data.data(), common::Ranges::of(0, data.size()), nullptr);
+    EXPECT_LT(v2Size, v1.flush());
+  }
+}
+
+TEST_F(RleEncoderV2Test, minAndMax) {
+  std::vector<int64_t> data;
+  for (auto i = 0; i < 2'000; ++i) {
+    switch (folly::Random::rand32(4)) {
+      case 0:
+        data.push_back(std::numeric_limits<int64_t>::min());
+        break;
+      case 1:
+        data.push_back(std::numeric_limits<int64_t>::max());
+        break;
+      default:
+        data.push_back(folly::Random::rand32(10));
+    }
+  }
+  roundTrip<true>(data);
+  roundTrip<false>(data);
+  std::vector<int64_t> extremes(100, std::numeric_limits<int64_t>::min());
+  extremes.resize(200, std::numeric_limits<int64_t>::max());
+  roundTrip<true>(extremes);
+}
+
+TEST_F(RleEncoderV2Test, random) {
+  for (auto iter = 0; iter < 100; ++iter) {
+    std::vector<int64_t> data;
+    const auto size = 1 + folly::Random::rand32(3'000);
+    const auto maxBits = 1 + folly::Random::rand32(64);
+    for (auto i = 0; i < size; ++i) {
+      // Mix runs of repeats with random values of varying width.
+      if (!data.empty() && folly::Random::oneIn(3)) {
+        data.push_back(data.back());
+      } else {
+        data.push_back(
+            static_cast<int64_t>(folly::Random::rand64() >> (64 - maxBits)));
+      }
+    }
+    roundTrip<true>(data);
+    roundTrip<false>(data);
+  }
+}
+
+TEST_F(RleEncoderV2Test, nulls) {
+  std::vector<int64_t> data;
+  std::vector<uint64_t> nulls(bits::nwords(4'096));
+  for (auto i = 0; i < 4'096; ++i) {
+    data.push_back(i % 500 < 250 ? i : 17);
+    bits::setNull(nulls.data(), i, folly::Random::oneIn(5));
+  }
+  roundTrip<true>(data, nulls.data());
+}
+
+TEST_F(RleEncoderV2Test, seekToRowGroup) {
+  MemorySink memSink(kMemStreamSize, {.pool = pool_.get()});
+  DataBufferHolder holder{
+      *pool_, kBlockSize, 0, DEFAULT_PAGE_GROW_RATIO, &memSink};
+  auto encoder = createRleEncoder</*isSigned=*/true>(
+      RleVersion_2,
+      std::make_unique<BufferedOutputStream>(holder),
+      true,
+      LONG_BYTE_SIZE);
+
+  constexpr int32_t kStride = 1'000;
+  constexpr int32_t kNumStrides = 10;
+  std::vector<int64_t> data;
+  TestPositionRecorder recorder;
+  for (auto stride = 0; stride < kNumStrides; ++stride) {
+    if (stride > 0) {
+      recorder.addEntry();
+    }
+    encoder->recordPosition(recorder);
+    for (auto i = 0; i < kStride; ++i) {
+      data.push_back(
+          stride % 2 == 0 ? stride * kStride + i
+                          : folly::Random::rand32(1'000));
+    }
+    encoder->add(
+        data.data(),
+        common::Ranges::of(stride * kStride, (stride + 1) * kStride),
+        nullptr);
+  }
+  encoder->flush();
+
+  RleDecoderV2<true> decoder(
+      std::make_unique<SeekableArrayInputStream>(
+          memSink.data(), memSink.size()),
+      *pool_);
+  std::vector<int64_t> decoded(kStride);
+  for (auto stride = kNumStrides - 1; stride >= 0; --stride) {
+    PositionProvider positions(recorder.getPositions(stride));
+    decoder.seekToRowGroup(positions);
+    decoder.next(decoded.data(), kStride, nullptr);
+    for (auto i = 0; i < kStride; ++i) {
+      ASSERT_EQ(data[stride * kStride + i], decoded[i]);
+    }
+  }
+}
+
+} // namespace facebook::velox::dwrf
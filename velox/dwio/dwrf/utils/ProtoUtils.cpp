@@ -47,6 +47,32 @@ CREATE_TYPE_TRAIT(ROW, STRUCT)
 
 #undef CREATE_TYPE_TRAIT
 
+template <TypeKind T>
+class OrcSchemaType {};
+
+#define CREATE_ORC_TYPE_TRAIT(Kind, SchemaKind)        \
+  template <>                                          \
+  struct OrcSchemaType<TypeKind::Kind> {               \
+    static constexpr proto::orc::Type_Kind kind =      \
+        proto::orc::Type_Kind::Type_Kind_##SchemaKind; \
+  };
+
+CREATE_ORC_TYPE_TRAIT(BOOLEAN, BOOLEAN)
+CREATE_ORC_TYPE_TRAIT(TINYINT, BYTE)
+CREATE_ORC_TYPE_TRAIT(SMALLINT, SHORT)
+CREATE_ORC_TYPE_TRAIT(INTEGER, INT)
+CREATE_ORC_TYPE_TRAIT(BIGINT, LONG)
+CREATE_ORC_TYPE_TRAIT(REAL, FLOAT)
+CREATE_ORC_TYPE_TRAIT(DOUBLE, DOUBLE)
+CREATE_ORC_TYPE_TRAIT(VARCHAR, STRING)
+CREATE_ORC_TYPE_TRAIT(VARBINARY, BINARY)
+CREATE_ORC_TYPE_TRAIT(TIMESTAMP, TIMESTAMP)
+CREATE_ORC_TYPE_TRAIT(ARRAY, LIST)
+CREATE_ORC_TYPE_TRAIT(MAP, MAP)
+CREATE_ORC_TYPE_TRAIT(ROW, STRUCT)
+
+#undef CREATE_ORC_TYPE_TRAIT
+
 } // namespace
 
 void ProtoUtils::writeType(
@@ -84,6 +110,173 @@ void ProtoUtils::writeType(
   }
 }
 
+void ProtoUtils::writeType(
+    const Type& type,
+    proto::orc::Footer& footer,
+    proto::orc::Type* parent) {
+  auto self = footer.add_types();
+  if (parent) {
+    parent->add_subtypes(footer.types_size() - 1);
+  }
+  if (type.isDecimal()) {
+    const auto [precision, scale] = getDecimalPrecisionScale(type);
+    self->set_kind(proto::orc::Type_Kind_DECIMAL);
+    self->set_precision(precision);
+    self->set_scale(scale);
+    return;
+  }
+  if (type.isDate()) {
+    self->set_kind(proto::orc::Type_Kind_DATE);
+    return;
+  }
+  auto kind =
+      VELOX_STATIC_FIELD_DYNAMIC_DISPATCH(OrcSchemaType, kind, type.kind());
+  self->set_kind(kind);
+  switch (type.kind()) {
+    case TypeKind::ROW: {
+      auto& row = type.asRow();
+      for (size_t i = 0; i < row.size(); ++i) {
+        self->add_fieldnames(row.nameOf(i));
+        writeType(*row.childAt(i), footer, self);
+      }
+      break;
+    }
+    case TypeKind::ARRAY:
+      writeType(*type.asArray().elementType(), footer, self);
+      break;
+    case TypeKind::MAP: {
+      auto& map = type.asMap();
+      writeType(*map.keyType(), footer, self);
+      writeType(*map.valueType(), footer, self);
+      break;
+    }
+    default:
+      DWIO_ENSURE(type.isPrimitiveType());
+      break;
+  }
+}
+
+void ProtoUtils::toOrcStatistics(
+    const Type& type,
+    const proto::ColumnStatistics& from,
+    proto::orc::ColumnStatistics& to) {
+  if (from.has_numberofvalues()) {
+    to.set_numberofvalues(from.numberofvalues());
+  }
+  if (from.has_hasnull()) {
+    to.set_hasnull(from.hasnull());
+  }
+  // Decimal min/max are not collected by the writer. The ORC readers expect
+  // decimal statistics as strings, so nothing is better than integers here.
+  if (type.isDecimal()) {
+    return;
+  }
+  if (from.has_intstatistics()) {
+    const auto& stats = from.intstatistics();
+    if (type.isDate()) {
+      auto* dateStats = to.mutable_datestatistics();
+      if (stats.has_minimum()) {
+        dateStats->set_minimum(stats.minimum());
+      }
+      if (stats.has_maximum()) {
+        dateStats->set_maximum(stats.maximum());
+      }
+      return;
+    }
+    auto* intStats = to.mutable_intstatistics();
+    if (stats.has_minimum()) {
+      intStats->set_minimum(stats.minimum());
+    }
+    if (stats.has_maximum()) {
+      intStats->set_maximum(stats.maximum());
+    }
+    if (stats.has_sum()) {
+      intStats->set_sum(stats.sum());
+    }
+  }
+  if (from.has_doublestatistics()) {
+    const auto& stats = from.doublestatistics();
+    auto* doubleStats = to.mutable_doublestatistics();
+    if (stats.has_minimum()) {
+      doubleStats->set_minimum(stats.minimum());
+    }
+    if (stats.has_maximum()) {
+      doubleStats->set_maximum(stats.maximum());
+    }
+    if (stats.has_sum()) {
+      doubleStats->set_sum(stats.sum());
+    }
+  }
+  if (from.has_stringstatistics()) {
+    const auto& stats = from.stringstatistics();
+    auto* stringStats = to.mutable_stringstatistics();
+    if (stats.has_minimum()) {
+      stringStats->set_minimum(stats.minimum());
+    }
+    if (stats.has_maximum()) {
+      stringStats->set_maximum(stats.maximum());
+    }
+    if (stats.has_sum()) {
+      stringStats->set_sum(stats.sum());
+    }
+  }
+  if (from.has_bucketstatistics()) {
+    *to.mutable_bucketstatistics()->mutable_count() =
+        from.bucketstatistics().count();
+  }
+  if (from.has_binarystatistics() && from.binarystatistics().has_sum()) {
+    to.mutable_binarystatistics()->set_sum(from.binarystatistics().sum());
+  }
+}
+
+proto::orc::CompressionKind ProtoUtils::toOrcCompression(
+    common::CompressionKind kind) {
+  switch (kind) {
+    case common::CompressionKind_NONE:
+      return proto::orc::CompressionKind::NONE;
+    case common::CompressionKind_ZLIB:
+      return proto::orc::CompressionKind::ZLIB;
+    case common::CompressionKind_SNAPPY:
+      return proto::orc::CompressionKind::SNAPPY;
+    case common::CompressionKind_LZO:
+      return proto::orc::CompressionKind::LZO;
+    case common::CompressionKind_LZ4:
+      return proto::orc::CompressionKind::LZ4;
+    case common::CompressionKind_ZSTD:
+      return proto::orc::CompressionKind::ZSTD;
+    default:
+      VELOX_FAIL(
+          "Compression kind not supported by ORC: {}",
+          common::compressionKindToString(kind));
+  }
+}
+
+void ProtoUtils::toOrcEncoding(
+    const proto::ColumnEncoding& from,
+    proto::orc::ColumnEncoding& to) {
+  switch (from.kind()) {
+    case proto::ColumnEncoding_Kind_DIRECT:
+      to.set_kind(proto::orc::ColumnEncoding_Kind_DIRECT);
+      break;
+    case proto::ColumnEncoding_Kind_DICTIONARY:
+      to.set_kind(proto::orc::ColumnEncoding_Kind_DICTIONARY);
+      break;
+    case proto::ColumnEncoding_Kind_DIRECT_V2:
+      to.set_kind(proto::orc::ColumnEncoding_Kind_DIRECT_V2);
+      break;
+    case proto::ColumnEncoding_Kind_DICTIONARY_V2:
+      to.set_kind(proto::orc::ColumnEncoding_Kind_DICTIONARY_V2);
+      break;
+    default:
+      VELOX_FAIL(
+          "Column encoding not supported by ORC: {}",
+          proto::ColumnEncoding_Kind_Name(from.kind()));
+  }
+  if (from.has_dictionarysize() && from.dictionarysize() > 0) {
+    to.set_dictionarysize(from.dictionarysize());
+  }
+}
+
 std::shared_ptr<const Type> ProtoUtils::fromFooter(
     const proto::Footer& footer,
     std::function<bool(uint32_t)> selector,
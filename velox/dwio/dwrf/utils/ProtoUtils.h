@@ -16,8 +16,10 @@
 
 #pragma once
 
+#include "velox/common/compression/Compression.h"
 #include "velox/dwio/common/SeekableInputStream.h"
 #include "velox/dwio/dwrf/common/wrap/dwrf-proto-wrapper.h"
+#include "velox/dwio/dwrf/common/wrap/orc-proto-wrapper.h"
 #include "velox/type/Type.h"
 
 namespace facebook::velox::dwrf {
@@ -29,6 +31,27 @@ class ProtoUtils final {
       proto::Footer& footer,
       proto::Type* parent = nullptr);
 
+  // Writes the ORC schema of 'type'. Unlike DWRF, ORC has native DATE and
+  // DECIMAL types.
+  static void writeType(
+      const Type& type,
+      proto::orc::Footer& footer,
+      proto::orc::Type* parent = nullptr);
+
+  // Converts the statistics collected by the DWRF statistics builders for a
+  // column of 'type' to their ORC representation.
+  static void toOrcStatistics(
+      const Type& type,
+      const proto::ColumnStatistics& from,
+      proto::orc::ColumnStatistics& to);
+
+  static proto::orc::CompressionKind toOrcCompression(
+      common::CompressionKind kind);
+
+  static void toOrcEncoding(
+      const proto::ColumnEncoding& from,
+      proto::orc::ColumnEncoding& to);
+
   static std::shared_ptr<const Type> fromFooter(
       const proto::Footer& footer,
       std::function<bool(uint32_t)> selector = [](uint32_t) { return true; },
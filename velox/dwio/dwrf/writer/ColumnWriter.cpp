@@ -290,8 +290,7 @@ class IntegerColumnWriter : public BaseColumnWriter {
   void setEncoding(proto::ColumnEncoding& encoding) const override {
     BaseColumnWriter::setEncoding(encoding);
     if (useDictionaryEncoding_) {
-      encoding.set_kind(
-          proto::ColumnEncoding_Kind::ColumnEncoding_Kind_DICTIONARY);
+      encoding.set_kind(dictionaryEncodingKind());
       encoding.set_dictionarysize(finalDictionarySize_);
     }
   }
@@ -386,12 +385,19 @@ class IntegerColumnWriter : public BaseColumnWriter {
     if (!data_ && !dataDirect_) {
       if (dictEncoding) {
         data_ = createRleEncoder</* isSigned = */ false>(
-            RleVersion_1,
+            rleVersion_,
             newStream(StreamKind::StreamKind_DATA),
             getConfig(Config::USE_VINTS),
             sizeof(T));
         inDictionary_ = createBooleanRleEncoder(
             newStream(StreamKind::StreamKind_IN_DICTIONARY));
+      } else if (context_.format() == DwrfFormat::kOrc) {
+        // Unlike DWRF, ORC run length encodes direct integer data.
+        dataDirect_ = createRleEncoder</* isSigned */ true>(
+            rleVersion_,
+            newStream(StreamKind::StreamKind_DATA),
+            getConfig(Config::USE_VINTS),
+            sizeof(T));
       } else {
         dataDirect_ = createDirectEncoder</* isSigned */ true>(
             newStream(StreamKind::StreamKind_DATA),
@@ -447,7 +453,9 @@ class IntegerColumnWriter : public BaseColumnWriter {
   }
 
   bool useDictionaryEncoding() const override {
-    return getConfig(Config::INTEGER_DICTIONARY_ENCODING_ENABLED) &&
+    // ORC has no dictionary encoding for integers.
+    return context_.format() == DwrfFormat::kDwrf &&
+        getConfig(Config::INTEGER_DICTIONARY_ENCODING_ENABLED) &&
         BaseColumnWriter::useDictionaryEncoding();
   }
 
@@ -664,15 +672,20 @@ class TimestampColumnWriter : public BaseColumnWriter {
       std::function<void(IndexBuilder&)> onRecordPosition)
       : BaseColumnWriter{context, type, sequence, onRecordPosition},
         seconds_{createRleEncoder</* isSigned = */ true>(
-            RleVersion_1,
+            rleVersion_,
             newStream(StreamKind::StreamKind_DATA),
             context.getConfig(Config::USE_VINTS),
             LONG_BYTE_SIZE)},
         nanos_{createRleEncoder</* isSigned = */ false>(
-            RleVersion_1,
+            rleVersion_,
             newStream(StreamKind::StreamKind_NANO_DATA),
             context.getConfig(Config::USE_VINTS),
-            LONG_BYTE_SIZE)} {
+            LONG_BYTE_SIZE)},
+        // ORC files declare UTC as the writer time zone, so their seconds are
+        // relative to 2015-01-01 00:00:00 UTC.
+        epochOffset_{
+            context.format() == DwrfFormat::kOrc ? UTC_EPOCH_OFFSET
+                                                 : EPOCH_OFFSET} {
     reset();
   }
 
@@ -695,6 +708,7 @@ class TimestampColumnWriter : public BaseColumnWriter {
  private:
   std::unique_ptr<IntEncoder<true>> seconds_;
   std::unique_ptr<IntEncoder<false>> nanos_;
+  const int64_t epochOffset_;
 };
 
 class DecimalColumnWriter : public BaseColumnWriter {
@@ -714,7 +728,7 @@ class DecimalColumnWriter : public BaseColumnWriter {
             isShortDecimal_ ? getConfig(Config::USE_VINTS) : /*useVInts=*/true,
             isShortDecimal_ ? LONG_BYTE_SIZE : 2 * LONG_BYTE_SIZE)},
         scales_{createRleEncoder</*isSigned=*/true>(
-            RleVersion_1,
+            rleVersion_,
             // DWRF's NANO_DATA has the same enum value as ORC's SECONDARY.
             newStream(StreamKind::StreamKind_NANO_DATA),
             getConfig(Config::USE_VINTS),
@@ -810,7 +824,8 @@ class DecimalColumnWriter : public BaseColumnWriter {
 };
 
 namespace {
-FOLLY_ALWAYS_INLINE int64_t formatTime(int64_t seconds, uint64_t nanos) {
+FOLLY_ALWAYS_INLINE int64_t
+formatTime(int64_t seconds, uint64_t nanos, int64_t epochOffset) {
   VELOX_CHECK_GE(seconds, MIN_SECONDS);
 
   if (seconds < 0 && nanos != 0) {
@@ -827,7 +842,7 @@ FOLLY_ALWAYS_INLINE int64_t formatTime(int64_t seconds, uint64_t nanos) {
     seconds += 1;
   }
 
-  return seconds - EPOCH_OFFSET;
+  return seconds - epochOffset;
 }
 
 FOLLY_ALWAYS_INLINE int64_t formatNanos(uint64_t nanos) {
@@ -864,7 +879,8 @@ uint64_t TimestampColumnWriter::write(
     for (auto& pos : ranges) {
       if (!decodedVector.isNullAt(pos)) {
         auto ts = decodedVector.valueAt<Timestamp>(pos);
-        seconds_->writeValue(formatTime(ts.getSeconds(), ts.getNanos()));
+        seconds_->writeValue(
+            formatTime(ts.getSeconds(), ts.getNanos(), epochOffset_));
         nanos_->writeValue(formatNanos(ts.getNanos()));
         ++count;
       }
@@ -872,7 +888,8 @@ uint64_t TimestampColumnWriter::write(
   } else {
     for (auto& pos : ranges) {
       auto ts = decodedVector.valueAt<Timestamp>(pos);
-      seconds_->writeValue(formatTime(ts.getSeconds(), ts.getNanos()));
+      seconds_->writeValue(
+          formatTime(ts.getSeconds(), ts.getNanos(), epochOffset_));
       nanos_->writeValue(formatNanos(ts.getNanos()));
       ++count;
     }
@@ -1003,8 +1020,7 @@ class StringColumnWriter : public BaseColumnWriter {
   void setEncoding(proto::ColumnEncoding& encoding) const override {
     BaseColumnWriter::setEncoding(encoding);
     if (useDictionaryEncoding_) {
-      encoding.set_kind(
-          proto::ColumnEncoding_Kind::ColumnEncoding_Kind_DICTIONARY);
+      encoding.set_kind(dictionaryEncodingKind());
       encoding.set_dictionarysize(finalDictionarySize_);
     }
   }
@@ -1097,14 +1113,14 @@ class StringColumnWriter : public BaseColumnWriter {
     if (!data_ && !dataDirect_) {
       if (dictEncoding) {
         data_ = createRleEncoder</* isSigned = */ false>(
-            RleVersion_1,
+            rleVersion_,
             newStream(StreamKind::StreamKind_DATA),
             getConfig(Config::USE_VINTS),
             sizeof(uint32_t));
         dictionaryData_ = std::make_unique<AppendOnlyBufferedStream>(
             newStream(StreamKind::StreamKind_DICTIONARY_DATA));
         dictionaryDataLength_ = createRleEncoder</* isSigned = */ false>(
-            RleVersion_1,
+            rleVersion_,
             newStream(StreamKind::StreamKind_LENGTH),
             getConfig(Config::USE_VINTS),
             sizeof(uint32_t));
@@ -1113,7 +1129,7 @@ class StringColumnWriter : public BaseColumnWriter {
         strideDictionaryData_ = std::make_unique<AppendOnlyBufferedStream>(
             newStream(StreamKind::StreamKind_STRIDE_DICTIONARY));
         strideDictionaryDataLength_ = createRleEncoder</* isSigned = */ false>(
-            RleVersion_1,
+            rleVersion_,
             newStream(StreamKind::StreamKind_STRIDE_DICTIONARY_LENGTH),
             getConfig(Config::USE_VINTS),
             sizeof(uint32_t));
@@ -1121,7 +1137,7 @@ class StringColumnWriter : public BaseColumnWriter {
         dataDirect_ = std::make_unique<AppendOnlyBufferedStream>(
             newStream(StreamKind::StreamKind_DATA));
         dataDirectLength_ = createRleEncoder</* isSigned = */ false>(
-            RleVersion_1,
+            rleVersion_,
             newStream(StreamKind::StreamKind_LENGTH),
             getConfig(Config::USE_VINTS),
             sizeof(uint32_t));
@@ -1329,7 +1345,9 @@ void StringColumnWriter::populateDictionaryEncodingStreams() {
       pool,
       sort_,
       DictionaryEncodingUtils::frequencyOrdering,
-      true,
+      // ORC has no stride dictionaries, so all keys stay in the stripe
+      // dictionary.
+      /*dropInfrequentKeys=*/context_.format() == DwrfFormat::kDwrf,
       lookupTable,
       inDict,
       strideDictCounts,
@@ -1602,7 +1620,7 @@ class BinaryColumnWriter : public BaseColumnWriter {
       : BaseColumnWriter{context, type, sequence, onRecordPosition},
         data_{newStream(StreamKind::StreamKind_DATA)},
         lengths_{createRleEncoder</* isSigned */ false>(
-            RleVersion_1,
+            rleVersion_,
             newStream(StreamKind::StreamKind_LENGTH),
             context.getConfig(Config::USE_VINTS),
             dwio::common::INT_BYTE_SIZE)} {
@@ -1845,7 +1863,7 @@ class ListColumnWriter : public BaseColumnWriter {
       std::function<void(IndexBuilder&)> onRecordPosition)
       : BaseColumnWriter{context, type, sequence, onRecordPosition},
         lengths_{createRleEncoder</* isSigned = */ false>(
-            RleVersion_1,
+            rleVersion_,
             newStream(StreamKind::StreamKind_LENGTH),
             context.getConfig(Config::USE_VINTS),
             dwio::common::INT_BYTE_SIZE)} {
@@ -1972,7 +1990,7 @@ class MapColumnWriter : public BaseColumnWriter {
       std::function<void(IndexBuilder&)> onRecordPosition)
       : BaseColumnWriter{context, type, sequence, onRecordPosition},
         lengths_{createRleEncoder</* isSigned = */ false>(
-            RleVersion_1,
+            rleVersion_,
             newStream(StreamKind::StreamKind_LENGTH),
             context.getConfig(Config::USE_VINTS),
             dwio::common::INT_BYTE_SIZE)} {
@@ -2094,6 +2112,37 @@ uint64_t MapColumnWriter::write(
 
 } // namespace
 
+RleVersion BaseColumnWriter::rleVersionFor(
+    WriterContext& context,
+    const TypeWithId& type) {
+  const auto& rleV2Cols = context.getConfig(Config::RLE_V2_COLS);
+  const bool allColumns = context.format() == DwrfFormat::kOrc &&
+      context.getConfig(Config::ORC_RLE_V2);
+  if (!allColumns &&
+      std::find(rleV2Cols.begin(), rleV2Cols.end(), type.id()) ==
+          rleV2Cols.end()) {
+    return RleVersion_1;
+  }
+  switch (type.type()->kind()) {
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::HUGEINT:
+      // DWRF writes direct integer data as plain varints rather than RLE.
+      return context.format() == DwrfFormat::kOrc ? RleVersion_2
+                                                   : RleVersion_1;
+    case TypeKind::TIMESTAMP:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+    case TypeKind::ARRAY:
+    case TypeKind::MAP:
+      return RleVersion_2;
+    default:
+      // No integer streams to encode.
+      return RleVersion_1;
+  }
+}
+
 std::unique_ptr<BaseColumnWriter> BaseColumnWriter::create(
     WriterContext& context,
     const TypeWithId& type,
@@ -2183,7 +2232,8 @@ std::unique_ptr<BaseColumnWriter> BaseColumnWriter::create(
           context, type, sequence, onRecordPosition);
       ret->children_.reserve(type.size());
       for (int32_t i = 0; i < type.size(); ++i) {
-        ret->children_.push_back(create(context, *type.childAt(i), sequence));
+        ret->children_.push_back(create(
+            context, *type.childAt(i), sequence, nullptr, format));
       }
       return ret;
     }
@@ -2199,15 +2249,18 @@ std::unique_ptr<BaseColumnWriter> BaseColumnWriter::create(
       }
       auto ret = std::make_unique<MapColumnWriter>(
           context, type, sequence, onRecordPosition);
-      ret->children_.push_back(create(context, *type.childAt(0), sequence));
-      ret->children_.push_back(create(context, *type.childAt(1), sequence));
+      ret->children_.push_back(
+          create(context, *type.childAt(0), sequence, nullptr, format));
+      ret->children_.push_back(
+          create(context, *type.childAt(1), sequence, nullptr, format));
       return ret;
     }
     case TypeKind::ARRAY: {
       VELOX_CHECK_EQ(type.size(), 1, "Array should have exactly one child");
       auto ret = std::make_unique<ListColumnWriter>(
           context, type, sequence, onRecordPosition);
-      ret->children_.push_back(create(context, *type.childAt(0), sequence));
+      ret->children_.push_back(
+          create(context, *type.childAt(0), sequence, nullptr, format));
       return ret;
     }
     default:
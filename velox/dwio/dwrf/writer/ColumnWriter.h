@@ -163,8 +163,10 @@ class BaseColumnWriter : public ColumnWriter {
       : ColumnWriter{context, type.id(), sequence},
         type_{type},
         indexBuilder_{context_.newIndexBuilder(
-            newStream(StreamKind::StreamKind_ROW_INDEX))},
-        onRecordPosition_{std::move(onRecordPosition)} {
+            newStream(StreamKind::StreamKind_ROW_INDEX),
+            type.type())},
+        onRecordPosition_{std::move(onRecordPosition)},
+        rleVersion_{rleVersionFor(context, type)} {
     if (!isRoot()) {
       present_ =
           createBooleanRleEncoder(newStream(StreamKind::StreamKind_PRESENT));
@@ -207,6 +209,20 @@ class BaseColumnWriter : public ColumnWriter {
     return 0;
   }
 
+  void setEncoding(proto::ColumnEncoding& encoding) const override {
+    ColumnWriter::setEncoding(encoding);
+    if (rleVersion_ == RleVersion_2) {
+      encoding.set_kind(
+          proto::ColumnEncoding_Kind::ColumnEncoding_Kind_DIRECT_V2);
+    }
+  }
+
+  proto::ColumnEncoding_Kind dictionaryEncodingKind() const {
+    return rleVersion_ == RleVersion_2
+        ? proto::ColumnEncoding_Kind::ColumnEncoding_Kind_DICTIONARY_V2
+        : proto::ColumnEncoding_Kind::ColumnEncoding_Kind_DICTIONARY;
+  }
+
   virtual void recordPosition() {
     if (onRecordPosition_) {
       onRecordPosition_(*indexBuilder_);
@@ -268,6 +284,13 @@ class BaseColumnWriter : public ColumnWriter {
   // callback used to inject the logic that captures positions for flat map
   // in_map stream
   const std::function<void(IndexBuilder&)> onRecordPosition_;
+  // RLE version of the integer streams of this column.
+  const RleVersion rleVersion_;
+
+ private:
+  static RleVersion rleVersionFor(
+      WriterContext& context,
+      const dwio::common::TypeWithId& type);
 
   VELOX_FRIEND_TEST(ColumnWriterTest, LowMemoryModeConfig);
   VELOX_FRIEND_TEST(ColumnWriterTest, IntegerDictionaryEncodingEnabledConfig);
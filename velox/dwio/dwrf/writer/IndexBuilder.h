@@ -17,7 +17,9 @@
 #pragma once
 
 #include "velox/dwio/common/OutputStream.h"
+#include "velox/dwio/dwrf/common/Common.h"
 #include "velox/dwio/dwrf/common/wrap/dwrf-proto-wrapper.h"
+#include "velox/dwio/dwrf/utils/ProtoUtils.h"
 #include "velox/dwio/dwrf/writer/StatisticsBuilder.h"
 
 namespace facebook::velox::dwrf {
@@ -38,6 +40,17 @@ class IndexBuilder : public PositionRecorder {
   IndexBuilder(std::unique_ptr<BufferedOutputStream> out)
       : out_{std::move(out)} {}
 
+  // Builds an index serialized as ORC RowIndex. Positions are laid out the
+  // same way in both formats; only the statistics differ, so 'type' is needed
+  // to translate them.
+  IndexBuilder(
+      std::unique_ptr<BufferedOutputStream> out,
+      DwrfFormat format,
+      TypePtr type)
+      : out_{std::move(out)}, format_{format}, type_{std::move(type)} {
+    VELOX_CHECK(format_ == DwrfFormat::kDwrf || type_ != nullptr);
+  }
+
   virtual ~IndexBuilder() = default;
 
   void add(uint64_t pos, int32_t index = -1) override {
@@ -59,7 +72,11 @@ class IndexBuilder : public PositionRecorder {
 
   virtual void flush() {
     // remove isPresent positions if none is null
-    index_.SerializeToZeroCopyStream(out_.get());
+    if (format_ == DwrfFormat::kOrc) {
+      toOrcIndex().SerializeToZeroCopyStream(out_.get());
+    } else {
+      index_.SerializeToZeroCopyStream(out_.get());
+    }
     out_->flush();
     index_.Clear();
     entry_.Clear();
@@ -86,6 +103,19 @@ class IndexBuilder : public PositionRecorder {
   }
 
  private:
+  proto::orc::RowIndex toOrcIndex() const {
+    proto::orc::RowIndex orcIndex;
+    for (const auto& entry : index_.entry()) {
+      auto* orcEntry = orcIndex.add_entry();
+      *orcEntry->mutable_positions() = entry.positions();
+      if (entry.has_statistics()) {
+        ProtoUtils::toOrcStatistics(
+            *type_, entry.statistics(), *orcEntry->mutable_statistics());
+      }
+    }
+    return orcIndex;
+  }
+
   proto::RowIndexEntry* getEntry(int32_t index) {
     if (index < 0) {
       return &entry_;
@@ -98,6 +128,8 @@ class IndexBuilder : public PositionRecorder {
   }
 
   const std::unique_ptr<BufferedOutputStream> out_;
+  const DwrfFormat format_{DwrfFormat::kDwrf};
+  const TypePtr type_;
   proto::RowIndex index_;
   proto::RowIndexEntry entry_;
   std::optional<int32_t> presentStreamOffset_;
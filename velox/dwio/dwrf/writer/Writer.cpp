@@ -149,6 +149,34 @@ uint8_t orcWriterZSTDCompressionLevel(
       .value_or(kDefaultZstdCompressionLevel);
 }
 
+// Translates the stripe footer built by the encoding manager to ORC. Streams
+// keep their order, and ORC expects exactly one encoding per column id, in
+// column id order.
+proto::orc::StripeFooter toOrcStripeFooter(
+    const proto::StripeFooter& footer,
+    uint32_t numColumns) {
+  proto::orc::StripeFooter orcFooter;
+  for (const auto& stream : footer.streams()) {
+    auto* orcStream = orcFooter.add_streams();
+    orcStream->set_kind(toOrcStreamKind(toStreamKind(stream.kind())));
+    orcStream->set_column(stream.node());
+    orcStream->set_length(stream.length());
+  }
+
+  std::vector<const proto::ColumnEncoding*> encodings(numColumns, nullptr);
+  for (const auto& encoding : footer.encoding()) {
+    VELOX_CHECK_EQ(encoding.sequence(), 0);
+    encodings.at(encoding.node()) = &encoding;
+  }
+  for (const auto* encoding : encodings) {
+    VELOX_CHECK_NOT_NULL(encoding);
+    ProtoUtils::toOrcEncoding(*encoding, *orcFooter.add_columns());
+  }
+  // Timestamp seconds are written relative to 2015-01-01 00:00:00 UTC.
+  orcFooter.set_writertimezone("UTC");
+  return orcFooter;
+}
+
 #define NON_RECLAIMABLE_SECTION_CHECK() \
   VELOX_CHECK(nonReclaimableSection_ == nullptr || *nonReclaimableSection_);
 } // namespace
@@ -175,7 +203,8 @@ Writer::Writer(
       pool,
       options.sessionTimezone,
       options.adjustTimestampToTimezone,
-      std::move(handler));
+      std::move(handler),
+      options.format);
   auto& context = writerBase_->getContext();
   VELOX_CHECK_EQ(
       context.getTotalMemoryUsage(),
@@ -200,7 +229,12 @@ Writer::Writer(
   }
 
   if (options.columnWriterFactory == nullptr) {
-    writer_ = BaseColumnWriter::create(writerBase_->getContext(), *schema_);
+    writer_ = BaseColumnWriter::create(
+        writerBase_->getContext(),
+        *schema_,
+        /*sequence=*/0,
+        /*onRecordPosition=*/nullptr,
+        options.format);
   } else {
     writer_ = options.columnWriterFactory(writerBase_->getContext(), *schema_);
   }
@@ -619,7 +653,12 @@ void Writer::flushStripe(bool close) {
   VELOX_CHECK_EQ(footerOffset, stripeOffset + dataLength + indexLength);
 
   sink.setMode(WriterSink::Mode::Footer);
-  writerBase_->writeProto(encodingManager.getFooter());
+  if (context.format() == DwrfFormat::kOrc) {
+    writerBase_->writeProto(toOrcStripeFooter(
+        encodingManager.getFooter(), schema_->maxId() + 1));
+  } else {
+    writerBase_->writeProto(encodingManager.getFooter());
+  }
   sink.setMode(WriterSink::Mode::None);
 
   auto& stripe = writerBase_->addStripeInfo();
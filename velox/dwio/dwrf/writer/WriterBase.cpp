@@ -20,12 +20,35 @@
 
 namespace facebook::velox::dwrf {
 
+namespace {
+
+// Writer version ORC-135: timestamps, including their statistics, are in
+// UTC.
+constexpr uint32_t kOrcWriterVersion = 6;
+
+// Collects the types in the same pre-order the column ids are assigned in.
+void collectTypes(const Type& type, std::vector<const Type*>& types) {
+  types.push_back(&type);
+  for (uint32_t i = 0; i < type.size(); ++i) {
+    collectTypes(*type.childAt(i), types);
+  }
+}
+
+} // namespace
+
 void WriterBase::writeFooter(const Type& type) {
   auto pos = writerSink_->size();
   footer_.set_headerlength(ORC_MAGIC_LEN);
   footer_.set_contentlength(pos - ORC_MAGIC_LEN);
   writerSink_->setMode(WriterSink::Mode::None);
 
+  if (context_->format() == DwrfFormat::kOrc) {
+    writeOrcFooter(
+        type,
+        static_cast<uint32_t>(context_->getConfig(Config::WRITER_VERSION)));
+    return;
+  }
+
   // write cache when available
   auto cacheSize = writerSink_->getCacheSize();
   if (cacheSize > 0) {
@@ -78,6 +101,66 @@ void WriterBase::writeFooter(const Type& type) {
       context_->getMemoryPool(MemoryUsageCategory::OUTPUT_STREAM), &psLen, 1);
 }
 
+void WriterBase::writeOrcFooter(const Type& type, uint32_t writerVersion) {
+  proto::orc::Footer footer;
+  footer.set_headerlength(footer_.headerlength());
+  footer.set_contentlength(footer_.contentlength());
+  for (const auto& stripe : footer_.stripes()) {
+    auto* orcStripe = footer.add_stripes();
+    orcStripe->set_offset(stripe.offset());
+    orcStripe->set_indexlength(stripe.indexlength());
+    orcStripe->set_datalength(stripe.datalength());
+    orcStripe->set_footerlength(stripe.footerlength());
+    orcStripe->set_numberofrows(stripe.numberofrows());
+  }
+
+  ProtoUtils::writeType(type, footer);
+  DWIO_ENSURE_EQ(footer.types_size(), footer_.statistics_size());
+  std::vector<const Type*> types;
+  types.reserve(footer.types_size());
+  collectTypes(type, types);
+  for (int32_t i = 0; i < footer_.statistics_size(); ++i) {
+    ProtoUtils::toOrcStatistics(
+        *types[i], footer_.statistics(i), *footer.add_statistics());
+  }
+
+  writeUserMetadata(writerVersion);
+  for (const auto& item : footer_.metadata()) {
+    auto* orcItem = footer.add_metadata();
+    orcItem->set_name(item.name());
+    orcItem->set_value(item.value());
+  }
+  footer.set_numberofrows(context_->fileRowCount());
+  footer.set_rowindexstride(context_->indexStride());
+
+  auto pos = writerSink_->size();
+  writeProto(footer);
+  const auto footerLength = writerSink_->size() - pos;
+
+  // write postscript
+  pos = writerSink_->size();
+  proto::orc::PostScript ps;
+  ps.set_footerlength(footerLength);
+  ps.set_compression(ProtoUtils::toOrcCompression(context_->compression()));
+  if (context_->compression() !=
+      common::CompressionKind::CompressionKind_NONE) {
+    ps.set_compressionblocksize(context_->compressionBlockSize());
+  }
+  // Hive 0.12 file version. Stripe statistics are not written, so the
+  // metadata section is empty.
+  ps.add_version(0);
+  ps.add_version(12);
+  ps.set_metadatalength(0);
+  ps.set_writerversion(kOrcWriterVersion);
+  ps.set_magic(std::string(ORC_MAGIC.data(), ORC_MAGIC_LEN));
+  writeProto(ps, common::CompressionKind::CompressionKind_NONE);
+  auto psLength = writerSink_->size() - pos;
+  DWIO_ENSURE_LE(psLength, 0xff, "PostScript is too large: ", psLength);
+  auto psLen = static_cast<char>(psLength);
+  writerSink_->addBuffer(
+      context_->getMemoryPool(MemoryUsageCategory::OUTPUT_STREAM), &psLen, 1);
+}
+
 void WriterBase::writeUserMetadata(uint32_t writerVersion) {
   // add writer version
   userMetadata_[std::string{WRITER_NAME_KEY}] = kDwioWriter;
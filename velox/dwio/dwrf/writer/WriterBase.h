@@ -76,18 +76,21 @@ class WriterBase {
       std::shared_ptr<velox::memory::MemoryPool> pool,
       const tz::TimeZone* sessionTimezone = nullptr,
       const bool adjustTimestampToTimezone = false,
-      std::unique_ptr<encryption::EncryptionHandler> handler = nullptr) {
+      std::unique_ptr<encryption::EncryptionHandler> handler = nullptr,
+      DwrfFormat format = DwrfFormat::kDwrf) {
     context_ = std::make_unique<WriterContext>(
         config,
         std::move(pool),
         sink_->metricsLog(),
         sessionTimezone,
         adjustTimestampToTimezone,
-        std::move(handler));
+        std::move(handler),
+        format);
     writerSink_ = std::make_unique<WriterSink>(
         *sink_,
         context_->getMemoryPool(MemoryUsageCategory::OUTPUT_STREAM),
-        context_->getConfigs());
+        context_->getConfigs(),
+        format);
   }
 
   void initBuffers();
@@ -167,6 +170,11 @@ class WriterBase {
  private:
   void writeUserMetadata(uint32_t writerVersion);
 
+  // Writes the file footer and postscript following the ORC spec. Stripe
+  // information and file statistics are collected in 'footer_' while writing
+  // and translated here.
+  void writeOrcFooter(const Type& type, uint32_t writerVersion);
+
   std::unique_ptr<WriterContext> context_;
   std::unique_ptr<dwio::common::FileSink> sink_;
   std::unique_ptr<WriterSink> writerSink_;
@@ -16,6 +16,7 @@
 
 #include "velox/dwio/dwrf/writer/WriterContext.h"
 #include "velox/common/compression/Compression.h"
+#include "velox/dwio/dwrf/utils/ProtoUtils.h"
 #include "velox/exec/MemoryReclaimer.h"
 
 namespace facebook::velox::dwrf {
@@ -29,7 +30,8 @@ WriterContext::WriterContext(
     const dwio::common::MetricsLogPtr& metricLogger,
     const tz::TimeZone* sessionTimezone,
     const bool adjustTimestampToTimezone,
-    std::unique_ptr<encryption::EncryptionHandler> handler)
+    std::unique_ptr<encryption::EncryptionHandler> handler,
+    DwrfFormat format)
     : config_{config},
       pool_{std::move(pool)},
       dictionaryPool_{
@@ -56,6 +58,7 @@ WriterContext::WriterContext(
       metricLogger_{metricLogger},
       sessionTimezone_{sessionTimezone},
       adjustTimestampToTimezone_{adjustTimestampToTimezone},
+      format_{format},
       handler_{std::move(handler)} {
   const bool forceLowMemoryMode{getConfig(Config::FORCE_LOW_MEMORY_MODE)};
   const bool disableLowMemoryMode{getConfig(Config::DISABLE_LOW_MEMORY_MODE)};
@@ -92,6 +95,16 @@ void WriterContext::validateConfigs() const {
   VELOX_CHECK_GE(
       getConfig(Config::COMPRESSION_BLOCK_SIZE_EXTEND_RATIO),
       dwio::common::MIN_PAGE_GROW_RATIO);
+  if (format_ == DwrfFormat::kOrc) {
+    // ORC integers are always varint encoded, and flat maps and DWRF style
+    // encryption have no representation in the ORC footer.
+    VELOX_CHECK(getConfig(Config::USE_VINTS), "ORC requires varint encoding");
+    VELOX_CHECK(
+        !getConfig(Config::FLATTEN_MAP), "Flat maps are not supported by ORC");
+    VELOX_CHECK(!handler_->isEncrypted(), "Encryption is not supported by ORC");
+    // Fails on compression kinds ORC does not define.
+    ProtoUtils::toOrcCompression(compression_);
+  }
 }
 
 void WriterContext::initBuffer() {
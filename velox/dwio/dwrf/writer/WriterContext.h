@@ -45,7 +45,8 @@ class WriterContext : public CompressionBufferPool {
           dwio::common::MetricsLog::voidLog(),
       const tz::TimeZone* sessionTimezone = nullptr,
       const bool adjustTimestampToTimezone = false,
-      std::unique_ptr<encryption::EncryptionHandler> handler = nullptr);
+      std::unique_ptr<encryption::EncryptionHandler> handler = nullptr,
+      DwrfFormat format = DwrfFormat::kDwrf);
 
   ~WriterContext() override;
 
@@ -138,10 +139,15 @@ class WriterContext : public CompressionBufferPool {
   }
 
   std::unique_ptr<IndexBuilder> newIndexBuilder(
-      std::unique_ptr<BufferedOutputStream> stream) const {
-    return indexBuilderFactory_
-        ? indexBuilderFactory_(std::move(stream))
-        : std::make_unique<IndexBuilder>(std::move(stream));
+      std::unique_ptr<BufferedOutputStream> stream,
+      const TypePtr& type = nullptr) const {
+    if (indexBuilderFactory_) {
+      return indexBuilderFactory_(std::move(stream));
+    }
+    if (format_ == DwrfFormat::kOrc) {
+      return std::make_unique<IndexBuilder>(std::move(stream), format_, type);
+    }
+    return std::make_unique<IndexBuilder>(std::move(stream));
   }
 
   void suppressStream(const DwrfStreamIdentifier& stream) {
@@ -605,6 +611,12 @@ class WriterContext : public CompressionBufferPool {
     return adjustTimestampToTimezone_;
   }
 
+  /// The file format being written. ORC files are produced by the same column
+  /// writers, restricted to the encodings and streams the ORC spec defines.
+  DwrfFormat format() const {
+    return format_;
+  }
+
  private:
   void validateConfigs() const;
 
@@ -640,6 +652,7 @@ class WriterContext : public CompressionBufferPool {
   const dwio::common::MetricsLogPtr metricLogger_;
   const tz::TimeZone* sessionTimezone_;
   const bool adjustTimestampToTimezone_;
+  const DwrfFormat format_;
 
   // Map needs referential stability because reference to map value is stored by
   // another class.
@@ -39,11 +39,16 @@ class WriterSink {
   WriterSink(
       dwio::common::FileSink& sink,
       memory::MemoryPool& pool,
-      const Config& configs)
+      const Config& configs,
+      DwrfFormat format = DwrfFormat::kDwrf)
       : sink_{&sink},
         checksum_{
             ChecksumFactory::create(configs.get(Config::CHECKSUM_ALGORITHM))},
-        cacheMode_{configs.get(Config::STRIPE_CACHE_MODE)},
+        // ORC has no stripe metadata cache.
+        cacheMode_{
+            format == DwrfFormat::kOrc
+                ? StripeCacheMode::NA
+                : configs.get(Config::STRIPE_CACHE_MODE)},
         shouldBuffer_{!sink_->isBuffered()},
         maxCacheSize_{configs.get(Config::STRIPE_CACHE_SIZE)},
         mode_{Mode::None},
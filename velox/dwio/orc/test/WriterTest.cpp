@@ -0,0 +1,309 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/dwio/common/FileSink.h"
+#include "velox/dwio/common/IntCodecCommon.h"
+#include "velox/dwio/dwrf/common/DecoderUtil.h"
+#include "velox/dwio/dwrf/reader/DwrfReader.h"
+#include "velox/dwio/orc/reader/OrcReader.h"
+#include "velox/dwio/orc/writer/OrcWriter.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::dwio::common;
+using namespace facebook::velox::test;
+
+namespace {
+
+class OrcWriterTest : public testing::Test, public VectorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance(memory::MemoryManager::Options{});
+    orc::registerOrcReaderFactory();
+  }
+
+  static void TearDownTestCase() {
+    orc::unregisterOrcReaderFactory();
+  }
+
+  // Writes 'data' as ORC and returns the file contents.
+  std::string write(
+      const RowVectorPtr& data,
+      std::shared_ptr<dwrf::Config> config = nullptr) {
+    orc::OrcWriterFactory factory;
+    std::shared_ptr<dwio::common::WriterOptions> options =
+        factory.createWriterOptions();
+    auto* orcOptions = dynamic_cast<dwrf::WriterOptions*>(options.get());
+    orcOptions->schema = data->type();
+    orcOptions->memoryPool = rootPool_.get();
+    if (config != nullptr) {
+      orcOptions->config = std::move(config);
+    }
+    auto sink = std::make_unique<MemorySink>(
+        64 << 20, FileSink::Options{.pool = pool()});
+    auto* sinkPtr = sink.get();
+    auto writer = factory.createWriter(std::move(sink), options);
+    writer->write(data);
+    writer->close();
+    return std::string(sinkPtr->data(), sinkPtr->size());
+  }
+
+  // Reads 'file' back with the registered ORC reader.
+  std::unique_ptr<dwrf::DwrfReader> createReader(const std::string& file) {
+    ReaderOptions readerOptions{pool()};
+    readerOptions.setFileFormat(FileFormat::ORC);
+    auto reader = getReaderFactory(FileFormat::ORC)
+                      ->createReader(
+                          std::make_unique<BufferedInput>(
+                              std::make_shared<InMemoryReadFile>(file),
+                              *pool()),
+                          readerOptions);
+    return std::unique_ptr<dwrf::DwrfReader>(
+        dynamic_cast<dwrf::DwrfReader*>(reader.release()));
+  }
+
+  RowVectorPtr read(dwrf::DwrfReader& reader, const RowTypePtr& type) {
+    auto rowReader = reader.createRowReader(RowReaderOptions{});
+    auto result = BaseVector::create<RowVector>(type, 0, pool());
+    VectorPtr batch;
+    while (rowReader->next(1'000, batch)) {
+      result->append(batch.get());
+    }
+    return result;
+  }
+};
+
+TEST_F(OrcWriterTest, roundTrip) {
+  constexpr vector_size_t kSize = 25'000;
+  auto data = makeRowVector(
+      {"c0", "c1", "c2", "c3", "c4", "c5", "c6", "c7", "c8", "c9", "c10"},
+      {
+          makeFlatVector<int64_t>(kSize, [](auto row) { return row * 3; }),
+          makeFlatVector<int32_t>(
+              kSize, [](auto row) { return row % 11; }, nullEvery(7)),
+          // Low cardinality strings are dictionary encoded.
+          makeFlatVector<std::string>(
+              kSize,
+              [](auto row) { return fmt::format("key_{}", row % 13); },
+              nullEvery(5)),
+          // Unique strings fall back to direct encoding.
+          makeFlatVector<std::string>(
+              kSize,
+              [](auto row) { return fmt::format("unique string {}", row); }),
+          makeFlatVector<double>(kSize, [](auto row) { return row * 0.5; }),
+          makeFlatVector<bool>(kSize, [](auto row) { return row % 3 == 0; }),
+          makeFlatVector<int64_t>(
+              kSize,
+              [](auto row) { return row * 101; },
+              nullptr,
+              DECIMAL(10, 2)),
+          makeFlatVector<int128_t>(
+              kSize,
+              [](auto row) { return HugeInt::build(row, row * 7); },
+              nullptr,
+              DECIMAL(38, 5)),
+          makeArrayVector<int32_t>(
+              kSize,
+              [](auto row) { return row % 4; },
+              [](auto row) { return row; }),
+          makeMapVector<std::string, int64_t>(
+              kSize,
+              [](auto row) { return row % 3; },
+              [](auto row) { return fmt::format("k{}", row % 5); },
+              [](auto row) { return row; }),
+          // Runs mixed with wide literals of both signs.
+          makeFlatVector<int64_t>(
+              kSize,
+              [](auto row) -> int64_t {
+                const int64_t value = row;
+                if (row % 50 < 20) {
+                  return 7;
+                }
+                return row % 2 ? -(value << 33) : value << 40;
+              },
+              nullEvery(13)),
+      });
+
+  auto file = write(data);
+  ASSERT_EQ(file.substr(0, 3), "ORC");
+
+  auto reader = createReader(file);
+  ASSERT_EQ(reader->getFooter().format(), dwrf::DwrfFormat::kOrc);
+  ASSERT_EQ(reader->numberOfRows().value(), kSize);
+
+  const auto& footer = *reader->getFooter().getOrcPtr();
+  ASSERT_EQ(footer.types(7).kind(), dwrf::proto::orc::Type_Kind_DECIMAL);
+  ASSERT_EQ(footer.types(7).precision(), 10);
+  ASSERT_EQ(footer.types(7).scale(), 2);
+  ASSERT_EQ(footer.types(8).kind(), dwrf::proto::orc::Type_Kind_DECIMAL);
+  ASSERT_EQ(footer.statistics(1).intstatistics().maximum(), (kSize - 1) * 3);
+
+  auto rowType = asRowType(data->type());
+  assertEqualVectors(data, read(*reader, rowType));
+}
+
+TEST_F(OrcWriterTest, stripeFooter) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(10'000, [](auto row) { return row % 5; }),
+      makeFlatVector<std::string>(
+          10'000, [](auto row) { return fmt::format("{}", row % 5); }),
+  });
+  auto file = write(data);
+  auto reader = createReader(file);
+
+  auto rowReader = reader->createRowReader(RowReaderOptions{});
+  auto* dwrfRowReader = dynamic_cast<dwrf::DwrfRowReader*>(rowReader.get());
+  bool preload = true;
+  auto stripe = dwrfRowReader->fetchStripe(0, preload);
+  const auto& stripeFooter = stripe->footer->getStripeFooterOrc();
+  // One encoding per column, including the root struct.
+  ASSERT_EQ(stripeFooter.columns_size(), 3);
+  // ORC has no integer dictionaries. Integer streams use RLEv2 by default.
+  ASSERT_EQ(
+      stripeFooter.columns(1).kind(),
+      dwrf::proto::orc::ColumnEncoding_Kind_DIRECT_V2);
+  ASSERT_EQ(
+      stripeFooter.columns(2).kind(),
+      dwrf::proto::orc::ColumnEncoding_Kind_DICTIONARY_V2);
+  ASSERT_EQ(stripeFooter.columns(2).dictionarysize(), 5);
+  for (const auto& stream : stripeFooter.streams()) {
+    ASSERT_LE(stream.column(), 2);
+    ASSERT_TRUE(dwrf::proto::orc::Stream_Kind_IsValid(stream.kind()));
+  }
+}
+
+TEST_F(OrcWriterTest, rleV2) {
+  constexpr vector_size_t kSize = 20'000;
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(
+          kSize,
+          [](auto row) -> int64_t {
+            return row % 100 == 0 ? static_cast<int64_t>(row) << 30 : row;
+          }),
+      makeFlatVector<int32_t>(
+          kSize, [](auto row) { return row % 9; }, nullEvery(11)),
+      makeFlatVector<std::string>(
+          kSize, [](auto row) { return fmt::format("{}", row % 5); }),
+      makeFlatVector<std::string>(
+          kSize, [](auto row) { return fmt::format("unique {}", row); }),
+      makeArrayVector<int64_t>(
+          kSize,
+          [](auto row) { return row % 4; },
+          [](auto row) { return -row; }),
+  });
+  auto config = std::make_shared<dwrf::Config>();
+  // Node ids: the array elements (6) keep RLEv1.
+  config->set(dwrf::Config::ORC_RLE_V2, false);
+  config->set(dwrf::Config::RLE_V2_COLS, {1, 2, 3, 4, 5});
+  auto file = write(data, config);
+  auto reader = createReader(file);
+  assertEqualVectors(data, read(*reader, asRowType(data->type())));
+
+  auto rowReader = reader->createRowReader(RowReaderOptions{});
+  auto* dwrfRowReader = dynamic_cast<dwrf::DwrfRowReader*>(rowReader.get());
+  bool preload = true;
+  auto stripe = dwrfRowReader->fetchStripe(0, preload);
+  const auto& stripeFooter = stripe->footer->getStripeFooterOrc();
+  ASSERT_EQ(stripeFooter.columns_size(), 7);
+  for (auto node : {1, 2, 4, 5}) {
+    ASSERT_EQ(
+        stripeFooter.columns(node).kind(),
+        dwrf::proto::orc::ColumnEncoding_Kind_DIRECT_V2);
+  }
+  ASSERT_EQ(
+      stripeFooter.columns(3).kind(),
+      dwrf::proto::orc::ColumnEncoding_Kind_DICTIONARY_V2);
+  ASSERT_EQ(
+      stripeFooter.columns(6).kind(),
+      dwrf::proto::orc::ColumnEncoding_Kind_DIRECT);
+}
+
+TEST_F(OrcWriterTest, timestamp) {
+  const std::vector<Timestamp> timestamps = {
+      Timestamp(0, 0),
+      Timestamp(dwio::common::UTC_EPOCH_OFFSET, 0),
+      // 2015-07-01 12:00:00, in daylight saving time in Los Angeles.
+      Timestamp(1435752000, 500'000'000),
+      Timestamp(-86400 * 365, 123'000'000),
+  };
+  auto data = makeRowVector({makeFlatVector<Timestamp>(timestamps)});
+  auto config = std::make_shared<dwrf::Config>();
+  config->set(dwrf::Config::COMPRESSION, common::CompressionKind_NONE);
+  auto file = write(data, config);
+  auto reader = createReader(file);
+  assertEqualVectors(data, read(*reader, asRowType(data->type())));
+
+  auto rowReader = reader->createRowReader(RowReaderOptions{});
+  auto* dwrfRowReader = dynamic_cast<dwrf::DwrfRowReader*>(rowReader.get());
+  bool preload = true;
+  auto stripe = dwrfRowReader->fetchStripe(0, preload);
+  const auto& stripeFooter = stripe->footer->getStripeFooterOrc();
+  ASSERT_EQ(stripeFooter.writertimezone(), "UTC");
+
+  // Decode the seconds as stored. Streams are laid out in footer order from
+  // the start of the stripe.
+  uint64_t offset = reader->getFooter().stripes(0).offset();
+  const dwrf::proto::orc::Stream* secondsStream = nullptr;
+  for (const auto& stream : stripeFooter.streams()) {
+    if (stream.column() == 1 &&
+        stream.kind() == dwrf::proto::orc::Stream_Kind_DATA) {
+      secondsStream = &stream;
+      break;
+    }
+    offset += stream.length();
+  }
+  ASSERT_NE(secondsStream, nullptr);
+  const auto version = stripeFooter.columns(1).kind() ==
+          dwrf::proto::orc::ColumnEncoding_Kind_DIRECT_V2
+      ? dwrf::RleVersion_2
+      : dwrf::RleVersion_1;
+  auto decoder = dwrf::createRleDecoder</*isSigned=*/true>(
+      std::make_unique<SeekableArrayInputStream>(
+          file.data() + offset, secondsStream->length()),
+      version,
+      *pool(),
+      /*useVInts=*/true,
+      dwio::common::LONG_BYTE_SIZE);
+  std::vector<int64_t> seconds(timestamps.size());
+  decoder->next(seconds.data(), seconds.size(), nullptr);
+  for (size_t i = 0; i < timestamps.size(); ++i) {
+    auto expected =
+        timestamps[i].getSeconds() - dwio::common::UTC_EPOCH_OFFSET;
+    // Like the Java writer, negative seconds with nanos are rounded up.
+    if (timestamps[i].getSeconds() < 0 && timestamps[i].getNanos() != 0) {
+      ++expected;
+    }
+    EXPECT_EQ(seconds[i], expected) << i;
+  }
+}
+
+TEST_F(OrcWriterTest, unsupportedFeatures) {
+  auto data = makeRowVector({makeMapVector<int32_t, int32_t>({{{1, 2}}})});
+  auto config = std::make_shared<dwrf::Config>();
+  config->set(dwrf::Config::FLATTEN_MAP, true);
+  config->set(dwrf::Config::MAP_FLAT_COLS, {0});
+  VELOX_ASSERT_THROW(write(data, config), "Flat maps are not supported by ORC");
+
+  config = std::make_shared<dwrf::Config>();
+  config->set(dwrf::Config::COMPRESSION, common::CompressionKind_GZIP);
+  VELOX_ASSERT_THROW(
+      write(data, config), "Compression kind not supported by ORC");
+}
+
+} // namespace
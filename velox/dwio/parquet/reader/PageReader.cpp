@@ -69,7 +69,7 @@ void PageReader::seekToPage(int64_t row) {
               bufferEnd_);
           continue;
         }
-        prepareDictionary(pageHeader);
+        deferDictionary(pageHeader);
         continue;
       default:
         break; // ignore INDEX page type and any other custom extensions
@@ -213,9 +213,14 @@ void PageReader::prepareDataPageV1(const PageHeader& pageHeader, int64_t row) {
         inputStream_.get(),
         bufferStart_,
         bufferEnd_);
-
+    if (stats_) {
+      ++stats_->skippedPages;
+    }
     return;
   }
+  if (row != kRepDefOnly) {
+    loadDictionary(pageHeader.data_page_header.encoding);
+  }
   pageData_ = readBytes(pageHeader.compressed_page_size, pageBuffer_);
   pageData_ = decompressData(
       pageData_,
@@ -269,8 +274,14 @@ void PageReader::prepareDataPageV2(const PageHeader& pageHeader, int64_t row) {
         inputStream_.get(),
         bufferStart_,
         bufferEnd_);
+    if (stats_) {
+      ++stats_->skippedPages;
+    }
     return;
   }
+  if (row != kRepDefOnly) {
+    loadDictionary(pageHeader.data_page_header_v2.encoding);
+  }
 
   uint32_t defineLength =
       pageHeader.data_page_header_v2.definition_levels_byte_length;
@@ -324,7 +335,40 @@ void PageReader::prepareDataPageV2(const PageHeader& pageHeader, int64_t row) {
   }
 }
 
-void PageReader::prepareDictionary(const PageHeader& pageHeader) {
+void PageReader::deferDictionary(const PageHeader& pageHeader) {
+  const auto size = pageHeader.compressed_page_size;
+  dwio::common::ensureCapacity<char>(pendingDictionaryPage_, size, &pool_);
+  dwio::common::readBytes(
+      size,
+      inputStream_.get(),
+      pendingDictionaryPage_->asMutable<char>(),
+      bufferStart_,
+      bufferEnd_);
+  pendingDictionaryHeader_ = pageHeader;
+}
+
+void PageReader::loadDictionary(thrift::Encoding::type encoding) {
+  if (!pendingDictionaryHeader_.has_value() ||
+      (encoding != Encoding::PLAIN_DICTIONARY &&
+       encoding != Encoding::RLE_DICTIONARY)) {
+    return;
+  }
+  const auto pageHeader = std::move(pendingDictionaryHeader_.value());
+  pendingDictionaryHeader_.reset();
+  const char* data = pendingDictionaryPage_->as<char>();
+  if (codec_ != common::CompressionKind::CompressionKind_NONE) {
+    data = decompressData(
+        data,
+        pageHeader.compressed_page_size,
+        pageHeader.uncompressed_page_size);
+  }
+  prepareDictionary(pageHeader, data);
+  pendingDictionaryPage_.reset();
+}
+
+void PageReader::prepareDictionary(
+    const PageHeader& pageHeader,
+    const char* data) {
   dictionary_.numValues = pageHeader.dictionary_page_header.num_values;
   dictionaryEncoding_ = pageHeader.dictionary_page_header.encoding;
   dictionary_.sorted = pageHeader.dictionary_page_header.__isset.is_sorted &&
@@ -333,14 +377,6 @@ void PageReader::prepareDictionary(const PageHeader& pageHeader) {
       dictionaryEncoding_ == Encoding::PLAIN_DICTIONARY ||
       dictionaryEncoding_ == Encoding::PLAIN);
 
-  if (codec_ != common::CompressionKind::CompressionKind_NONE) {
-    pageData_ = readBytes(pageHeader.compressed_page_size, pageBuffer_);
-    pageData_ = decompressData(
-        pageData_,
-        pageHeader.compressed_page_size,
-        pageHeader.uncompressed_page_size);
-  }
-
   auto parquetType = type_->parquetType_.value();
   switch (parquetType) {
     case thrift::Type::INT32:
@@ -365,16 +401,7 @@ void PageReader::prepareDictionary(const PageHeader& pageHeader) {
       } else {
         dictionary_.values = AlignedBuffer::allocate<char>(numBytes, &pool_);
       }
-      if (pageData_) {
-        memcpy(dictionary_.values->asMutable<char>(), pageData_, numBytes);
-      } else {
-        dwio::common::readBytes(
-            numBytes,
-            inputStream_.get(),
-            dictionary_.values->asMutable<char>(),
-            bufferStart_,
-            bufferEnd_);
-      }
+      memcpy(dictionary_.values->asMutable<char>(), data, numBytes);
       if (type_->type()->isShortDecimal() &&
           parquetType == thrift::Type::INT32) {
         auto values = dictionary_.values->asMutable<int64_t>();
@@ -400,16 +427,7 @@ void PageReader::prepareDictionary(const PageHeader& pageHeader) {
       auto numVeloxBytes = dictionary_.numValues * sizeof(int128_t);
       dictionary_.values = AlignedBuffer::allocate<char>(numVeloxBytes, &pool_);
       auto numBytes = dictionary_.numValues * sizeof(Int96Timestamp);
-      if (pageData_) {
-        memcpy(dictionary_.values->asMutable<char>(), pageData_, numBytes);
-      } else {
-        dwio::common::readBytes(
-            numBytes,
-            inputStream_.get(),
-            dictionary_.values->asMutable<char>(),
-            bufferStart_,
-            bufferEnd_);
-      }
+      memcpy(dictionary_.values->asMutable<char>(), data, numBytes);
       // Expand the Parquet type length values to Velox type length.
       // We start from the end to allow in-place expansion.
       auto values = dictionary_.values->asMutable<int128_t>();
@@ -432,12 +450,7 @@ void PageReader::prepareDictionary(const PageHeader& pageHeader) {
       auto values = dictionary_.values->asMutable<StringView>();
       dictionary_.strings = AlignedBuffer::allocate<char>(numBytes, &pool_);
       auto strings = dictionary_.strings->asMutable<char>();
-      if (pageData_) {
-        memcpy(strings, pageData_, numBytes);
-      } else {
-        dwio::common::readBytes(
-            numBytes, inputStream_.get(), strings, bufferStart_, bufferEnd_);
-      }
+      memcpy(strings, data, numBytes);
       auto header = strings;
       for (auto i = 0; i < dictionary_.numValues; ++i) {
         auto length = *reinterpret_cast<const int32_t*>(header);
@@ -453,18 +466,9 @@ void PageReader::prepareDictionary(const PageHeader& pageHeader) {
       auto veloxTypeLength = type_->type()->cppSizeInBytes();
       auto numVeloxBytes = dictionary_.numValues * veloxTypeLength;
       dictionary_.values = AlignedBuffer::allocate<char>(numVeloxBytes, &pool_);
-      auto data = dictionary_.values->asMutable<char>();
+      auto bytes = dictionary_.values->asMutable<char>();
       // Read the data bytes.
-      if (pageData_) {
-        memcpy(data, pageData_, numParquetBytes);
-      } else {
-        dwio::common::readBytes(
-            numParquetBytes,
-            inputStream_.get(),
-            data,
-            bufferStart_,
-            bufferEnd_);
-      }
+      memcpy(bytes, data, numParquetBytes);
       if (type_->type()->isShortDecimal()) {
         // Parquet decimal values have a fixed typeLength_ and are in big-endian
         // layout.
@@ -473,7 +477,7 @@ void PageReader::prepareDictionary(const PageHeader& pageHeader) {
           for (auto i = dictionary_.numValues - 1; i >= 0; --i) {
             // Expand the Parquet type length values to Velox type length.
             // We start from the end to allow in-place expansion.
-            auto sourceValue = data + (i * parquetTypeLength);
+            auto sourceValue = bytes + (i * parquetTypeLength);
             int64_t value = *sourceValue >= 0 ? 0 : -1;
             memcpy(
                 reinterpret_cast<uint8_t*>(&value) + veloxTypeLength -
@@ -496,7 +500,7 @@ void PageReader::prepareDictionary(const PageHeader& pageHeader) {
           for (auto i = dictionary_.numValues - 1; i >= 0; --i) {
             // Expand the Parquet type length values to Velox type length.
             // We start from the end to allow in-place expansion.
-            auto sourceValue = data + (i * parquetTypeLength);
+            auto sourceValue = bytes + (i * parquetTypeLength);
             int128_t value = *sourceValue >= 0 ? 0 : -1;
             memcpy(
                 reinterpret_cast<uint8_t*>(&value) + veloxTypeLength -
@@ -764,6 +768,12 @@ void PageReader::skip(int64_t numRows) {
   }
   auto toSkip = numRows;
   if (firstUnvisited_ + numRows >= rowOfPage_ + numRowsInPage_) {
+    if (isTopLevel_) {
+      // The target row is past the current page. Defer seeking until a row is
+      // accessed so that pages with no accessed rows are not decompressed.
+      firstUnvisited_ += numRows;
+      return;
+    }
     seekToPage(firstUnvisited_ + numRows);
     if (hasChunkRepDefs_) {
       numLeafNullsConsumed_ = rowOfPage_;
@@ -849,9 +859,13 @@ void PageReader::readNullsOnly(int64_t numValues, BufferPtr& buffer) {
   nullConcatenation_.reset(buffer);
   while (toRead) {
     auto availableOnPage = rowOfPage_ + numRowsInPage_ - firstUnvisited_;
-    if (!availableOnPage) {
+    if (availableOnPage <= 0) {
       seekToPage(firstUnvisited_);
-      availableOnPage = numRowsInPage_;
+      // A deferred skip may leave the position inside the page.
+      if (firstUnvisited_ > rowOfPage_) {
+        skipNulls(firstUnvisited_ - rowOfPage_);
+      }
+      availableOnPage = rowOfPage_ + numRowsInPage_ - firstUnvisited_;
     }
     auto numRead = std::min(availableOnPage, toRead);
     auto nulls = readNulls(numRead, nullsInReadRange_);
@@ -907,8 +921,12 @@ bool PageReader::rowsForPage(
   // Check if the first row to go to is in the current page. If not, seek to the
   // page that contains the row.
   auto rowZero = visitBase_ + visitorRows_[currentVisitorRow_];
+  bool seeked = false;
   if (rowZero >= rowOfPage_ + numRowsInPage_) {
     seekToPage(rowZero);
+    seeked = true;
+    // The decoders are positioned at the first row of the new page.
+    firstUnvisited_ = rowOfPage_;
     if (hasChunkRepDefs_) {
       numLeafNullsConsumed_ = rowOfPage_;
     }
@@ -957,9 +975,11 @@ bool PageReader::rowsForPage(
     assert(it != rangeLeft.begin());
     numToVisit = it - (visitorRows_ + currentVisitorRow_);
   }
-  // If the page did not change and this is the first call, we can return a view
-  // on the original visitor rows.
-  if (rowOfPage_ == initialRowOfPage_ && currentVisitorRow_ == 0) {
+  // If this is the first call and the decoders are positioned at 'visitBase_',
+  // we can return a view on the original visitor rows.
+  if (currentVisitorRow_ == 0 &&
+      (seeked ? rowOfPage_ == visitBase_
+              : rowOfPage_ == initialRowOfPage_)) {
     nulls =
         readNulls(visitorRows_[numToVisit - 1] + 1, reader.nullsInReadRange());
     rowNumberBias_ = 0;
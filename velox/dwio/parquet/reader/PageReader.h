@@ -42,7 +42,8 @@ class PageReader {
       ParquetTypeWithIdPtr fileType,
       common::CompressionKind codec,
       int64_t chunkSize,
-      const tz::TimeZone* sessionTimezone)
+      const tz::TimeZone* sessionTimezone,
+      dwio::common::ColumnReaderStatistics* stats = nullptr)
       : pool_(pool),
         inputStream_(std::move(stream)),
         type_(std::move(fileType)),
@@ -52,7 +53,8 @@ class PageReader {
         codec_(codec),
         chunkSize_(chunkSize),
         nullConcatenation_(pool_),
-        sessionTimezone_(sessionTimezone) {
+        sessionTimezone_(sessionTimezone),
+        stats_(stats) {
     type_->makeLevelInfo(leafInfo_);
   }
 
@@ -73,7 +75,10 @@ class PageReader {
         nullConcatenation_(pool_),
         sessionTimezone_(sessionTimezone) {}
 
-  /// Advances 'numRows' top level rows.
+  /// Advances 'numRows' top level rows. For a top level column, a skip that
+  /// ends past the current page only records the new position. The page
+  /// containing it is located, decompressed and decoded on the next access,
+  /// so that pages none of whose rows are read are never decompressed.
   void skip(int64_t numRows);
 
   /// Decodes repdefs for 'numTopLevelRows'. Use getLengthsAndNulls()
@@ -202,7 +207,20 @@ class PageReader {
 
   void prepareDataPageV1(const thrift::PageHeader& pageHeader, int64_t row);
   void prepareDataPageV2(const thrift::PageHeader& pageHeader, int64_t row);
-  void prepareDictionary(const thrift::PageHeader& pageHeader);
+
+  // Retains the encoded bytes of the dictionary page described by
+  // 'pageHeader'. The dictionary is decompressed and decoded by
+  // loadDictionary() when the first dictionary encoded data page is read.
+  void deferDictionary(const thrift::PageHeader& pageHeader);
+
+  // Decodes the dictionary retained by deferDictionary() if 'encoding' is a
+  // dictionary encoding and the dictionary is not yet loaded.
+  void loadDictionary(thrift::Encoding::type encoding);
+
+  // Decodes the dictionary from the uncompressed page contents at 'data'.
+  void prepareDictionary(
+      const thrift::PageHeader& pageHeader,
+      const char* data);
   void makeDecoder();
 
   // For a non-top level leaf, reads the defs and sets 'leafNulls_' and
@@ -451,6 +469,12 @@ class PageReader {
   dwio::common::DictionaryValues dictionary_;
   thrift::Encoding::type dictionaryEncoding_;
 
+  // Header of a dictionary page that has been read but not yet decoded.
+  std::optional<thrift::PageHeader> pendingDictionaryHeader_;
+
+  // Encoded bytes of the page in 'pendingDictionaryHeader_'.
+  BufferPtr pendingDictionaryPage_;
+
   // Offset of current page's header from start of ColumnChunk.
   uint64_t pageStart_{0};
 
@@ -504,6 +528,10 @@ class PageReader {
 
   const tz::TimeZone* sessionTimezone_{nullptr};
 
+  // Column reader statistics to update with skipped page counts. nullptr if
+  // not tracked.
+  dwio::common::ColumnReaderStatistics* const stats_{nullptr};
+
   // Decoders. Only one will be set at a time.
   std::unique_ptr<dwio::common::DirectDecoder<true>> directDecoder_;
   std::unique_ptr<RleBpDataDecoder> dictionaryIdDecoder_;
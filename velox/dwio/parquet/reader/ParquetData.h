@@ -63,8 +63,10 @@ class ParquetData : public dwio::common::FormatData {
       const std::shared_ptr<const dwio::common::TypeWithId>& type,
       const FileMetaDataPtr fileMetadataPtr,
       memory::MemoryPool& pool,
+      dwio::common::ColumnReaderStatistics& stats,
       const tz::TimeZone* sessionTimezone)
       : pool_(pool),
+        stats_(stats),
         type_(std::static_pointer_cast<const ParquetTypeWithId>(type)),
         fileMetaDataPtr_(fileMetadataPtr),
         maxDefine_(type_->maxDefine_),
@@ -210,6 +212,7 @@ class ParquetData : public dwio::common::FormatData {
 
  protected:
   memory::MemoryPool& pool_;
+  dwio::common::ColumnReaderStatistics& stats_;
   std::shared_ptr<const ParquetTypeWithId> type_;
   const FileMetaDataPtr fileMetaDataPtr_;
   // Streams for this column in each of 'rowGroups_'. Will be created on or
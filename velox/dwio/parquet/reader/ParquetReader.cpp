@@ -1186,6 +1186,8 @@ class ParquetRowReader::Impl {
   void updateRuntimeStats(dwio::common::RuntimeStatistics& stats) const {
     stats.skippedStrides += skippedStrides_;
     stats.processedStrides += rowGroupIds_.size();
+    stats.columnReaderStatistics.skippedPages +=
+        columnReaderStats_.skippedPages;
   }
 
   void resetFilterCaches() {
@@ -1143,6 +1143,71 @@ TEST_F(ParquetReaderTest, readDifferentEncodingsWithFilter) {
       expected);
 }
 
+TEST_F(ParquetReaderTest, skipPagesWithoutSelectedRows) {
+  constexpr int32_t kSize = 10'000;
+  auto data = makeRowVector(
+      {"c0", "c1", "c2", "c3"},
+      {
+          makeFlatVector<int64_t>(kSize, [](auto row) { return row; }),
+          makeFlatVector<int64_t>(kSize, [](auto row) { return row * 3; }),
+          makeFlatVector<std::string>(
+              kSize, [](auto row) { return fmt::format("s{}", row % 100); }),
+          makeFlatVector<int64_t>(
+              kSize, [](auto row) { return row; }, nullEvery(7)),
+      });
+  auto rowType = asRowType(data->type());
+  auto filePath = fmt::format("{}/pages.parquet", tempPath_->getPath());
+  WriterOptions options;
+  options.memoryPool = rootPool_.get();
+  // Every write batch fills a page, so each column has 10 pages of 1'000 rows.
+  options.batchSize = 1'000;
+  options.dataPageSize = 1;
+  auto writer =
+      std::make_unique<Writer>(createSink(filePath), options, rowType);
+  writer->write(data);
+  writer->close();
+
+  // Reads the rows where 'c0' is in 'rows' and returns the number of skipped
+  // pages.
+  auto readAndCountSkippedPages = [&](const std::vector<int64_t>& rows,
+                                      const RowVectorPtr& expected) {
+    dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+    auto reader = createReader(filePath, readerOptions);
+    auto scanSpec = makeScanSpec(rowType);
+    scanSpec->getOrCreateChild(Subfield("c0"))->setFilter(exec::in(rows));
+    auto rowReaderOpts = getReaderOpts(rowType);
+    rowReaderOpts.setScanSpec(scanSpec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    assertReadWithReaderAndExpected(rowType, *rowReader, expected, *leafPool_);
+    dwio::common::RuntimeStatistics stats;
+    rowReader->updateRuntimeStats(stats);
+    return stats.columnReaderStatistics.skippedPages;
+  };
+
+  // Pages 0 to 8 of 'c1', 'c2' and 'c3' are neither decompressed nor decoded.
+  auto expected = makeRowVector(
+      {"c0", "c1", "c2", "c3"},
+      {
+          makeFlatVector<int64_t>({9'000}),
+          makeFlatVector<int64_t>({27'000}),
+          makeFlatVector<std::string>({"s0"}),
+          makeFlatVector<int64_t>({9'000}),
+      });
+  EXPECT_EQ(readAndCountSkippedPages({9'000}, expected), 3 * 9);
+
+  // The skips before rows 2'499 and 9'000 both cross pages with nulls. Pages
+  // 0, 1 and 3 to 8 are skipped. Row 2'499 of 'c3' is null.
+  expected = makeRowVector(
+      {"c0", "c1", "c2", "c3"},
+      {
+          makeFlatVector<int64_t>({2'499, 9'000}),
+          makeFlatVector<int64_t>({7'497, 27'000}),
+          makeFlatVector<std::string>({"s99", "s0"}),
+          makeNullableFlatVector<int64_t>({std::nullopt, 9'000}),
+      });
+  EXPECT_EQ(readAndCountSkippedPages({2'499, 9'000}, expected), 3 * 8);
+}
+
 // This test is to verify filterRowGroups() doesn't throw the fileOffset Velox
 // check failure
 TEST_F(ParquetReaderTest, filterRowGroups) {
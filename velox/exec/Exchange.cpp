@@ -30,6 +30,11 @@ std::unique_ptr<VectorSerde::Options> getVectorSerdeOptions(
       : std::make_unique<VectorSerde::Options>();
   options->compressionKind =
       common::stringToCompressionKind(queryConfig.shuffleCompressionKind());
+  if (kind == VectorSerde::Kind::kPresto) {
+    static_cast<serializer::presto::PrestoVectorSerde::PrestoOptions*>(
+        options.get())
+        ->zeroCopy = queryConfig.exchangeZeroCopyDeserializationEnabled();
+  }
   return options;
 }
 } // namespace
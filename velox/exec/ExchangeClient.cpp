@@ -15,6 +15,8 @@
  */
 #include "velox/exec/ExchangeClient.h"
 
+#include <numeric>
+
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/StatsReporter.h"
 
@@ -110,6 +112,30 @@ folly::F14FastMap<std::string, RuntimeMetric> ExchangeClient::stats() const {
     }
   }
 
+  const auto addSourceValue = [&](const std::string& name,
+                                  int64_t value,
+                                  RuntimeCounter::Unit unit) {
+    auto it = stats.find(name);
+    if (it == stats.end()) {
+      it = stats.emplace(name, RuntimeMetric(unit)).first;
+    }
+    it->second.addValue(value);
+  };
+  for (const auto& [source, timing] : sourceTimings_) {
+    addSourceValue(
+        "sourceRequestWallNanos",
+        timing.requestTimeUs * 1'000,
+        RuntimeCounter::Unit::kNanos);
+    addSourceValue(
+        "sourceRequestLatencyNanos",
+        static_cast<int64_t>(timing.latencyUs * 1'000),
+        RuntimeCounter::Unit::kNanos);
+    addSourceValue(
+        "sourceThroughputBytesPerSec",
+        timing.bytes * 1'000'000 / std::max<int64_t>(1, timing.requestTimeUs),
+        RuntimeCounter::Unit::kBytes);
+  }
+
   stats["peakBytes"] =
       RuntimeMetric(queue_->peakBytes(), RuntimeCounter::Unit::kBytes);
   stats["numReceivedPages"] = RuntimeMetric(queue_->receivedPages());
@@ -169,9 +195,10 @@ void ExchangeClient::request(std::vector<RequestSpec>&& requestSpecs) {
     std::move(future)
         .via(executor_)
         .thenValue(
-            [self, spec = std::move(spec), sendTimeMs = getCurrentTimeMs()](
+            [self, spec = std::move(spec), sendTimeUs = getCurrentTimeMicro()](
                 ExchangeSource::Response&& response) {
-              const auto requestTimeMs = getCurrentTimeMs() - sendTimeMs;
+              const auto requestTimeUs = getCurrentTimeMicro() - sendTimeUs;
+              const auto requestTimeMs = requestTimeUs / 1'000;
               if (spec.maxBytes == 0) {
                 RECORD_HISTOGRAM_METRIC_VALUE(
                     kMetricExchangeDataSizeTimeMs, requestTimeMs);
@@ -190,6 +217,10 @@ void ExchangeClient::request(std::vector<RequestSpec>&& requestSpecs) {
               std::shared_ptr<ExchangeSource> currentSource = spec.source;
               {
                 std::lock_guard<std::mutex> l(self->queue_->mutex());
+                if (spec.maxBytes > 0) {
+                  self->recordDataRequestLocked(
+                      spec.source.get(), response.bytes, requestTimeUs);
+                }
                 if (self->closed_) {
                   return;
                 }
@@ -241,24 +272,28 @@ ExchangeClient::pickSourcesToRequestLocked() {
   }
   int64_t availableSpace =
       maxQueuedBytes_ - queue_->totalBytes() - totalPendingBytes_;
-  while (availableSpace > 0 && !producingSources_.empty()) {
-    auto& source = producingSources_.front().source;
-    int64_t requestBytes = 0;
-    for (auto bytes : producingSources_.front().remainingBytes) {
-      availableSpace -= bytes;
-      if (availableSpace < 0) {
+  if (adaptiveFetchSizing_) {
+    pickProducingSourcesAdaptiveLocked(availableSpace, requestSpecs);
+  } else {
+    while (availableSpace > 0 && !producingSources_.empty()) {
+      auto& source = producingSources_.front().source;
+      int64_t requestBytes = 0;
+      for (auto bytes : producingSources_.front().remainingBytes) {
+        availableSpace -= bytes;
+        if (availableSpace < 0) {
+          break;
+        }
+        requestBytes += bytes;
+      }
+      if (requestBytes == 0) {
+        VELOX_CHECK_LT(availableSpace, 0);
         break;
       }
-      requestBytes += bytes;
+      VELOX_CHECK(source->shouldRequestLocked());
+      requestSpecs.push_back({std::move(source), requestBytes});
+      producingSources_.pop();
+      totalPendingBytes_ += requestBytes;
     }
-    if (requestBytes == 0) {
-      VELOX_CHECK_LT(availableSpace, 0);
-      break;
-    }
-    VELOX_CHECK(source->shouldRequestLocked());
-    requestSpecs.push_back({std::move(source), requestBytes});
-    producingSources_.pop();
-    totalPendingBytes_ += requestBytes;
   }
 
   if ((queue_->totalBytes() + totalPendingBytes_ < minOutputBatchBytes_) &&
@@ -283,6 +318,103 @@ ExchangeClient::pickSourcesToRequestLocked() {
   return requestSpecs;
 }
 
+void ExchangeClient::pickProducingSourcesAdaptiveLocked(
+    int64_t availableSpace,
+    std::vector<RequestSpec>& requestSpecs) {
+  if (availableSpace <= 0 || producingSources_.empty()) {
+    return;
+  }
+  std::vector<ProducingSource> candidates;
+  candidates.reserve(producingSources_.size());
+  while (!producingSources_.empty()) {
+    candidates.push_back(std::move(producingSources_.front()));
+    producingSources_.pop();
+  }
+
+  // Sources without timing yet are assumed to be as fast as the average
+  // source. A source that returned no data in its recent requests keeps a
+  // small share so that it is still requested.
+  std::vector<double> rates(candidates.size(), -1);
+  double knownRateSum = 0;
+  int32_t numKnown = 0;
+  for (auto i = 0; i < candidates.size(); ++i) {
+    auto it = sourceTimings_.find(candidates[i].source.get());
+    if (it != sourceTimings_.end()) {
+      rates[i] = it->second.bytesPerUs;
+      knownRateSum += rates[i];
+      ++numKnown;
+    }
+  }
+  const double defaultRate = numKnown > 0 ? knownRateSum / numKnown : 1;
+  const double minRate = std::max(defaultRate / 100, 1e-6);
+  double rateSum = 0;
+  for (auto& rate : rates) {
+    rate = std::max(rate < 0 ? defaultRate : rate, minRate);
+    rateSum += rate;
+  }
+
+  // Slowest first. Sources of the same speed stay in FIFO order.
+  std::vector<int32_t> order(candidates.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(
+      order.begin(), order.end(), [&](int32_t left, int32_t right) {
+        return rates[left] < rates[right];
+      });
+
+  std::vector<bool> requested(candidates.size(), false);
+  for (auto i : order) {
+    auto& candidate = candidates[i];
+    if (availableSpace <= 0 ||
+        candidate.remainingBytes.at(0) > availableSpace) {
+      break;
+    }
+    // The space not used by the sources before goes to the ones after.
+    const auto share = std::min(
+        availableSpace,
+        static_cast<int64_t>(availableSpace * (rates[i] / rateSum)));
+    rateSum -= rates[i];
+    int64_t requestBytes = 0;
+    for (auto bytes : candidate.remainingBytes) {
+      if (requestBytes > 0 && requestBytes + bytes > share) {
+        break;
+      }
+      requestBytes += bytes;
+    }
+    VELOX_CHECK(candidate.source->shouldRequestLocked());
+    requestSpecs.push_back({std::move(candidate.source), requestBytes});
+    requested[i] = true;
+    availableSpace -= requestBytes;
+    totalPendingBytes_ += requestBytes;
+  }
+
+  for (auto i = 0; i < candidates.size(); ++i) {
+    if (!requested[i]) {
+      producingSources_.push(std::move(candidates[i]));
+    }
+  }
+}
+
+void ExchangeClient::recordDataRequestLocked(
+    const ExchangeSource* source,
+    int64_t bytes,
+    int64_t requestTimeUs) {
+  const double bytesPerUs =
+      static_cast<double>(bytes) / std::max<int64_t>(1, requestTimeUs);
+  auto& timing = sourceTimings_[source];
+  if (timing.numRequests == 0) {
+    timing.bytesPerUs = bytesPerUs;
+    timing.latencyUs = requestTimeUs;
+  } else {
+    timing.bytesPerUs =
+        kTimingDecay * bytesPerUs + (1 - kTimingDecay) * timing.bytesPerUs;
+    timing.latencyUs =
+        kTimingDecay * requestTimeUs + (1 - kTimingDecay) * timing.latencyUs;
+  }
+  ++timing.numRequests;
+  timing.bytes += bytes;
+  timing.requestTimeUs += requestTimeUs;
+}
+
 ExchangeClient::~ExchangeClient() {
   close();
 }
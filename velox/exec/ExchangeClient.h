@@ -36,11 +36,13 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
       uint64_t minOutputBatchBytes,
       memory::MemoryPool* pool,
       folly::Executor* executor,
-      int32_t requestDataSizesMaxWaitSec = 10)
+      int32_t requestDataSizesMaxWaitSec = 10,
+      bool adaptiveFetchSizing = false)
       : taskId_{std::move(taskId)},
         destination_(destination),
         maxQueuedBytes_{maxQueuedBytes},
         kRequestDataSizesMaxWaitSec_{requestDataSizesMaxWaitSec},
+        adaptiveFetchSizing_{adaptiveFetchSizing},
         pool_(pool),
         executor_(executor),
         queue_(std::make_shared<ExchangeQueue>(
@@ -87,7 +89,9 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
 
   // Returns runtime statistics aggregated across all of the exchange sources.
   // ExchangeClient is expected to report background CPU time by including a
-  // runtime metric named ExchangeClient::kBackgroundCpuTimeMs.
+  // runtime metric named ExchangeClient::kBackgroundCpuTimeMs. The timing of
+  // the data requests is reported with one value per source, so that min and
+  // max show the fastest and the slowest source.
   folly::F14FastMap<std::string, RuntimeMetric> stats() const;
 
   const std::shared_ptr<ExchangeQueue>& queue() const {
@@ -131,8 +135,35 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
     std::vector<int64_t> remainingBytes;
   };
 
+  // Timing of the data requests to one source.
+  struct SourceTiming {
+    int64_t numRequests{0};
+    int64_t bytes{0};
+    int64_t requestTimeUs{0};
+    // Exponential moving averages over the recent data requests.
+    double bytesPerUs{0};
+    double latencyUs{0};
+  };
+
+  // Weight of the latest request in the moving averages of SourceTiming.
+  static constexpr double kTimingDecay = 0.3;
+
   std::vector<RequestSpec> pickSourcesToRequestLocked();
 
+  // Requests data from producing sources in 'availableSpace' bytes. Each
+  // source gets a share of the space proportional to its throughput. The
+  // slowest sources are requested first, so that their longer requests start
+  // early, and the space they do not use goes to the faster sources. The
+  // first page of a source is requested even if it exceeds the share.
+  void pickProducingSourcesAdaptiveLocked(
+      int64_t availableSpace,
+      std::vector<RequestSpec>& requestSpecs);
+
+  void recordDataRequestLocked(
+      const ExchangeSource* source,
+      int64_t bytes,
+      int64_t requestTimeUs);
+
   void request(std::vector<RequestSpec>&& requestSpecs);
 
   // Handy for ad-hoc logging.
@@ -140,6 +171,10 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
   const int destination_;
   const int64_t maxQueuedBytes_;
   const std::chrono::seconds kRequestDataSizesMaxWaitSec_;
+  // If true, request sizes follow the throughput of the sources. Otherwise,
+  // sources are requested in FIFO order for all the data they have as long
+  // as it fits.
+  const bool adaptiveFetchSizing_;
 
   memory::MemoryPool* const pool_;
   folly::Executor* const executor_;
@@ -161,6 +196,8 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
   std::queue<ProducingSource> producingSources_;
   // A queue of sources that returned empty response from the latest request.
   std::queue<std::shared_ptr<ExchangeSource>> emptySources_;
+
+  folly::F14FastMap<const ExchangeSource*, SourceTiming> sourceTimings_;
 };
 
 } // namespace facebook::velox::exec
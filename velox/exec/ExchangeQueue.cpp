@@ -47,7 +47,14 @@ SerializedPage::~SerializedPage() {
 }
 
 std::unique_ptr<ByteInputStream> SerializedPage::prepareStreamForDeserialize() {
-  return std::make_unique<BufferInputStream>(std::move(ranges_));
+  // The memory of a page with a destruction callback may be freed by the
+  // callback, so it can only be referenced while the page is alive.
+  std::shared_ptr<folly::IOBuf> memoryOwner;
+  if (onDestructionCb_ == nullptr) {
+    memoryOwner = iobuf_->clone();
+  }
+  return std::make_unique<BufferInputStream>(
+      std::move(ranges_), std::move(memoryOwner));
 }
 
 void ExchangeQueue::noMoreSources() {
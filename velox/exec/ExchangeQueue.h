@@ -41,7 +41,9 @@ class SerializedPage {
   }
 
   /// Makes 'input' ready for deserializing 'this' with
-  /// VectorStreamGroup::read().
+  /// VectorStreamGroup::read(). Unless the page has a destruction callback,
+  /// the returned stream shares ownership of the page memory, so that
+  /// deserialized vectors can reference it after the page is destroyed.
   std::unique_ptr<ByteInputStream> prepareStreamForDeserialize();
 
   std::unique_ptr<folly::IOBuf> getIOBuf() const {
@@ -73,13 +73,8 @@ void HashPartitionFunction::init(
   }
 }
 
-std::optional<uint32_t> HashPartitionFunction::partition(
-    const RowVector& input,
-    std::vector<uint32_t>& partitions) {
-  if (hashers_.empty()) {
-    return 0u;
-  }
-
+void HashPartitionFunction::computeHashes(const RowVector& input) {
+  VELOX_DCHECK(!hashers_.empty());
   const auto size = input.size();
   rows_.resize(size);
   rows_.setAll();
@@ -94,7 +89,26 @@ std::optional<uint32_t> HashPartitionFunction::partition(
       hashers_[i]->hashPrecomputed(rows_, i > 0, hashes_);
     }
   }
+}
 
+uint32_t HashPartitionFunction::partitionOf(uint64_t hash) const {
+  if (hashBitRange_.has_value()) {
+    return hashBitRange_->partition(
+        localExchange_ ? localExchangeHash(hash) : hash);
+  }
+  return (localExchange_ ? localExchangeHash(hash) : hash) % numPartitions_;
+}
+
+std::optional<uint32_t> HashPartitionFunction::partition(
+    const RowVector& input,
+    std::vector<uint32_t>& partitions) {
+  if (hashers_.empty()) {
+    return 0u;
+  }
+
+  computeHashes(input);
+
+  const auto size = input.size();
   partitions.resize(size);
   if (hashBitRange_.has_value()) {
     if (localExchange_) {
@@ -52,6 +52,17 @@ class HashPartitionFunction : public core::PartitionFunction {
     return numPartitions_;
   }
 
+ protected:
+  /// Computes the hash of the partition keys of each row of 'input' into
+  /// 'hashes_'. Requires non-empty partition keys.
+  void computeHashes(const RowVector& input);
+
+  /// Returns the partition for a row with key hash 'hash'.
+  uint32_t partitionOf(uint64_t hash) const;
+
+  // Key hashes of the rows of the last input. Filled by computeHashes().
+  raw_vector<uint64_t> hashes_;
+
  private:
   void init(
       const RowTypePtr& inputType,
@@ -65,7 +76,6 @@ class HashPartitionFunction : public core::PartitionFunction {
 
   // Reusable memory.
   SelectivityVector rows_;
-  raw_vector<uint64_t> hashes_;
 };
 
 /// Factory class to create HashPartitionFunction
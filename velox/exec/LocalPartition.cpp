@@ -30,27 +30,40 @@ void notify(std::vector<ContinuePromise>& promises) {
 bool LocalExchangeMemoryManager::increaseMemoryUsage(
     ContinueFuture* future,
     int64_t added) {
-  std::lock_guard<std::mutex> l(mutex_);
-  bufferedBytes_ += added;
-
-  if (bufferedBytes_ >= maxBufferSize_) {
-    promises_.emplace_back("LocalExchangeMemoryManager::updateMemoryUsage");
-    *future = promises_.back().getSemiFuture();
-    return true;
+  if (bufferedBytes_.fetch_add(added) + added < maxBufferSize_) {
+    return false;
   }
 
-  return false;
+  std::lock_guard<std::mutex> l(mutex_);
+  promises_.emplace_back("LocalExchangeMemoryManager::updateMemoryUsage");
+  numPromises_ = promises_.size();
+  // A concurrent decreaseMemoryUsage() may have gone below the limit before
+  // it could see the promise. Either it sees the promise or this sees its
+  // decrease.
+  if (bufferedBytes_ < maxBufferSize_) {
+    promises_.back().setValue();
+    promises_.pop_back();
+    numPromises_ = promises_.size();
+    return false;
+  }
+  *future = promises_.back().getSemiFuture();
+  return true;
 }
 
 std::vector<ContinuePromise> LocalExchangeMemoryManager::decreaseMemoryUsage(
     int64_t removed) {
+  bufferedBytes_ -= removed;
+  if (numPromises_ == 0) {
+    return {};
+  }
+
   std::vector<ContinuePromise> promises;
   {
     std::lock_guard<std::mutex> l(mutex_);
-    bufferedBytes_ -= removed;
-
     if (bufferedBytes_ < maxBufferSize_) {
       promises = std::move(promises_);
+      promises_.clear();
+      numPromises_ = 0;
     }
   }
   return promises;
@@ -82,28 +95,32 @@ RowVectorPtr LocalExchangeVectorPool::pop() {
 }
 
 void LocalExchangeQueue::addProducer() {
-  queue_.withWLock([&](auto& /*queue*/) {
-    VELOX_CHECK(!noMoreProducers_, "addProducer called after noMoreProducers");
-    ++pendingProducers_;
-  });
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK(!noMoreProducers_, "addProducer called after noMoreProducers");
+  ++pendingProducers_;
 }
 
 void LocalExchangeQueue::noMoreProducers() {
   std::vector<ContinuePromise> consumerPromises;
-  queue_.withWLock([&](auto& queue) {
+  {
+    std::lock_guard<std::mutex> l(mutex_);
     VELOX_CHECK(!noMoreProducers_, "noMoreProducers can be called only once");
     noMoreProducers_ = true;
     if (pendingProducers_ == 0) {
       // No more data will be produced.
+      producersDone_ = true;
       consumerPromises = std::move(consumerPromises_);
+      consumerPromises_.clear();
+      numConsumerPromises_ = 0;
     }
-  });
+  }
   notify(consumerPromises);
 }
 
 void LocalExchangeQueue::drain() {
   std::vector<ContinuePromise> consumerPromises;
-  queue_.withWLock([&](auto& queue) {
+  {
+    std::lock_guard<std::mutex> l(mutex_);
     VELOX_CHECK(!closed_, "Queue is closed");
     ++drainedProducers_;
     VELOX_CHECK_LE(drainedProducers_, pendingProducers_);
@@ -111,34 +128,60 @@ void LocalExchangeQueue::drain() {
       return;
     }
     consumerPromises = std::move(consumerPromises_);
-  });
+    consumerPromises_.clear();
+    numConsumerPromises_ = 0;
+  }
   notify(consumerPromises);
 }
 
+std::vector<ContinuePromise> LocalExchangeQueue::takeConsumerPromises() {
+  // Pairs with the fence in next(): either the consumer sees the enqueued
+  // data or this sees the consumer's promise.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (numConsumerPromises_ == 0) {
+    return {};
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  auto consumerPromises = std::move(consumerPromises_);
+  consumerPromises_.clear();
+  numConsumerPromises_ = 0;
+  return consumerPromises;
+}
+
+std::vector<ContinuePromise> LocalExchangeQueue::clearQueue() {
+  int64_t freedBytes{0};
+  Entry entry;
+  while (queue_.try_dequeue(entry)) {
+    freedBytes += entry.second;
+  }
+  if (freedBytes == 0) {
+    return {};
+  }
+  return memoryManager_->decreaseMemoryUsage(freedBytes);
+}
+
 BlockingReason LocalExchangeQueue::enqueue(
     RowVectorPtr input,
     int64_t inputBytes,
     ContinueFuture* future) {
-  std::vector<ContinuePromise> consumerPromises;
-  bool blockedOnConsumer = false;
-  const bool isClosed = queue_.withWLock([&](auto& queue) {
-    if (closed_) {
-      return true;
-    }
-    queue.emplace(std::move(input), inputBytes);
-    consumerPromises = std::move(consumerPromises_);
-
-    if (memoryManager_->increaseMemoryUsage(future, inputBytes)) {
-      blockedOnConsumer = true;
-    }
+  if (closed_) {
+    return BlockingReason::kNotBlocked;
+  }
 
-    return false;
-  });
+  // Account for the memory before the data becomes visible to consumers.
+  const bool blockedOnConsumer =
+      memoryManager_->increaseMemoryUsage(future, inputBytes);
+  queue_.enqueue(Entry(std::move(input), inputBytes));
 
-  if (isClosed) {
+  if (closed_) {
+    // Raced with close(), which may have cleared the queue before the data
+    // was added.
+    auto memoryPromises = clearQueue();
+    notify(memoryPromises);
     return BlockingReason::kNotBlocked;
   }
 
+  auto consumerPromises = takeConsumerPromises();
   notify(consumerPromises);
 
   if (blockedOnConsumer) {
@@ -150,14 +193,18 @@ BlockingReason LocalExchangeQueue::enqueue(
 
 void LocalExchangeQueue::noMoreData() {
   std::vector<ContinuePromise> consumerPromises;
-  queue_.withWLock([&](auto& queue) {
+  {
+    std::lock_guard<std::mutex> l(mutex_);
     VELOX_CHECK_EQ(drainedProducers_, 0);
     VELOX_CHECK_GT(pendingProducers_, 0);
     --pendingProducers_;
     if (noMoreProducers_ && pendingProducers_ == 0) {
+      producersDone_ = true;
       consumerPromises = std::move(consumerPromises_);
+      consumerPromises_.clear();
+      numConsumerPromises_ = 0;
     }
-  });
+  }
   notify(consumerPromises);
 }
 
@@ -167,12 +214,14 @@ BlockingReason LocalExchangeQueue::next(
     RowVectorPtr* data,
     bool& drained) {
   drained = false;
-  int64_t size{0};
-  std::vector<ContinuePromise> memoryPromises;
-  const auto blockingReason = queue_.withWLock([&](auto& queue) {
-    *data = nullptr;
-    if (queue.empty()) {
-      if (isFinishedLocked(queue)) {
+  *data = nullptr;
+  Entry entry;
+  if (!queue_.try_dequeue(entry)) {
+    std::lock_guard<std::mutex> l(mutex_);
+    // The producers enqueue before they change their state under the mutex,
+    // so the data they produced before is visible here.
+    if (!queue_.try_dequeue(entry)) {
+      if (isFinished()) {
         return BlockingReason::kNotBlocked;
       }
       if (testAndClearDrainedLocked()) {
@@ -181,35 +230,25 @@ BlockingReason LocalExchangeQueue::next(
       }
 
       consumerPromises_.emplace_back("LocalExchangeQueue::next");
-      *future = consumerPromises_.back().getSemiFuture();
-
-      return BlockingReason::kWaitForProducer;
+      numConsumerPromises_ = consumerPromises_.size();
+      // Pairs with the fence in takeConsumerPromises().
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (!queue_.try_dequeue(entry)) {
+        *future = consumerPromises_.back().getSemiFuture();
+        return BlockingReason::kWaitForProducer;
+      }
+      consumerPromises_.back().setValue();
+      consumerPromises_.pop_back();
+      numConsumerPromises_ = consumerPromises_.size();
     }
-
-    std::tie(*data, size) = std::move(queue.front());
-    queue.pop();
-
-    memoryPromises = memoryManager_->decreaseMemoryUsage(size);
-    return BlockingReason::kNotBlocked;
-  });
-
-  notify(memoryPromises);
-  if (*data != nullptr) {
-    vectorPool_->push(*data, size);
-  }
-  return blockingReason;
-}
-
-bool LocalExchangeQueue::isFinishedLocked(const Queue& queue) const {
-  if (closed_) {
-    return true;
-  }
-
-  if (noMoreProducers_ && pendingProducers_ == 0 && queue.empty()) {
-    return true;
   }
 
-  return false;
+  int64_t size;
+  std::tie(*data, size) = std::move(entry);
+  auto memoryPromises = memoryManager_->decreaseMemoryUsage(size);
+  notify(memoryPromises);
+  vectorPool_->push(*data, size);
+  return BlockingReason::kNotBlocked;
 }
 
 bool LocalExchangeQueue::testAndClearDrainedLocked() {
@@ -222,32 +261,24 @@ bool LocalExchangeQueue::testAndClearDrainedLocked() {
   return true;
 }
 
-bool LocalExchangeQueue::isFinished() {
-  return queue_.withWLock([&](auto& queue) { return isFinishedLocked(queue); });
+bool LocalExchangeQueue::isFinished() const {
+  return closed_ || (producersDone_ && queue_.empty());
 }
 
 bool LocalExchangeQueue::testingProducersDone() const {
-  return queue_.withRLock(
-      [&](auto& queue) { return noMoreProducers_ && pendingProducers_ == 0; });
+  return producersDone_;
 }
 
 void LocalExchangeQueue::close() {
   std::vector<ContinuePromise> consumerPromises;
-  std::vector<ContinuePromise> memoryPromises;
-  queue_.withWLock([&](auto& queue) {
-    uint64_t freedBytes = 0;
-    while (!queue.empty()) {
-      freedBytes += queue.front().second;
-      queue.pop();
-    }
-
-    if (freedBytes) {
-      memoryPromises = memoryManager_->decreaseMemoryUsage(freedBytes);
-    }
-
-    consumerPromises = std::move(consumerPromises_);
+  {
+    std::lock_guard<std::mutex> l(mutex_);
     closed_ = true;
-  });
+    consumerPromises = std::move(consumerPromises_);
+    consumerPromises_.clear();
+    numConsumerPromises_ = 0;
+  }
+  auto memoryPromises = clearQueue();
   notify(consumerPromises);
   notify(memoryPromises);
 }
@@ -499,14 +530,33 @@ void LocalPartition::addInput(RowVectorPtr input) {
   }
 
   const auto numInput = input->size();
+  const auto* replicatedRows = partitionFunction_->replicatedRows();
   std::vector<vector_size_t> maxIndex(numPartitions_, 0);
-  for (auto i = 0; i < numInput; ++i) {
-    ++maxIndex[partitions_[i]];
+  if (replicatedRows == nullptr) {
+    for (auto i = 0; i < numInput; ++i) {
+      ++maxIndex[partitions_[i]];
+    }
+  } else {
+    for (auto i = 0; i < numInput; ++i) {
+      if (!replicatedRows->isValid(i)) {
+        ++maxIndex[partitions_[i]];
+      }
+    }
+    const auto numReplicated = replicatedRows->countSelected();
+    for (auto& numRows : maxIndex) {
+      numRows += numReplicated;
+    }
   }
   allocateIndexBuffers(maxIndex);
 
   std::fill(maxIndex.begin(), maxIndex.end(), 0);
   for (auto i = 0; i < numInput; ++i) {
+    if (replicatedRows != nullptr && replicatedRows->isValid(i)) {
+      for (auto partition = 0; partition < numPartitions_; ++partition) {
+        rawIndices_[partition][maxIndex[partition]++] = i;
+      }
+      continue;
+    }
     auto partition = partitions_[i];
     rawIndices_[partition][maxIndex[partition]] = i;
     ++maxIndex[partition];
@@ -15,13 +15,16 @@
  */
 #pragma once
 
+#include <folly/concurrency/UnboundedQueue.h>
+
 #include "velox/exec/Operator.h"
 #include "velox/exec/VectorHasher.h"
 
 namespace facebook::velox::exec {
 
 /// Keeps track of the total size in bytes of the data buffered in all
-/// LocalExchangeQueues.
+/// LocalExchangeQueues. The usage is updated without locking. The mutex is
+/// only taken to register or wake up producers blocked on the limit.
 class LocalExchangeMemoryManager {
  public:
   explicit LocalExchangeMemoryManager(int64_t maxBufferSize)
@@ -49,7 +52,10 @@ class LocalExchangeMemoryManager {
  private:
   const int64_t maxBufferSize_;
   std::mutex mutex_;
-  tsan_atomic<int64_t> bufferedBytes_{0};
+  std::atomic<int64_t> bufferedBytes_{0};
+  // The number of entries in 'promises_'. Lets decreaseMemoryUsage() skip
+  // the mutex when no producer is blocked.
+  std::atomic<int32_t> numPromises_{0};
   std::vector<ContinuePromise> promises_;
 };
 
@@ -77,6 +83,11 @@ class LocalExchangeVectorPool {
 /// must be called after all producers have been registered. A producer calls
 /// 'enqueue' multiple time to put the data and calls 'noMoreData' when done.
 /// Consumers call 'next' repeatedly to fetch the data.
+///
+/// The data is kept in a lock-free multi-producer/multi-consumer queue. The
+/// mutex is only taken by consumers that find the queue empty, by producers
+/// that need to wake up waiting consumers, and for the rare producer state
+/// changes.
 class LocalExchangeQueue {
  public:
   LocalExchangeQueue(
@@ -123,7 +134,7 @@ class LocalExchangeQueue {
       RowVectorPtr* data,
       bool& drained);
 
-  bool isFinished();
+  bool isFinished() const;
 
   /// Drop remaining data from the queue and notify consumers and producers if
   /// called before all the data has been processed. No-op otherwise.
@@ -139,29 +150,42 @@ class LocalExchangeQueue {
   bool testingProducersDone() const;
 
  private:
-  using Queue = std::queue<std::pair<RowVectorPtr, int64_t>>;
-
-  bool isFinishedLocked(const Queue& queue) const;
+  using Entry = std::pair<RowVectorPtr, int64_t>;
 
   bool testAndClearDrainedLocked();
 
+  // Returns the promises of the waiting consumers, if any.
+  std::vector<ContinuePromise> takeConsumerPromises();
+
+  // Removes all data from the queue and returns the promises of the producers
+  // to unblock.
+  std::vector<ContinuePromise> clearQueue();
+
   const std::shared_ptr<LocalExchangeMemoryManager> memoryManager_;
   const std::shared_ptr<LocalExchangeVectorPool> vectorPool_;
   const int partition_;
 
-  folly::Synchronized<Queue> queue_;
+  folly::UMPMCQueue<Entry, /*MayBlock=*/false> queue_;
+
+  // Protects the members below except for the atomics.
+  mutable std::mutex mutex_;
   // Satisfied when data becomes available or all producers report that they
   // finished producing, e.g. queue_ is not empty or noMoreProducers_ is true
   // and pendingProducers_ is zero.
   std::vector<ContinuePromise> consumerPromises_;
+  // The number of entries in 'consumerPromises_'. Lets producers skip the
+  // mutex when no consumer is waiting.
+  std::atomic<int32_t> numConsumerPromises_{0};
   int pendingProducers_{0};
   bool noMoreProducers_{false};
+  // True if 'noMoreProducers_' is set and 'pendingProducers_' is zero.
+  std::atomic<bool> producersDone_{false};
   // The number of drained producers when the task is under barrier processing.
   // If it equals to 'pendingProducers_', then the queue is drained. The
   // consumer receives the drained signal on the next call to 'next', and
   // 'drainedProducers_' is reset to zero.
   int drainedProducers_{0};
-  bool closed_{false};
+  std::atomic<bool> closed_{false};
 };
 
 /// Fetches data for a single partition produced by local exchange from
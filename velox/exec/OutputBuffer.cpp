@@ -92,15 +92,18 @@ void DestinationBuffer::Stats::recordEnqueue(const SerializedPage& data) {
 void DestinationBuffer::Stats::recordAcknowledge(const SerializedPage& data) {
   const auto numRows = data.numRows();
   VELOX_CHECK(numRows.has_value(), "SerializedPage's numRows must be valid");
-  const int64_t size = data.size();
-  bytesBuffered -= size;
+  recordAcknowledge(data.size(), numRows.value());
+}
+
+void DestinationBuffer::Stats::recordAcknowledge(int64_t bytes, int64_t rows) {
+  bytesBuffered -= bytes;
   VELOX_DCHECK_GE(bytesBuffered, 0, "bytesBuffered must be non-negative");
-  rowsBuffered -= numRows.value();
+  rowsBuffered -= rows;
   VELOX_DCHECK_GE(rowsBuffered, 0, "rowsBuffered must be non-negative");
   --pagesBuffered;
   VELOX_DCHECK_GE(pagesBuffered, 0, "pagesBuffered must be non-negative");
-  bytesSent += size;
-  rowsSent += numRows.value();
+  bytesSent += bytes;
+  rowsSent += rows;
   ++pagesSent;
 }
 
@@ -120,8 +123,8 @@ DestinationBuffer::Data DestinationBuffer::getData(
     loadData(arbitraryBuffer, maxBytes);
   }
 
-  if (sequence - sequence_ >= data_.size()) {
-    if (sequence - sequence_ > data_.size()) {
+  if (sequence - sequence_ >= numPages()) {
+    if (sequence - sequence_ > numPages()) {
       VLOG(1) << this << " Out of order get: " << sequence << " over "
               << sequence_ << " Setting second notify " << notifySequence_
               << " / " << sequence;
@@ -137,7 +140,7 @@ DestinationBuffer::Data DestinationBuffer::getData(
     }
     notify_ = std::move(notify);
     aliveCheck_ = std::move(activeCheck);
-    if (sequence - sequence_ > data_.size()) {
+    if (sequence - sequence_ > numPages()) {
       notifySequence_ = std::min(notifySequence_, sequence);
     } else {
       notifySequence_ = sequence;
@@ -150,15 +153,16 @@ DestinationBuffer::Data DestinationBuffer::getData(
   uint64_t resultBytes = 0;
   auto i = sequence - sequence_;
   if (maxBytes > 0) {
-    for (; i < data_.size(); ++i) {
+    for (; i < numPages(); ++i) {
       // nullptr is used as end marker
-      if (data_[i] == nullptr) {
-        VELOX_CHECK_EQ(i, data_.size() - 1, "null marker found in the middle");
+      if (isEndMarker(i)) {
+        VELOX_CHECK_EQ(i, numPages() - 1, "null marker found in the middle");
         data.push_back(nullptr);
         break;
       }
-      data.push_back(data_[i]->getIOBuf());
-      resultBytes += data_[i]->size();
+      const auto page = pageAt(i);
+      data.push_back(page->getIOBuf());
+      resultBytes += page->size();
       if (resultBytes >= maxBytes) {
         ++i;
         break;
@@ -167,14 +171,14 @@ DestinationBuffer::Data DestinationBuffer::getData(
   }
   bool atEnd = false;
   std::vector<int64_t> remainingBytes;
-  remainingBytes.reserve(data_.size() - i);
-  for (; i < data_.size(); ++i) {
-    if (data_[i] == nullptr) {
-      VELOX_CHECK_EQ(i, data_.size() - 1, "null marker found in the middle");
+  remainingBytes.reserve(numPages() - i);
+  for (; i < numPages(); ++i) {
+    if (isEndMarker(i)) {
+      VELOX_CHECK_EQ(i, numPages() - 1, "null marker found in the middle");
       atEnd = true;
       break;
     }
-    remainingBytes.push_back(data_[i]->size());
+    remainingBytes.push_back(pageBytes(i));
   }
   if (!atEnd && arbitraryBuffer) {
     arbitraryBuffer->getAvailablePageSizes(remainingBytes);
@@ -202,6 +206,11 @@ DataAvailable DestinationBuffer::getAndClearNotify() {
     VELOX_CHECK_NULL(aliveCheck_);
     return DataAvailable();
   }
+  if (unspilling_ && notifySequence_ - sequence_ < numSpilledPages()) {
+    // The readers of these pages are taken out. The fetch that reads them
+    // back answers this one.
+    return DataAvailable();
+  }
   DataAvailable result;
   result.callback = notify_;
   result.sequence = notifySequence_;
@@ -212,6 +221,20 @@ DataAvailable DestinationBuffer::getAndClearNotify() {
   return result;
 }
 
+void DestinationBuffer::deferGetData(
+    uint64_t maxBytes,
+    int64_t sequence,
+    DataAvailableCallback notify,
+    DataConsumerActiveCheckCallback activeCheck) {
+  VELOX_CHECK(unspilling_);
+  VELOX_CHECK_GE(
+      sequence, sequence_, "Get received for an already acknowledged item");
+  notify_ = std::move(notify);
+  aliveCheck_ = std::move(activeCheck);
+  notifySequence_ = sequence;
+  notifyMaxBytes_ = maxBytes;
+}
+
 void DestinationBuffer::clearNotify() {
   notify_ = nullptr;
   aliveCheck_ = nullptr;
@@ -221,7 +244,9 @@ void DestinationBuffer::clearNotify() {
 
 void DestinationBuffer::finish() {
   VELOX_CHECK_NULL(notify_, "notify must be cleared before finish");
-  VELOX_CHECK(data_.empty(), "data must be fetched before finish");
+  VELOX_CHECK(
+      data_.empty() && spilledPageSizes_.empty(),
+      "data must be fetched before finish");
   stats_.finished = true;
 }
 
@@ -267,9 +292,25 @@ std::vector<std::shared_ptr<SerializedPage>> DestinationBuffer::acknowledge(
   }
 
   VELOX_CHECK_LE(
-      numDeleted, data_.size(), "Ack received for a not yet produced item");
+      numDeleted, numPages(), "Ack received for a not yet produced item");
+
+  // Spilled pages are not counted in the buffered bytes of the output buffer,
+  // so they are not returned.
+  const auto numSpilledDeleted = std::min(numDeleted, numSpilledPages());
+  if (numSpilledDeleted > 0) {
+    for (auto i = 0; i < numSpilledDeleted; ++i) {
+      const auto [bytes, rows] = spilledPageSizes_[i];
+      stats_.recordAcknowledge(bytes, rows);
+    }
+    spilledPageSizes_.erase(
+        spilledPageSizes_.begin(),
+        spilledPageSizes_.begin() + numSpilledDeleted);
+    deleteSpilledPages(numSpilledDeleted);
+  }
+
+  const auto numDataDeleted = numDeleted - numSpilledDeleted;
   std::vector<std::shared_ptr<SerializedPage>> freed;
-  for (auto i = 0; i < numDeleted; ++i) {
+  for (auto i = 0; i < numDataDeleted; ++i) {
     if (data_[i] == nullptr) {
       VELOX_CHECK_EQ(i, data_.size() - 1, "null marker found in the middle");
       break;
@@ -277,13 +318,22 @@ std::vector<std::shared_ptr<SerializedPage>> DestinationBuffer::acknowledge(
     stats_.recordAcknowledge(*data_[i]);
     freed.push_back(std::move(data_[i]));
   }
-  data_.erase(data_.begin(), data_.begin() + numDeleted);
+  data_.erase(data_.begin(), data_.begin() + numDataDeleted);
   sequence_ += numDeleted;
   return freed;
 }
 
 std::vector<std::shared_ptr<SerializedPage>>
 DestinationBuffer::deleteResults() {
+  for (const auto& [bytes, rows] : spilledPageSizes_) {
+    stats_.recordAcknowledge(bytes, rows);
+  }
+  spilledPageSizes_.clear();
+  for (auto& reader : spillReaders_) {
+    reader->deleteAll();
+  }
+  spillReaders_.clear();
+
   std::vector<std::shared_ptr<SerializedPage>> freed;
   for (auto i = 0; i < data_.size(); ++i) {
     if (data_[i] == nullptr) {
@@ -297,13 +347,169 @@ DestinationBuffer::deleteResults() {
   return freed;
 }
 
+void DestinationBuffer::deleteSpilledPages(int64_t numPages) {
+  if (unspilling_) {
+    numDeferredSpillDeletes_ += numPages;
+    return;
+  }
+  while (numPages > 0) {
+    auto& reader = spillReaders_.front();
+    const auto numReaderPages = std::min<int64_t>(numPages, reader->numPages());
+    reader->deleteFront(numReaderPages);
+    numPages -= numReaderPages;
+    if (reader->empty()) {
+      spillReaders_.pop_front();
+    }
+  }
+}
+
+std::vector<std::shared_ptr<SerializedPage>> DestinationBuffer::startSpill() {
+  if (spilling_) {
+    return {};
+  }
+  // Keep the end marker in memory.
+  auto numPages = data_.size();
+  if (numPages > 0 && data_.back() == nullptr) {
+    --numPages;
+  }
+  if (numPages == 0) {
+    return {};
+  }
+  spilling_ = true;
+  spillSequence_ = sequence_ + numSpilledPages();
+  return {data_.begin(), data_.begin() + numPages};
+}
+
+void DestinationBuffer::finishSpill(
+    int64_t numPages,
+    SerializedPageSpiller::Result&& spillResult,
+    uint64_t readBufferSize,
+    memory::MemoryPool* pool,
+    folly::Synchronized<common::SpillStats>* stats) {
+  VELOX_CHECK(spilling_);
+  spilling_ = false;
+  auto reader = std::make_unique<SerializedPageSpillReader>(
+      std::move(spillResult), readBufferSize, pool, stats);
+  VELOX_CHECK_EQ(reader->numPages(), numPages);
+  // Dropping the acknowledged pages from 'reader' would read them back.
+  if (sequence_ + numSpilledPages() != spillSequence_) {
+    reader->deleteAll();
+    return;
+  }
+  for (auto i = 0; i < numPages; ++i) {
+    spilledPageSizes_.emplace_back(
+        data_[i]->size(), data_[i]->numRows().value());
+  }
+  spillReaders_.push_back(std::move(reader));
+  data_.erase(data_.begin(), data_.begin() + numPages);
+}
+
+void DestinationBuffer::abortSpill() {
+  VELOX_CHECK(spilling_);
+  spilling_ = false;
+}
+
+void DestinationBuffer::Unspill::load() {
+  auto index = lastPage;
+  for (auto& reader : readers) {
+    if (index < reader->numPages()) {
+      reader->at(index);
+      return;
+    }
+    reader->at(reader->numPages() - 1);
+    index -= reader->numPages();
+  }
+  VELOX_UNREACHABLE();
+}
+
+std::optional<DestinationBuffer::Unspill> DestinationBuffer::startUnspill(
+    uint64_t maxBytes,
+    int64_t sequence) {
+  VELOX_CHECK(!unspilling_);
+  const auto firstPage = sequence - sequence_;
+  if (maxBytes == 0 || firstPage < 0 || firstPage >= numSpilledPages()) {
+    return std::nullopt;
+  }
+  // The pages getData() returns.
+  auto lastPage = firstPage;
+  uint64_t bytes = pageBytes(lastPage);
+  while (bytes < maxBytes && lastPage + 1 < numSpilledPages()) {
+    bytes += pageBytes(++lastPage);
+  }
+  bool loaded{true};
+  for (auto i = firstPage; i <= lastPage; ++i) {
+    if (!isSpilledPageLoaded(i)) {
+      loaded = false;
+      break;
+    }
+  }
+  if (loaded) {
+    return std::nullopt;
+  }
+  unspilling_ = true;
+  Unspill unspill{std::move(spillReaders_), lastPage};
+  spillReaders_.clear();
+  return unspill;
+}
+
+void DestinationBuffer::finishUnspill(Unspill&& unspill) {
+  VELOX_CHECK(unspilling_);
+  unspilling_ = false;
+  // Readers of pages spilled in the meantime follow the ones taken out.
+  for (auto it = unspill.readers.rbegin(); it != unspill.readers.rend(); ++it) {
+    spillReaders_.push_front(std::move(*it));
+  }
+  deleteSpilledPages(std::exchange(numDeferredSpillDeletes_, 0));
+}
+
+int64_t DestinationBuffer::exclusiveBytes() const {
+  int64_t bytes{0};
+  for (const auto& page : data_) {
+    if (page != nullptr && page.use_count() == 1) {
+      bytes += page->size();
+    }
+  }
+  return bytes;
+}
+
+std::shared_ptr<SerializedPage> DestinationBuffer::pageAt(int64_t index) {
+  if (index < numSpilledPages()) {
+    for (auto& reader : spillReaders_) {
+      if (index < reader->numPages()) {
+        return reader->at(index);
+      }
+      index -= reader->numPages();
+    }
+    VELOX_UNREACHABLE();
+  }
+  return data_[index - numSpilledPages()];
+}
+
+bool DestinationBuffer::isSpilledPageLoaded(int64_t index) const {
+  for (const auto& reader : spillReaders_) {
+    if (index < reader->numPages()) {
+      return index < reader->numLoadedPages();
+    }
+    index -= reader->numPages();
+  }
+  VELOX_UNREACHABLE();
+}
+
+int64_t DestinationBuffer::pageBytes(int64_t index) const {
+  if (index < numSpilledPages()) {
+    return spilledPageSizes_[index].first;
+  }
+  return data_[index - numSpilledPages()]->size();
+}
+
 DestinationBuffer::Stats DestinationBuffer::stats() const {
   return stats_;
 }
 
 std::string DestinationBuffer::toString() {
   std::stringstream out;
-  out << "[available: " << data_.size() << ", " << "sequence: " << sequence_
+  out << "[available: " << data_.size() << ", "
+      << "spilled: " << numSpilledPages() << ", " << "sequence: " << sequence_
       << ", " << (notify_ ? "notify registered, " : "") << this << "]";
   return out.str();
 }
@@ -322,6 +528,38 @@ void releaseAfterAcknowledge(
   }
 }
 
+std::optional<common::SpillConfig> makeSpillConfig(Task* task) {
+  const auto& queryConfig = task->queryCtx()->queryConfig();
+  if (!queryConfig.spillEnabled() || !queryConfig.outputBufferSpillEnabled()) {
+    return std::nullopt;
+  }
+  if (task->spillDirectory().empty() && !task->hasCreateSpillDirectoryCb()) {
+    return std::nullopt;
+  }
+  return common::SpillConfig(
+      [task]() -> std::string_view {
+        return task->getOrCreateSpillDirectory();
+      },
+      [task](uint64_t bytes) {
+        task->queryCtx()->updateSpilledBytesAndCheckLimit(bytes);
+      },
+      "outputBuffer",
+      queryConfig.maxSpillFileSize(),
+      queryConfig.spillWriteBufferSize(),
+      queryConfig.spillReadBufferSize(),
+      task->queryCtx()->spillExecutor(),
+      queryConfig.minSpillableReservationPct(),
+      queryConfig.spillableReservationGrowthPct(),
+      queryConfig.spillStartPartitionBit(),
+      queryConfig.spillNumPartitionBits(),
+      queryConfig.maxSpillLevel(),
+      queryConfig.maxSpillRunRows(),
+      queryConfig.writerFlushThresholdBytes(),
+      queryConfig.spillCompressionKind(),
+      std::nullopt,
+      queryConfig.spillFileCreateConfig());
+}
+
 } // namespace
 
 OutputBuffer::OutputBuffer(
@@ -335,6 +573,12 @@ OutputBuffer::OutputBuffer(
       continueSize_((maxSize_ * kContinuePct) / 100),
       arbitraryBuffer_(
           isArbitrary() ? std::make_unique<ArbitraryBuffer>() : nullptr),
+      spillConfig_(makeSpillConfig(task_.get())),
+      spillPool_(
+          spillConfig_.has_value()
+              ? task_->pool()->addLeafChild(
+                    fmt::format("outputBufferSpill.{}", task_->taskId()))
+              : nullptr),
       numDrivers_(numDrivers) {
   buffers_.reserve(numDestinations);
   for (int i = 0; i < numDestinations; i++) {
@@ -451,6 +695,7 @@ bool OutputBuffer::enqueue(
   VELOX_CHECK(
       task_->isRunning(), "Task is terminated, cannot add data to output.");
   std::vector<DataAvailable> dataAvailableCallbacks;
+  std::vector<DestinationSpill> spills;
   bool blocked = false;
   {
     std::lock_guard<std::mutex> l(mutex_);
@@ -473,13 +718,11 @@ bool OutputBuffer::enqueue(
         break;
     }
 
-    if (bufferedBytes_ >= maxSize_ && future) {
-      common::testutil::TestValue::adjust(
-          "facebook::velox::exec::OutputBuffer::enqueue", this);
-
-      promises_.emplace_back("OutputBuffer::enqueue");
-      *future = promises_.back().getSemiFuture();
-      blocked = true;
+    if (bufferedBytes_ >= maxSize_ && canSpill()) {
+      spills = startLaggingDestinationSpillLocked();
+    }
+    if (spills.empty()) {
+      blocked = maybeBlockProducerLocked(future);
     }
   }
 
@@ -488,9 +731,34 @@ bool OutputBuffer::enqueue(
     callback.notify();
   }
 
+  if (!spills.empty()) {
+    writeSpills(spills);
+    std::vector<std::shared_ptr<SerializedPage>> freed;
+    std::vector<ContinuePromise> promises;
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      finishSpillsLocked(spills, freed);
+      updateAfterAcknowledgeLocked(freed, promises);
+      blocked = maybeBlockProducerLocked(future);
+    }
+    releaseAfterAcknowledge(freed, promises);
+  }
+
   return blocked;
 }
 
+bool OutputBuffer::maybeBlockProducerLocked(ContinueFuture* future) {
+  if (bufferedBytes_ < maxSize_ || !future) {
+    return false;
+  }
+  common::testutil::TestValue::adjust(
+      "facebook::velox::exec::OutputBuffer::enqueue", this);
+
+  promises_.emplace_back("OutputBuffer::enqueue");
+  *future = promises_.back().getSemiFuture();
+  return true;
+}
+
 void OutputBuffer::enqueueBroadcastOutputLocked(
     std::unique_ptr<SerializedPage> data,
     std::vector<DataAvailable>& dataAvailableCbs) {
@@ -672,6 +940,155 @@ void OutputBuffer::updateAfterAcknowledgeLocked(
   }
 }
 
+std::vector<OutputBuffer::DestinationSpill>
+OutputBuffer::startLaggingDestinationSpillLocked() {
+  int destination{-1};
+  int64_t maxBytes{0};
+  for (auto i = 0; i < buffers_.size(); ++i) {
+    if (buffers_[i] == nullptr) {
+      continue;
+    }
+    const auto bytes = buffers_[i]->exclusiveBytes();
+    if (bytes > maxBytes) {
+      maxBytes = bytes;
+      destination = i;
+    }
+  }
+  std::vector<DestinationSpill> spills;
+  if (destination >= 0 && maxBytes * 2 >= bufferedBytes_) {
+    startDestinationSpillLocked(destination, spills);
+  }
+  return spills;
+}
+
+uint64_t OutputBuffer::spill(uint64_t targetBytes) {
+  VELOX_CHECK(canSpill());
+  std::vector<DestinationSpill> spills;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    spills = startSpillLocked(targetBytes);
+  }
+  if (spills.empty()) {
+    return 0;
+  }
+
+  writeSpills(spills);
+  std::vector<std::shared_ptr<SerializedPage>> freed;
+  std::vector<ContinuePromise> promises;
+  uint64_t freedBytes;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    freedBytes = finishSpillsLocked(spills, freed);
+    updateAfterAcknowledgeLocked(freed, promises);
+  }
+  releaseAfterAcknowledge(freed, promises);
+  return freedBytes;
+}
+
+std::vector<OutputBuffer::DestinationSpill> OutputBuffer::startSpillLocked(
+    uint64_t targetBytes) {
+  std::vector<std::pair<int64_t, int>> candidates;
+  for (auto i = 0; i < buffers_.size(); ++i) {
+    if (buffers_[i] == nullptr) {
+      continue;
+    }
+    const auto bytes = buffers_[i]->exclusiveBytes();
+    if (bytes > 0) {
+      candidates.emplace_back(bytes, i);
+    }
+  }
+  std::sort(candidates.begin(), candidates.end(), std::greater<>());
+
+  std::vector<DestinationSpill> spills;
+  uint64_t spillBytes{0};
+  for (const auto& [bytes, destination] : candidates) {
+    startDestinationSpillLocked(destination, spills);
+    spillBytes += bytes;
+    if (targetBytes > 0 && spillBytes >= targetBytes) {
+      break;
+    }
+  }
+  return spills;
+}
+
+void OutputBuffer::startDestinationSpillLocked(
+    int destination,
+    std::vector<DestinationSpill>& spills) {
+  auto pages = buffers_[destination]->startSpill();
+  if (pages.empty()) {
+    return;
+  }
+  spills.push_back({destination, numSpills_++, std::move(pages), {}});
+}
+
+void OutputBuffer::writeSpills(std::vector<DestinationSpill>& spills) {
+  common::testutil::TestValue::adjust(
+      "facebook::velox::exec::OutputBuffer::writeSpills", this);
+  auto updateAndCheckSpillLimitCb = spillConfig_->updateAndCheckSpillLimitCb;
+  try {
+    for (auto& spill : spills) {
+      SerializedPageSpiller spiller(
+          spillConfig_->writeBufferSize,
+          spillConfig_->maxFileSize,
+          fmt::format(
+              "{}/{}-{}-{}",
+              spillConfig_->getSpillDirPathCb(),
+              spillConfig_->fileNamePrefix,
+              spill.destination,
+              spill.spillId),
+          spillConfig_->fileCreateConfig,
+          updateAndCheckSpillLimitCb,
+          spillPool_.get(),
+          &spillStats_);
+      spiller.spill(spill.pages);
+      spill.result = spiller.finishSpill();
+    }
+  } catch (...) {
+    std::vector<std::shared_ptr<SerializedPage>> freed;
+    std::vector<ContinuePromise> promises;
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      for (auto& spill : spills) {
+        if (auto* buffer = buffers_[spill.destination].get()) {
+          buffer->abortSpill();
+        }
+        for (auto& page : spill.pages) {
+          freed.push_back(std::move(page));
+        }
+      }
+      updateAfterAcknowledgeLocked(freed, promises);
+    }
+    releaseAfterAcknowledge(freed, promises);
+    throw;
+  }
+}
+
+uint64_t OutputBuffer::finishSpillsLocked(
+    std::vector<DestinationSpill>& spills,
+    std::vector<std::shared_ptr<SerializedPage>>& freed) {
+  uint64_t freedBytes{0};
+  for (auto& spill : spills) {
+    // A destination deleted during the write has dropped its pages.
+    if (auto* buffer = buffers_[spill.destination].get()) {
+      buffer->finishSpill(
+          spill.pages.size(),
+          std::move(spill.result),
+          spillConfig_->readBufferSize,
+          spillPool_.get(),
+          &spillStats_);
+    }
+    // Pages acknowledged or deleted during the write are only referenced
+    // here, so they are freed too.
+    for (auto& page : spill.pages) {
+      if (page.use_count() == 1) {
+        freedBytes += page->size();
+      }
+      freed.push_back(std::move(page));
+    }
+  }
+  return freedBytes;
+}
+
 bool OutputBuffer::deleteResults(int destination) {
   std::vector<std::shared_ptr<SerializedPage>> freed;
   std::vector<ContinuePromise> promises;
@@ -717,10 +1134,11 @@ void OutputBuffer::getData(
     DataAvailableCallback notify,
     DataConsumerActiveCheckCallback activeCheck) {
   DestinationBuffer::Data data;
+  std::vector<DataAvailable> dataAvailable;
   std::vector<std::shared_ptr<SerializedPage>> freed;
   std::vector<ContinuePromise> promises;
   {
-    std::lock_guard<std::mutex> l(mutex_);
+    std::unique_lock<std::mutex> l(mutex_);
 
     if (!isPartitioned() && destination >= buffers_.size()) {
       addOutputBuffersLocked(destination + 1);
@@ -731,21 +1149,84 @@ void OutputBuffer::getData(
     if (buffer) {
       freed = buffer->acknowledge(sequence, true);
       updateAfterAcknowledgeLocked(freed, promises);
-      data = buffer->getData(
-          maxBytes, sequence, notify, activeCheck, arbitraryBuffer_.get());
+      if (buffer->isUnspilling()) {
+        // Another fetch is reading back spilled pages of 'destination'. This
+        // one is answered by that fetch when the read is done.
+        buffer->deferGetData(maxBytes, sequence, notify, activeCheck);
+      } else {
+        buffer = unspillLocked(destination, maxBytes, sequence, l);
+        if (buffer) {
+          data = buffer->getData(
+              maxBytes, sequence, notify, activeCheck, arbitraryBuffer_.get());
+        } else {
+          data.data.emplace_back(nullptr);
+          data.immediate = true;
+        }
+        // Answers the fetches that arrived during the reads.
+        while (buffer != nullptr && buffer->hasNotifyData()) {
+          buffer = unspillLocked(
+              destination,
+              buffer->notifyMaxBytes(),
+              buffer->notifySequence(),
+              l);
+          if (buffer != nullptr && buffer->hasNotifyData()) {
+            dataAvailable.push_back(buffer->getAndClearNotify());
+          }
+        }
+      }
     } else {
       data.data.emplace_back(nullptr);
       data.immediate = true;
+    }
+    if (buffer == nullptr) {
       VLOG(1) << "getData received after deleteResults for destination "
               << destination << " and sequence " << sequence;
     }
   }
   releaseAfterAcknowledge(freed, promises);
+  for (auto& available : dataAvailable) {
+    available.notify();
+  }
   if (data.immediate) {
     notify(std::move(data.data), sequence, std::move(data.remainingBytes));
   }
 }
 
+DestinationBuffer* OutputBuffer::unspillLocked(
+    int destination,
+    uint64_t maxBytes,
+    int64_t sequence,
+    std::unique_lock<std::mutex>& l) {
+  auto* buffer = buffers_[destination].get();
+  // Only one fetch at a time reads back the spilled pages of a destination.
+  VELOX_CHECK(!buffer->isUnspilling());
+  auto unspill = buffer->startUnspill(maxBytes, sequence);
+  if (!unspill.has_value()) {
+    return buffer;
+  }
+
+  l.unlock();
+  std::exception_ptr error;
+  try {
+    common::testutil::TestValue::adjust(
+        "facebook::velox::exec::OutputBuffer::unspill", this);
+    unspill->load();
+  } catch (...) {
+    error = std::current_exception();
+  }
+  l.lock();
+
+  // A destination deleted during the read has dropped its spilled pages.
+  buffer = buffers_[destination].get();
+  if (buffer != nullptr) {
+    buffer->finishUnspill(std::move(unspill.value()));
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+  return buffer;
+}
+
 void OutputBuffer::terminate() {
   VELOX_CHECK(!task_->isRunning());
 
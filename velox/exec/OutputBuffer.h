@@ -15,8 +15,10 @@
  */
 #pragma once
 
+#include "velox/common/base/SpillConfig.h"
 #include "velox/core/PlanNode.h"
 #include "velox/exec/ExchangeQueue.h"
+#include "velox/exec/SerializedPageSpiller.h"
 
 namespace facebook::velox::exec {
 
@@ -102,6 +104,8 @@ class DestinationBuffer {
 
     void recordAcknowledge(const SerializedPage& data);
 
+    void recordAcknowledge(int64_t bytes, int64_t rows);
+
     void recordDelete(const SerializedPage& data);
 
     bool finished{false};
@@ -172,6 +176,80 @@ class DestinationBuffer {
   /// Removes all remaining data from the queue and returns the removed data.
   std::vector<std::shared_ptr<SerializedPage>> deleteResults();
 
+  /// Starts spilling the buffered pages except the end marker and returns
+  /// them. The pages stay buffered while the caller writes them to spill files
+  /// without holding the lock of the output buffer. Returns no pages if there
+  /// is nothing to spill or if a spill of this destination is in progress.
+  std::vector<std::shared_ptr<SerializedPage>> startSpill();
+
+  /// Removes the 'numPages' pages returned by startSpill() from memory and
+  /// reads them from 'spillResult' when they are fetched, after the pages
+  /// spilled earlier. Keeps the pages in memory if some of them were
+  /// acknowledged during the write, i.e. the destination is no longer lagging.
+  void finishSpill(
+      int64_t numPages,
+      SerializedPageSpiller::Result&& spillResult,
+      uint64_t readBufferSize,
+      memory::MemoryPool* pool,
+      folly::Synchronized<common::SpillStats>* stats);
+
+  /// Ends a spill whose write failed. The pages stay in memory.
+  void abortSpill();
+
+  /// The spill readers of a destination, taken out to read spilled pages back
+  /// without holding the lock of the output buffer.
+  struct Unspill {
+    std::deque<std::unique_ptr<SerializedPageSpillReader>> readers;
+    /// The index of the last page to read back, counted across 'readers'.
+    int64_t lastPage;
+
+    /// Reads back the pages up to 'lastPage'.
+    void load();
+  };
+
+  /// Returns the spill readers to read back the spilled pages that a fetch of
+  /// up to 'maxBytes' starting at 'sequence' returns, or std::nullopt if these
+  /// pages are in memory. The readers must be returned with finishUnspill().
+  std::optional<Unspill> startUnspill(uint64_t maxBytes, int64_t sequence);
+
+  /// Returns the readers taken out by startUnspill() and deletes the spilled
+  /// pages that were acknowledged in the meantime.
+  void finishUnspill(Unspill&& unspill);
+
+  /// True between startUnspill() and finishUnspill().
+  bool isUnspilling() const {
+    return unspilling_;
+  }
+
+  /// Installs 'notify' for a fetch of up to 'maxBytes' starting at 'sequence'
+  /// that arrives while the spilled pages are read back. The fetch is answered
+  /// through getAndClearNotify() once the read is done.
+  void deferGetData(
+      uint64_t maxBytes,
+      int64_t sequence,
+      DataAvailableCallback notify,
+      DataConsumerActiveCheckCallback activeCheck);
+
+  /// True if a fetch waits for 'notify' and there are pages at its sequence,
+  /// i.e. getAndClearNotify() returns data for it.
+  bool hasNotifyData() const {
+    return notify_ != nullptr && notifySequence_ >= sequence_ &&
+        notifySequence_ - sequence_ < numPages();
+  }
+
+  /// The 'maxBytes' and 'sequence' of the fetch that waits for 'notify'.
+  uint64_t notifyMaxBytes() const {
+    return notifyMaxBytes_;
+  }
+
+  int64_t notifySequence() const {
+    return notifySequence_;
+  }
+
+  /// Returns the bytes of the buffered pages that are not shared with other
+  /// destinations, i.e. the bytes that spill() frees.
+  int64_t exclusiveBytes() const;
+
   /// Returns and clears the notify callback, if any, along with arguments for
   /// the callback.
   DataAvailable getAndClearNotify();
@@ -187,8 +265,51 @@ class DestinationBuffer {
  private:
   void clearNotify();
 
+  int64_t numSpilledPages() const {
+    return spilledPageSizes_.size();
+  }
+
+  // Returns the number of pages, including spilled pages and the end marker.
+  int64_t numPages() const {
+    return numSpilledPages() + data_.size();
+  }
+
+  // Returns the page at 'index', reading it back if it is spilled.
+  std::shared_ptr<SerializedPage> pageAt(int64_t index);
+
+  // Returns the byte size of the page at 'index', which must not be the end
+  // marker, without reading it back if it is spilled.
+  int64_t pageBytes(int64_t index) const;
+
+  // True if the page at 'index' is the end marker.
+  bool isEndMarker(int64_t index) const {
+    return index >= numSpilledPages() &&
+        data_[index - numSpilledPages()] == nullptr;
+  }
+
+  // True if the spilled page at 'index' is read back into memory.
+  bool isSpilledPageLoaded(int64_t index) const;
+
+  // Deletes the first 'numPages' spilled pages, or defers this to
+  // finishUnspill() while the spill readers are taken out.
+  void deleteSpilledPages(int64_t numPages);
+
+  // Pages spilled to disk, one reader per spill run in spill order. These
+  // precede the pages in 'data_'.
+  std::deque<std::unique_ptr<SerializedPageSpillReader>> spillReaders_;
+  // The byte size and number of rows of each page in 'spillReaders_'.
+  std::deque<std::pair<int64_t, int64_t>> spilledPageSizes_;
+  // True between startSpill() and finishSpill() or abortSpill().
+  bool spilling_{false};
+  // The sequence number of the first page returned by startSpill().
+  int64_t spillSequence_{0};
+  // True while 'spillReaders_' are taken out by startUnspill().
+  bool unspilling_{false};
+  // The number of spilled pages acknowledged while 'unspilling_'.
+  int64_t numDeferredSpillDeletes_{0};
   std::vector<std::shared_ptr<SerializedPage>> data_;
-  // The sequence number of the first in 'data_'.
+  // The sequence number of the first spilled page, or of the first in 'data_'
+  // if no pages are spilled.
   int64_t sequence_ = 0;
   DataAvailableCallback notify_{nullptr};
   DataConsumerActiveCheckCallback aliveCheck_{nullptr};
@@ -324,6 +445,22 @@ class OutputBuffer {
   /// Gets the Stats of this output buffer.
   Stats stats();
 
+  /// Returns true if the pages buffered for destinations can be spilled.
+  bool canSpill() const {
+    return spillConfig_.has_value();
+  }
+
+  /// Spills the pages of the destinations with the most buffered bytes until
+  /// at least 'targetBytes' are freed, or all if 'targetBytes' is zero.
+  /// Blocked producers are resumed if this brings the buffered bytes below the
+  /// continue size. Returns the freed bytes. Requires canSpill().
+  uint64_t spill(uint64_t targetBytes);
+
+  /// Returns the stats of spilling the pages of destinations.
+  common::SpillStats spillStats() const {
+    return spillStats_.copy();
+  }
+
  private:
   // Percentage of maxSize below which a blocked producer should
   // be unblocked.
@@ -348,6 +485,58 @@ class OutputBuffer {
       const std::vector<std::shared_ptr<SerializedPage>>& freed,
       std::vector<ContinuePromise>& promises);
 
+  // Blocks the producer on 'future' if the buffer is full. Returns true if
+  // blocked.
+  bool maybeBlockProducerLocked(ContinueFuture* future);
+
+  // The pages of a destination that are written to spill files without
+  // holding 'mutex_'.
+  struct DestinationSpill {
+    int destination;
+    // Makes the names of the spill files unique.
+    uint32_t spillId;
+    std::vector<std::shared_ptr<SerializedPage>> pages;
+    SerializedPageSpiller::Result result;
+  };
+
+  // Starts spilling the destination with the most exclusive bytes if they are
+  // at least half of the buffered bytes, i.e. if one slow destination is
+  // holding the buffer.
+  std::vector<DestinationSpill> startLaggingDestinationSpillLocked();
+
+  // Starts spilling the destinations in descending order of exclusive bytes
+  // until the spilled pages hold at least 'targetBytes', or all destinations
+  // if 'targetBytes' is zero.
+  std::vector<DestinationSpill> startSpillLocked(uint64_t targetBytes);
+
+  // Starts spilling 'destination' and appends it to 'spills' unless it has no
+  // pages to spill.
+  void startDestinationSpillLocked(
+      int destination,
+      std::vector<DestinationSpill>& spills);
+
+  // Writes the pages of 'spills' to spill files. Must be called without
+  // holding 'mutex_'. If a write fails, the spills are aborted and the error
+  // is rethrown.
+  void writeSpills(std::vector<DestinationSpill>& spills);
+
+  // Removes the pages written by writeSpills() from memory and appends them to
+  // 'freed'. Returns the bytes of the pages that are no longer referenced.
+  uint64_t finishSpillsLocked(
+      std::vector<DestinationSpill>& spills,
+      std::vector<std::shared_ptr<SerializedPage>>& freed);
+
+  // Reads back the spilled pages of 'destination' that a fetch of up to
+  // 'maxBytes' starting at 'sequence' returns. Releases 'l' on 'mutex_' while
+  // reading. Fetches of 'destination' that arrive in the meantime wait in its
+  // buffer, see DestinationBuffer::deferGetData(). Returns the buffer of
+  // 'destination' or nullptr if it was deleted in the meantime.
+  DestinationBuffer* unspillLocked(
+      int destination,
+      uint64_t maxBytes,
+      int64_t sequence,
+      std::unique_lock<std::mutex>& l);
+
   /// Given an updated total number of broadcast buffers, add any missing ones
   /// and enqueue data that has been produced so far (e.g. dataToBroadcast_).
   void addOutputBuffersLocked(int numBuffers);
@@ -388,6 +577,14 @@ class OutputBuffer {
   // resumed.
   const uint64_t continueSize_;
   const std::unique_ptr<ArbitraryBuffer> arbitraryBuffer_;
+  // Set if the pages buffered for destinations can be spilled.
+  const std::optional<common::SpillConfig> spillConfig_;
+  // Pool for the spill write buffers and the pages read back from spill
+  // files. Set if 'spillConfig_' is set.
+  const std::shared_ptr<memory::MemoryPool> spillPool_;
+  folly::Synchronized<common::SpillStats> spillStats_;
+  // The number of destination spills, used to make unique spill file names.
+  uint32_t numSpills_{0};
 
   // Total number of drivers expected to produce results. This number will
   // decrease in the end of grouped execution, when we understand the real
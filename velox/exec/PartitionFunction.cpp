@@ -15,6 +15,7 @@
  */
 #include <velox/exec/HashPartitionFunction.h>
 #include <velox/exec/RoundRobinPartitionFunction.h>
+#include <velox/exec/SkewedHashPartitionFunction.h>
 #include "velox/core/PlanNode.h"
 
 namespace facebook::velox::exec {
@@ -27,6 +28,9 @@ void registerPartitionFunctionSerDe() {
   registry.Register(
       "RoundRobinPartitionFunctionSpec",
       RoundRobinPartitionFunctionSpec::deserialize);
+  registry.Register(
+      "SkewedHashPartitionFunctionSpec",
+      SkewedHashPartitionFunctionSpec::deserialize);
 }
 
 } // namespace facebook::velox::exec
@@ -15,18 +15,88 @@
  */
 
 #include "velox/exec/PartitionedOutput.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/exec/OutputBufferManager.h"
 #include "velox/exec/Task.h"
 
 namespace facebook::velox::exec {
 namespace {
+bool useScatter(
+    const core::QueryConfig& queryConfig,
+    int numDestinations,
+    bool replicateNullsAndAny,
+    VectorSerde::Kind kind) {
+  const auto minDestinations =
+      queryConfig.partitionedOutputScatterMinDestinations();
+  return minDestinations > 0 && numDestinations > 1 &&
+      numDestinations >= minDestinations && !replicateNullsAndAny &&
+      (kind == VectorSerde::Kind::kPresto ||
+       kind == VectorSerde::Kind::kArrowIpc);
+}
+
+template <typename T>
+VectorPtr gatherFlat(
+    const FlatVector<T>& source,
+    folly::Range<const vector_size_t*> rows,
+    memory::MemoryPool* pool) {
+  auto result =
+      BaseVector::create<FlatVector<T>>(source.type(), rows.size(), pool);
+  simd::transpose(source.rawValues(), rows, result->mutableRawValues());
+  if (source.rawNulls() != nullptr) {
+    simd::gatherBits(source.rawNulls(), rows, result->mutableRawNulls());
+  }
+  return result;
+}
+
+// Returns the values of 'column' at 'indices'. Flat fixed-width values of 4
+// and 8 bytes are gathered with SIMD into a flat vector. Other columns are
+// wrapped in a dictionary over 'indices' that the serializer reads through,
+// so that strings and nested values are not copied.
+VectorPtr gatherColumn(
+    const VectorPtr& column,
+    const BufferPtr& indices,
+    vector_size_t size,
+    memory::MemoryPool* pool) {
+  const auto& loaded = BaseVector::loadedVectorShared(column);
+  if (loaded->encoding() == VectorEncoding::Simple::CONSTANT) {
+    return loaded;
+  }
+  if (loaded->encoding() == VectorEncoding::Simple::FLAT) {
+    const folly::Range<const vector_size_t*> rows(
+        indices->as<vector_size_t>(), size);
+    switch (loaded->typeKind()) {
+      case TypeKind::INTEGER:
+        return gatherFlat(
+            *loaded->asUnchecked<FlatVector<int32_t>>(), rows, pool);
+      case TypeKind::BIGINT:
+        return gatherFlat(
+            *loaded->asUnchecked<FlatVector<int64_t>>(), rows, pool);
+      case TypeKind::REAL:
+        return gatherFlat(
+            *loaded->asUnchecked<FlatVector<float>>(), rows, pool);
+      case TypeKind::DOUBLE:
+        return gatherFlat(
+            *loaded->asUnchecked<FlatVector<double>>(), rows, pool);
+      default:
+        break;
+    }
+  }
+  return BaseVector::wrapInDictionary(nullptr, indices, size, loaded);
+}
+
 std::unique_ptr<VectorSerde::Options> getVectorSerdeOptions(
     const core::QueryConfig& queryConfig,
     VectorSerde::Kind kind) {
-  std::unique_ptr<VectorSerde::Options> options =
-      kind == VectorSerde::Kind::kPresto
-      ? std::make_unique<serializer::presto::PrestoVectorSerde::PrestoOptions>()
-      : std::make_unique<VectorSerde::Options>();
+  std::unique_ptr<VectorSerde::Options> options;
+  if (kind == VectorSerde::Kind::kPresto) {
+    auto prestoOptions = std::make_unique<
+        serializer::presto::PrestoVectorSerde::PrestoOptions>();
+    prestoOptions->adaptiveCompression =
+        queryConfig.shuffleAdaptiveCompressionEnabled();
+    options = std::move(prestoOptions);
+  } else {
+    options = std::make_unique<VectorSerde::Options>();
+  }
   options->compressionKind =
       common::stringToCompressionKind(queryConfig.shuffleCompressionKind());
   options->minCompressionRatio = PartitionedOutput::minCompressionRatio();
@@ -102,8 +172,20 @@ BlockingReason Destination::advance(
     VELOX_CHECK_NOT_NULL(outputUnsafeRow);
     current_->append(*outputUnsafeRow, rows, sizes);
   } else {
-    VELOX_CHECK_EQ(serde_->kind(), VectorSerde::Kind::kPresto);
-    current_->append(output, rows, scratch);
+    VELOX_CHECK(
+        serde_->kind() == VectorSerde::Kind::kPresto ||
+        serde_->kind() == VectorSerde::Kind::kArrowIpc);
+    // Rows are added in increasing order, so they are contiguous if the first
+    // and the last are as far apart as their count. A range is serialized
+    // column by column without per row indirection.
+    if (rows.back() - rows.front() + 1 ==
+        static_cast<vector_size_t>(rows.size())) {
+      const IndexRange range{
+          rows.front(), static_cast<vector_size_t>(rows.size())};
+      current_->append(output, folly::Range(&range, 1), scratch);
+    } else {
+      current_->append(output, rows, scratch);
+    }
   }
 
   // Update output state variable.
@@ -204,6 +286,11 @@ PartitionedOutput::PartitionedOutput(
       serde_(getNamedVectorSerde(planNode->serdeKind())),
       serdeOptions_(getVectorSerdeOptions(
           operatorCtx_->driverCtx()->queryConfig(),
+          planNode->serdeKind())),
+      scatter_(useScatter(
+          operatorCtx_->driverCtx()->queryConfig(),
+          numDestinations_,
+          replicateNullsAndAny_,
           planNode->serdeKind())) {
   if (!planNode->isPartitioned()) {
     VELOX_USER_CHECK_EQ(numDestinations_, 1);
@@ -298,7 +385,9 @@ void PartitionedOutput::estimateRowSizes() {
     serde_->estimateSerializedSize(
         outputUnsafeRow_.get(), rows, sizePointers_.data());
   } else {
-    VELOX_CHECK_EQ(serde_->kind(), VectorSerde::Kind::kPresto);
+    VELOX_CHECK(
+        serde_->kind() == VectorSerde::Kind::kPresto ||
+        serde_->kind() == VectorSerde::Kind::kArrowIpc);
     serde_->estimateSerializedSize(
         output_.get(), rows, sizePointers_.data(), scratch_);
   }
@@ -308,7 +397,6 @@ void PartitionedOutput::addInput(RowVectorPtr input) {
   initializeInput(std::move(input));
   initializeDestinations();
   initializeSizeBuffers();
-  estimateRowSizes();
 
   for (auto& destination : destinations_) {
     destination->beginBatch();
@@ -316,9 +404,20 @@ void PartitionedOutput::addInput(RowVectorPtr input) {
 
   auto numInput = input_->size();
   if (numDestinations_ == 1) {
+    estimateRowSizes();
     destinations_[0]->addRows(IndexRange{0, numInput});
   } else {
     auto singlePartition = partitionFunction_->partition(*input_, partitions_);
+    const auto* replicatedRows = partitionFunction_->replicatedRows();
+    if (scatter_ && !singlePartition.has_value() && replicatedRows == nullptr) {
+      scatterByDestination();
+      estimateRowSizes();
+      return;
+    }
+    estimateRowSizes();
+    const auto isReplicated = [&](vector_size_t row) {
+      return replicatedRows != nullptr && replicatedRows->isValid(row);
+    };
     if (replicateNullsAndAny_) {
       collectNullRows();
 
@@ -332,7 +431,7 @@ void PartitionedOutput::addInput(RowVectorPtr input) {
         start = 1;
       }
       for (auto i = start; i < numInput; ++i) {
-        if (nullRows_.isValid(i)) {
+        if (nullRows_.isValid(i) || isReplicated(i)) {
           for (auto& destination : destinations_) {
             destination->addRow(i);
           }
@@ -348,15 +447,63 @@ void PartitionedOutput::addInput(RowVectorPtr input) {
       if (singlePartition.has_value()) {
         destinations_[singlePartition.value()]->addRows(
             IndexRange{0, numInput});
-      } else {
+      } else if (replicatedRows == nullptr) {
         for (vector_size_t i = 0; i < numInput; ++i) {
           destinations_[partitions_[i]]->addRow(i);
         }
+      } else {
+        for (vector_size_t i = 0; i < numInput; ++i) {
+          if (replicatedRows->isValid(i)) {
+            for (auto& destination : destinations_) {
+              destination->addRow(i);
+            }
+          } else {
+            destinations_[partitions_[i]]->addRow(i);
+          }
+        }
       }
     }
   }
 }
 
+void PartitionedOutput::scatterByDestination() {
+  const auto numInput = input_->size();
+  // Count the rows of each destination and turn the counts into start
+  // offsets.
+  destinationOffsets_.assign(numDestinations_ + 1, 0);
+  for (vector_size_t i = 0; i < numInput; ++i) {
+    ++destinationOffsets_[partitions_[i] + 1];
+  }
+  for (auto i = 0; i < numDestinations_; ++i) {
+    destinationOffsets_[i + 1] += destinationOffsets_[i];
+  }
+
+  // Place the input row numbers in destination order. Advances the start
+  // offsets to the end offsets.
+  auto indices = allocateIndices(numInput, pool());
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  for (vector_size_t i = 0; i < numInput; ++i) {
+    rawIndices[destinationOffsets_[partitions_[i]]++] = i;
+  }
+
+  std::vector<VectorPtr> columns;
+  columns.reserve(output_->childrenSize());
+  for (const auto& column : output_->children()) {
+    columns.push_back(gatherColumn(column, indices, numInput, pool()));
+  }
+  output_ = std::make_shared<RowVector>(
+      pool(), outputType_, nullptr, numInput, std::move(columns));
+
+  vector_size_t begin = 0;
+  for (auto i = 0; i < numDestinations_; ++i) {
+    const auto end = destinationOffsets_[i];
+    if (end > begin) {
+      destinations_[i]->addRows(IndexRange{begin, end - begin});
+    }
+    begin = end;
+  }
+}
+
 void PartitionedOutput::collectNullRows() {
   auto size = input_->size();
   rows_.resize(size);
@@ -475,6 +622,29 @@ bool PartitionedOutput::isFinished() {
   return finished_;
 }
 
+bool PartitionedOutput::canReclaim() const {
+  auto bufferManager = bufferManager_.lock();
+  if (bufferManager == nullptr) {
+    return false;
+  }
+  auto buffer = bufferManager->getBufferIfExists(taskId());
+  return buffer != nullptr && buffer->canSpill();
+}
+
+void PartitionedOutput::reclaim(
+    uint64_t targetBytes,
+    memory::MemoryReclaimer::Stats& /*stats*/) {
+  auto bufferManager = bufferManager_.lock();
+  if (bufferManager == nullptr) {
+    return;
+  }
+  auto buffer = bufferManager->getBufferIfExists(taskId());
+  if (buffer == nullptr || !buffer->canSpill()) {
+    return;
+  }
+  buffer->spill(targetBytes);
+}
+
 void PartitionedOutput::close() {
   Operator::close();
   {
@@ -185,6 +185,16 @@ class PartitionedOutput : public Operator {
 
   void close() override;
 
+  /// Returns true if the output buffer of the task can spill its pages.
+  bool canReclaim() const override;
+
+  /// Spills the pages buffered for the destinations of the task's output
+  /// buffer. The pages are allocated from the pools of all the
+  /// PartitionedOutput operators of the task, so memory may be freed from the
+  /// other drivers.
+  void reclaim(uint64_t targetBytes, memory::MemoryReclaimer::Stats& stats)
+      override;
+
   static void testingSetMinCompressionRatio(float ratio) {
     minCompressionRatio_ = ratio;
   }
@@ -205,6 +215,10 @@ class PartitionedOutput : public Operator {
   // Collect all rows with null keys into nullRows_.
   void collectNullRows();
 
+  // Reorders 'output_' so that the rows of each destination are contiguous,
+  // in the order of 'partitions_', and adds the rows to the destinations.
+  void scatterByDestination();
+
   // If compression in serde is enabled, this is the minimum compression that
   // must be achieved before starting to skip compression. Used for testing.
   inline static float minCompressionRatio_ = 0.8;
@@ -221,6 +235,9 @@ class PartitionedOutput : public Operator {
   const bool eagerFlush_;
   VectorSerde* const serde_;
   const std::unique_ptr<VectorSerde::Options> serdeOptions_;
+  // True if the input is reordered by destination before serializing. See
+  // QueryConfig::kPartitionedOutputScatterMinDestinations.
+  const bool scatter_;
 
   BlockingReason blockingReason_{BlockingReason::kNotBlocked};
   ContinueFuture future_;
@@ -248,6 +265,9 @@ class PartitionedOutput : public Operator {
   SelectivityVector rows_;
   SelectivityVector nullRows_;
   std::vector<uint32_t> partitions_;
+  // Offsets of the rows of each destination in the reordered 'output_'. Used
+  // by scatterByDestination().
+  std::vector<vector_size_t> destinationOffsets_;
   std::vector<DecodedVector> decodedVectors_;
   Scratch scratch_;
 };
@@ -129,6 +129,10 @@ uint64_t SerializedPageSpillReader::numPages() const {
   return numPages_;
 }
 
+uint64_t SerializedPageSpillReader::numLoadedPages() const {
+  return bufferedPages_.size();
+}
+
 std::shared_ptr<SerializedPage> SerializedPageSpillReader::at(uint64_t index) {
   ensurePages(index);
   return bufferedPages_[index];
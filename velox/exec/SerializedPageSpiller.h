@@ -110,6 +110,10 @@ class SerializedPageSpillReader {
   /// Returns the current number of pages in the reader.
   uint64_t numPages() const;
 
+  /// Returns the number of front pages that are read back into memory, i.e.
+  /// that at() returns without reading the spill files.
+  uint64_t numLoadedPages() const;
+
   /// Returns the page at 'index' in the reader.
   std::shared_ptr<SerializedPage> at(uint64_t index);
 
@@ -0,0 +1,317 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/SkewedHashPartitionFunction.h"
+
+#include <cmath>
+
+#include <folly/Random.h>
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
+
+namespace facebook::velox::exec {
+namespace {
+folly::Synchronized<
+    folly::F14FastMap<std::string, std::weak_ptr<SkewedKeySet>>>&
+keySetRegistry() {
+  static folly::Synchronized<
+      folly::F14FastMap<std::string, std::weak_ptr<SkewedKeySet>>>
+      registry;
+  return registry;
+}
+
+std::string modeName(SkewedHashPartitionFunction::Mode mode) {
+  switch (mode) {
+    case SkewedHashPartitionFunction::Mode::kSpread:
+      return "SPREAD";
+    case SkewedHashPartitionFunction::Mode::kReplicate:
+      return "REPLICATE";
+  }
+  VELOX_UNREACHABLE();
+}
+
+SkewedHashPartitionFunction::Mode modeByName(const std::string& name) {
+  if (name == "SPREAD") {
+    return SkewedHashPartitionFunction::Mode::kSpread;
+  }
+  if (name == "REPLICATE") {
+    return SkewedHashPartitionFunction::Mode::kReplicate;
+  }
+  VELOX_FAIL("Unknown skewed hash partitioning mode: {}", name);
+}
+} // namespace
+
+// static
+std::shared_ptr<SkewedKeySet> SkewedKeySet::getOrCreate(
+    const std::string& id,
+    const Config& config) {
+  return keySetRegistry().withWLock([&](auto& registry) {
+    auto& entry = registry[id];
+    if (auto keySet = entry.lock()) {
+      return keySet;
+    }
+    auto keySet = std::make_shared<SkewedKeySet>(id, config);
+    entry = keySet;
+    return keySet;
+  });
+}
+
+SkewedKeySet::SkewedKeySet(std::string id, Config config)
+    : id_(std::move(id)),
+      config_(std::move(config)),
+      sketch_(config_.maxHotKeys) {
+  VELOX_CHECK_GT(config_.skewFactor, 0);
+  if (config_.hotKeys.has_value()) {
+    hotKeys_.insert(config_.hotKeys->begin(), config_.hotKeys->end());
+    frozen_ = true;
+  }
+}
+
+SkewedKeySet::~SkewedKeySet() {
+  keySetRegistry().withWLock([&](auto& registry) {
+    auto it = registry.find(id_);
+    if (it != registry.end() && it->second.expired()) {
+      registry.erase(it);
+    }
+  });
+}
+
+void SkewedKeySet::addSample(
+    const uint64_t* hashes,
+    vector_size_t numRows,
+    uint32_t numPartitions) {
+  if (frozen()) {
+    return;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  if (frozen()) {
+    return;
+  }
+  addSampleLocked(hashes, numRows);
+  if (sketch_.total() >= config_.sampleRows) {
+    freezeLocked(numPartitions);
+  }
+}
+
+void SkewedKeySet::addSampleLocked(
+    const uint64_t* hashes,
+    vector_size_t numRows) {
+  for (auto i = 0; i < numRows; ++i) {
+    sketch_.add(hashes[i]);
+  }
+}
+
+void SkewedKeySet::freezeLocked(uint32_t numPartitions) {
+  VELOX_CHECK_GT(numPartitions, 0);
+  const auto minCount = std::max<uint64_t>(
+      1,
+      std::ceil(config_.skewFactor * sketch_.total() / numPartitions));
+  for (const auto& hitter : sketch_.heavyHitters(minCount)) {
+    hotKeys_.insert(hitter.key);
+  }
+  sketch_.clear();
+  frozen_.store(true, std::memory_order_release);
+}
+
+std::vector<uint64_t> SkewedKeySet::hotKeys() const {
+  if (!frozen()) {
+    return {};
+  }
+  return std::vector<uint64_t>(hotKeys_.begin(), hotKeys_.end());
+}
+
+SkewedHashPartitionFunction::SkewedHashPartitionFunction(
+    Mode mode,
+    std::shared_ptr<SkewedKeySet> keySet,
+    bool localExchange,
+    int numPartitions,
+    const RowTypePtr& inputType,
+    const std::vector<column_index_t>& keyChannels)
+    : HashPartitionFunction(
+          localExchange,
+          numPartitions,
+          inputType,
+          keyChannels),
+      mode_(mode),
+      keySet_(std::move(keySet)),
+      nextSpreadPartition_(folly::Random::rand32(numPartitions)) {
+  VELOX_CHECK_NOT_NULL(keySet_);
+  VELOX_CHECK(
+      mode_ == Mode::kSpread || keySet_->config().hotKeys.has_value(),
+      "Replicating hot keys requires fixed hot keys");
+  VELOX_CHECK(!keyChannels.empty());
+  for (const auto channel : keyChannels) {
+    VELOX_CHECK_NE(
+        channel,
+        kConstantChannel,
+        "Skewed hash partitioning does not support constant keys");
+  }
+}
+
+std::optional<uint32_t> SkewedHashPartitionFunction::partition(
+    const RowVector& input,
+    std::vector<uint32_t>& partitions) {
+  computeHashes(input);
+
+  const auto size = input.size();
+  if (mode_ == Mode::kSpread) {
+    keySet_->addSample(hashes_.data(), size, numPartitions());
+  }
+
+  partitions.resize(size);
+  hasReplicatedRows_ = false;
+  if (!keySet_->hasHotKeys()) {
+    for (auto i = 0; i < size; ++i) {
+      partitions[i] = partitionOf(hashes_[i]);
+    }
+    return std::nullopt;
+  }
+
+  vector_size_t numHotRows = 0;
+  if (mode_ == Mode::kSpread) {
+    for (auto i = 0; i < size; ++i) {
+      if (keySet_->isHot(hashes_[i])) {
+        partitions[i] = nextSpreadPartition_;
+        nextSpreadPartition_ = (nextSpreadPartition_ + 1) % numPartitions();
+        ++numHotRows;
+      } else {
+        partitions[i] = partitionOf(hashes_[i]);
+      }
+    }
+    keySet_->addSpreadRows(numHotRows);
+    return std::nullopt;
+  }
+
+  replicatedRows_.resize(size);
+  replicatedRows_.clearAll();
+  for (auto i = 0; i < size; ++i) {
+    partitions[i] = partitionOf(hashes_[i]);
+    if (keySet_->isHot(hashes_[i])) {
+      replicatedRows_.setValid(i, true);
+      ++numHotRows;
+    }
+  }
+  if (numHotRows > 0) {
+    replicatedRows_.updateBounds();
+    hasReplicatedRows_ = true;
+    keySet_->addReplicatedRows(numHotRows);
+  }
+  return std::nullopt;
+}
+
+SkewedHashPartitionFunctionSpec::SkewedHashPartitionFunctionSpec(
+    RowTypePtr inputType,
+    std::vector<column_index_t> keyChannels,
+    SkewedHashPartitionFunction::Mode mode,
+    std::shared_ptr<SkewedKeySet> keySet)
+    : inputType_{std::move(inputType)},
+      keyChannels_{std::move(keyChannels)},
+      mode_{mode},
+      keySet_{std::move(keySet)} {
+  VELOX_CHECK_NOT_NULL(keySet_);
+  // The build side of a join can't wait for the probe side to be sampled.
+  VELOX_USER_CHECK(
+      mode_ == SkewedHashPartitionFunction::Mode::kSpread ||
+          keySet_->config().hotKeys.has_value(),
+      "Replicating hot keys requires fixed hot keys");
+}
+
+// static
+std::shared_ptr<SkewedHashPartitionFunctionSpec>
+SkewedHashPartitionFunctionSpec::forJoinBuild(
+    core::JoinType joinType,
+    RowTypePtr inputType,
+    std::vector<column_index_t> keyChannels,
+    std::shared_ptr<SkewedKeySet> keySet) {
+  VELOX_USER_CHECK(
+      !core::isRightJoin(joinType) && !core::isFullJoin(joinType) &&
+          !core::isRightSemiFilterJoin(joinType) &&
+          !core::isRightSemiProjectJoin(joinType),
+      "Replicating hot keys on the build side is not supported for {} join",
+      core::JoinTypeName::toName(joinType));
+  return std::make_shared<SkewedHashPartitionFunctionSpec>(
+      std::move(inputType),
+      std::move(keyChannels),
+      SkewedHashPartitionFunction::Mode::kReplicate,
+      std::move(keySet));
+}
+
+std::unique_ptr<core::PartitionFunction>
+SkewedHashPartitionFunctionSpec::create(
+    int numPartitions,
+    bool localExchange) const {
+  return std::make_unique<SkewedHashPartitionFunction>(
+      mode_, keySet_, localExchange, numPartitions, inputType_, keyChannels_);
+}
+
+std::string SkewedHashPartitionFunctionSpec::toString() const {
+  std::ostringstream keys;
+  for (auto i = 0; i < keyChannels_.size(); ++i) {
+    if (i > 0) {
+      keys << ", ";
+    }
+    keys << inputType_->nameOf(keyChannels_[i]);
+  }
+  return fmt::format("SKEWED_HASH({}; {})", keys.str(), modeName(mode_));
+}
+
+folly::dynamic SkewedHashPartitionFunctionSpec::serialize() const {
+  folly::dynamic obj = folly::dynamic::object;
+  obj["name"] = "SkewedHashPartitionFunctionSpec";
+  obj["inputType"] = inputType_->serialize();
+  obj["keyChannels"] = ISerializable::serialize(keyChannels_);
+  obj["mode"] = modeName(mode_);
+
+  const auto& config = keySet_->config();
+  folly::dynamic keySet = folly::dynamic::object;
+  keySet["id"] = keySet_->id();
+  keySet["sampleRows"] = config.sampleRows;
+  keySet["skewFactor"] = config.skewFactor;
+  keySet["maxHotKeys"] = config.maxHotKeys;
+  if (config.hotKeys.has_value()) {
+    folly::dynamic hotKeys = folly::dynamic::array;
+    for (const auto hash : config.hotKeys.value()) {
+      hotKeys.push_back(static_cast<int64_t>(hash));
+    }
+    keySet["hotKeys"] = std::move(hotKeys);
+  }
+  obj["keySet"] = std::move(keySet);
+  return obj;
+}
+
+// static
+core::PartitionFunctionSpecPtr SkewedHashPartitionFunctionSpec::deserialize(
+    const folly::dynamic& obj,
+    void* context) {
+  const auto& keySetObj = obj["keySet"];
+  SkewedKeySet::Config config;
+  config.sampleRows = keySetObj["sampleRows"].asInt();
+  config.skewFactor = keySetObj["skewFactor"].asDouble();
+  config.maxHotKeys = keySetObj["maxHotKeys"].asInt();
+  if (keySetObj.count("hotKeys") != 0) {
+    std::vector<uint64_t> hotKeys;
+    for (const auto& hash : keySetObj["hotKeys"]) {
+      hotKeys.push_back(static_cast<uint64_t>(hash.asInt()));
+    }
+    config.hotKeys = std::move(hotKeys);
+  }
+  return std::make_shared<SkewedHashPartitionFunctionSpec>(
+      ISerializable::deserialize<RowType>(obj["inputType"]),
+      ISerializable::deserialize<std::vector<column_index_t>>(
+          obj["keyChannels"], context),
+      modeByName(obj["mode"].asString()),
+      SkewedKeySet::getOrCreate(keySetObj["id"].asString(), config));
+}
+} // namespace facebook::velox::exec
@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/container/F14Set.h>
+
+#include "velox/common/base/HeavyHitterSketch.h"
+#include "velox/exec/HashPartitionFunction.h"
+
+namespace facebook::velox::exec {
+
+/// The hot partition keys of a skew-aware hash repartitioning, identified by
+/// the hashes of the keys. One set is shared by the partition functions of all
+/// drivers of one side of a join or aggregation and, for joins, by those of
+/// the other side too.
+///
+/// The set either starts with fixed hot keys, e.g. from table statistics, or
+/// detects them at runtime. In the latter case the spreading side feeds the
+/// key hashes of its input to a HeavyHitterSketch until 'sampleRows' rows have
+/// been seen, and then freezes the hot keys.
+///
+/// Runtime detection is only for sets without a replicating side, i.e. ahead
+/// of a partial aggregation. The build side of a join must know the hot keys
+/// before it routes its first row, because rows routed by plain hashing can't
+/// be replicated afterwards. The probe side, which carries the skew, runs
+/// concurrently and may not have been sampled by then. Joins therefore use
+/// fixed hot keys, e.g. the hotKeys() of a set that sampled the probe side.
+class SkewedKeySet {
+ public:
+  struct Config {
+    /// Number of rows the spreading side samples before the hot keys are
+    /// frozen.
+    uint64_t sampleRows{10'000};
+
+    /// A key is hot if its rows alone make 'skewFactor' times the average
+    /// number of rows per partition.
+    double skewFactor{2.0};
+
+    /// Maximum number of hot keys. Also the capacity of the sketch.
+    uint32_t maxHotKeys{32};
+
+    /// Fixed hot key hashes. If set, no detection is done.
+    std::optional<std::vector<uint64_t>> hotKeys;
+  };
+
+  /// Returns the set registered under 'id', creating it from 'config' if
+  /// there is none. Partition function specs that must agree on the hot keys
+  /// use the same 'id'.
+  static std::shared_ptr<SkewedKeySet> getOrCreate(
+      const std::string& id,
+      const Config& config);
+
+  SkewedKeySet(std::string id, Config config);
+
+  ~SkewedKeySet();
+
+  const std::string& id() const {
+    return id_;
+  }
+
+  const Config& config() const {
+    return config_;
+  }
+
+  /// Adds the key hashes of a batch on the spreading side to the sample.
+  /// Freezes the hot keys once 'sampleRows' rows have been sampled.
+  void addSample(
+      const uint64_t* hashes,
+      vector_size_t numRows,
+      uint32_t numPartitions);
+
+  bool frozen() const {
+    return frozen_.load(std::memory_order_acquire);
+  }
+
+  /// True if the set is frozen with at least one hot key.
+  bool hasHotKeys() const {
+    return frozen() && !hotKeys_.empty();
+  }
+
+  /// Returns true if 'hash' is the hash of a hot key. Requires frozen().
+  bool isHot(uint64_t hash) const {
+    return hotKeys_.contains(hash);
+  }
+
+  /// Returns the hot key hashes. Empty if not frozen.
+  std::vector<uint64_t> hotKeys() const;
+
+  struct Stats {
+    /// Rows of hot keys spread over all partitions.
+    uint64_t numSpreadRows{0};
+    /// Rows of hot keys sent to all partitions.
+    uint64_t numReplicatedRows{0};
+  };
+
+  Stats stats() const {
+    return Stats{numSpreadRows_.load(), numReplicatedRows_.load()};
+  }
+
+  void addSpreadRows(uint64_t numRows) {
+    numSpreadRows_ += numRows;
+  }
+
+  void addReplicatedRows(uint64_t numRows) {
+    numReplicatedRows_ += numRows;
+  }
+
+ private:
+  void addSampleLocked(const uint64_t* hashes, vector_size_t numRows);
+
+  void freezeLocked(uint32_t numPartitions);
+
+  const std::string id_;
+  const Config config_;
+
+  std::mutex mutex_;
+  common::HeavyHitterSketch sketch_;
+  std::atomic_bool frozen_{false};
+  // Written once under 'mutex_' before 'frozen_' is set, read only after.
+  folly::F14FastSet<uint64_t> hotKeys_;
+
+  std::atomic_uint64_t numSpreadRows_{0};
+  std::atomic_uint64_t numReplicatedRows_{0};
+};
+
+/// Hash partitioning that spreads the rows of hot keys instead of sending all
+/// of them to one partition. Keys that are not hot are routed exactly as by
+/// HashPartitionFunction.
+///
+/// kSpread routes the rows of hot keys round-robin over all partitions. It is
+/// used on the probe side of a join and on the input of a partial
+/// aggregation. kReplicate sends the rows of hot keys to every partition. It
+/// is used on the build side of a join so that every probe partition sees all
+/// build rows of the hot keys. This keeps inner, left, left semi and anti
+/// joins correct. It must not be used for right, full outer and right semi
+/// joins: these emit build rows, and each partition would emit a replicated
+/// build row on its own, as unmatched wherever no probe row of its key
+/// landed. SkewedHashPartitionFunctionSpec::forJoinBuild() enforces this.
+/// kReplicate requires a SkewedKeySet with fixed hot keys.
+/// Aggregations must spread only ahead of a partial aggregation whose results
+/// are repartitioned by plain hashing.
+class SkewedHashPartitionFunction : public HashPartitionFunction {
+ public:
+  enum class Mode { kSpread, kReplicate };
+
+  SkewedHashPartitionFunction(
+      Mode mode,
+      std::shared_ptr<SkewedKeySet> keySet,
+      bool localExchange,
+      int numPartitions,
+      const RowTypePtr& inputType,
+      const std::vector<column_index_t>& keyChannels);
+
+  std::optional<uint32_t> partition(
+      const RowVector& input,
+      std::vector<uint32_t>& partitions) override;
+
+  const SelectivityVector* replicatedRows() const override {
+    return hasReplicatedRows_ ? &replicatedRows_ : nullptr;
+  }
+
+ private:
+  const Mode mode_;
+  const std::shared_ptr<SkewedKeySet> keySet_;
+
+  // Next partition for a row of a hot key in kSpread mode.
+  uint32_t nextSpreadPartition_;
+
+  SelectivityVector replicatedRows_;
+  bool hasReplicatedRows_{false};
+};
+
+/// Factory class to create SkewedHashPartitionFunction. The specs of the two
+/// sides of a join are created with the same SkewedKeySet. The build side of
+/// a join should be created with forJoinBuild(), which refuses join types that
+/// can't replicate build rows.
+class SkewedHashPartitionFunctionSpec : public core::PartitionFunctionSpec {
+ public:
+  SkewedHashPartitionFunctionSpec(
+      RowTypePtr inputType,
+      std::vector<column_index_t> keyChannels,
+      SkewedHashPartitionFunction::Mode mode,
+      std::shared_ptr<SkewedKeySet> keySet);
+
+  /// Returns the kReplicate spec for the build side of a join of 'joinType'.
+  /// Throws for right, full outer and right semi joins, which emit build rows
+  /// and would emit the replicated ones once per partition. 'keySet' must
+  /// have fixed hot keys.
+  static std::shared_ptr<SkewedHashPartitionFunctionSpec> forJoinBuild(
+      core::JoinType joinType,
+      RowTypePtr inputType,
+      std::vector<column_index_t> keyChannels,
+      std::shared_ptr<SkewedKeySet> keySet);
+
+  std::unique_ptr<core::PartitionFunction> create(
+      int numPartitions,
+      bool localExchange) const override;
+
+  std::string toString() const override;
+
+  folly::dynamic serialize() const override;
+
+  static core::PartitionFunctionSpecPtr deserialize(
+      const folly::dynamic& obj,
+      void* context);
+
+  const std::shared_ptr<SkewedKeySet>& keySet() const {
+    return keySet_;
+  }
+
+ private:
+  const RowTypePtr inputType_;
+  const std::vector<column_index_t> keyChannels_;
+  const SkewedHashPartitionFunction::Mode mode_;
+  const std::shared_ptr<SkewedKeySet> keySet_;
+};
+} // namespace facebook::velox::exec
@@ -34,6 +34,10 @@ DEFINE_int32(task_width, 4, "Number of threads in each task in shuffle");
 
 DEFINE_int32(num_local_tasks, 8, "Number of concurrent local shuffles");
 DEFINE_int32(num_local_repeat, 8, "Number of repeats of local exchange query");
+DEFINE_int32(
+    local_wide_width,
+    64,
+    "Number of drivers in each task of the wide local exchange benchmark");
 DEFINE_int32(flat_batch_mb, 1, "MB in a 10k row flat batch.");
 DEFINE_int64(
     local_exchange_buffer_mb,
@@ -88,6 +92,30 @@ void sortByAndPrintMax(
             << "\n Min: " << metrics.back().toString() << std::endl;
 }
 
+void printLocalStats(
+    const char* title,
+    int64_t wallUs,
+    const PlanNodeStats& localPartitionStats,
+    LocalPartitionWaitStats& waitStats) {
+  std::sort(waitStats.wallMs.begin(), waitStats.wallMs.end());
+  VELOX_CHECK(!waitStats.wallMs.empty());
+  std::cout << title << std::endl;
+  std::cout << "Wall Time (ms): " << "\n Total: " << succinctMicros(wallUs)
+            << "\n Max: " << waitStats.wallMs.back()
+            << "\n Median: " << waitStats.wallMs[waitStats.wallMs.size() / 2]
+            << "\n Min: " << waitStats.wallMs.front() << std::endl;
+  std::cout << "LocalPartition: " << localPartitionStats.toString()
+            << std::endl;
+  sortByAndPrintMax(
+      "Producer Wait Time (ms)",
+      waitStats.totalProducerWaitMs,
+      waitStats.producerWaitMs);
+  sortByAndPrintMax(
+      "Consumer Wait Time (ms)",
+      waitStats.totalConsumerWaitMs,
+      waitStats.consumerWaitMs);
+}
+
 class ExchangeBenchmark : public VectorTestBase {
  public:
   std::vector<RowVectorPtr> makeRows(
@@ -523,6 +551,22 @@ void runBenchmarks() {
     return 1;
   });
 
+  // Many drivers repartitioning small batches stress the concurrency of the
+  // local exchange queues rather than the data movement.
+  int64_t localWideWallUs;
+  PlanNodeStats localPartitionStatsWideFlat50;
+  LocalPartitionWaitStats localWideWaitStats;
+  folly::addBenchmark(__FILE__, "localWideFlat50", [&]() {
+    bm->runLocal(
+        flat50,
+        FLAGS_local_wide_width,
+        FLAGS_num_local_tasks,
+        localWideWallUs,
+        localPartitionStatsWideFlat50,
+        localWideWaitStats);
+    return 1;
+  });
+
   folly::runBenchmarks();
 
   std::cout
@@ -565,31 +609,17 @@ void runBenchmarks() {
             << std::endl;
   std::cout << "Exchange: " << exchangeStatsStruct1K.toString() << std::endl;
 
-  std::cout
-      << "--------------------------------LocalFlat10K-------------------------------"
-      << std::endl;
-  std::cout << "Wall Time (ms): " << "\n Total: "
-            << succinctMicros(localPartitionWallUs)
-            << "\n Max: " << localPartitionWaitStats.wallMs.back()
-            << "\n Median: "
-            << localPartitionWaitStats
-                   .wallMs[localPartitionWaitStats.wallMs.size() / 2]
-            << "\n Min: " << localPartitionWaitStats.wallMs.front()
-            << std::endl;
-  std::cout << "LocalPartition: " << localPartitionStatsFlat10K.toString()
-            << std::endl;
-  sortByAndPrintMax(
-      "Producer Wait Time (ms)",
-      localPartitionWaitStats.totalProducerWaitMs,
-      localPartitionWaitStats.producerWaitMs);
-  sortByAndPrintMax(
-      "Consumer Wait Time (ms)",
-      localPartitionWaitStats.totalConsumerWaitMs,
-      localPartitionWaitStats.consumerWaitMs);
-  std::sort(
-      localPartitionWaitStats.wallMs.begin(),
-      localPartitionWaitStats.wallMs.end());
-  assert(!localPartitionWaitStats.wallMs.empty());
+  printLocalStats(
+      "--------------------------------LocalFlat10K-------------------------------",
+      localPartitionWallUs,
+      localPartitionStatsFlat10K,
+      localPartitionWaitStats);
+
+  printLocalStats(
+      "------------------------------LocalWideFlat50------------------------------",
+      localWideWallUs,
+      localPartitionStatsWideFlat50,
+      localWideWaitStats);
 }
 
 } // namespace
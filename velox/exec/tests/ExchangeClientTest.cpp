@@ -283,6 +283,251 @@ TEST_P(ExchangeClientTest, flowControl) {
   client->close();
 }
 
+// Same as flowControl with request sizes that follow the throughput of the
+// sources. Verify that the queue limit holds and that the timing of each source
+// is reported.
+TEST_P(ExchangeClientTest, adaptiveFetchSizing) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(10'000, [](auto row) { return row; }),
+  });
+
+  auto page = test::toSerializedPage(data, serdeKind_, bufferManager_, pool());
+
+  auto client = std::make_shared<ExchangeClient>(
+      "adaptive.fetch",
+      17,
+      page->size() * 3.5,
+      1,
+      1024,
+      pool(),
+      executor(),
+      10,
+      true);
+
+  std::vector<std::shared_ptr<Task>> tasks;
+  for (auto i = 0; i < 10; ++i) {
+    auto taskId = fmt::format("local://t{}", i);
+    auto task = makeTask(taskId);
+
+    bufferManager_->initializeTask(
+        task, core::PartitionedOutputNode::Kind::kPartitioned, 100, 16);
+
+    // Enqueue 1 to 3 pages.
+    for (auto j = 0; j <= i % 3; ++j) {
+      enqueue(taskId, 17, data);
+    }
+
+    tasks.push_back(task);
+    client->addRemoteTaskId(taskId);
+  }
+
+  fetchPages(1, *client, 19);
+
+  // The pages are enqueued before the response callbacks that record the
+  // timing run.
+  auto stats = client->stats();
+  while (stats.count("sourceRequestWallNanos") == 0 ||
+         stats.at("sourceRequestWallNanos").count < tasks.size()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    stats = client->stats();
+  }
+  EXPECT_LE(stats.at("peakBytes").sum, page->size() * 4);
+  EXPECT_EQ(19, stats.at("numReceivedPages").sum);
+  EXPECT_EQ(tasks.size(), stats.at("sourceRequestWallNanos").count);
+  EXPECT_EQ(tasks.size(), stats.at("sourceRequestLatencyNanos").count);
+  const auto& throughput = stats.at("sourceThroughputBytesPerSec");
+  EXPECT_EQ(tasks.size(), throughput.count);
+  EXPECT_GT(throughput.min, 0);
+  EXPECT_LE(throughput.min, throughput.max);
+
+  for (auto& task : tasks) {
+    task->requestCancel();
+    bufferManager_->removeTask(task->taskId());
+  }
+
+  client->close();
+}
+
+// An exchange source whose responses are set by the test. Records the size of
+// each request and the pauses of each source.
+class ScriptedExchangeSource : public ExchangeSource {
+ public:
+  struct Log {
+    std::mutex mutex;
+    // The remote task and the max bytes of each request in request order.
+    std::vector<std::pair<std::string, uint32_t>> requests;
+    folly::F14FastMap<std::string, int32_t> numPauses;
+  };
+
+  ScriptedExchangeSource(
+      const std::string& taskId,
+      int destination,
+      std::shared_ptr<ExchangeQueue> queue,
+      memory::MemoryPool* pool,
+      std::shared_ptr<Log> log)
+      : ExchangeSource(taskId, destination, std::move(queue), pool),
+        log_(std::move(log)) {}
+
+  bool shouldRequestLocked() override {
+    return !requestPending_.exchange(true);
+  }
+
+  folly::SemiFuture<Response> request(
+      uint32_t maxBytes,
+      std::chrono::microseconds /*maxWait*/) override {
+    auto promise = VeloxPromise<Response>("ScriptedExchangeSource::request");
+    auto future = promise.getSemiFuture();
+    std::lock_guard<std::mutex> l(log_->mutex);
+    log_->requests.emplace_back(remoteTaskId_, maxBytes);
+    promise_ = std::move(promise);
+    return future;
+  }
+
+  folly::SemiFuture<Response> requestDataSizes(
+      std::chrono::microseconds maxWait) override {
+    return request(0, maxWait);
+  }
+
+  void pause() override {
+    std::lock_guard<std::mutex> l(log_->mutex);
+    ++log_->numPauses[remoteTaskId_];
+  }
+
+  void close() override {}
+
+  // Completes the pending request with 'response'. Waits for the request if
+  // it is not issued yet.
+  void respond(Response response) {
+    std::optional<VeloxPromise<Response>> promise;
+    while (!promise.has_value()) {
+      {
+        std::lock_guard<std::mutex> l(log_->mutex);
+        promise.swap(promise_);
+      }
+      if (!promise.has_value()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    }
+    requestPending_ = false;
+    promise->setValue(std::move(response));
+  }
+
+ private:
+  const std::shared_ptr<Log> log_;
+  std::optional<VeloxPromise<Response>> promise_;
+};
+
+// Verify that with adaptive fetch sizing the slowest source is requested first
+// and that request sizes follow the throughput of the sources. The slow source
+// still gets its first page. Requesting in FIFO order would instead give all
+// the space to the fast source, which is the first to report data.
+TEST_P(ExchangeClientTest, adaptiveFetchSizingOrder) {
+  constexpr int64_t kPageBytes = 1'000;
+  auto log = std::make_shared<ScriptedExchangeSource::Log>();
+  folly::F14FastMap<std::string, std::shared_ptr<ScriptedExchangeSource>>
+      sources;
+  std::mutex sourcesMutex;
+  ExchangeSource::registerFactory(
+      [&](const auto& taskId, auto destination, auto queue, auto pool)
+          -> std::shared_ptr<ExchangeSource> {
+        auto source = std::make_shared<ScriptedExchangeSource>(
+            taskId, destination, std::move(queue), pool, log);
+        std::lock_guard<std::mutex> l(sourcesMutex);
+        sources[taskId] = source;
+        return source;
+      });
+  auto respond = [&](const std::string& taskId,
+                     int64_t bytes,
+                     bool atEnd,
+                     int32_t numRemainingPages) {
+    std::shared_ptr<ScriptedExchangeSource> source;
+    {
+      std::lock_guard<std::mutex> l(sourcesMutex);
+      source = sources.at(taskId);
+    }
+    source->respond(
+        {bytes,
+         atEnd,
+         std::vector<int64_t>(numRemainingPages, kPageBytes)});
+  };
+  auto waitForPause = [&](const std::string& taskId) {
+    for (;;) {
+      {
+        std::lock_guard<std::mutex> l(log->mutex);
+        if (log->numPauses[taskId] > 0) {
+          return;
+        }
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  };
+  auto waitForRequests = [&](size_t numRequests) {
+    for (;;) {
+      {
+        std::lock_guard<std::mutex> l(log->mutex);
+        if (log->requests.size() >= numRequests) {
+          return;
+        }
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  };
+
+  auto client = std::make_shared<ExchangeClient>(
+      "adaptive.order",
+      17,
+      10 * kPageBytes,
+      1,
+      1,
+      pool(),
+      executor(),
+      10,
+      true);
+
+  // Time one data request of a page to each source. The slow source takes
+  // 500ms, the fast one responds right away.
+  client->addRemoteTaskId("slow");
+  client->addRemoteTaskId("fast");
+  respond("slow", 0, false, 1);
+  waitForRequests(3);
+  respond("fast", 0, false, 1);
+  waitForRequests(4);
+  respond("fast", kPageBytes, false, 0);
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+  respond("slow", kPageBytes, false, 0);
+  waitForRequests(6);
+
+  // A third source takes all the space. The fast and the slow source report
+  // data meanwhile, the fast one first. Without space they are not requested
+  // but paused.
+  client->addRemoteTaskId("blocker");
+  respond("blocker", 0, false, 10);
+  waitForRequests(8);
+  respond("fast", 0, false, 20);
+  waitForPause("fast");
+  respond("slow", 0, false, 8);
+  waitForPause("slow");
+
+  // Once the space is free, both sources are requested at once.
+  respond("blocker", 10 * kPageBytes, true, 0);
+  waitForRequests(10);
+  {
+    using Request = std::pair<std::string, uint32_t>;
+    std::lock_guard<std::mutex> l(log->mutex);
+    ASSERT_EQ(log->requests.size(), 10);
+    // The blocker took all the space.
+    EXPECT_EQ(log->requests[7], Request("blocker", 10 * kPageBytes));
+    // The slow source is requested first and gets its first page, though its
+    // share is less than a page. The fast source gets the rest of the space.
+    EXPECT_EQ(log->requests[8], Request("slow", kPageBytes));
+    EXPECT_EQ(log->requests[9], Request("fast", 9 * kPageBytes));
+  }
+
+  client->close();
+  respond("slow", 0, true, 0);
+  respond("fast", 0, true, 0);
+}
+
 // Test that small pages will block and we will keep
 // requesting from the queue if we do not have enough buffer
 // to fillout minOutputBatchBytes
@@ -1100,6 +1100,64 @@ TEST_F(LocalPartitionTest, vectorPool) {
   ASSERT_FALSE(vectorPool.pop());
 }
 
+TEST_F(LocalPartitionTest, concurrentQueue) {
+  constexpr int kNumProducers = 8;
+  constexpr int kNumConsumers = 4;
+  constexpr int kNumVectorsPerProducer = 1'000;
+  constexpr int64_t kVectorBytes = 10;
+  // A small limit makes the producers block and unblock frequently.
+  auto memoryManager =
+      std::make_shared<LocalExchangeMemoryManager>(10 * kVectorBytes);
+  auto queue = std::make_shared<LocalExchangeQueue>(
+      memoryManager, std::make_shared<LocalExchangeVectorPool>(0), 0);
+  for (int i = 0; i < kNumProducers; ++i) {
+    queue->addProducer();
+  }
+  queue->noMoreProducers();
+
+  auto vector = makeRowVector({makeFlatSequence<int64_t>(0, 10)});
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kNumProducers; ++i) {
+    threads.emplace_back([&]() {
+      for (int j = 0; j < kNumVectorsPerProducer; ++j) {
+        ContinueFuture future = ContinueFuture::makeEmpty();
+        if (queue->enqueue(vector, kVectorBytes, &future) !=
+            BlockingReason::kNotBlocked) {
+          future.wait();
+        }
+      }
+      queue->noMoreData();
+    });
+  }
+  std::atomic<int> numReceived{0};
+  for (int i = 0; i < kNumConsumers; ++i) {
+    threads.emplace_back([&]() {
+      for (;;) {
+        ContinueFuture future = ContinueFuture::makeEmpty();
+        RowVectorPtr data;
+        bool drained;
+        if (queue->next(&future, pool(), &data, drained) !=
+            BlockingReason::kNotBlocked) {
+          future.wait();
+          continue;
+        }
+        ASSERT_FALSE(drained);
+        if (data == nullptr) {
+          break;
+        }
+        ++numReceived;
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(numReceived, kNumProducers * kNumVectorsPerProducer);
+  ASSERT_TRUE(queue->isFinished());
+  ASSERT_EQ(memoryManager->bufferedBytes(), 0);
+}
+
 TEST_F(LocalPartitionTest, barrier) {
   const auto rowType = ROW({"c0"}, {BIGINT()});
   std::vector<RowVectorPtr> vectors;
@@ -17,10 +17,12 @@
 #include <gtest/gtest.h>
 #include "folly/experimental/EventCount.h"
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/testutil/TestValue.h"
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
 #include "velox/exec/Task.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 #include "velox/exec/tests/utils/SerializedPageUtil.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/serializers/CompactRowSerializer.h"
 #include "velox/serializers/PrestoSerializer.h"
 #include "velox/serializers/UnsafeRowSerializer.h"
@@ -58,6 +60,7 @@ class OutputBufferManagerTest : public testing::Test {
 
   static void SetUpTestCase() {
     memory::MemoryManager::testingSetInstance(memory::MemoryManager::Options{});
+    common::testutil::TestValue::enable();
   }
 
   void SetUp() override {
@@ -89,7 +92,8 @@ class OutputBufferManagerTest : public testing::Test {
       PartitionedOutputNode::Kind kind,
       int numDestinations,
       int numDrivers,
-      int maxOutputBufferSize = 0) {
+      int maxOutputBufferSize = 0,
+      const std::string& spillDirectory = "") {
     bufferManager_->removeTask(taskId);
 
     auto planFragment = exec::test::PlanBuilder()
@@ -101,6 +105,10 @@ class OutputBufferManagerTest : public testing::Test {
       configSettings[core::QueryConfig::kMaxPartitionedOutputBufferSize] =
           std::to_string(maxOutputBufferSize);
     }
+    if (!spillDirectory.empty()) {
+      configSettings[core::QueryConfig::kSpillEnabled] = "true";
+      configSettings[core::QueryConfig::kOutputBufferSpillEnabled] = "true";
+    }
     auto queryCtx = core::QueryCtx::create(
         executor_.get(), core::QueryConfig(std::move(configSettings)));
 
@@ -110,6 +118,9 @@ class OutputBufferManagerTest : public testing::Test {
         0,
         std::move(queryCtx),
         Task::ExecutionMode::kParallel);
+    if (!spillDirectory.empty()) {
+      task->setSpillDirectory(spillDirectory);
+    }
 
     bufferManager_->initializeTask(task, kind, numDestinations, numDrivers);
     return task;
@@ -1276,6 +1287,211 @@ TEST_P(AllOutputBufferManagerTest, maxBytes) {
   bufferManager_->removeTask(taskId);
 }
 
+TEST_F(OutputBufferManagerTest, spillLaggingDestination) {
+  const vector_size_t size = 100;
+  const std::string taskId = "t0";
+  auto spillDirectory = exec::test::TempDirectoryPath::create();
+  const auto pageSize = makeSerializedPage(rowType_, size)->size();
+  auto task = initializeTask(
+      taskId,
+      rowType_,
+      PartitionedOutputNode::Kind::kPartitioned,
+      2,
+      1,
+      4 * pageSize,
+      spillDirectory->getPath());
+  auto buffer = bufferManager_->getBufferIfExists(taskId);
+  ASSERT_TRUE(buffer->canSpill());
+
+  // Destination 1 is fetched as data arrives while destination 0 is not
+  // fetched. Once destination 0 fills the buffer, its pages are spilled
+  // instead of blocking the producer.
+  for (int i = 0; i < 8; ++i) {
+    enqueue(taskId, 0, rowType_, size);
+    enqueue(taskId, 1, rowType_, size);
+    fetchOneAndAck(taskId, 1, i);
+  }
+  ASSERT_GT(buffer->spillStats().spilledBytes, 0);
+  ASSERT_LT(getStats(taskId).bufferedBytes, 4 * pageSize);
+  ASSERT_EQ(getStats(taskId).buffersStats[0].pagesBuffered, 8);
+
+  // Spilled pages are read back in order on fetch.
+  for (int i = 0; i < 8; ++i) {
+    fetchOneAndAck(taskId, 0, i);
+  }
+  ASSERT_EQ(getStats(taskId).buffersStats[0].pagesBuffered, 0);
+  ASSERT_EQ(getStats(taskId).buffersStats[0].pagesSent, 8);
+
+  noMoreData(taskId);
+  fetchEndMarker(taskId, 0, 8);
+  fetchEndMarker(taskId, 1, 8);
+  EXPECT_TRUE(bufferManager_->isFinished(taskId));
+  bufferManager_->removeTask(taskId);
+}
+
+TEST_F(OutputBufferManagerTest, spillIoWithoutLock) {
+  const vector_size_t size = 100;
+  const std::string taskId = "t0";
+  auto spillDirectory = exec::test::TempDirectoryPath::create();
+  const auto pageSize = makeSerializedPage(rowType_, size)->size();
+  auto task = initializeTask(
+      taskId,
+      rowType_,
+      PartitionedOutputNode::Kind::kPartitioned,
+      2,
+      1,
+      4 * pageSize,
+      spillDirectory->getPath());
+  auto buffer = bufferManager_->getBufferIfExists(taskId);
+
+  // Spill files are written and read back without holding the lock of the
+  // buffer, so the other destination can be served meanwhile.
+  std::atomic_int numWrites{0};
+  std::atomic_int numReads{0};
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::OutputBuffer::writeSpills",
+      std::function<void(void*)>([&](void* /*unused*/) {
+        getStats(taskId);
+        ++numWrites;
+      }));
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::OutputBuffer::unspill",
+      std::function<void(void*)>([&](void* /*unused*/) {
+        getStats(taskId);
+        ++numReads;
+      }));
+
+  for (int i = 0; i < 8; ++i) {
+    enqueue(taskId, 0, rowType_, size);
+    enqueue(taskId, 1, rowType_, size);
+    fetchOneAndAck(taskId, 1, i);
+  }
+  ASSERT_GT(buffer->spillStats().spilledBytes, 0);
+  for (int i = 0; i < 8; ++i) {
+    fetchOneAndAck(taskId, 0, i);
+  }
+#ifndef NDEBUG
+  ASSERT_GT(numWrites, 0);
+  ASSERT_GT(numReads, 0);
+#endif
+
+  noMoreData(taskId);
+  fetchEndMarker(taskId, 0, 8);
+  fetchEndMarker(taskId, 1, 8);
+  EXPECT_TRUE(bufferManager_->isFinished(taskId));
+  bufferManager_->removeTask(taskId);
+}
+
+TEST_F(OutputBufferManagerTest, getDataDuringUnspill) {
+  const vector_size_t size = 100;
+  const std::string taskId = "t0";
+  auto spillDirectory = exec::test::TempDirectoryPath::create();
+  const auto pageSize = makeSerializedPage(rowType_, size)->size();
+  auto task = initializeTask(
+      taskId,
+      rowType_,
+      PartitionedOutputNode::Kind::kPartitioned,
+      2,
+      1,
+      4 * pageSize,
+      spillDirectory->getPath());
+  auto buffer = bufferManager_->getBufferIfExists(taskId);
+  for (int i = 0; i < 8; ++i) {
+    enqueue(taskId, 0, rowType_, size);
+    enqueue(taskId, 1, rowType_, size);
+    fetchOneAndAck(taskId, 1, i);
+  }
+  ASSERT_GT(buffer->spillStats().spilledBytes, 0);
+
+  // A fetch that arrives while another one reads back spilled pages returns
+  // without waiting. It is answered when the read is done.
+  std::atomic_bool deferredFetched{false};
+  std::atomic_int deferredPages{0};
+  const auto fetchPage = [&](std::atomic_int& numPages) {
+    ASSERT_TRUE(bufferManager_->getData(
+        taskId,
+        0,
+        1,
+        0,
+        [&](std::vector<std::unique_ptr<folly::IOBuf>> pages,
+            int64_t sequence,
+            std::vector<int64_t> /*remainingBytes*/) {
+          EXPECT_EQ(sequence, 0);
+          numPages += pages.size();
+        }));
+  };
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::OutputBuffer::unspill",
+      std::function<void(void*)>([&](void* /*unused*/) {
+        if (!deferredFetched.exchange(true)) {
+          fetchPage(deferredPages);
+          EXPECT_EQ(deferredPages, 0);
+        }
+      }));
+  std::atomic_int numPages{0};
+  fetchPage(numPages);
+  ASSERT_EQ(numPages, 1);
+#ifndef NDEBUG
+  ASSERT_TRUE(deferredFetched);
+  ASSERT_EQ(deferredPages, 1);
+#endif
+
+  acknowledge(taskId, 0, 1);
+  for (int i = 1; i < 8; ++i) {
+    fetchOneAndAck(taskId, 0, i);
+  }
+  noMoreData(taskId);
+  fetchEndMarker(taskId, 0, 8);
+  fetchEndMarker(taskId, 1, 8);
+  EXPECT_TRUE(bufferManager_->isFinished(taskId));
+  bufferManager_->removeTask(taskId);
+}
+
+TEST_F(OutputBufferManagerTest, spillOnReclaim) {
+  const vector_size_t size = 100;
+  const std::string taskId = "t0";
+  auto spillDirectory = exec::test::TempDirectoryPath::create();
+  auto task = initializeTask(
+      taskId,
+      rowType_,
+      PartitionedOutputNode::Kind::kBroadcast,
+      2,
+      1,
+      0,
+      spillDirectory->getPath());
+  bufferManager_->updateOutputBuffers(taskId, 2, true);
+  auto buffer = bufferManager_->getBufferIfExists(taskId);
+
+  for (int i = 0; i < 4; ++i) {
+    enqueue(taskId, rowType_, size);
+  }
+  // The pages are shared by both destinations, so spilling frees nothing.
+  ASSERT_EQ(buffer->spill(0), 0);
+  ASSERT_EQ(buffer->spillStats().spilledBytes, 0);
+
+  // Once destination 1 acknowledges all pages, spilling destination 0 frees
+  // them.
+  for (int i = 0; i < 4; ++i) {
+    fetchOneAndAck(taskId, 1, i);
+  }
+  const auto bufferedBytes = getStats(taskId).bufferedBytes;
+  ASSERT_EQ(buffer->spill(0), bufferedBytes);
+  ASSERT_EQ(getStats(taskId).bufferedBytes, 0);
+  ASSERT_GT(buffer->spillStats().spilledBytes, 0);
+
+  // Pages enqueued after the spill follow the spilled pages.
+  enqueue(taskId, rowType_, size);
+  fetch(taskId, 0, 0, std::numeric_limits<uint64_t>::max(), 5);
+  acknowledge(taskId, 0, 5);
+  fetchOneAndAck(taskId, 1, 4);
+
+  noMoreData(taskId);
+  fetchEndMarker(taskId, 0, 5);
+  fetchEndMarker(taskId, 1, 5);
+  EXPECT_TRUE(bufferManager_->isFinished(taskId));
+  bufferManager_->removeTask(taskId);
+}
+
 TEST_P(AllOutputBufferManagerTest, outputBufferUtilization) {
   const std::string taskId = std::to_string(rand());
   const auto destination = 0;
@@ -20,6 +20,7 @@
 #include "velox/exec/Task.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/serializers/PrestoSerializer.h"
 
 namespace facebook::velox::exec::test {
 
@@ -89,6 +90,28 @@ class PartitionedOutputTest
     return result;
   }
 
+  // Deserializes and concatenates the rows of 'pages'.
+  RowVectorPtr deserializeAll(
+      const std::vector<std::unique_ptr<folly::IOBuf>>& pages,
+      const RowTypePtr& rowType) {
+    auto* serde = getNamedVectorSerde(GetParam());
+    std::unique_ptr<VectorSerde::Options> options =
+        GetParam() == VectorSerde::Kind::kPresto
+        ? std::make_unique<
+              serializer::presto::PrestoVectorSerde::PrestoOptions>()
+        : std::make_unique<VectorSerde::Options>();
+    auto result = BaseVector::create<RowVector>(rowType, 0, pool());
+    for (const auto& page : pages) {
+      BufferInputStream input(byteRangesFromIOBuf(page.get()));
+      while (!input.atEnd()) {
+        RowVectorPtr batch;
+        serde->deserialize(&input, pool(), rowType, &batch, options.get());
+        result->append(batch.get());
+      }
+    }
+    return result;
+  }
+
  private:
   const std::shared_ptr<OutputBufferManager> bufferManager_{
       OutputBufferManager::getInstanceRef()};
@@ -206,6 +229,79 @@ TEST_P(PartitionedOutputTest, keyChannelNotAtBeginningWithNulls) {
           .count()));
 }
 
+TEST_P(PartitionedOutputTest, scatterByDestination) {
+  // Verifies that reordering the input by destination before serializing
+  // produces the same rows in the same order for each destination.
+  constexpr int kNumDestinations = 8;
+  constexpr vector_size_t kNumRows = 1'000;
+  auto input = makeRowVector(
+      {"p1", "v1", "v2", "v3", "v4", "v5", "v6"},
+      {makeFlatVector<int64_t>(kNumRows, [](auto row) { return row % 17; }),
+       makeFlatVector<double>(kNumRows, [](auto row) { return row * 0.5; }),
+       makeFlatVector<int32_t>(
+           kNumRows, [](auto row) { return row; }, nullEvery(7)),
+       makeFlatVector<std::string>(
+           kNumRows,
+           [](auto row) { return fmt::format("a string of row {}", row); }),
+       makeArrayVector<int32_t>(
+           kNumRows,
+           [](auto row) { return row % 3; },
+           [](auto row) { return row; }),
+       makeMapVector<int32_t, int64_t>(
+           kNumRows,
+           [](auto row) { return row % 4; },
+           [](auto row) { return row; },
+           [](auto row) { return row * 2; },
+           nullEvery(11)),
+       makeRowVector(
+           {makeFlatVector<int16_t>(kNumRows, [](auto row) { return row; }),
+            makeFlatVector<std::string>(
+                kNumRows, [](auto row) { return std::to_string(row); })},
+           nullEvery(13))});
+  const auto outputType = asRowType(input->type());
+
+  auto plan = PlanBuilder()
+                  .values({input}, false, 3)
+                  .partitionedOutput(
+                      {"p1"},
+                      kNumDestinations,
+                      outputType->names(),
+                      GetParam())
+                  .planNode();
+
+  const auto run = [&](const std::string& taskId, int32_t minDestinations) {
+    auto task = Task::create(
+        taskId,
+        core::PlanFragment{plan},
+        0,
+        createQueryContext(
+            {{core::QueryConfig::kPartitionedOutputScatterMinDestinations,
+              std::to_string(minDestinations)}}),
+        Task::ExecutionMode::kParallel);
+    task->start(1);
+    std::vector<RowVectorPtr> destinations;
+    for (auto i = 0; i < kNumDestinations; ++i) {
+      destinations.push_back(
+          deserializeAll(getAllData(taskId, i), outputType));
+    }
+    EXPECT_TRUE(waitForTaskCompletion(
+        task.get(),
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::seconds(10))
+            .count()));
+    return destinations;
+  };
+
+  const auto expected = run("local://test-partitioned-output-scatter-0", 0);
+  const auto actual = run("local://test-partitioned-output-scatter-1", 2);
+  vector_size_t numRows = 0;
+  for (auto i = 0; i < kNumDestinations; ++i) {
+    assertEqualVectors(expected[i], actual[i]);
+    numRows += actual[i]->size();
+  }
+  ASSERT_EQ(numRows, kNumRows * 3);
+}
+
 VELOX_INSTANTIATE_TEST_SUITE_P(
     PartitionedOutputTest,
     PartitionedOutputTest,
@@ -0,0 +1,328 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/SkewedHashPartitionFunction.h"
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+using namespace facebook;
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+
+class SkewedHashPartitionFunctionTest : public velox::test::VectorTestBase,
+                                        public testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance(memory::MemoryManager::Options{});
+  }
+
+  // Half of the rows have key 0, the others have distinct keys.
+  RowVectorPtr makeSkewedVector(vector_size_t numRows) {
+    return makeRowVector({
+        makeFlatVector<int64_t>(
+            numRows, [](auto row) { return row % 2 == 0 ? 0 : row; }),
+        makeFlatVector<int32_t>(numRows, [](auto row) { return row; }),
+    });
+  }
+
+  std::shared_ptr<SkewedKeySet> makeKeySet(uint64_t sampleRows = 1'000) {
+    SkewedKeySet::Config config;
+    config.sampleRows = sampleRows;
+    return std::make_shared<SkewedKeySet>("test", config);
+  }
+
+  // Returns a set with the hot keys of column 0 of 'sample' as fixed hot keys.
+  // These are detected by spreading 'sample', as done for the probe side.
+  std::shared_ptr<SkewedKeySet> makeFixedKeySet(
+      const RowVectorPtr& sample,
+      int numPartitions) {
+    const auto detected = makeKeySet(sample->size());
+    SkewedHashPartitionFunction function(
+        SkewedHashPartitionFunction::Mode::kSpread,
+        detected,
+        true,
+        numPartitions,
+        asRowType(sample->type()),
+        {0});
+    std::vector<uint32_t> partitions;
+    function.partition(*sample, partitions);
+    VELOX_CHECK(detected->frozen());
+
+    SkewedKeySet::Config config;
+    config.hotKeys = detected->hotKeys();
+    return std::make_shared<SkewedKeySet>("fixed", config);
+  }
+};
+
+TEST_F(SkewedHashPartitionFunctionTest, spread) {
+  constexpr int kNumPartitions = 8;
+  const auto vector = makeSkewedVector(10'000);
+  const auto rowType = asRowType(vector->type());
+  const auto keySet = makeKeySet();
+
+  HashPartitionFunction hashFunction(true, kNumPartitions, rowType, {0});
+  std::vector<uint32_t> hashPartitions;
+  hashFunction.partition(*vector, hashPartitions);
+
+  SkewedHashPartitionFunction function(
+      SkewedHashPartitionFunction::Mode::kSpread,
+      keySet,
+      true,
+      kNumPartitions,
+      rowType,
+      {0});
+  std::vector<uint32_t> partitions;
+  ASSERT_FALSE(keySet->frozen());
+
+  // The batch fills the sample, which freezes the hot keys before the batch
+  // is routed. The rows of the hot key are spread evenly over all partitions,
+  // the other rows are routed by plain hashing.
+  ASSERT_FALSE(function.partition(*vector, partitions).has_value());
+  ASSERT_EQ(function.replicatedRows(), nullptr);
+  ASSERT_TRUE(keySet->frozen());
+  ASSERT_EQ(keySet->hotKeys().size(), 1);
+  std::vector<int32_t> hotRowsPerPartition(kNumPartitions);
+  for (auto i = 0; i < vector->size(); ++i) {
+    if (i % 2 == 0) {
+      ++hotRowsPerPartition[partitions[i]];
+    } else {
+      ASSERT_EQ(partitions[i], hashPartitions[i]);
+    }
+  }
+  for (const auto numRows : hotRowsPerPartition) {
+    ASSERT_EQ(numRows, vector->size() / 2 / kNumPartitions);
+  }
+  ASSERT_EQ(keySet->stats().numSpreadRows, vector->size() / 2);
+}
+
+TEST_F(SkewedHashPartitionFunctionTest, replicate) {
+  constexpr int kNumPartitions = 8;
+  const auto vector = makeSkewedVector(1'000);
+  const auto rowType = asRowType(vector->type());
+  const auto keySet = makeFixedKeySet(vector, kNumPartitions);
+  ASSERT_EQ(keySet->hotKeys().size(), 1);
+
+  HashPartitionFunction hashFunction(true, kNumPartitions, rowType, {0});
+  std::vector<uint32_t> hashPartitions;
+  hashFunction.partition(*vector, hashPartitions);
+
+  SkewedHashPartitionFunction function(
+      SkewedHashPartitionFunction::Mode::kReplicate,
+      keySet,
+      true,
+      kNumPartitions,
+      rowType,
+      {0});
+  std::vector<uint32_t> partitions;
+  ASSERT_FALSE(function.partition(*vector, partitions).has_value());
+
+  const auto* replicatedRows = function.replicatedRows();
+  ASSERT_NE(replicatedRows, nullptr);
+  ASSERT_EQ(replicatedRows->countSelected(), vector->size() / 2);
+  for (auto i = 0; i < vector->size(); ++i) {
+    ASSERT_EQ(replicatedRows->isValid(i), i % 2 == 0);
+    if (i % 2 != 0) {
+      ASSERT_EQ(partitions[i], hashPartitions[i]);
+    }
+  }
+  ASSERT_EQ(keySet->stats().numReplicatedRows, vector->size() / 2);
+
+  // A batch without hot keys replicates nothing.
+  const auto uniform = makeRowVector(
+      {makeFlatVector<int64_t>(100, [](auto row) { return row + 1; }),
+       makeFlatVector<int32_t>(100, [](auto row) { return row; })});
+  function.partition(*uniform, partitions);
+  ASSERT_EQ(function.replicatedRows(), nullptr);
+}
+
+TEST_F(SkewedHashPartitionFunctionTest, noSkew) {
+  constexpr int kNumPartitions = 8;
+  const auto vector = makeRowVector(
+      {makeFlatVector<int64_t>(10'000, [](auto row) { return row % 1'000; })});
+  const auto rowType = asRowType(vector->type());
+  const auto keySet = makeKeySet();
+
+  HashPartitionFunction hashFunction(false, kNumPartitions, rowType, {0});
+  std::vector<uint32_t> hashPartitions;
+  hashFunction.partition(*vector, hashPartitions);
+
+  SkewedHashPartitionFunction function(
+      SkewedHashPartitionFunction::Mode::kSpread,
+      keySet,
+      false,
+      kNumPartitions,
+      rowType,
+      {0});
+  std::vector<uint32_t> partitions;
+  for (auto i = 0; i < 2; ++i) {
+    function.partition(*vector, partitions);
+    ASSERT_EQ(partitions, hashPartitions);
+  }
+  ASSERT_TRUE(keySet->frozen());
+  ASSERT_TRUE(keySet->hotKeys().empty());
+}
+
+TEST_F(SkewedHashPartitionFunctionTest, fixedHotKeys) {
+  constexpr int kNumPartitions = 8;
+  const auto vector = makeSkewedVector(1'000);
+  const auto rowType = asRowType(vector->type());
+  std::vector<uint32_t> partitions;
+
+  const auto keySet = makeFixedKeySet(vector, kNumPartitions);
+  ASSERT_TRUE(keySet->frozen());
+  ASSERT_EQ(keySet->hotKeys().size(), 1);
+
+  SkewedHashPartitionFunctionSpec spec(
+      rowType,
+      {0},
+      SkewedHashPartitionFunction::Mode::kReplicate,
+      keySet);
+  for (const bool localExchange : {true, false}) {
+    auto function = spec.create(kNumPartitions, localExchange);
+    function->partition(*vector, partitions);
+    ASSERT_EQ(
+        function->replicatedRows()->countSelected(), vector->size() / 2);
+  }
+
+  // The build side of a join can't wait for the probe side to be sampled, so
+  // replicating needs fixed hot keys.
+  VELOX_ASSERT_THROW(
+      SkewedHashPartitionFunctionSpec(
+          rowType,
+          {0},
+          SkewedHashPartitionFunction::Mode::kReplicate,
+          makeKeySet()),
+      "Replicating hot keys requires fixed hot keys");
+}
+
+// The probe side is skewed on key 0 while every build key is unique, as for
+// a join of a foreign key with a primary key. The build side alone has no hot
+// keys, so the hot keys come from a sample of the probe side.
+TEST_F(SkewedHashPartitionFunctionTest, skewedProbeOnly) {
+  constexpr int kNumPartitions = 8;
+  const auto probe = makeSkewedVector(10'000);
+  const auto build = makeRowVector({
+      makeFlatVector<int64_t>(10'000, [](auto row) { return row; }),
+  });
+  const auto keySet = makeFixedKeySet(probe, kNumPartitions);
+  ASSERT_EQ(keySet->hotKeys().size(), 1);
+
+  auto probeFunction =
+      SkewedHashPartitionFunctionSpec(
+          asRowType(probe->type()),
+          {0},
+          SkewedHashPartitionFunction::Mode::kSpread,
+          keySet)
+          .create(kNumPartitions, true);
+  auto buildFunction =
+      SkewedHashPartitionFunctionSpec::forJoinBuild(
+          core::JoinType::kInner, asRowType(build->type()), {0}, keySet)
+          ->create(kNumPartitions, true);
+
+  // Only the build row of key 0 is replicated.
+  std::vector<uint32_t> buildPartitions;
+  buildFunction->partition(*build, buildPartitions);
+  const auto* replicatedRows = buildFunction->replicatedRows();
+  ASSERT_NE(replicatedRows, nullptr);
+  ASSERT_EQ(replicatedRows->countSelected(), 1);
+  ASSERT_TRUE(replicatedRows->isValid(0));
+
+  // The probe rows of key 0 are spread evenly. Every probe row lands in a
+  // partition that has the build row of its key.
+  std::vector<uint32_t> probePartitions;
+  probeFunction->partition(*probe, probePartitions);
+  std::vector<int32_t> hotRowsPerPartition(kNumPartitions);
+  const auto* keys = probe->childAt(0)->asFlatVector<int64_t>();
+  for (auto i = 0; i < probe->size(); ++i) {
+    const auto key = keys->valueAt(i);
+    if (key == 0) {
+      ++hotRowsPerPartition[probePartitions[i]];
+    } else {
+      ASSERT_EQ(probePartitions[i], buildPartitions[key]);
+    }
+  }
+  for (const auto numRows : hotRowsPerPartition) {
+    ASSERT_EQ(numRows, probe->size() / 2 / kNumPartitions);
+  }
+}
+
+TEST_F(SkewedHashPartitionFunctionTest, joinBuild) {
+  const auto inputType = ROW({"c0"}, {BIGINT()});
+  SkewedKeySet::Config config;
+  config.hotKeys = std::vector<uint64_t>{1};
+  const auto fixedKeySet = std::make_shared<SkewedKeySet>("fixed", config);
+  for (const auto joinType :
+       {core::JoinType::kInner,
+        core::JoinType::kLeft,
+        core::JoinType::kLeftSemiFilter,
+        core::JoinType::kLeftSemiProject,
+        core::JoinType::kAnti}) {
+    const auto spec = SkewedHashPartitionFunctionSpec::forJoinBuild(
+        joinType, inputType, {0}, fixedKeySet);
+    ASSERT_EQ(spec->toString(), "SKEWED_HASH(c0; REPLICATE)");
+  }
+
+  // These joins emit build rows, so replicated build rows would be emitted
+  // once per partition.
+  for (const auto joinType :
+       {core::JoinType::kRight,
+        core::JoinType::kFull,
+        core::JoinType::kRightSemiFilter,
+        core::JoinType::kRightSemiProject}) {
+    VELOX_ASSERT_THROW(
+        SkewedHashPartitionFunctionSpec::forJoinBuild(
+            joinType, inputType, {0}, fixedKeySet),
+        "Replicating hot keys on the build side is not supported");
+  }
+}
+
+TEST_F(SkewedHashPartitionFunctionTest, spec) {
+  Type::registerSerDe();
+
+  const auto inputType = ROW({"c0", "c1"}, {BIGINT(), VARCHAR()});
+  SkewedKeySet::Config config;
+  config.sampleRows = 123;
+  const auto keySet = SkewedKeySet::getOrCreate("spec", config);
+  ASSERT_EQ(SkewedKeySet::getOrCreate("spec", {}), keySet);
+
+  SkewedHashPartitionFunctionSpec spec(
+      inputType, {1, 0}, SkewedHashPartitionFunction::Mode::kSpread, keySet);
+  ASSERT_EQ(spec.toString(), "SKEWED_HASH(c1, c0; SPREAD)");
+
+  // Specs deserialized in the same process share the key set.
+  const auto copy =
+      SkewedHashPartitionFunctionSpec::deserialize(spec.serialize(), pool());
+  ASSERT_EQ(copy->toString(), spec.toString());
+  const auto* skewedCopy =
+      dynamic_cast<const SkewedHashPartitionFunctionSpec*>(copy.get());
+  ASSERT_NE(skewedCopy, nullptr);
+  ASSERT_EQ(skewedCopy->keySet(), keySet);
+
+  // Fixed hot keys round trip.
+  config.hotKeys = std::vector<uint64_t>{1, 0xFFFFFFFFFFFFFFFFULL};
+  SkewedHashPartitionFunctionSpec fixedSpec(
+      inputType,
+      {0},
+      SkewedHashPartitionFunction::Mode::kReplicate,
+      std::make_shared<SkewedKeySet>("fixed", config));
+  const auto fixedCopy = std::dynamic_pointer_cast<
+      const SkewedHashPartitionFunctionSpec>(
+      SkewedHashPartitionFunctionSpec::deserialize(
+          fixedSpec.serialize(), pool()));
+  auto hotKeys = fixedCopy->keySet()->hotKeys();
+  std::sort(hotKeys.begin(), hotKeys.end());
+  ASSERT_EQ(hotKeys, config.hotKeys.value());
+}
@@ -19,6 +19,7 @@
 #include "velox/common/base/Exceptions.h"
 #include "velox/core/CoreTypeSystem.h"
 #include "velox/expression/StringWriter.h"
+#include "velox/type/FastStringParse.h"
 #include "velox/type/Type.h"
 #include "velox/vector/SelectivityVector.h"
 
@@ -49,6 +50,28 @@ inline std::exception_ptr makeBadCastException(
       false));
 }
 
+/// Casts the strings in 'rows' of 'input' that 'parse' accepts and returns the
+/// remaining rows, which need the general cast. 'parse' returns std::nullopt
+/// for the strings it does not accept, including all invalid ones.
+template <typename T, typename TParse>
+const SelectivityVector& castStringsWithFastPath(
+    const SelectivityVector& rows,
+    const SimpleVector<StringView>& input,
+    FlatVector<T>& result,
+    LocalSelectivityVector& remainingRows,
+    TParse&& parse) {
+  auto& remaining = *remainingRows.get(rows);
+  rows.applyToSelected([&](auto row) {
+    const auto value = input.valueAt(row);
+    if (const auto parsed = parse(std::string_view(value))) {
+      result.set(row, *parsed);
+      remaining.setValid(row, false);
+    }
+  });
+  remaining.updateBounds();
+  return remaining;
+}
+
 } // namespace
 
 template <typename Func>
@@ -349,10 +372,17 @@ void CastExpr::applyVarcharToDecimalCastKernel(
     const TypePtr& toType,
     VectorPtr& result) {
   auto sourceVector = input.as<SimpleVector<StringView>>();
-  auto rawBuffer = result->asUnchecked<FlatVector<T>>()->mutableRawValues();
+  auto* flatResult = result->asUnchecked<FlatVector<T>>();
+  auto rawBuffer = flatResult->mutableRawValues();
   const auto toPrecisionScale = getDecimalPrecisionScale(*toType);
 
-  rows.applyToSelected([&](auto row) {
+  LocalSelectivityVector remainingRows(context);
+  castStringsWithFastPath(
+      rows, *sourceVector, *flatResult, remainingRows, [&](auto value) {
+        return util::fastparse::tryParseDecimal(
+            value, toPrecisionScale.first, toPrecisionScale.second);
+      });
+  remainingRows->applyToSelected([&](auto row) {
     T decimalValue;
     const auto status = DecimalUtil::castFromString<T>(
         hooks_->removeWhiteSpaces(sourceVector->valueAt(row)),
@@ -562,27 +592,42 @@ void CastExpr::applyCastPrimitives(
   auto* resultFlatVector = result->as<FlatVector<To>>();
   auto* inputSimpleVector = input.as<SimpleVector<From>>();
 
+  // Rows left for the per-row kernel.
+  const SelectivityVector* remaining = &rows;
+  LocalSelectivityVector remainingRows(context);
+  if constexpr (
+      FromKind == TypeKind::VARCHAR &&
+      (ToKind == TypeKind::TINYINT || ToKind == TypeKind::SMALLINT ||
+       ToKind == TypeKind::INTEGER || ToKind == TypeKind::BIGINT)) {
+    remaining = &castStringsWithFastPath(
+        rows,
+        *inputSimpleVector,
+        *resultFlatVector,
+        remainingRows,
+        [](auto value) { return util::fastparse::tryParseInteger<To>(value); });
+  }
+
   switch (hooks_->getPolicy()) {
     case LegacyCastPolicy:
-      applyToSelectedNoThrowLocal(context, rows, result, [&](int row) {
+      applyToSelectedNoThrowLocal(context, *remaining, result, [&](int row) {
         applyCastKernel<ToKind, FromKind, util::LegacyCastPolicy>(
             row, context, inputSimpleVector, resultFlatVector);
       });
       break;
     case PrestoCastPolicy:
-      applyToSelectedNoThrowLocal(context, rows, result, [&](int row) {
+      applyToSelectedNoThrowLocal(context, *remaining, result, [&](int row) {
         applyCastKernel<ToKind, FromKind, util::PrestoCastPolicy>(
             row, context, inputSimpleVector, resultFlatVector);
       });
       break;
     case SparkCastPolicy:
-      applyToSelectedNoThrowLocal(context, rows, result, [&](int row) {
+      applyToSelectedNoThrowLocal(context, *remaining, result, [&](int row) {
         applyCastKernel<ToKind, FromKind, util::SparkCastPolicy>(
             row, context, inputSimpleVector, resultFlatVector);
       });
       break;
     case SparkTryCastPolicy:
-      applyToSelectedNoThrowLocal(context, rows, result, [&](int row) {
+      applyToSelectedNoThrowLocal(context, *remaining, result, [&](int row) {
         applyCastKernel<ToKind, FromKind, util::SparkTryCastPolicy>(
             row, context, inputSimpleVector, resultFlatVector);
       });
@@ -115,7 +115,14 @@ VectorPtr CastExpr::castToDate(
   switch (fromType->kind()) {
     case TypeKind::VARCHAR: {
       auto* inputVector = input.as<SimpleVector<StringView>>();
-      applyToSelectedNoThrowLocal(context, rows, castResult, [&](int row) {
+      LocalSelectivityVector remainingRows(context);
+      const auto& remaining = castStringsWithFastPath(
+          rows,
+          *inputVector,
+          *resultFlatVector,
+          remainingRows,
+          [](auto value) { return util::fastparse::tryParseDate(value); });
+      applyToSelectedNoThrowLocal(context, remaining, castResult, [&](int row) {
         bool wrapException = true;
         try {
           const auto result =
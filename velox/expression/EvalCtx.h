@@ -532,6 +532,12 @@ class EvalCtx {
     return execCtx_->optimizationParams().maxSharedSubexprResultsCached;
   }
 
+  /// Returns true if string inputs that were not all ASCII in the last few
+  /// batches are scanned for asciiness only periodically.
+  bool adaptiveAsciiScanEnabled() const {
+    return execCtx_->optimizationParams().adaptiveAsciiScanEnabled;
+  }
+
   /// Returns true if peeling is enabled.
   bool peelingEnabled() const {
     return execCtx_->optimizationParams().peelingEnabled;
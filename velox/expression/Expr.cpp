@@ -1240,6 +1240,16 @@ void Expr::evalWithMemo(
 
   ++baseOfDictionaryRepeats_;
 
+  // If all rows are cached and there is no partial result to merge into,
+  // return the cache itself. The wrapped result then keeps the same base
+  // across batches, so that expressions over it are memoized as well.
+  if (!result && dictionaryCache_ && cachedDictionaryIndices_ &&
+      rows.isSubset(*cachedDictionaryIndices_)) {
+    result = dictionaryCache_;
+    context.releaseVector(base);
+    return;
+  }
+
   if (cachedDictionaryIndices_) {
     LocalSelectivityVector cachedHolder(context, rows);
     auto cached = cachedHolder.get();
@@ -1313,7 +1323,9 @@ void Expr::setAllNulls(
 }
 
 namespace {
-void computeIsAsciiForInputs(
+/// Computes asciiness of the inputs the function asks for. Returns whether all
+/// of them are all ASCII, or std::nullopt if there are no such inputs.
+std::optional<bool> computeIsAsciiForInputs(
     const VectorFunction* vectorFunction,
     const std::vector<VectorPtr>& inputValues,
     const SelectivityVector& rows) {
@@ -1328,6 +1340,7 @@ void computeIsAsciiForInputs(
   }
 
   // Compute string encoding for input vectors at indicies.
+  std::optional<bool> allAscii;
   for (auto& index : indices) {
     // Some arguments are optional and hence may not exist. And some
     // functions operate on dynamic types, but we only scan them when the
@@ -1338,9 +1351,11 @@ void computeIsAsciiForInputs(
           inputValues[index]->template as<SimpleVector<StringView>>();
 
       VELOX_CHECK(vector, inputValues[index]->toString());
-      vector->computeAndSetIsAscii(rows);
+      const bool isAscii = vector->computeAndSetIsAscii(rows);
+      allAscii = allAscii.value_or(true) && isAscii;
     }
   }
+  return allAscii;
 }
 
 /// Computes asciiness on specified inputs for propagation.
@@ -1539,6 +1554,24 @@ bool Expr::applyFunctionWithPeeling(
   return true;
 }
 
+void Expr::maybeComputeIsAsciiForInputs(
+    const SelectivityVector& rows,
+    EvalCtx& context) {
+  if (context.adaptiveAsciiScanEnabled() &&
+      numNonAsciiBatches_ >= kNonAsciiBatchesToSkipScan &&
+      ++numBatchesSinceAsciiScan_ < kAsciiScanProbeInterval) {
+    return;
+  }
+  numBatchesSinceAsciiScan_ = 0;
+  const auto allAscii =
+      computeIsAsciiForInputs(vectorFunction_.get(), inputValues_, rows);
+  if (allAscii.has_value()) {
+    numNonAsciiBatches_ = allAscii.value()
+        ? 0
+        : std::min(numNonAsciiBatches_ + 1, kNonAsciiBatchesToSkipScan);
+  }
+}
+
 void Expr::applyFunction(
     const SelectivityVector& rows,
     EvalCtx& context,
@@ -1547,7 +1580,7 @@ void Expr::applyFunction(
   stats_.numProcessedRows += rows.countSelected();
   auto timer = cpuWallTimer();
 
-  computeIsAsciiForInputs(vectorFunction_.get(), inputValues_, rows);
+  maybeComputeIsAsciiForInputs(rows, context);
   auto isAscii = type()->isVarchar()
       ? computeIsAsciiForResult(vectorFunction_.get(), inputValues_, rows)
       : std::nullopt;
@@ -449,6 +449,14 @@ class Expr {
       EvalCtx& context,
       VectorPtr& result);
 
+  // Scans the string inputs in 'inputValues_' that the function asks for to
+  // set their asciiness. If adaptive ASCII scan is enabled and the inputs
+  // were not all ASCII in the last kNonAsciiBatchesToSkipScan batches, scans
+  // only every kAsciiScanProbeInterval batches until they are all ASCII again.
+  void maybeComputeIsAsciiForInputs(
+      const SelectivityVector& rows,
+      EvalCtx& context);
+
   // Returns true if values in 'distinctFields_' have nulls that are
   // worth skipping. If so, the rows in 'rows' with at least one sure
   // null are deselected in 'nullHolder->get()'.
@@ -650,6 +658,16 @@ class Expr {
   // The indices that are valid in 'dictionaryCache_'.
   std::unique_ptr<SelectivityVector> cachedDictionaryIndices_;
 
+  static constexpr int32_t kNonAsciiBatchesToSkipScan = 4;
+  static constexpr int32_t kAsciiScanProbeInterval = 32;
+
+  // Number of consecutive scanned batches, up to kNonAsciiBatchesToSkipScan,
+  // in which the inputs of the function were not all ASCII.
+  int32_t numNonAsciiBatches_{0};
+
+  // Number of batches since the inputs were last scanned for asciiness.
+  int32_t numBatchesSinceAsciiScan_{0};
+
   /// Runtime statistics. CPU time, wall time and number of processed rows.
   ExprStats stats_;
 
@@ -15,13 +15,18 @@
  */
 
 #include "velox/expression/ExprCompiler.h"
+
+#include <folly/container/F14Set.h>
+
 #include "velox/expression/CastExpr.h"
 #include "velox/expression/CoalesceExpr.h"
 #include "velox/expression/ConjunctExpr.h"
 #include "velox/expression/ConstantExpr.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/FieldReference.h"
+#include "velox/expression/FusedExpr.h"
 #include "velox/expression/LambdaExpr.h"
+#include "velox/expression/MultiPathExtractExpr.h"
 #include "velox/expression/RowConstructor.h"
 #include "velox/expression/SimpleFunctionRegistry.h"
 #include "velox/expression/SpecialFormRegistry.h"
@@ -58,6 +63,20 @@ using ExprDedupMap = folly::F14FastMap<
     ITypedExprHasher,
     ITypedExprComparer>;
 
+// A call to a function registered with registerMultiPathFunction and the
+// group of calls over the same column it is evaluated with.
+struct MultiPathCall {
+  std::shared_ptr<MultiPathGroup> group;
+  // The path of the call in 'group'.
+  size_t index;
+};
+
+using MultiPathCallMap = folly::F14FastMap<
+    const ITypedExpr*,
+    MultiPathCall,
+    ITypedExprHasher,
+    ITypedExprComparer>;
+
 /// Represents a lexical scope. A top level scope corresponds to a top
 /// level Expr and is shared among the Exprs of the ExprSet. Each
 /// lambda introduces a new Scope where the 'locals' are the formal
@@ -85,6 +104,10 @@ struct Scope {
 
   std::vector<TypedExprPtr> rewrittenExpressions;
 
+  // Calls evaluated together with other calls over the same column. Only set
+  // for a top level Scope.
+  const MultiPathCallMap* multiPathCalls{nullptr};
+
   Scope(std::vector<std::string>&& _locals, Scope* _parent, ExprSet* _exprSet)
       : locals(_locals), parent(_parent), exprSet(_exprSet) {}
 
@@ -414,7 +437,26 @@ ExprPtr compileRewrittenExpression(
           trackCpuUsage);
     }
   } else if (auto call = dynamic_cast<const core::CallTypedExpr*>(expr.get())) {
-    if (auto specialForm = specialFormRegistry().getSpecialForm(call->name())) {
+    const MultiPathCall* multiPathCall = nullptr;
+    if (scope->multiPathCalls != nullptr) {
+      auto it = scope->multiPathCalls->find(call);
+      if (it != scope->multiPathCalls->end()) {
+        multiPathCall = &it->second;
+      }
+    }
+    if (multiPathCall != nullptr) {
+      result = std::make_shared<MultiPathExtractExpr>(
+          resultType,
+          std::move(compiledInputs),
+          call->name(),
+          multiPathCall->group,
+          multiPathCall->index,
+          trackCpuUsage);
+      // Values extracted for one batch must not be handed out for the next.
+      scope->exprSet->addToReset(result);
+    } else if (
+        auto specialForm =
+            specialFormRegistry().getSpecialForm(call->name())) {
       result = specialForm->constructSpecialForm(
           resultType, std::move(compiledInputs), trackCpuUsage, config);
     } else if (
@@ -482,6 +524,11 @@ ExprPtr compileRewrittenExpression(
             folly::join("\n", signatures));
       }
     }
+    if (config.exprFusedEvaluationEnabled()) {
+      if (auto fused = FusedExpr::tryFuse(result, trackCpuUsage)) {
+        result = std::move(fused);
+      }
+    }
   } else if (
       auto access =
           dynamic_cast<const core::FieldAccessTypedExpr*>(expr.get())) {
@@ -593,6 +640,100 @@ std::unordered_set<std::string> collectFlatteningCandidates(
     return flatteningCandidates;
   });
 }
+
+using TypedExprSet =
+    folly::F14FastSet<const ITypedExpr*, ITypedExprHasher, ITypedExprComparer>;
+
+// Calls to the same function on the same column, keyed on the function and
+// column names.
+using MultiPathCandidates = std::map<
+    std::pair<std::string, std::string>,
+    std::vector<const core::CallTypedExpr*>>;
+
+// Returns the path of 'call' if it is a call to a function registered with
+// registerMultiPathFunction on a top level column and a constant path.
+std::optional<std::string> multiPathCallPath(const core::CallTypedExpr& call) {
+  if (call.inputs().size() != 2) {
+    return std::nullopt;
+  }
+  auto field = std::dynamic_pointer_cast<const core::FieldAccessTypedExpr>(
+      call.inputs()[0]);
+  auto constant = std::dynamic_pointer_cast<const core::ConstantTypedExpr>(
+      call.inputs()[1]);
+  if (field == nullptr || !field->isInputColumn() || constant == nullptr ||
+      !constant->type()->isVarchar() || constant->isNull()) {
+    return std::nullopt;
+  }
+  if (constant->hasValueVector()) {
+    return constant->valueVector()
+        ->as<ConstantVector<StringView>>()
+        ->valueAt(0)
+        .str();
+  }
+  return constant->value().value<TypeKind::VARCHAR>();
+}
+
+// Adds the distinct calls in 'expr' that qualify for multi path extraction to
+// 'groups'. Does not descend into lambdas, where a column may be a capture
+// and the rows are different.
+void collectMultiPathCalls(
+    const TypedExprPtr& expr,
+    MultiPathCandidates& groups,
+    TypedExprSet& visited) {
+  if (dynamic_cast<const core::LambdaTypedExpr*>(expr.get()) ||
+      !visited.insert(expr.get()).second) {
+    return;
+  }
+  if (auto call = dynamic_cast<const core::CallTypedExpr*>(expr.get())) {
+    if (getMultiPathExtractorFactory(call->name()) != nullptr) {
+      if (multiPathCallPath(*call).has_value()) {
+        const auto& column =
+            static_cast<const core::FieldAccessTypedExpr*>(
+                call->inputs()[0].get())
+                ->name();
+        groups[{call->name(), column}].push_back(call);
+        return;
+      }
+    }
+  }
+  for (const auto& input : expr->inputs()) {
+    collectMultiPathCalls(input, groups, visited);
+  }
+}
+
+// Groups the calls that extract different paths from the same column with the
+// same function, so that each value of the column is parsed once per group.
+MultiPathCallMap collectMultiPathGroups(
+    const std::vector<TypedExprPtr>& exprs) {
+  MultiPathCandidates groups;
+  TypedExprSet visited;
+  for (const auto& expr : exprs) {
+    collectMultiPathCalls(expr, groups, visited);
+  }
+
+  MultiPathCallMap multiPathCalls;
+  for (const auto& [key, calls] : groups) {
+    if (calls.size() < 2) {
+      continue;
+    }
+    std::vector<std::string> paths;
+    paths.reserve(calls.size());
+    for (const auto* call : calls) {
+      paths.push_back(multiPathCallPath(*call).value());
+    }
+    auto factory = getMultiPathExtractorFactory(key.first);
+    auto extractor = factory(paths, calls[0]->type());
+    if (extractor == nullptr) {
+      continue;
+    }
+    auto group =
+        std::make_shared<MultiPathGroup>(std::move(extractor), calls.size());
+    for (size_t i = 0; i < calls.size(); ++i) {
+      multiPathCalls.emplace(calls[i], MultiPathCall{group, i});
+    }
+  }
+  return multiPathCalls;
+}
 } // namespace
 
 std::vector<std::shared_ptr<Expr>> compileExpressions(
@@ -608,11 +749,18 @@ std::vector<std::shared_ptr<Expr>> compileExpressions(
   // lock function registry once vs. locking for each function call.
   auto flatteningCandidates = collectFlatteningCandidates(sources);
 
+  const auto& config = execCtx->queryCtx()->queryConfig();
+  MultiPathCallMap multiPathCalls;
+  if (config.exprMultiPathExtractEnabled()) {
+    multiPathCalls = collectMultiPathGroups(sources);
+    scope.multiPathCalls = &multiPathCalls;
+  }
+
   for (auto& source : sources) {
     exprs.push_back(compileExpression(
         source,
         &scope,
-        execCtx->queryCtx()->queryConfig(),
+        config,
         execCtx->pool(),
         flatteningCandidates,
         enableConstantFolding));
@@ -0,0 +1,601 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/expression/FusedExpr.h"
+
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
+
+#include "velox/expression/ConstantExpr.h"
+#include "velox/expression/DecodedArgs.h"
+#include "velox/expression/FieldReference.h"
+#include "velox/type/FloatingPointUtil.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+
+// Number of rows evaluated per pass over the program. A register holds the
+// values of one block, at most 8KB.
+constexpr vector_size_t kBlockSize = 1'024;
+
+folly::Synchronized<folly::F14FastMap<std::string, FusedOp>>&
+fusedFunctions() {
+  static folly::Synchronized<folly::F14FastMap<std::string, FusedOp>>
+      functions;
+  return functions;
+}
+
+bool isComparison(FusedOp op) {
+  return op >= FusedOp::kEq;
+}
+
+bool isFusedType(const Type& type) {
+  static const std::vector<TypePtr> kTypes = {
+      TINYINT(), SMALLINT(), INTEGER(), BIGINT(), REAL(), DOUBLE()};
+  // DATE, intervals and short decimals have the same kinds as some of the
+  // above but are not equivalent to them.
+  return std::any_of(kTypes.begin(), kTypes.end(), [&](const auto& fusedType) {
+    return type.equivalent(*fusedType);
+  });
+}
+
+// Returns the operation computed by 'expr' if 'expr' is a call to a function
+// registered with registerFusedFunction.
+std::optional<FusedOp> fusedCallOp(const Expr& expr) {
+  if (expr.isSpecialForm() || expr.inputs().size() != 2 ||
+      !expr.vectorFunctionMetadata().defaultNullBehavior ||
+      !expr.vectorFunctionMetadata().deterministic) {
+    return std::nullopt;
+  }
+  auto op = getFusedOp(expr.name());
+  if (!op.has_value()) {
+    return std::nullopt;
+  }
+  const auto& argType = *expr.inputs()[0]->type();
+  if (!isFusedType(argType) ||
+      !argType.equivalent(*expr.inputs()[1]->type())) {
+    return std::nullopt;
+  }
+  const auto& resultType = isComparison(*op) ? *BOOLEAN() : argType;
+  if (!expr.type()->equivalent(resultType)) {
+    return std::nullopt;
+  }
+  return op;
+}
+
+// Translates a tree of fusable calls into instructions. The leaves of the tree
+// must be columns or constants.
+class ProgramBuilder {
+ public:
+  // Index of a leaf if 'isLeaf', otherwise the index of an instruction.
+  struct Operand {
+    bool isLeaf;
+    int32_t index;
+  };
+
+  struct Call {
+    FusedOp op;
+    Operand left;
+    Operand right;
+  };
+
+  // Adds the instructions for 'call' and its inputs. Returns false if the
+  // tree can not be fused.
+  bool addCall(const Expr& call, FusedOp op) {
+    Operand operands[2];
+    for (auto i = 0; i < 2; ++i) {
+      if (!addInput(call.inputs()[i], operands[i])) {
+        return false;
+      }
+    }
+    calls_.push_back({op, operands[0], operands[1]});
+    return true;
+  }
+
+  const std::vector<Call>& calls() const {
+    return calls_;
+  }
+
+  std::vector<ExprPtr>& leaves() {
+    return leaves_;
+  }
+
+ private:
+  bool addInput(const ExprPtr& input, Operand& operand) {
+    if ((input->is<FieldReference>() && input->inputs().empty()) ||
+        input->is<ConstantExpr>()) {
+      operand = {true, leafIndex(input)};
+      return true;
+    }
+    // A call that was fused on its own is fused again into the parent.
+    const Expr* call = input.get();
+    if (auto* fused = input->as<FusedExpr>()) {
+      call = fused->unfused().get();
+    }
+    auto op = fusedCallOp(*call);
+    if (!op.has_value() || !addCall(*call, *op)) {
+      return false;
+    }
+    operand = {false, static_cast<int32_t>(calls_.size() - 1)};
+    return true;
+  }
+
+  int32_t leafIndex(const ExprPtr& leaf) {
+    auto it = std::find(leaves_.begin(), leaves_.end(), leaf);
+    if (it != leaves_.end()) {
+      return it - leaves_.begin();
+    }
+    leaves_.push_back(leaf);
+    return leaves_.size() - 1;
+  }
+
+  std::vector<ExprPtr> leaves_;
+  std::vector<Call> calls_;
+};
+
+template <typename T>
+void applyComparison(
+    FusedOp op,
+    const T* left,
+    const T* right,
+    uint8_t* result,
+    int32_t size) {
+  using namespace util::floating_point;
+  constexpr bool kIsFloat = std::is_floating_point_v<T>;
+  auto compare = [&](auto comparison) {
+    for (auto i = 0; i < size; ++i) {
+      result[i] = comparison(left[i], right[i]);
+    }
+  };
+  switch (op) {
+    case FusedOp::kEq:
+      if constexpr (kIsFloat) {
+        compare(NaNAwareEquals<T>{});
+      } else {
+        compare(std::equal_to<T>{});
+      }
+      break;
+    case FusedOp::kNeq:
+      if constexpr (kIsFloat) {
+        compare([](T a, T b) { return !NaNAwareEquals<T>{}(a, b); });
+      } else {
+        compare(std::not_equal_to<T>{});
+      }
+      break;
+    case FusedOp::kLt:
+      if constexpr (kIsFloat) {
+        compare(NaNAwareLessThan<T>{});
+      } else {
+        compare(std::less<T>{});
+      }
+      break;
+    case FusedOp::kLte:
+      if constexpr (kIsFloat) {
+        compare(NaNAwareLessThanEqual<T>{});
+      } else {
+        compare(std::less_equal<T>{});
+      }
+      break;
+    case FusedOp::kGt:
+      if constexpr (kIsFloat) {
+        compare(NaNAwareGreaterThan<T>{});
+      } else {
+        compare(std::greater<T>{});
+      }
+      break;
+    case FusedOp::kGte:
+      if constexpr (kIsFloat) {
+        compare(NaNAwareGreaterThanEqual<T>{});
+      } else {
+        compare(std::greater_equal<T>{});
+      }
+      break;
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+template <typename T>
+void divideFloatingPoint(const T* left, const T* right, T* result, int32_t size)
+// Division by zero gives infinity or NaN like in DivideFunction.
+#if defined(__has_feature)
+#if __has_feature(__address_sanitizer__)
+    __attribute__((__no_sanitize__("float-divide-by-zero")))
+#endif
+#endif
+{
+  for (auto i = 0; i < size; ++i) {
+    result[i] = left[i] / right[i];
+  }
+}
+
+// Sets 'errors[i]' to 1 for rows where integer arithmetic overflows or
+// divides by zero. Does not clear 'errors'.
+template <typename T>
+void applyArithmetic(
+    FusedOp op,
+    const T* left,
+    const T* right,
+    T* result,
+    uint8_t* errors,
+    int32_t size) {
+  if constexpr (std::is_integral_v<T>) {
+    switch (op) {
+      case FusedOp::kPlus:
+        for (auto i = 0; i < size; ++i) {
+          errors[i] |= __builtin_add_overflow(left[i], right[i], &result[i]);
+        }
+        break;
+      case FusedOp::kMinus:
+        for (auto i = 0; i < size; ++i) {
+          errors[i] |= __builtin_sub_overflow(left[i], right[i], &result[i]);
+        }
+        break;
+      case FusedOp::kMultiply:
+        for (auto i = 0; i < size; ++i) {
+          errors[i] |= __builtin_mul_overflow(left[i], right[i], &result[i]);
+        }
+        break;
+      case FusedOp::kDivide:
+        for (auto i = 0; i < size; ++i) {
+          const bool invalid = (right[i] == 0) |
+              ((left[i] == std::numeric_limits<T>::min()) & (right[i] == -1));
+          errors[i] |= invalid;
+          result[i] = left[i] / (invalid ? T(1) : right[i]);
+        }
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+  } else {
+    switch (op) {
+      case FusedOp::kPlus:
+        for (auto i = 0; i < size; ++i) {
+          result[i] = left[i] + right[i];
+        }
+        break;
+      case FusedOp::kMinus:
+        for (auto i = 0; i < size; ++i) {
+          result[i] = left[i] - right[i];
+        }
+        break;
+      case FusedOp::kMultiply:
+        for (auto i = 0; i < size; ++i) {
+          result[i] = left[i] * right[i];
+        }
+        break;
+      case FusedOp::kDivide:
+        divideFloatingPoint(left, right, result, size);
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+  }
+}
+} // namespace
+
+void registerFusedFunction(const std::string& name, FusedOp op) {
+  fusedFunctions().wlock()->insert_or_assign(name, op);
+}
+
+std::optional<FusedOp> getFusedOp(const std::string& name) {
+  return fusedFunctions().withRLock(
+      [&](const auto& functions) -> std::optional<FusedOp> {
+        auto it = functions.find(name);
+        if (it == functions.end()) {
+          return std::nullopt;
+        }
+        return it->second;
+      });
+}
+
+FusedExpr::FusedExpr(
+    TypePtr type,
+    std::vector<ExprPtr>&& inputs,
+    ExprPtr unfused,
+    std::vector<Instruction>&& program,
+    int32_t numRegisters,
+    bool supportsFlatNoNullsFastPath,
+    bool trackCpuUsage)
+    : SpecialForm(
+          std::move(type),
+          std::move(inputs),
+          kFused,
+          supportsFlatNoNullsFastPath,
+          trackCpuUsage),
+      unfused_(std::move(unfused)),
+      program_(std::move(program)),
+      numRegisters_(numRegisters),
+      argKind_(unfused_->inputs()[0]->type()->kind()) {}
+
+// static
+std::shared_ptr<FusedExpr> FusedExpr::tryFuse(
+    const ExprPtr& expr,
+    bool trackCpuUsage) {
+  auto op = fusedCallOp(*expr);
+  if (!op.has_value()) {
+    return nullptr;
+  }
+  ProgramBuilder builder;
+  if (!builder.addCall(*expr, *op) || builder.calls().size() < 2) {
+    return nullptr;
+  }
+
+  // Each call result is used once, by a later call. Its register is free for
+  // reuse after that, so the number of registers grows with the depth of the
+  // tree, not with the number of calls.
+  const auto& calls = builder.calls();
+  const int32_t numLeaves = builder.leaves().size();
+  int32_t numRegisters = numLeaves;
+  std::vector<int32_t> callRegisters(calls.size());
+  std::vector<int32_t> freeRegisters;
+  auto operandRegister = [&](const ProgramBuilder::Operand& operand) {
+    if (operand.isLeaf) {
+      return operand.index;
+    }
+    freeRegisters.push_back(callRegisters[operand.index]);
+    return callRegisters[operand.index];
+  };
+  std::vector<Instruction> program;
+  program.reserve(calls.size());
+  for (auto i = 0; i < calls.size(); ++i) {
+    const auto left = operandRegister(calls[i].left);
+    const auto right = operandRegister(calls[i].right);
+    int32_t result;
+    if (freeRegisters.empty()) {
+      result = numRegisters++;
+    } else {
+      result = freeRegisters.back();
+      freeRegisters.pop_back();
+    }
+    callRegisters[i] = result;
+    program.push_back({calls[i].op, left, right, result});
+  }
+
+  expr->computeMetadata();
+  auto& leaves = builder.leaves();
+  const bool supportsFlatNoNullsFastPath =
+      Expr::allSupportFlatNoNullsFastPath(leaves);
+  return std::shared_ptr<FusedExpr>(new FusedExpr(
+      expr->type(),
+      std::move(leaves),
+      expr,
+      std::move(program),
+      numRegisters,
+      supportsFlatNoNullsFastPath,
+      trackCpuUsage));
+}
+
+void FusedExpr::evalSpecialForm(
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    VectorPtr& result) {
+  // Rows where no input is null.
+  LocalSelectivityVector remainingRows(context, rows);
+  auto* remaining = remainingRows.get();
+  bool hasNulls = false;
+  LocalDecodedVector decoded(context);
+  inputValues_.resize(inputs_.size());
+  for (auto i = 0; i < inputs_.size(); ++i) {
+    inputs_[i]->eval(*remaining, context, inputValues_[i]);
+    if (!inputValues_[i]->mayHaveNulls()) {
+      continue;
+    }
+    decoded.get()->decode(*inputValues_[i], *remaining);
+    if (auto* nulls = decoded.get()->nulls(remaining)) {
+      remaining->deselectNulls(nulls, remaining->begin(), remaining->end());
+      hasNulls = true;
+      if (!remaining->hasSelections()) {
+        break;
+      }
+    }
+  }
+
+  if (remaining->hasSelections()) {
+    context.ensureWritable(*remaining, type(), result);
+    LocalSelectivityVector errorRows(context, remaining->end());
+    errorRows.get()->clearAll();
+    switch (argKind_) {
+      case TypeKind::TINYINT:
+        evalProgram<int8_t>(*remaining, context, *result, *errorRows.get());
+        break;
+      case TypeKind::SMALLINT:
+        evalProgram<int16_t>(*remaining, context, *result, *errorRows.get());
+        break;
+      case TypeKind::INTEGER:
+        evalProgram<int32_t>(*remaining, context, *result, *errorRows.get());
+        break;
+      case TypeKind::BIGINT:
+        evalProgram<int64_t>(*remaining, context, *result, *errorRows.get());
+        break;
+      case TypeKind::REAL:
+        evalProgram<float>(*remaining, context, *result, *errorRows.get());
+        break;
+      case TypeKind::DOUBLE:
+        evalProgram<double>(*remaining, context, *result, *errorRows.get());
+        break;
+      default:
+        VELOX_UNREACHABLE("Unexpected type of fused call arguments");
+    }
+    result->clearNulls(*remaining);
+    if (errorRows.get()->hasSelections()) {
+      evalUnfused(*errorRows.get(), context, result);
+    }
+  }
+
+  if (hasNulls) {
+    addNulls(rows, remaining->asRange().bits(), context, result);
+  }
+}
+
+template <typename T>
+void FusedExpr::evalProgram(
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    BaseVector& result,
+    SelectivityVector& errorRows) {
+  const auto numInputs = inputs_.size();
+  registers_.resize(
+      bits::roundUp(numRegisters_ * kBlockSize * sizeof(T), sizeof(int64_t)) /
+      sizeof(int64_t));
+  auto registerValues = [&](int32_t index) {
+    return reinterpret_cast<T*>(registers_.data()) + index * kBlockSize;
+  };
+
+  // Values of each register in the current block. Flat inputs are read in
+  // place. Constants are copied to their register once.
+  std::vector<const T*> values(numRegisters_);
+  DecodedArgs decodedArgs(rows, inputValues_, context);
+  std::vector<DecodedVector*> gatheredInputs;
+  std::vector<int32_t> gatheredRegisters;
+  std::vector<const T*> flatInputs(numInputs, nullptr);
+  for (auto i = 0; i < numInputs; ++i) {
+    auto* decoded = decodedArgs.at(i);
+    if (decoded->isIdentityMapping()) {
+      flatInputs[i] = decoded->data<T>();
+    } else if (decoded->isConstantMapping()) {
+      std::fill_n(
+          registerValues(i), kBlockSize, decoded->valueAt<T>(rows.begin()));
+      values[i] = registerValues(i);
+    } else {
+      gatheredInputs.push_back(decoded);
+      gatheredRegisters.push_back(i);
+      values[i] = registerValues(i);
+    }
+  }
+
+  const bool comparison = isComparison(program_.back().op);
+  T* rawResult = nullptr;
+  uint64_t* rawBits = nullptr;
+  if (comparison) {
+    rawBits =
+        result.asUnchecked<FlatVector<bool>>()->mutableRawValues<uint64_t>();
+  } else {
+    rawResult = result.asUnchecked<FlatVector<T>>()->mutableRawValues();
+  }
+  const bool mayFail = std::is_integral_v<T> &&
+      std::any_of(program_.begin(), program_.end(), [](const auto& op) {
+        return !isComparison(op.op);
+      });
+  uint8_t flags[kBlockSize];
+  uint8_t errors[kBlockSize];
+  const auto* rowBits = rows.asRange().bits();
+
+  // Blocks start at a multiple of 64 so that boolean results are written a
+  // word at a time.
+  for (auto begin = rows.begin() & ~63; begin < rows.end();
+       begin += kBlockSize) {
+    const auto end = std::min(begin + kBlockSize, rows.end());
+    if (bits::findFirstBit(rowBits, begin, end) < 0) {
+      continue;
+    }
+    const auto size = end - begin;
+    for (auto i = 0; i < numInputs; ++i) {
+      if (flatInputs[i]) {
+        values[i] = flatInputs[i] + begin;
+      }
+    }
+    for (auto i = 0; i < gatheredInputs.size(); ++i) {
+      auto* decoded = gatheredInputs[i];
+      auto* gathered = registerValues(gatheredRegisters[i]);
+      bits::forEachSetBit(rowBits, begin, end, [&](auto row) {
+        gathered[row - begin] = decoded->valueAt<T>(row);
+      });
+    }
+    if (mayFail) {
+      std::fill_n(errors, size, 0);
+    }
+
+    for (const auto& instruction : program_) {
+      auto* resultValues = registerValues(instruction.result);
+      if (isComparison(instruction.op)) {
+        applyComparison(
+            instruction.op,
+            values[instruction.left],
+            values[instruction.right],
+            flags,
+            size);
+      } else {
+        applyArithmetic(
+            instruction.op,
+            values[instruction.left],
+            values[instruction.right],
+            resultValues,
+            errors,
+            size);
+      }
+      values[instruction.result] = resultValues;
+    }
+
+    if (comparison) {
+      for (auto word = begin / 64; word * 64 < end; ++word) {
+        const auto offset = word * 64 - begin;
+        const auto numBits = std::min<int32_t>(64, size - offset);
+        uint64_t resultBits = 0;
+        for (auto i = 0; i < numBits; ++i) {
+          resultBits |= static_cast<uint64_t>(flags[offset + i]) << i;
+        }
+        const auto mask = rowBits[word] &
+            (numBits == 64 ? ~0ULL : bits::lowMask(numBits));
+        rawBits[word] = (rawBits[word] & ~mask) | (resultBits & mask);
+      }
+    } else {
+      const auto* resultValues = values[program_.back().result];
+      if (bits::isAllSet(rowBits, begin, end)) {
+        std::copy(resultValues, resultValues + size, rawResult + begin);
+      } else {
+        bits::forEachSetBit(rowBits, begin, end, [&](auto row) {
+          rawResult[row] = resultValues[row - begin];
+        });
+      }
+    }
+
+    if (mayFail) {
+      bits::forEachSetBit(rowBits, begin, end, [&](auto row) {
+        if (errors[row - begin]) {
+          errorRows.setValid(row, true);
+        }
+      });
+    }
+  }
+  errorRows.updateBounds();
+}
+
+void FusedExpr::evalUnfused(
+    SelectivityVector& rows,
+    EvalCtx& context,
+    VectorPtr& result) {
+  // The original calls throw or set the errors for 'rows'.
+  VectorPtr unfusedResult;
+  unfused_->eval(rows, context, unfusedResult);
+  context.deselectErrors(rows);
+  if (rows.hasSelections()) {
+    result->copy(unfusedResult.get(), rows, nullptr);
+  }
+}
+
+std::string FusedExpr::toString(bool recursive) const {
+  if (recursive) {
+    return unfused_->toString(true);
+  }
+  return name_;
+}
+
+std::string FusedExpr::toSql(std::vector<VectorPtr>* complexConstants) const {
+  return unfused_->toSql(complexConstants);
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/expression/SpecialForm.h"
+
+namespace facebook::velox::exec {
+
+constexpr const char* kFused = "fused";
+
+/// Binary operations a FusedExpr can evaluate. Arithmetic on integers fails
+/// on overflow and division by zero. Floating point comparisons treat NaN as
+/// equal to NaN and greater than any other value.
+enum class FusedOp : uint8_t {
+  kPlus,
+  kMinus,
+  kMultiply,
+  kDivide,
+  kEq,
+  kNeq,
+  kLt,
+  kLte,
+  kGt,
+  kGte,
+};
+
+/// Declares that the function 'name' computes 'op' for all of its signatures
+/// that take two arguments of the same TINYINT, SMALLINT, INTEGER, BIGINT,
+/// REAL or DOUBLE type. The function must be deterministic and have default
+/// null behavior. Calls to such functions may be evaluated by a FusedExpr.
+void registerFusedFunction(const std::string& name, FusedOp op);
+
+/// Returns the operation registered for 'name' or std::nullopt if 'name' is
+/// not registered with registerFusedFunction.
+std::optional<FusedOp> getFusedOp(const std::string& name);
+
+/// Evaluates a tree of arithmetic and comparison calls over columns and
+/// constants in one pass per block of rows, without materializing the
+/// results of the intermediate calls. The tree is compiled into a small
+/// register-based program. Each register holds the values of one block, so
+/// the registers stay in cache. Rows for which the program detects an error,
+/// e.g. an integer overflow, are evaluated again with the original
+/// expressions to report the error the same way.
+class FusedExpr : public SpecialForm {
+ public:
+  /// Returns a FusedExpr equivalent to 'expr' or nullptr if 'expr' is not a
+  /// call to a registered function or if fewer than two calls can be fused.
+  static std::shared_ptr<FusedExpr> tryFuse(
+      const ExprPtr& expr,
+      bool trackCpuUsage);
+
+  void evalSpecialForm(
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      VectorPtr& result) override;
+
+  void clearCache() override {
+    Expr::clearCache();
+    unfused_->clearCache();
+    registers_.clear();
+  }
+
+  std::string toString(bool recursive = true) const override;
+
+  std::string toSql(
+      std::vector<VectorPtr>* complexConstants = nullptr) const override;
+
+  /// The expression tree evaluated by 'this'.
+  const ExprPtr& unfused() const {
+    return unfused_;
+  }
+
+  /// Number of calls evaluated by 'this'.
+  size_t numFusedCalls() const {
+    return program_.size();
+  }
+
+ private:
+  // Computes 'op' on registers 'left' and 'right' and stores the result in
+  // register 'result'. Registers [0, inputs_.size()) hold the inputs.
+  struct Instruction {
+    FusedOp op;
+    int32_t left;
+    int32_t right;
+    int32_t result;
+  };
+
+  FusedExpr(
+      TypePtr type,
+      std::vector<ExprPtr>&& inputs,
+      ExprPtr unfused,
+      std::vector<Instruction>&& program,
+      int32_t numRegisters,
+      bool supportsFlatNoNullsFastPath,
+      bool trackCpuUsage);
+
+  void computePropagatesNulls() override {
+    propagatesNulls_ = true;
+  }
+
+  // Runs 'program_' on 'rows' and writes the values to 'result'. Adds the
+  // rows for which an instruction failed to 'errorRows'.
+  template <typename T>
+  void evalProgram(
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      BaseVector& result,
+      SelectivityVector& errorRows);
+
+  // Evaluates 'unfused_' for 'rows' and copies the rows that did not fail to
+  // 'result'.
+  void evalUnfused(
+      SelectivityVector& rows,
+      EvalCtx& context,
+      VectorPtr& result);
+
+  const ExprPtr unfused_;
+  const std::vector<Instruction> program_;
+  const int32_t numRegisters_;
+  // Type of the arguments of all instructions.
+  const TypeKind argKind_;
+
+  // Backing memory for the registers, 'numRegisters_' blocks of values.
+  std::vector<int64_t> registers_;
+};
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/expression/MultiPathExtractExpr.h"
+
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
+
+namespace facebook::velox::exec {
+
+namespace {
+
+using FactoryMap = folly::F14FastMap<std::string, MultiPathExtractorFactory>;
+
+folly::Synchronized<FactoryMap>& multiPathFunctions() {
+  static folly::Synchronized<FactoryMap> functions;
+  return functions;
+}
+
+} // namespace
+
+void registerMultiPathFunction(
+    const std::string& name,
+    MultiPathExtractorFactory factory) {
+  VELOX_CHECK_NOT_NULL(factory);
+  multiPathFunctions().wlock()->insert_or_assign(name, std::move(factory));
+}
+
+MultiPathExtractorFactory getMultiPathExtractorFactory(
+    const std::string& name) {
+  return multiPathFunctions().withRLock(
+      [&](const auto& functions) -> MultiPathExtractorFactory {
+        auto it = functions.find(name);
+        return it == functions.end() ? nullptr : it->second;
+      });
+}
+
+VectorPtr MultiPathGroup::values(
+    size_t index,
+    const SelectivityVector& rows,
+    const VectorPtr& input,
+    EvalCtx& context) {
+  VELOX_CHECK_LT(index, numPaths_);
+  const bool cached = input.get() == input_ && !weakInput_.expired() &&
+      values_[index] != nullptr && rows.isSubset(rows_);
+  if (!cached) {
+    LocalDecodedVector decoded(context, *input, rows);
+    values_.assign(numPaths_, nullptr);
+    extractor_->extract(rows, *decoded.get(), context, values_);
+    VELOX_CHECK_EQ(values_.size(), numPaths_);
+    input_ = input.get();
+    weakInput_ = input;
+    rows_ = rows;
+  }
+  // The other calls of the group take the other values. The caller owns this
+  // one, so that it can be reused.
+  return std::move(values_[index]);
+}
+
+void MultiPathExtractExpr::evalSpecialForm(
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    VectorPtr& result) {
+  VectorPtr input;
+  inputs_[0]->eval(rows, context, input);
+  auto values = group_->values(index_, rows, input, context);
+  context.moveOrCopyResult(values, rows, result);
+}
+
+} // namespace facebook::velox::exec
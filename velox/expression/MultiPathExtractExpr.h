@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/expression/SpecialForm.h"
+
+namespace facebook::velox::exec {
+
+/// Extracts the values of several paths from each row of one input, e.g. the
+/// values of several JSON paths from a single parse of each document.
+class MultiPathExtractor {
+ public:
+  virtual ~MultiPathExtractor() = default;
+
+  /// Sets 'results[i]' to the values of the i-th path for 'rows' of 'input'.
+  /// Rows where 'input' is null or where the path has no value are null. Must
+  /// not throw for individual rows.
+  virtual void extract(
+      const SelectivityVector& rows,
+      const DecodedVector& input,
+      EvalCtx& context,
+      std::vector<VectorPtr>& results) const = 0;
+};
+
+/// Returns an extractor for 'paths' or nullptr if some path is not supported,
+/// e.g. it is malformed. 'resultType' is the type of the values of each path.
+using MultiPathExtractorFactory =
+    std::function<std::unique_ptr<MultiPathExtractor>(
+        const std::vector<std::string>& paths,
+        const TypePtr& resultType)>;
+
+/// Declares that calls to the function 'name' with a column and a constant
+/// path as arguments may be evaluated together with the other calls to 'name'
+/// on the same column by one extractor made by 'factory'. The function must be
+/// deterministic and return null for null inputs.
+void registerMultiPathFunction(
+    const std::string& name,
+    MultiPathExtractorFactory factory);
+
+/// Returns the factory registered for 'name' or nullptr if 'name' is not
+/// registered with registerMultiPathFunction.
+MultiPathExtractorFactory getMultiPathExtractorFactory(
+    const std::string& name);
+
+/// The values of all paths of a group of calls over the same column. The
+/// values are extracted for all paths when the first call of the group is
+/// evaluated on a new input and handed out to the other calls as they are
+/// evaluated.
+class MultiPathGroup {
+ public:
+  MultiPathGroup(
+      std::unique_ptr<MultiPathExtractor> extractor,
+      size_t numPaths)
+      : extractor_(std::move(extractor)), numPaths_(numPaths) {}
+
+  /// Returns the values of path 'index' for 'rows' of 'input'. Extracts the
+  /// values of all paths for 'rows' unless they were already extracted from
+  /// 'input' for a superset of 'rows'.
+  VectorPtr values(
+      size_t index,
+      const SelectivityVector& rows,
+      const VectorPtr& input,
+      EvalCtx& context);
+
+  void clear() {
+    input_ = nullptr;
+    weakInput_.reset();
+    values_.clear();
+  }
+
+ private:
+  const std::unique_ptr<MultiPathExtractor> extractor_;
+  const size_t numPaths_;
+
+  // The input the cached values were extracted from. 'weakInput_' detects
+  // that the input was freed and a new input allocated at the same address.
+  const BaseVector* input_{nullptr};
+  std::weak_ptr<BaseVector> weakInput_;
+  // The rows for which 'values_' are set.
+  SelectivityVector rows_;
+  // The values of each path. An entry is reset when it is handed out.
+  std::vector<VectorPtr> values_;
+};
+
+/// A call to a function registered with registerMultiPathFunction that
+/// extracts one path of a MultiPathGroup. The inputs are the column and the
+/// constant path, so that the expression prints like the call.
+class MultiPathExtractExpr : public SpecialForm {
+ public:
+  MultiPathExtractExpr(
+      TypePtr type,
+      std::vector<ExprPtr>&& inputs,
+      const std::string& name,
+      std::shared_ptr<MultiPathGroup> group,
+      size_t index,
+      bool trackCpuUsage)
+      : SpecialForm(
+            std::move(type),
+            std::move(inputs),
+            name,
+            false /* supportsFlatNoNullsFastPath */,
+            trackCpuUsage),
+        group_(std::move(group)),
+        index_(index) {}
+
+  void evalSpecialForm(
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      VectorPtr& result) override;
+
+  // Drops the values extracted for the previous batch. An input vector may be
+  // reused for the next batch at the same address, so 'group_' cannot tell
+  // the batches apart by the input alone.
+  void reset() override {
+    Expr::reset();
+    group_->clear();
+  }
+
+  void clearCache() override {
+    Expr::clearCache();
+    group_->clear();
+  }
+
+  const std::shared_ptr<MultiPathGroup>& group() const {
+    return group_;
+  }
+
+ private:
+  void computePropagatesNulls() override {
+    propagatesNulls_ = true;
+  }
+
+  const std::shared_ptr<MultiPathGroup> group_;
+  // The path of 'this' in 'group_'.
+  const size_t index_;
+};
+
+} // namespace facebook::velox::exec
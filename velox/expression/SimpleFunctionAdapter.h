@@ -21,6 +21,8 @@
 #include <optional>
 #include <type_traits>
 
+#include <folly/Range.h>
+
 #include "velox/common/base/Portability.h"
 #include "velox/common/base/Status.h"
 #include "velox/expression/ComplexWriterTypes.h"
@@ -151,6 +153,29 @@ class SimpleFunctionAdapter : public VectorFunction {
     }() && ...);
   }
 
+  template <int32_t POSITION>
+  static constexpr bool isArgBatchEligible() {
+    if constexpr (isVariadicType<arg_at<POSITION>>::value) {
+      return false;
+    } else {
+      return SimpleTypeTrait<arg_at<POSITION>>::isPrimitiveType &&
+          SimpleTypeTrait<arg_at<POSITION>>::isFixedWidth &&
+          SimpleTypeTrait<arg_at<POSITION>>::typeKind != TypeKind::BOOLEAN;
+    }
+  }
+
+  template <size_t... Is>
+  static constexpr bool allArgsBatchEligibleImpl(std::index_sequence<Is...>) {
+    return (isArgBatchEligible<Is>() && ...);
+  }
+
+  // Whether the UDF provides callBatch() and the result and all arguments are
+  // stored as arrays of values.
+  static constexpr bool batchEligible = FUNC::udf_has_callBatch &&
+      FUNC::num_args > 0 && fastPathIteration &&
+      return_type_traits::typeKind != TypeKind::BOOLEAN &&
+      allArgsBatchEligibleImpl(std::make_index_sequence<FUNC::num_args>());
+
   /// When true, a fast path for each possible combination of encodings will be
   /// used for reading arguments when all arguments are flat or constant
   /// primitivies.
@@ -322,11 +347,17 @@ class SimpleFunctionAdapter : public VectorFunction {
     // - the argument is singly-referenced and has singly-referenced values
     // and nulls buffers.
     bool isResultReused = false;
+    [[maybe_unused]] bool callBatch = false;
+    if constexpr (batchEligible) {
+      callBatch = canCallBatch(rows, args);
+    }
     if constexpr (
         !FUNC::can_produce_null_output && !FUNC::udf_has_callNullFree &&
         return_type_traits::isPrimitiveType &&
         return_type_traits::isFixedWidth) {
-      if (!reusableResult->get()) {
+      // A callBatch() that gives up may have overwritten part of the input.
+      const bool mayGiveUp = callBatch && FUNC::udf_has_callBatch_return_bool;
+      if (!reusableResult->get() && !mayGiveUp) {
         if (auto* arg = findReusableArg<0>(args)) {
           if ((*arg)->type()->equivalent(*outputType)) {
             reusableResult = arg;
@@ -369,6 +400,15 @@ class SimpleFunctionAdapter : public VectorFunction {
       }
     }
 
+    if constexpr (batchEligible) {
+      if (callBatch && applyBatch(applyContext, args)) {
+        if (isResultReused) {
+          result = std::move(*reusableResult);
+        }
+        return;
+      }
+    }
+
     std::vector<std::optional<LocalDecodedVector>> decoded;
     if (allPrimitiveArgsFlatConstant(args)) {
       if constexpr (
@@ -476,6 +516,44 @@ class SimpleFunctionAdapter : public VectorFunction {
   }
 
  private:
+  // Returns true if all rows can be evaluated with one callBatch() call: all
+  // rows are selected and all arguments are flat without nulls.
+  static bool canCallBatch(
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) {
+    if (!rows.isAllSelected()) {
+      return false;
+    }
+    for (const auto& arg : args) {
+      if (!arg->isFlatEncoding() || arg->mayHaveNulls()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Returns false if callBatch() gave up and the rows need to be evaluated
+  // one at a time.
+  bool applyBatch(
+      ApplyContext& applyContext,
+      const std::vector<VectorPtr>& args) const {
+    return applyBatchImpl(
+        applyContext, args, std::make_index_sequence<FUNC::num_args>());
+  }
+
+  template <size_t... Is>
+  bool applyBatchImpl(
+      ApplyContext& applyContext,
+      const std::vector<VectorPtr>& args,
+      std::index_sequence<Is...>) const {
+    const auto size = applyContext.rows->end();
+    return fn_->callBatch(
+        folly::Range<T*>(applyContext.resultWriter.data_, size),
+        folly::Range<const exec_arg_at<Is>*>(
+            args[Is]->asUnchecked<FlatVector<exec_arg_at<Is>>>()->rawValues(),
+            size)...);
+  }
+
   // This is called only when we know that all args are flat or constant and are
   // eligible for the optimization and the optimization is enabled.
   template <int32_t POSITION, typename... TReader>
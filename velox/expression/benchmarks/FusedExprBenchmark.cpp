@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/functions/lib/benchmarks/FunctionBenchmarkBase.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+
+// Compares evaluating trees of arithmetic and comparison calls one call at a
+// time with evaluating them with a FusedExpr.
+
+using namespace facebook::velox;
+
+namespace {
+
+class FusedExprBenchmark : public functions::test::FunctionBenchmarkBase {
+ public:
+  FusedExprBenchmark() {
+    functions::prestosql::registerAllScalarFunctions();
+
+    constexpr vector_size_t kSize = 10'000;
+    std::vector<VectorPtr> doubles;
+    for (auto i = 0; i < 4; ++i) {
+      doubles.push_back(vectorMaker_.flatVector<double>(
+          kSize, [i](auto row) { return (row + i) % 100 + 0.5; }));
+    }
+    doubleData_ = vectorMaker_.rowVector(doubles);
+    bigintData_ = vectorMaker_.rowVector({
+        vectorMaker_.flatVector<int64_t>(
+            kSize, [](auto row) { return row % 1'000; }),
+        vectorMaker_.flatVector<int64_t>(
+            kSize, [](auto row) { return 1 + row % 7; }),
+    });
+  }
+
+  size_t run(const std::string& expression, bool fused, bool bigint) {
+    folly::BenchmarkSuspender suspender;
+    queryCtx_->testingOverrideConfigUnsafe({
+        {core::QueryConfig::kExprFusedEvaluationEnabled,
+         fused ? "true" : "false"},
+    });
+    const auto& data = bigint ? bigintData_ : doubleData_;
+    auto exprSet = compileExpression(expression, data->type());
+    SelectivityVector rows(data->size());
+    VectorPtr result;
+    suspender.dismiss();
+
+    size_t count = 0;
+    for (auto i = 0; i < 100; ++i) {
+      evaluate(exprSet, data, rows, result);
+      count += result->size();
+    }
+    return count;
+  }
+
+ private:
+  RowVectorPtr doubleData_;
+  RowVectorPtr bigintData_;
+};
+
+std::unique_ptr<FusedExprBenchmark> benchmark;
+
+const std::string kFilter = "(c0 * 1.07 - c1) / c2 > c3";
+const std::string kProjection =
+    "((c0 * 1.07 - c1) / c2 + c3 * 0.5) * (c0 - c3) + c1 * c2 / 3.0";
+const std::string kChecked = "(c0 * c1 + c0) / c1 - c0 * 3";
+
+BENCHMARK_MULTI(filter) {
+  return benchmark->run(kFilter, false, false);
+}
+
+BENCHMARK_RELATIVE_MULTI(filterFused) {
+  return benchmark->run(kFilter, true, false);
+}
+
+BENCHMARK_MULTI(projection) {
+  return benchmark->run(kProjection, false, false);
+}
+
+BENCHMARK_RELATIVE_MULTI(projectionFused) {
+  return benchmark->run(kProjection, true, false);
+}
+
+BENCHMARK_MULTI(checkedBigint) {
+  return benchmark->run(kChecked, false, true);
+}
+
+BENCHMARK_RELATIVE_MULTI(checkedBigintFused) {
+  return benchmark->run(kChecked, true, true);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  memory::MemoryManager::initialize(memory::MemoryManager::Options{});
+  benchmark = std::make_unique<FusedExprBenchmark>();
+  folly::runBenchmarks();
+  benchmark.reset();
+  return 0;
+}
@@ -1306,6 +1306,44 @@ TEST_F(CastExprTest, errorHandling) {
       "Non-whitespace character found after end of conversion");
 }
 
+TEST_F(CastExprTest, stringFastPath) {
+  // Strings in the common formats are parsed in a batch and the others fall
+  // back to the general parser, which produces the errors.
+  testTryCast<std::string, int64_t>(
+      "bigint",
+      {"123456789012345678",
+       "-123456789012345678",
+       "1234567890123456789",
+       " 12",
+       "0012",
+       "-",
+       "1e3",
+       std::nullopt},
+      {123456789012345678,
+       -123456789012345678,
+       1234567890123456789,
+       12,
+       12,
+       std::nullopt,
+       std::nullopt,
+       std::nullopt});
+  testTryCast<std::string, int16_t>(
+      "smallint",
+      {"32767", "-32768", "32768", "-32769", "12a"},
+      {32767, -32768, std::nullopt, std::nullopt, std::nullopt});
+  testTryCast<std::string, int32_t>(
+      "date",
+      {"2024-02-29", "2023-02-29", "2024-13-01", "2024-1-01", "1969-12-31"},
+      {19782, std::nullopt, std::nullopt, 19723, -1},
+      VARCHAR(),
+      DATE());
+  testCast(
+      makeFlatVector<StringView>(
+          {"12.34", "-0.5", "1.234", "12", "123456789.5", "1.2e1"}),
+      makeFlatVector<int64_t>(
+          {1234, -50, 123, 1200, 12345678950, 1200}, DECIMAL(12, 2)));
+}
+
 constexpr vector_size_t kVectorSize = 1'000;
 
 TEST_F(CastExprTest, mapCast) {
@@ -2171,6 +2171,39 @@ TEST_F(ExprTest, memo) {
   VELOX_CHECK_EQ(base.use_count(), 1);
 }
 
+TEST_F(ExprTest, memoReturnsCachedBase) {
+  // Verify that once all rows of a dictionary input are memoized, the result
+  // is a dictionary over the same base in every batch, so that a downstream
+  // expression over it is memoized as well.
+  auto base = makeFlatVector<std::string>({"Apple", "Banana", "Cherry"});
+  auto indices = makeIndices(30, [](auto row) { return row % 3; });
+  auto input = makeRowVector({wrapInDictionary(indices, 30, base)});
+
+  auto lowerExprSet = compileExpression("lower(c0)", asRowType(input->type()));
+  evaluate(lowerExprSet.get(), input);
+  evaluate(lowerExprSet.get(), input);
+  auto first = evaluate(lowerExprSet.get(), input);
+  auto second = evaluate(lowerExprSet.get(), input);
+
+  auto expected = wrapInDictionary(
+      indices, 30, makeFlatVector<std::string>({"apple", "banana", "cherry"}));
+  assertEqualVectors(expected, first);
+  assertEqualVectors(expected, second);
+  ASSERT_EQ(first->encoding(), VectorEncoding::Simple::DICTIONARY);
+  ASSERT_EQ(second->encoding(), VectorEncoding::Simple::DICTIONARY);
+  ASSERT_EQ(first->valueVector().get(), second->valueVector().get());
+
+  auto upperExprSet = compileExpression("upper(c0)", asRowType(input->type()));
+  evaluate(upperExprSet.get(), makeRowVector({first}));
+  evaluate(upperExprSet.get(), makeRowVector({second}));
+  auto [result, stats] =
+      evaluateWithStats(upperExprSet.get(), makeRowVector({second}));
+  expected = wrapInDictionary(
+      indices, 30, makeFlatVector<std::string>({"APPLE", "BANANA", "CHERRY"}));
+  assertEqualVectors(expected, result);
+  ASSERT_EQ(stats["upper"].numProcessedRows, 2 * base->size());
+}
+
 // This test triggers the situation when peelEncodings() produces an empty
 // selectivity vector, which if passed to evalWithMemo() causes the latter to
 // produce null Expr::dictionaryCache_, which leads to a crash in evaluation
@@ -5044,6 +5077,46 @@ TEST_F(ExprTest, disableMemoization) {
   ASSERT_EQ(stats["plus"].numProcessedRows, 3 * flatSize);
 }
 
+TEST_F(ExprTest, adaptiveAsciiScan) {
+  // Verify that inputs are no longer scanned for asciiness after 4 batches
+  // that are not all ASCII, are scanned again every 32 batches, and are
+  // scanned every batch once they are all ASCII again.
+  auto rowType = ROW({"c0"}, {VARCHAR()});
+  auto exprSet = compileExpression("length(c0)", rowType);
+  SelectivityVector rows(3);
+
+  auto evaluateBatch = [&](const std::vector<std::string>& values) {
+    auto input = makeFlatVector<std::string>(values);
+    auto result = evaluate(exprSet.get(), makeRowVector({input}));
+    assertEqualVectors(makeFlatVector<int64_t>({1, 1, 1}), result);
+    return input->isAscii(rows);
+  };
+
+  const std::vector<std::string> nonAscii = {"a", "à", "b"};
+  const std::vector<std::string> ascii = {"a", "b", "c"};
+  for (auto i = 0; i < 4; ++i) {
+    ASSERT_EQ(evaluateBatch(nonAscii), false);
+  }
+  for (auto i = 0; i < 31; ++i) {
+    ASSERT_EQ(evaluateBatch(ascii), std::nullopt);
+  }
+  ASSERT_EQ(evaluateBatch(ascii), true);
+  ASSERT_EQ(evaluateBatch(nonAscii), false);
+
+  // Adaptive scan disabled.
+  auto queryCtx = velox::core::QueryCtx::create(
+      nullptr,
+      core::QueryConfig(
+          {{core::QueryConfig::kExprAdaptiveAsciiScanEnabled, "false"}}));
+  auto execCtx = std::make_unique<core::ExecCtx>(pool_.get(), queryCtx.get());
+  exprSet = compileExpression("length(c0)", rowType);
+  for (auto i = 0; i < 8; ++i) {
+    auto input = makeFlatVector<std::string>(nonAscii);
+    evaluateWithStats(exprSet.get(), makeRowVector({input}), execCtx.get());
+    ASSERT_EQ(input->isAscii(rows), false);
+  }
+}
+
 TEST_F(ExprTest, disabledeferredLazyLoading) {
   // Verify that deferred lazy loading is disabled when the config is set by
   // confirming that all rows are loaded even when only a subset is required.
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/expression/FusedExpr.h"
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::test;
+
+namespace {
+
+class FusedExprTest : public functions::test::FunctionBaseTest {
+ protected:
+  void setFusedEvaluation(bool enabled) {
+    queryCtx_->testingOverrideConfigUnsafe({
+        {core::QueryConfig::kExprFusedEvaluationEnabled,
+         enabled ? "true" : "false"},
+    });
+  }
+
+  // Returns the number of calls fused into the top level expression of
+  // 'expression', 0 if it is not fused.
+  size_t numFusedCalls(const std::string& expression, const RowTypePtr& type) {
+    setFusedEvaluation(true);
+    auto exprSet = compileExpression(expression, type);
+    auto* fused = exprSet->exprs()[0]->as<exec::FusedExpr>();
+    return fused == nullptr ? 0 : fused->numFusedCalls();
+  }
+
+  // Checks that 'expression' gives the same result with and without fusion.
+  void testFused(
+      const std::string& expression,
+      const RowVectorPtr& data,
+      size_t expectedFusedCalls) {
+    ASSERT_EQ(
+        numFusedCalls(expression, asRowType(data->type())),
+        expectedFusedCalls);
+    setFusedEvaluation(false);
+    auto expected = evaluate(expression, data);
+    setFusedEvaluation(true);
+    assertEqualVectors(expected, evaluate(expression, data));
+  }
+};
+
+TEST_F(FusedExprTest, arithmeticAndComparison) {
+  constexpr vector_size_t kSize = 3'000;
+  auto data = makeRowVector({
+      makeFlatVector<double>(kSize, [](auto row) { return row * 0.3; }),
+      makeFlatVector<double>(
+          kSize, [](auto row) { return row % 17; }, nullEvery(7)),
+      makeFlatVector<double>(kSize, [](auto row) { return 1 + row % 5; }),
+      makeFlatVector<double>(
+          kSize, [](auto row) { return row % 11; }, nullEvery(13)),
+      makeFlatVector<int64_t>(kSize, [](auto row) { return row; }),
+  });
+
+  testFused("(c0 * 1.07 - c1) / c2 > c3", data, 4);
+  testFused("(c0 * 1.07 - c1) / c2", data, 3);
+  testFused("c0 + c0 * c0", data, 2);
+  testFused("(c0 * 1.07 - c1) / c2 > c3 AND c4 < c4 * c4", data, 0);
+  testFused("(c4 + c4) * c4 <= c4 - c4 * c4", data, 4);
+
+  setFusedEvaluation(true);
+  auto exprSet = compileExpression(
+      "(c0 * 1.07 - c1) / c2 > c3", asRowType(data->type()));
+  auto* fused = exprSet->exprs()[0]->as<exec::FusedExpr>();
+  ASSERT_TRUE(fused != nullptr);
+  // The inputs are the distinct columns and constants.
+  ASSERT_EQ(fused->inputs().size(), 5);
+  ASSERT_EQ(fused->toString(), fused->unfused()->toString());
+  ASSERT_EQ(fused->toString(false), exec::kFused);
+
+  // Both sides of the AND are fused.
+  exprSet = compileExpression(
+      "c0 * 2.0 + c1 > c3 AND c4 * c4 - c4 < c4 + c4",
+      asRowType(data->type()));
+  for (const auto& input : exprSet->exprs()[0]->inputs()) {
+    ASSERT_TRUE(input->is<exec::FusedExpr>());
+  }
+}
+
+TEST_F(FusedExprTest, types) {
+  auto data = makeRowVector({
+      makeFlatVector<int8_t>({1, 2, 3, -4, 5}),
+      makeFlatVector<int16_t>({100, -200, 300, 400, 500}),
+      makeFlatVector<int32_t>({1, 2, 3, 4, 5}),
+      makeFlatVector<float>({1.5, 2.5, -3.5, 4.5, 5.5}),
+      makeFlatVector<int32_t>({1, 2, 3, 4, 5}, DATE()),
+      makeFlatVector<int64_t>({1, 2, 3, 4, 5}, INTERVAL_DAY_TIME()),
+  });
+
+  testFused("c0 + c0 * c0", data, 2);
+  testFused("c1 - c1 / c1 = c1", data, 3);
+  testFused("c2 * c2 - c2 <> c2", data, 3);
+  testFused("c3 / c3 + c3 >= c3", data, 3);
+
+  // Single calls and calls on logical types are not fused.
+  ASSERT_EQ(numFusedCalls("c2 + c2", asRowType(data->type())), 0);
+  ASSERT_EQ(numFusedCalls("c5 + c5 = c5", asRowType(data->type())), 0);
+  ASSERT_EQ(numFusedCalls("c4 = c4", asRowType(data->type())), 0);
+  // Calls with other calls below them are not fused.
+  ASSERT_EQ(numFusedCalls("c2 + abs(c2) * c2", asRowType(data->type())), 0);
+}
+
+TEST_F(FusedExprTest, nan) {
+  constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+  constexpr double kInf = std::numeric_limits<double>::infinity();
+  auto data = makeRowVector({
+      makeFlatVector<double>({kNaN, 1, kNaN, kInf, 0, -1}),
+      makeFlatVector<double>({kNaN, kNaN, 1, kInf, 0, 0}),
+  });
+
+  for (const auto* op : {"=", "<>", "<", "<=", ">", ">="}) {
+    testFused(fmt::format("c0 + 0.0 {} c1 * 1.0", op), data, 3);
+  }
+  // Division by zero gives infinity or NaN.
+  testFused("c0 / c1 + 1.0", data, 2);
+}
+
+TEST_F(FusedExprTest, errors) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>({1, std::numeric_limits<int64_t>::max(), 3, 4}),
+      makeFlatVector<int64_t>({1, 2, 0, 4}),
+  });
+
+  setFusedEvaluation(true);
+  VELOX_ASSERT_THROW(
+      evaluate("c0 * c1 + 1", data),
+      "integer overflow: 9223372036854775807 * 2");
+  VELOX_ASSERT_THROW(evaluate("c0 / c1 - 1", data), "division by zero");
+
+  // Rows that fail are null in TRY.
+  auto expected = makeNullableFlatVector<int64_t>({2, std::nullopt, 1, 17});
+  assertEqualVectors(expected, evaluate("try(c0 * c1 + 1)", data));
+  expected = makeNullableFlatVector<int64_t>(
+      {0, 4'611'686'018'427'387'902, std::nullopt, 0});
+  assertEqualVectors(expected, evaluate("try(c0 / c1 - 1)", data));
+
+  // Rows that are not selected do not fail.
+  testFused("if(c1 > 0, c0 / c1 - 1, 0)", data, 0);
+  testFused("if(c0 < 100, c0 * c1 + 1, 0)", data, 0);
+}
+
+TEST_F(FusedExprTest, encodings) {
+  constexpr vector_size_t kSize = 2'000;
+  auto base = makeFlatVector<int64_t>(
+      kSize, [](auto row) { return row * 3; }, nullEvery(11));
+  auto indices = makeIndicesInReverse(kSize);
+  auto data = makeRowVector({
+      wrapInDictionary(indices, kSize, base),
+      makeConstant<int64_t>(7, kSize),
+      makeFlatVector<int64_t>(kSize, [](auto row) { return row; }),
+      makeNullConstant(TypeKind::BIGINT, kSize),
+  });
+
+  testFused("c0 * c1 - c2", data, 2);
+  testFused("c0 + c2 > c1 * c2", data, 3);
+  testFused("c0 + c2 * c3", data, 2);
+
+  // Sparse rows.
+  testFused("if(c2 % 3 = 0, c0 * c1 - c2, c2)", data, 0);
+  testFused("if(c2 % 3 = 0, c2 + c1 > c0 - 100, false)", data, 0);
+}
+
+} // namespace
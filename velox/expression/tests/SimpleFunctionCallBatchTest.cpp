@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/functions/Udf.h"
+#include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
+
+namespace facebook::velox {
+namespace {
+
+using namespace facebook::velox::test;
+
+int32_t numBatchCalls = 0;
+
+// Returns a * 10 + b.
+template <typename T>
+struct ShiftAddFunction {
+  VELOX_DEFINE_FUNCTION_TYPES(T);
+
+  void call(int64_t& out, int64_t a, int32_t b) {
+    out = a * 10 + b;
+  }
+
+  void callBatch(
+      folly::Range<int64_t*> out,
+      folly::Range<const int64_t*> a,
+      folly::Range<const int32_t*> b) {
+    ++numBatchCalls;
+    for (size_t i = 0; i < out.size(); ++i) {
+      out[i] = a[i] * 10 + b[i];
+    }
+  }
+};
+
+// Returns the square root of a non-negative integer, rounded down. Fails for
+// negative numbers.
+template <typename T>
+struct CheckedSqrtFunction {
+  VELOX_DEFINE_FUNCTION_TYPES(T);
+
+  void call(int64_t& out, int64_t a) {
+    VELOX_USER_CHECK_GE(a, 0, "Negative input");
+    out = std::sqrt(a);
+  }
+
+  bool callBatch(folly::Range<int64_t*> out, folly::Range<const int64_t*> a) {
+    ++numBatchCalls;
+    for (size_t i = 0; i < out.size(); ++i) {
+      if (a[i] < 0) {
+        return false;
+      }
+      out[i] = std::sqrt(a[i]);
+    }
+    return true;
+  }
+};
+
+class SimpleFunctionCallBatchTest : public functions::test::FunctionBaseTest {
+ protected:
+  static void SetUpTestCase() {
+    FunctionBaseTest::SetUpTestCase();
+    registerFunction<ShiftAddFunction, int64_t, int64_t, int32_t>(
+        {"shift_add"});
+    registerFunction<CheckedSqrtFunction, int64_t, int64_t>({"checked_sqrt"});
+  }
+
+  void SetUp() override {
+    FunctionBaseTest::SetUp();
+    numBatchCalls = 0;
+  }
+};
+
+TEST_F(SimpleFunctionCallBatchTest, flatNoNulls) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>({1, 2, 3, 4, 5}),
+      makeFlatVector<int32_t>({6, 7, 8, 9, 0}),
+  });
+  auto result = evaluate("shift_add(c0, c1)", data);
+  assertEqualVectors(makeFlatVector<int64_t>({16, 27, 38, 49, 50}), result);
+  EXPECT_EQ(numBatchCalls, 1);
+}
+
+TEST_F(SimpleFunctionCallBatchTest, rowByRow) {
+  // Nulls.
+  auto data = makeRowVector({
+      makeNullableFlatVector<int64_t>({1, std::nullopt, 3}),
+      makeFlatVector<int32_t>({6, 7, 8}),
+  });
+  auto result = evaluate("shift_add(c0, c1)", data);
+  assertEqualVectors(
+      makeNullableFlatVector<int64_t>({16, std::nullopt, 38}), result);
+
+  // Constant argument.
+  result = evaluate("shift_add(c0, 5)", data);
+  assertEqualVectors(
+      makeNullableFlatVector<int64_t>({15, std::nullopt, 35}), result);
+
+  // Not all rows selected.
+  data = makeRowVector({
+      makeFlatVector<int64_t>({1, 2, 3, 4}),
+      makeFlatVector<int32_t>({6, 7, 8, 9}),
+  });
+  result = evaluate("if(c0 % 2 = 0, shift_add(c0, c1), 0)", data);
+  assertEqualVectors(makeFlatVector<int64_t>({0, 27, 0, 49}), result);
+
+  EXPECT_EQ(numBatchCalls, 0);
+}
+
+TEST_F(SimpleFunctionCallBatchTest, giveUp) {
+  auto data = makeRowVector({makeFlatVector<int64_t>({1, 4, 9, 16})});
+  auto result = evaluate("checked_sqrt(c0)", data);
+  assertEqualVectors(makeFlatVector<int64_t>({1, 2, 3, 4}), result);
+  EXPECT_EQ(numBatchCalls, 1);
+
+  // The batch gives up at the negative number and the rows are evaluated one
+  // at a time.
+  data = makeRowVector({makeFlatVector<int64_t>({1, 4, -1, 16})});
+  result = evaluate("try(checked_sqrt(c0))", data);
+  assertEqualVectors(
+      makeNullableFlatVector<int64_t>({1, 2, std::nullopt, 4}), result);
+  EXPECT_EQ(numBatchCalls, 2);
+
+  VELOX_ASSERT_THROW(evaluate("checked_sqrt(c0)", data), "Negative input");
+}
+
+} // namespace
+} // namespace facebook::velox
@@ -132,6 +132,13 @@ DEFINE_bool(
     false,
     "Read back data after writing to SSD");
 
+// Used in functions/lib/RegexCache.cpp
+DEFINE_int64(
+    velox_regex_cache_max_bytes,
+    64 << 20,
+    "Approximate memory limit of the process-wide cache of compiled regular "
+    "expressions and LIKE patterns");
+
 // Used in /connectors/tpch
 DEFINE_int32(
     velox_tpch_text_pool_size_mb,
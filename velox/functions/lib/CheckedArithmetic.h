@@ -17,6 +17,9 @@
 
 #include <functional>
 #include <limits>
+
+#include <folly/Range.h>
+
 #include "velox/common/base/Exceptions.h"
 #include "velox/functions/Macros.h"
 #include "velox/functions/lib/CheckedArithmeticImpl.h"
@@ -30,6 +33,19 @@ struct CheckedPlusFunction {
   call(TInput& result, const TInput& a, const TInput& b) {
     result = checkedPlus(a, b);
   }
+
+  // Rows that overflow fail one at a time.
+  template <typename TInput>
+  bool callBatch(
+      folly::Range<TInput*> result,
+      folly::Range<const TInput*> a,
+      folly::Range<const TInput*> b) {
+    bool overflow = false;
+    for (size_t i = 0; i < result.size(); ++i) {
+      overflow |= __builtin_add_overflow(a[i], b[i], &result[i]);
+    }
+    return !overflow;
+  }
 };
 
 template <typename T>
@@ -39,6 +55,19 @@ struct CheckedMinusFunction {
   call(TInput& result, const TInput& a, const TInput& b) {
     result = checkedMinus(a, b);
   }
+
+  // Rows that overflow fail one at a time.
+  template <typename TInput>
+  bool callBatch(
+      folly::Range<TInput*> result,
+      folly::Range<const TInput*> a,
+      folly::Range<const TInput*> b) {
+    bool overflow = false;
+    for (size_t i = 0; i < result.size(); ++i) {
+      overflow |= __builtin_sub_overflow(a[i], b[i], &result[i]);
+    }
+    return !overflow;
+  }
 };
 
 template <typename T>
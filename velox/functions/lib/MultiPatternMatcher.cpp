@@ -0,0 +1,304 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/functions/lib/MultiPatternMatcher.h"
+
+#include <algorithm>
+#include <deque>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/functions/lib/Re2Functions.h"
+#include "velox/functions/lib/string/StringImpl.h"
+
+namespace facebook::velox::functions {
+
+namespace {
+
+re2::StringPiece toStringPiece(std::string_view s) {
+  return re2::StringPiece(s.data(), s.size());
+}
+
+RE2::Options likeOptions() {
+  RE2::Options options{RE2::Quiet};
+  options.set_dot_nl(true);
+  return options;
+}
+
+} // namespace
+
+AhoCorasick::AhoCorasick() {
+  nodes_.emplace_back();
+}
+
+void AhoCorasick::add(std::string_view pattern, uint8_t kind) {
+  VELOX_CHECK(!built_, "Cannot add patterns after build()");
+  if (pattern.empty()) {
+    emptyPatternKinds_ |= kind;
+    return;
+  }
+
+  int32_t node = 0;
+  for (auto c : pattern) {
+    const auto byte = static_cast<uint8_t>(c);
+    auto& children = nodes_[node].children;
+    auto it = std::find_if(
+        children.begin(), children.end(), [&](const auto& child) {
+          return child.first == byte;
+        });
+    if (it != children.end()) {
+      node = it->second;
+      continue;
+    }
+    const int32_t newNode = nodes_.size();
+    const auto depth = nodes_[node].depth + 1;
+    nodes_[node].children.emplace_back(byte, newNode);
+    nodes_.emplace_back();
+    nodes_.back().depth = depth;
+    node = newNode;
+  }
+  nodes_[node].kinds |= kind;
+}
+
+void AhoCorasick::build() {
+  VELOX_CHECK(!built_, "build() can be called only once");
+  built_ = true;
+  for (auto& node : nodes_) {
+    std::sort(node.children.begin(), node.children.end());
+  }
+  for (const auto& [byte, child] : nodes_[0].children) {
+    rootNext_[byte] = child;
+  }
+
+  // Breadth first, so that the failure links of all shallower nodes are set
+  // when a node is reached.
+  std::deque<int32_t> queue;
+  for (const auto& [byte, child] : nodes_[0].children) {
+    queue.push_back(child);
+  }
+  while (!queue.empty()) {
+    const auto node = queue.front();
+    queue.pop_front();
+    for (const auto& [byte, child] : nodes_[node].children) {
+      const auto fail = node == 0 ? 0 : next(nodes_[node].fail, byte);
+      nodes_[child].fail = fail;
+      nodes_[child].output =
+          nodes_[fail].kinds != 0 ? fail : nodes_[fail].output;
+      queue.push_back(child);
+    }
+  }
+}
+
+int32_t AhoCorasick::child(int32_t node, uint8_t byte) const {
+  const auto& children = nodes_[node].children;
+  auto it = std::lower_bound(
+      children.begin(),
+      children.end(),
+      byte,
+      [](const auto& child, uint8_t byte) { return child.first < byte; });
+  return it != children.end() && it->first == byte ? it->second : 0;
+}
+
+int32_t AhoCorasick::next(int32_t node, uint8_t byte) const {
+  while (node != 0) {
+    if (auto next = child(node, byte)) {
+      return next;
+    }
+    node = nodes_[node].fail;
+  }
+  return rootNext_[byte];
+}
+
+bool AhoCorasick::matchAt(int32_t node, size_t end, size_t size) const {
+  const auto& state = nodes_[node];
+  if (state.kinds & kContains) {
+    return true;
+  }
+  if ((state.kinds & kStartsWith) && state.depth == end) {
+    return true;
+  }
+  if (end == size) {
+    if (state.kinds & kEndsWith) {
+      return true;
+    }
+    if ((state.kinds & kEquals) && state.depth == size) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool AhoCorasick::match(std::string_view input) const {
+  VELOX_DCHECK(built_);
+  if (emptyPatternKinds_ & (kContains | kStartsWith | kEndsWith)) {
+    return true;
+  }
+  if (input.empty()) {
+    return emptyPatternKinds_ & kEquals;
+  }
+
+  int32_t state = 0;
+  for (size_t i = 0; i < input.size(); ++i) {
+    state = next(state, static_cast<uint8_t>(input[i]));
+    auto node = nodes_[state].kinds != 0 ? state : nodes_[state].output;
+    while (node != 0) {
+      if (matchAt(node, i + 1, input.size())) {
+        return true;
+      }
+      node = nodes_[node].output;
+    }
+  }
+  return false;
+}
+
+MultiPatternMatcher::RegexpSet::RegexpSet(
+    const RE2::Options& options,
+    RE2::Anchor anchor)
+    : options_(options), anchor_(anchor) {}
+
+void MultiPatternMatcher::RegexpSet::add(const std::string& pattern) {
+  patterns_.push_back(pattern);
+}
+
+void MultiPatternMatcher::RegexpSet::compile() {
+  if (patterns_.empty()) {
+    return;
+  }
+  set_ = std::make_unique<RE2::Set>(options_, anchor_);
+  for (const auto& pattern : patterns_) {
+    std::string error;
+    if (set_->Add(toStringPiece(pattern), &error) < 0) {
+      VELOX_USER_FAIL("invalid regular expression:{}", error);
+    }
+  }
+  if (!set_->Compile()) {
+    // Too many patterns to compile into one program.
+    set_.reset();
+    compileEach();
+  }
+}
+
+void MultiPatternMatcher::RegexpSet::compileEach() const {
+  std::call_once(compileEachOnce_, [&]() {
+    regexps_.reserve(patterns_.size());
+    for (const auto& pattern : patterns_) {
+      regexps_.push_back(
+          std::make_unique<RE2>(toStringPiece(pattern), options_));
+    }
+  });
+}
+
+bool MultiPatternMatcher::RegexpSet::match(std::string_view input) const {
+  if (patterns_.empty()) {
+    return false;
+  }
+  if (set_ != nullptr) {
+    RE2::Set::ErrorInfo errorInfo;
+    if (set_->Match(toStringPiece(input), nullptr, &errorInfo)) {
+      return true;
+    }
+    if (errorInfo.kind != RE2::Set::kOutOfMemory) {
+      return false;
+    }
+    // The DFA of the set ran out of memory on 'input'. Match the patterns one
+    // by one.
+    compileEach();
+  }
+  const auto text = toStringPiece(input);
+  for (const auto& regexp : regexps_) {
+    if (RE2::PartialMatch(text, *regexp)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+MultiPatternMatcher::MultiPatternMatcher(
+    const std::vector<std::string>& likePatterns,
+    const std::vector<std::string>& regexps)
+    : likeRegexps_(likeOptions(), RE2::UNANCHORED),
+      regexps_(RE2::Quiet, RE2::UNANCHORED) {
+  int64_t maxExactLength = -1;
+  for (const auto& pattern : likePatterns) {
+    const auto metadata = determinePatternKind(pattern, std::nullopt);
+    switch (metadata.patternKind()) {
+      case PatternKind::kFixed:
+        fixedPatterns_.add(metadata.fixedPattern(), AhoCorasick::kEquals);
+        break;
+      case PatternKind::kPrefix:
+        fixedPatterns_.add(metadata.fixedPattern(), AhoCorasick::kStartsWith);
+        break;
+      case PatternKind::kSuffix:
+        fixedPatterns_.add(metadata.fixedPattern(), AhoCorasick::kEndsWith);
+        break;
+      case PatternKind::kSubstring:
+        fixedPatterns_.add(metadata.fixedPattern(), AhoCorasick::kContains);
+        break;
+      case PatternKind::kExactlyN:
+        exactLengths_.push_back(metadata.length());
+        maxExactLength =
+            std::max<int64_t>(maxExactLength, metadata.length());
+        break;
+      case PatternKind::kAtLeastN:
+        minLength_ = minLength_ < 0
+            ? metadata.length()
+            : std::min<int64_t>(minLength_, metadata.length());
+        break;
+      default: {
+        bool validPattern;
+        likeRegexps_.add(likePatternToRe2(
+            StringView(pattern), std::nullopt, validPattern));
+        // Without an escape character all patterns are valid.
+        VELOX_DCHECK(validPattern);
+      }
+    }
+  }
+  // Lengths are counted up to one more than the longest exact length, so that
+  // longer strings do not match it.
+  maxLengthToCount_ = std::max<int64_t>(minLength_, maxExactLength + 1);
+
+  for (const auto& regexp : regexps) {
+    regexps_.add(regexp);
+  }
+
+  fixedPatterns_.build();
+  likeRegexps_.compile();
+  regexps_.compile();
+}
+
+bool MultiPatternMatcher::match(std::string_view input) const {
+  if (!fixedPatterns_.empty() && fixedPatterns_.match(input)) {
+    return true;
+  }
+  if (minLength_ >= 0 || !exactLengths_.empty()) {
+    const auto length =
+        stringImpl::cappedLength<false>(input, maxLengthToCount_);
+    if (minLength_ >= 0 && length >= minLength_) {
+      return true;
+    }
+    if (std::find(exactLengths_.begin(), exactLengths_.end(), length) !=
+        exactLengths_.end()) {
+      return true;
+    }
+  }
+  return likeRegexps_.match(input) || regexps_.match(input);
+}
+
+// static
+bool MultiPatternMatcher::isValidRegexp(const std::string& regexp) {
+  RE2 re(toStringPiece(regexp), RE2::Quiet);
+  return re.ok();
+}
+
+} // namespace facebook::velox::functions
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <re2/re2.h>
+#include <re2/set.h>
+
+namespace facebook::velox::functions {
+
+/// Aho-Corasick automaton over bytes. Reports whether a string contains,
+/// starts with, ends with or is equal to any of a set of strings in one pass
+/// over the string.
+class AhoCorasick {
+ public:
+  /// How a string added with add() must occur in the input to match.
+  static constexpr uint8_t kContains = 1;
+  static constexpr uint8_t kStartsWith = 2;
+  static constexpr uint8_t kEndsWith = 4;
+  static constexpr uint8_t kEquals = 8;
+
+  AhoCorasick();
+
+  /// Adds 'pattern' with one of the above kinds. Must not be called after
+  /// build().
+  void add(std::string_view pattern, uint8_t kind);
+
+  /// Computes the failure links. Must be called once before match().
+  void build();
+
+  /// Returns true if any pattern occurs in 'input' as required by its kind.
+  bool match(std::string_view input) const;
+
+  bool empty() const {
+    return nodes_.size() == 1 && emptyPatternKinds_ == 0;
+  }
+
+ private:
+  struct Node {
+    // Sorted by byte after build().
+    std::vector<std::pair<uint8_t, int32_t>> children;
+    // Node for the longest proper suffix of this node's string that is in the
+    // trie.
+    int32_t fail{0};
+    // Nearest node on the failure chain that ends a pattern, 0 if none.
+    int32_t output{0};
+    // Length of the string of this node.
+    int32_t depth{0};
+    // Kinds of the patterns that end at this node.
+    uint8_t kinds{0};
+  };
+
+  int32_t child(int32_t node, uint8_t byte) const;
+
+  // Follows the transition for 'byte' from 'node', taking failure links.
+  int32_t next(int32_t node, uint8_t byte) const;
+
+  bool matchAt(int32_t node, size_t end, size_t size) const;
+
+  // Node 0 is the root.
+  std::vector<Node> nodes_;
+  // Transitions from the root, so that the most frequent state does not
+  // search its children.
+  std::array<int32_t, 256> rootNext_{};
+  // Kinds of empty patterns.
+  uint8_t emptyPatternKinds_{0};
+  bool built_{false};
+};
+
+/// Matches a string against many LIKE patterns and regular expressions in one
+/// pass per matching engine. LIKE patterns that are fixed strings, prefixes,
+/// suffixes or substrings are matched with an Aho-Corasick automaton, patterns
+/// that only constrain the length are checked by length and all other
+/// patterns are matched with an RE2::Set. The matcher is immutable and may be
+/// shared between threads.
+class MultiPatternMatcher {
+ public:
+  /// 'likePatterns' are LIKE patterns without an escape character. 'regexps'
+  /// are RE2 patterns that match if they match a substring of the input, like
+  /// regexp_like. Throws if a regular expression is invalid.
+  MultiPatternMatcher(
+      const std::vector<std::string>& likePatterns,
+      const std::vector<std::string>& regexps);
+
+  /// Returns true if 'input' matches at least one of the patterns.
+  bool match(std::string_view input) const;
+
+  /// Returns true if 'regexp' is a valid regular expression for the
+  /// constructor.
+  static bool isValidRegexp(const std::string& regexp);
+
+ private:
+  // RE2 patterns matched as one set, with individually compiled patterns for
+  // inputs on which the set runs out of memory.
+  class RegexpSet {
+   public:
+    RegexpSet(const RE2::Options& options, RE2::Anchor anchor);
+
+    void add(const std::string& pattern);
+
+    void compile();
+
+    bool match(std::string_view input) const;
+
+    bool empty() const {
+      return patterns_.empty();
+    }
+
+   private:
+    // Compiles each pattern into 'regexps_' on first use.
+    void compileEach() const;
+
+    const RE2::Options options_;
+    const RE2::Anchor anchor_;
+    std::vector<std::string> patterns_;
+    // Null if the patterns are too many to compile into one set.
+    std::unique_ptr<RE2::Set> set_;
+    mutable std::once_flag compileEachOnce_;
+    mutable std::vector<std::unique_ptr<RE2>> regexps_;
+  };
+
+  AhoCorasick fixedPatterns_;
+
+  // Character lengths of patterns like '___'.
+  std::vector<int64_t> exactLengths_;
+  // Smallest character length of patterns like '__%', -1 if none.
+  int64_t minLength_{-1};
+  // Character length to stop counting at.
+  int64_t maxLengthToCount_{0};
+
+  // LIKE patterns translated to regular expressions.
+  RegexpSet likeRegexps_;
+  RegexpSet regexps_;
+};
+
+} // namespace facebook::velox::functions
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 #include "velox/functions/lib/Re2Functions.h"
+#include "velox/core/Expressions.h"
+#include "velox/functions/lib/MultiPatternMatcher.h"
 #include "velox/functions/lib/string/StringImpl.h"
 #include "velox/vector/FunctionVector.h"
 
@@ -35,7 +37,7 @@ re2::StringPiece toStringPiece(const T& s) {
 
 namespace detail {
 
-Expected<RE2*> ReCache::tryFindOrCompile(const StringView& pattern) {
+Expected<const RE2*> ReCache::tryFindOrCompile(const StringView& pattern) {
   const std::string key = pattern;
 
   auto reIt = cache_.find(key);
@@ -48,7 +50,8 @@ Expected<RE2*> ReCache::tryFindOrCompile(const StringView& pattern) {
         Status::UserError("Max number of regex reached"));
   }
 
-  auto re = std::make_unique<RE2>(toStringPiece(pattern), RE2::Quiet);
+  auto re = RegexCache::instance().findOrCompile(
+      std::string_view(pattern), RE2::Quiet);
   if (!re->ok()) {
     return folly::makeUnexpected(
         Status::UserError("invalid regular expression:{}", re->error()));
@@ -60,7 +63,7 @@ Expected<RE2*> ReCache::tryFindOrCompile(const StringView& pattern) {
   return it->second.get();
 }
 
-RE2* ReCache::findOrCompile(const StringView& pattern) {
+const RE2* ReCache::findOrCompile(const StringView& pattern) {
   return tryFindOrCompile(pattern).thenOrThrow(
       folly::identity,
       [&](const Status& status) { VELOX_USER_FAIL("{}", status.message()); });
@@ -157,6 +160,8 @@ bool re2Extract(
   }
 }
 
+} // namespace
+
 std::string likePatternToRe2(
     StringView pattern,
     std::optional<char> escapeChar,
@@ -213,11 +218,15 @@ std::string likePatternToRe2(
   return regex;
 }
 
+namespace {
+
 template <bool (*Fn)(StringView, const RE2&)>
 class Re2MatchConstantPattern final : public exec::VectorFunction {
  public:
   explicit Re2MatchConstantPattern(StringView pattern)
-      : re_(toStringPiece(pattern), RE2::Quiet) {}
+      : re_(RegexCache::instance().findOrCompile(
+            std::string_view(pattern),
+            RE2::Quiet)) {}
 
   void apply(
       const SelectivityVector& rows,
@@ -229,19 +238,19 @@ class Re2MatchConstantPattern final : public exec::VectorFunction {
     FlatVector<bool>& result = ensureWritableBool(rows, context, resultRef);
     exec::LocalDecodedVector toSearch(context, *args[0], rows);
     try {
-      checkForBadPattern(re_);
+      checkForBadPattern(*re_);
     } catch (const std::exception&) {
       context.setErrors(rows, std::current_exception());
       return;
     }
 
     context.applyToSelectedNoThrow(rows, [&](vector_size_t i) {
-      result.set(i, Fn(toSearch->valueAt<StringView>(i), re_));
+      result.set(i, Fn(toSearch->valueAt<StringView>(i), *re_));
     });
   }
 
  private:
-  RE2 re_;
+  const std::shared_ptr<const RE2> re_;
 };
 
 template <bool (*Fn)(StringView, const RE2&)>
@@ -292,7 +301,10 @@ class Re2SearchAndExtractConstantPattern final : public exec::VectorFunction {
   explicit Re2SearchAndExtractConstantPattern(
       StringView pattern,
       bool emptyNoMatch)
-      : re_(toStringPiece(pattern), RE2::Quiet), emptyNoMatch_(emptyNoMatch) {}
+      : re_(RegexCache::instance().findOrCompile(
+            std::string_view(pattern),
+            RE2::Quiet)),
+        emptyNoMatch_(emptyNoMatch) {}
 
   void apply(
       const SelectivityVector& rows,
@@ -307,7 +319,7 @@ class Re2SearchAndExtractConstantPattern final : public exec::VectorFunction {
 
     // apply() will not be invoked if the selection is empty.
     try {
-      checkForBadPattern(re_);
+      checkForBadPattern(*re_);
     } catch (const std::exception&) {
       context.setErrors(rows, std::current_exception());
       return;
@@ -321,7 +333,7 @@ class Re2SearchAndExtractConstantPattern final : public exec::VectorFunction {
       groups.resize(1);
       context.applyToSelectedNoThrow(rows, [&](vector_size_t i) {
         mustRefSourceStrings |=
-            re2Extract(result, i, re_, toSearch, groups, 0, emptyNoMatch_);
+            re2Extract(result, i, *re_, toSearch, groups, 0, emptyNoMatch_);
       });
       if (mustRefSourceStrings) {
         result.acquireSharedStringBuffers(toSearch->base());
@@ -331,7 +343,7 @@ class Re2SearchAndExtractConstantPattern final : public exec::VectorFunction {
 
     if (const auto groupId = getIfConstant<T>(*args[2])) {
       try {
-        checkForBadGroupId(*groupId, re_);
+        checkForBadGroupId(*groupId, *re_);
       } catch (const std::exception&) {
         context.setErrors(rows, std::current_exception());
         return;
@@ -340,7 +352,7 @@ class Re2SearchAndExtractConstantPattern final : public exec::VectorFunction {
       groups.resize(*groupId + 1);
       context.applyToSelectedNoThrow(rows, [&](vector_size_t i) {
         mustRefSourceStrings |= re2Extract(
-            result, i, re_, toSearch, groups, *groupId, emptyNoMatch_);
+            result, i, *re_, toSearch, groups, *groupId, emptyNoMatch_);
       });
       if (mustRefSourceStrings) {
         result.acquireSharedStringBuffers(toSearch->base());
@@ -352,12 +364,12 @@ class Re2SearchAndExtractConstantPattern final : public exec::VectorFunction {
     // number of capturing groups + 1.
     exec::LocalDecodedVector groupIds(context, *args[2], rows);
 
-    groups.resize(re_.NumberOfCapturingGroups() + 1);
+    groups.resize(re_->NumberOfCapturingGroups() + 1);
     context.applyToSelectedNoThrow(rows, [&](vector_size_t i) {
       T group = groupIds->valueAt<T>(i);
-      checkForBadGroupId(group, re_);
+      checkForBadGroupId(group, *re_);
       mustRefSourceStrings |=
-          re2Extract(result, i, re_, toSearch, groups, group, emptyNoMatch_);
+          re2Extract(result, i, *re_, toSearch, groups, group, emptyNoMatch_);
     });
     if (mustRefSourceStrings) {
       result.acquireSharedStringBuffers(toSearch->base());
@@ -365,7 +377,7 @@ class Re2SearchAndExtractConstantPattern final : public exec::VectorFunction {
   }
 
  private:
-  RE2 re_;
+  const std::shared_ptr<const RE2> re_;
   // If true, returns empty string as result for no match case, which is Spark's
   // behavior. Otherwise, returns null as result, which is Presto's behavior.
   const bool emptyNoMatch_;
@@ -856,9 +868,8 @@ class LikeWithRe2 final : public exec::VectorFunction {
   LikeWithRe2(StringView pattern, std::optional<char> escapeChar) {
     RE2::Options opt{RE2::Quiet};
     opt.set_dot_nl(true);
-    re_.emplace(
-        toStringPiece(likePatternToRe2(pattern, escapeChar, validPattern_)),
-        opt);
+    re_ = RegexCache::instance().findOrCompile(
+        likePatternToRe2(pattern, escapeChar, validPattern_), opt);
   }
 
   void apply(
@@ -910,7 +921,7 @@ class LikeWithRe2 final : public exec::VectorFunction {
   }
 
  private:
-  std::optional<RE2> re_;
+  std::shared_ptr<const RE2> re_;
   bool validPattern_;
 };
 
@@ -935,7 +946,7 @@ class LikeGeneric final : public exec::VectorFunction {
     auto applyWithRegex = [&](const StringView& input,
                               const StringView& pattern,
                               const std::optional<char>& escapeChar) -> bool {
-      auto* re = findOrCompileRegex(pattern, escapeChar);
+      const auto* re = findOrCompileRegex(pattern, escapeChar);
       return re2FullMatch(input, *re);
     };
 
@@ -1028,7 +1039,7 @@ class LikeGeneric final : public exec::VectorFunction {
   }
 
  private:
-  RE2* findOrCompileRegex(
+  const RE2* findOrCompileRegex(
       const StringView& pattern,
       std::optional<char> escapeChar) const {
     const auto key =
@@ -1052,7 +1063,7 @@ class LikeGeneric final : public exec::VectorFunction {
 
     RE2::Options opt{RE2::Quiet};
     opt.set_dot_nl(true);
-    auto re = std::make_unique<RE2>(toStringPiece(regex), opt);
+    auto re = RegexCache::instance().findOrCompile(regex, opt);
     checkForBadPattern(*re);
 
     auto [it, inserted] =
@@ -1064,7 +1075,7 @@ class LikeGeneric final : public exec::VectorFunction {
 
   mutable folly::F14FastMap<
       std::pair<std::string, std::optional<char>>,
-      std::unique_ptr<RE2>>
+      std::shared_ptr<const RE2>>
       compiledRegularExpressions_;
   int64_t maxCompiledRegexes_;
 };
@@ -1111,7 +1122,9 @@ template <typename T>
 class Re2ExtractAllConstantPattern final : public exec::VectorFunction {
  public:
   explicit Re2ExtractAllConstantPattern(StringView pattern)
-      : re_(toStringPiece(pattern), RE2::Quiet) {}
+      : re_(RegexCache::instance().findOrCompile(
+            std::string_view(pattern),
+            RE2::Quiet)) {}
 
   void apply(
       const SelectivityVector& rows,
@@ -1121,7 +1134,7 @@ class Re2ExtractAllConstantPattern final : public exec::VectorFunction {
       VectorPtr& resultRef) const final {
     VELOX_CHECK(args.size() == 2 || args.size() == 3);
     try {
-      checkForBadPattern(re_);
+      checkForBadPattern(*re_);
     } catch (const std::exception&) {
       context.setErrors(rows, std::current_exception());
       return;
@@ -1140,13 +1153,13 @@ class Re2ExtractAllConstantPattern final : public exec::VectorFunction {
       //
       groups.resize(1);
       context.applyToSelectedNoThrow(rows, [&](vector_size_t row) {
-        re2ExtractAll(resultWriter, re_, inputStrs, row, groups, 0);
+        re2ExtractAll(resultWriter, *re_, inputStrs, row, groups, 0);
       });
     } else if (const auto _groupId = getIfConstant<T>(*args[2])) {
       // Case 2: Constant groupId
       //
       try {
-        checkForBadGroupId(*_groupId, re_);
+        checkForBadGroupId(*_groupId, *re_);
       } catch (const std::exception&) {
         context.setErrors(rows, std::current_exception());
         return;
@@ -1154,18 +1167,18 @@ class Re2ExtractAllConstantPattern final : public exec::VectorFunction {
 
       groups.resize(*_groupId + 1);
       context.applyToSelectedNoThrow(rows, [&](vector_size_t row) {
-        re2ExtractAll(resultWriter, re_, inputStrs, row, groups, *_groupId);
+        re2ExtractAll(resultWriter, *re_, inputStrs, row, groups, *_groupId);
       });
     } else {
       // Case 3: Variable groupId, so resize the groups vector to accommodate
       // number of capturing groups + 1.
       exec::LocalDecodedVector groupIds(context, *args[2], rows);
 
-      groups.resize(re_.NumberOfCapturingGroups() + 1);
+      groups.resize(re_->NumberOfCapturingGroups() + 1);
       context.applyToSelectedNoThrow(rows, [&](vector_size_t row) {
         const T groupId = groupIds->valueAt<T>(row);
-        checkForBadGroupId(groupId, re_);
-        re2ExtractAll(resultWriter, re_, inputStrs, row, groups, groupId);
+        checkForBadGroupId(groupId, *re_);
+        re2ExtractAll(resultWriter, *re_, inputStrs, row, groups, groupId);
       });
     }
 
@@ -1178,7 +1191,7 @@ class Re2ExtractAllConstantPattern final : public exec::VectorFunction {
   }
 
  private:
-  RE2 re_;
+  const std::shared_ptr<const RE2> re_;
 };
 
 template <typename T>
@@ -1643,6 +1656,98 @@ class RegexpReplaceWithLambdaFunction : public exec::VectorFunction {
   mutable detail::ReCache cache_;
 };
 
+// Matches a string against constant arrays of LIKE patterns and regular
+// expressions. Returns true if any of them matches.
+class LikeAny final : public exec::VectorFunction {
+ public:
+  LikeAny(
+      const std::vector<std::string>& likePatterns,
+      const std::vector<std::string>& regexps)
+      : matcher_(likePatterns, regexps) {}
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& /* outputType */,
+      exec::EvalCtx& context,
+      VectorPtr& resultRef) const final {
+    FlatVector<bool>& result = ensureWritableBool(rows, context, resultRef);
+    exec::LocalDecodedVector input(context, *args[0], rows);
+    context.applyToSelectedNoThrow(rows, [&](vector_size_t i) {
+      const auto value = input->valueAt<StringView>(i);
+      result.set(i, matcher_.match(std::string_view(value)));
+    });
+  }
+
+ private:
+  const MultiPatternMatcher matcher_;
+};
+
+// Returns the elements of the constant array 'constant'.
+std::vector<std::string> constantArrayOfStrings(
+    const std::string& name,
+    const BaseVector* constant) {
+  VELOX_USER_CHECK(
+      constant != nullptr && !constant->isNullAt(0),
+      "{} requires constant non-null patterns",
+      name);
+  const auto* array = constant->wrappedVector()->as<ArrayVector>();
+  const auto index = constant->wrappedIndex(0);
+  const auto offset = array->offsetAt(index);
+  const auto size = array->sizeAt(index);
+
+  SelectivityVector elementRows(offset + size, false);
+  elementRows.setValidRange(offset, offset + size, true);
+  elementRows.updateBounds();
+  DecodedVector elements(*array->elements(), elementRows);
+
+  std::vector<std::string> strings;
+  strings.reserve(size);
+  for (auto i = offset; i < offset + size; ++i) {
+    VELOX_USER_CHECK(
+        !elements.isNullAt(i), "{} patterns must not be null", name);
+    strings.emplace_back(elements.valueAt<StringView>(i));
+  }
+  return strings;
+}
+
+// Returns the constant pattern of 'call' if it is a call to 'name' with a
+// column or expression and a constant non-null VARCHAR pattern.
+std::optional<std::string> constantPatternArg(
+    const core::CallTypedExpr& call,
+    const std::string& name) {
+  if (call.name() != name || call.inputs().size() != 2 ||
+      !call.inputs()[0]->type()->isVarchar()) {
+    return std::nullopt;
+  }
+  const auto* constant =
+      dynamic_cast<const core::ConstantTypedExpr*>(call.inputs()[1].get());
+  if (constant == nullptr || !constant->type()->isVarchar() ||
+      constant->isNull()) {
+    return std::nullopt;
+  }
+  if (constant->hasValueVector()) {
+    return std::string(constant->valueVector()
+                           ->as<SimpleVector<StringView>>()
+                           ->valueAt(0));
+  }
+  return constant->value().value<TypeKind::VARCHAR>();
+}
+
+// Adds the disjuncts of a tree of ORs rooted at 'expr' to 'disjuncts'.
+void flattenOr(
+    const core::TypedExprPtr& expr,
+    std::vector<core::TypedExprPtr>& disjuncts) {
+  const auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call != nullptr && call->name() == "or") {
+    for (const auto& input : call->inputs()) {
+      flattenOr(input, disjuncts);
+    }
+  } else {
+    disjuncts.push_back(expr);
+  }
+}
+
 } // namespace
 
 std::shared_ptr<exec::VectorFunction> makeRe2Match(
@@ -2271,8 +2376,8 @@ std::shared_ptr<exec::VectorFunction> makeLike(
       }
     }
 
-    patternMetadata =
-        determinePatternKind(std::string_view(pattern), escapeChar);
+    patternMetadata = *RegexCache::instance().findOrDeterminePatternKind(
+        std::string_view(pattern), escapeChar);
   } catch (...) {
     return std::make_shared<exec::AlwaysFailingVectorFunction>(
         std::current_exception());
@@ -2329,6 +2434,125 @@ std::vector<std::shared_ptr<exec::FunctionSignature>> likeSignatures() {
   };
 }
 
+std::shared_ptr<exec::VectorFunction> makeLikeAny(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& /* config */) {
+  VELOX_USER_CHECK_EQ(inputArgs.size(), 3, "{} requires 3 arguments", name);
+  return std::make_shared<LikeAny>(
+      constantArrayOfStrings(name, inputArgs[1].constantValue.get()),
+      constantArrayOfStrings(name, inputArgs[2].constantValue.get()));
+}
+
+std::vector<std::shared_ptr<exec::FunctionSignature>> likeAnySignatures() {
+  // varchar, array(varchar), array(varchar) -> boolean
+  return {exec::FunctionSignatureBuilder()
+              .returnType("boolean")
+              .argumentType("varchar")
+              .constantArgumentType("array(varchar)")
+              .constantArgumentType("array(varchar)")
+              .build()};
+}
+
+core::TypedExprPtr rewriteLikeDisjunction(
+    const std::string& prefix,
+    const core::TypedExprPtr& expr) {
+  const auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call == nullptr || call->name() != "or") {
+    return nullptr;
+  }
+
+  std::vector<core::TypedExprPtr> disjuncts;
+  flattenOr(expr, disjuncts);
+
+  // The patterns applied to each distinct string expression, in order of
+  // first appearance.
+  struct PatternGroup {
+    core::TypedExprPtr input;
+    std::vector<std::string> likePatterns;
+    std::vector<std::string> regexps;
+    std::vector<size_t> disjuncts;
+  };
+  std::vector<PatternGroup> groups;
+
+  const auto likeName = prefix + "like";
+  const auto regexpLikeName = prefix + "regexp_like";
+  for (size_t i = 0; i < disjuncts.size(); ++i) {
+    const auto* disjunct =
+        dynamic_cast<const core::CallTypedExpr*>(disjuncts[i].get());
+    if (disjunct == nullptr) {
+      continue;
+    }
+    auto likePattern = constantPatternArg(*disjunct, likeName);
+    auto regexp = likePattern.has_value()
+        ? std::nullopt
+        : constantPatternArg(*disjunct, regexpLikeName);
+    // Invalid regular expressions are left to regexp_like to report.
+    if (regexp.has_value() && !MultiPatternMatcher::isValidRegexp(*regexp)) {
+      continue;
+    }
+    if (!likePattern.has_value() && !regexp.has_value()) {
+      continue;
+    }
+
+    const auto& input = disjunct->inputs()[0];
+    auto it = std::find_if(groups.begin(), groups.end(), [&](const auto& g) {
+      return *g.input == *input;
+    });
+    if (it == groups.end()) {
+      groups.push_back({input, {}, {}, {}});
+      it = groups.end() - 1;
+    }
+    if (likePattern.has_value()) {
+      it->likePatterns.push_back(std::move(*likePattern));
+    } else {
+      it->regexps.push_back(std::move(*regexp));
+    }
+    it->disjuncts.push_back(i);
+  }
+
+  std::vector<bool> replaced(disjuncts.size(), false);
+  std::vector<core::TypedExprPtr> newDisjuncts;
+  for (auto& group : groups) {
+    if (group.disjuncts.size() < kMinLikeAnyPatterns) {
+      continue;
+    }
+    for (auto i : group.disjuncts) {
+      replaced[i] = true;
+    }
+    auto toArray = [](std::vector<std::string>& strings) {
+      std::vector<Variant> elements;
+      elements.reserve(strings.size());
+      for (auto& string : strings) {
+        elements.emplace_back(std::move(string));
+      }
+      return std::make_shared<core::ConstantTypedExpr>(
+          ARRAY(VARCHAR()), Variant::array(std::move(elements)));
+    };
+    newDisjuncts.push_back(std::make_shared<core::CallTypedExpr>(
+        BOOLEAN(),
+        std::vector<core::TypedExprPtr>{
+            group.input,
+            toArray(group.likePatterns),
+            toArray(group.regexps)},
+        "$internal$like_any"));
+  }
+  if (newDisjuncts.empty()) {
+    return nullptr;
+  }
+
+  for (size_t i = 0; i < disjuncts.size(); ++i) {
+    if (!replaced[i]) {
+      newDisjuncts.push_back(disjuncts[i]);
+    }
+  }
+  if (newDisjuncts.size() == 1) {
+    return newDisjuncts[0];
+  }
+  return std::make_shared<core::CallTypedExpr>(
+      BOOLEAN(), std::move(newDisjuncts), "or");
+}
+
 std::shared_ptr<exec::VectorFunction> makeRe2ExtractAll(
     const std::string& name,
     const std::vector<exec::VectorFunctionArg>& inputArgs,
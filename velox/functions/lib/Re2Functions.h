@@ -21,6 +21,7 @@
 #include <re2/re2.h>
 #include "velox/expression/VectorFunction.h"
 #include "velox/functions/Udf.h"
+#include "velox/functions/lib/RegexCache.h"
 #include "velox/vector/BaseVector.h"
 
 namespace facebook::velox::functions {
@@ -219,6 +220,14 @@ PatternMetadata determinePatternKind(
     std::string_view pattern,
     std::optional<char> escapeChar);
 
+/// Returns a RE2 pattern that fully matches the strings matched by LIKE
+/// 'pattern'. Sets 'validPattern' to false if 'escapeChar' is followed by a
+/// character other than '%', '_' or 'escapeChar'.
+std::string likePatternToRe2(
+    StringView pattern,
+    std::optional<char> escapeChar,
+    bool& validPattern);
+
 std::shared_ptr<exec::VectorFunction> makeLike(
     const std::string& name,
     const std::vector<exec::VectorFunctionArg>& inputArgs,
@@ -226,6 +235,32 @@ std::shared_ptr<exec::VectorFunction> makeLike(
 
 std::vector<std::shared_ptr<exec::FunctionSignature>> likeSignatures();
 
+/// like_any(string, like_patterns, regexps) → bool
+///
+/// Returns whether 'string' matches any of the LIKE patterns in the constant
+/// array 'like_patterns' or any of the regular expressions in the constant
+/// array 'regexps' as regexp_like would. Evaluates all patterns with one
+/// MultiPatternMatcher. Produced by rewriteLikeDisjunction.
+std::shared_ptr<exec::VectorFunction> makeLikeAny(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& config);
+
+std::vector<std::shared_ptr<exec::FunctionSignature>> likeAnySignatures();
+
+/// Minimum number of LIKE and regexp_like calls on the same string in a
+/// disjunction for rewriteLikeDisjunction to replace them.
+constexpr size_t kMinLikeAnyPatterns = 4;
+
+/// Rewrites an OR of at least kMinLikeAnyPatterns calls to 'prefix'like and
+/// 'prefix'regexp_like on the same string with constant patterns into one
+/// call to $internal$like_any. Calls to like with an escape character and
+/// regexp_like with an invalid pattern are left as is. Returns nullptr if
+/// 'expr' is not such an OR.
+core::TypedExprPtr rewriteLikeDisjunction(
+    const std::string& prefix,
+    const core::TypedExprPtr& expr);
+
 /// re2ExtractAll(string, pattern, group_id) → array<string>
 /// re2ExtractAll(string, pattern) → array<string>
 ///
@@ -256,7 +291,9 @@ namespace detail {
 // 'expression.max_compiled_regexes' different expressions.
 //
 // Compiling regular expressions is expensive. It can take up to 200 times
-// more CPU time to compile a regex vs. evaluate it.
+// more CPU time to compile a regex vs. evaluate it. The expressions are
+// compiled through the process-wide RegexCache, so that the instances of a
+// function in different drivers and queries share them.
 class ReCache {
  public:
   explicit ReCache(uint64_t maxCompiledRegexes)
@@ -266,12 +303,12 @@ class ReCache {
     maxCompiledRegexes_ = maxCompiledRegexes;
   }
 
-  RE2* findOrCompile(const StringView& pattern);
+  const RE2* findOrCompile(const StringView& pattern);
 
-  Expected<RE2*> tryFindOrCompile(const StringView& pattern);
+  Expected<const RE2*> tryFindOrCompile(const StringView& pattern);
 
  private:
-  folly::F14FastMap<std::string, std::unique_ptr<RE2>> cache_;
+  folly::F14FastMap<std::string, std::shared_ptr<const RE2>> cache_;
   uint64_t maxCompiledRegexes_;
 };
 
@@ -305,7 +342,7 @@ struct Re2RegexpReplace {
       const arg_type<Varchar>* replacement) {
     if (pattern != nullptr) {
       const auto processedPattern = prepareRegexpPattern(*pattern);
-      re_.emplace(processedPattern, RE2::Quiet);
+      re_ = RegexCache::instance().findOrCompile(processedPattern, RE2::Quiet);
       VELOX_USER_CHECK(
           re_->ok(),
           "Invalid regular expression {}: {}.",
@@ -318,7 +355,7 @@ struct Re2RegexpReplace {
       // Constant 'replacement' with non-constant 'pattern' needs to be
       // processed separately for each row.
       if (pattern != nullptr) {
-        ensureProcessedReplacement(re_.value(), *replacement);
+        ensureProcessedReplacement(*re_, *replacement);
         constantReplacement_ = true;
       }
     }
@@ -348,17 +385,17 @@ struct Re2RegexpReplace {
   }
 
  private:
-  RE2& ensurePattern(const arg_type<Varchar>& pattern) {
-    if (!re_.has_value()) {
+  const RE2& ensurePattern(const arg_type<Varchar>& pattern) {
+    if (re_ == nullptr) {
       auto processedPattern = prepareRegexpPattern(pattern);
       return *cache_.findOrCompile(StringView(processedPattern));
     } else {
-      return re_.value();
+      return *re_;
     }
   }
 
   const std::string& ensureProcessedReplacement(
-      RE2& re,
+      const RE2& re,
       const arg_type<Varchar>& replacement) {
     if (!constantReplacement_) {
       processedReplacement_ = prepareRegexpReplacement(re, replacement);
@@ -368,7 +405,7 @@ struct Re2RegexpReplace {
   }
 
   // Used when pattern is constant.
-  std::optional<RE2> re_;
+  std::shared_ptr<const RE2> re_;
 
   // True if replacement is constant.
   bool constantReplacement_{false};
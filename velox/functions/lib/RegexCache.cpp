@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/functions/lib/RegexCache.h"
+
+#include <gflags/gflags.h>
+
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/StatsReporter.h"
+#include "velox/functions/lib/Re2Functions.h"
+
+DECLARE_int64(velox_regex_cache_max_bytes);
+
+namespace facebook::velox::functions {
+
+namespace {
+
+// Approximate size of one instruction of a compiled RE2 program, including
+// the per-instruction state of the lazily built DFA.
+constexpr size_t kBytesPerInstruction = 32;
+
+// Returns the key for 'pattern' compiled with 'options'. Includes every
+// option that changes the compiled program.
+std::string regexKey(std::string_view pattern, const RE2::Options& options) {
+  const uint32_t flags = (options.encoding() == RE2::Options::EncodingLatin1) |
+      options.posix_syntax() << 1 | options.longest_match() << 2 |
+      options.literal() << 3 | options.never_nl() << 4 |
+      options.dot_nl() << 5 | options.never_capture() << 6 |
+      options.case_sensitive() << 7 | options.perl_classes() << 8 |
+      options.word_boundary() << 9 | options.one_line() << 10;
+  auto key = fmt::format("r{}:{}:", flags, options.max_mem());
+  key.append(pattern);
+  return key;
+}
+
+std::string likeKey(std::string_view pattern, std::optional<char> escapeChar) {
+  std::string key = escapeChar.has_value() ? std::string{'l', *escapeChar}
+                                           : std::string{'n', '\0'};
+  key.append(pattern);
+  return key;
+}
+
+} // namespace
+
+// static
+RegexCache& RegexCache::instance() {
+  static RegexCache instance(FLAGS_velox_regex_cache_max_bytes);
+  return instance;
+}
+
+RegexCache::RegexCache(size_t maxBytes) : cache_(maxBytes) {}
+
+std::optional<RegexCache::Entry> RegexCache::find(const std::string& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto* entry = cache_.get(key);
+  if (entry == nullptr) {
+    ++numMisses_;
+    return std::nullopt;
+  }
+  Entry result = *entry;
+  cache_.release(key);
+  return result;
+}
+
+RegexCache::Entry
+RegexCache::insert(std::string key, Entry entry, size_t size) {
+  uint64_t numEvicted;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (auto* existing = cache_.get(key)) {
+      // Another thread compiled the same pattern first.
+      Entry result = *existing;
+      cache_.release(key);
+      return result;
+    }
+    const auto numEntries = cache_.stats().numElements;
+    auto value = std::make_unique<Entry>(entry);
+    if (!cache_.add(std::move(key), value.get(), size)) {
+      // Larger than the whole cache.
+      return entry;
+    }
+    value.release();
+    numEvicted = numEntries + 1 - cache_.stats().numElements;
+    numEvictions_ += numEvicted;
+  }
+  if (numEvicted > 0) {
+    RECORD_METRIC_VALUE(kMetricRegexCacheNumEvictions, numEvicted);
+  }
+  return entry;
+}
+
+std::shared_ptr<const RE2> RegexCache::findOrCompile(
+    std::string_view pattern,
+    const RE2::Options& options) {
+  auto key = regexKey(pattern, options);
+  if (auto entry = find(key)) {
+    RECORD_METRIC_VALUE(kMetricRegexCacheNumHits);
+    return entry->regex;
+  }
+  RECORD_METRIC_VALUE(kMetricRegexCacheNumMisses);
+
+  auto regex = std::make_shared<const RE2>(
+      re2::StringPiece(pattern.data(), pattern.size()), options);
+  const size_t size = sizeof(Entry) + sizeof(RE2) + 2 * key.size() +
+      std::max(regex->ProgramSize(), 0) * kBytesPerInstruction;
+  return insert(std::move(key), Entry{std::move(regex), nullptr}, size).regex;
+}
+
+std::shared_ptr<const PatternMetadata> RegexCache::findOrDeterminePatternKind(
+    std::string_view pattern,
+    std::optional<char> escapeChar) {
+  auto key = likeKey(pattern, escapeChar);
+  if (auto entry = find(key)) {
+    RECORD_METRIC_VALUE(kMetricRegexCacheNumHits);
+    return entry->metadata;
+  }
+  RECORD_METRIC_VALUE(kMetricRegexCacheNumMisses);
+
+  auto metadata = std::make_shared<const PatternMetadata>(
+      determinePatternKind(pattern, escapeChar));
+  const size_t size =
+      sizeof(Entry) + sizeof(PatternMetadata) + 3 * key.size();
+  return insert(std::move(key), Entry{nullptr, std::move(metadata)}, size)
+      .metadata;
+}
+
+RegexCache::Stats RegexCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  const auto lruStats = cache_.stats();
+  Stats stats;
+  stats.numEntries = lruStats.numElements;
+  stats.numBytes = lruStats.curSize;
+  stats.numHits = lruStats.numHits;
+  stats.numMisses = numMisses_;
+  stats.numEvictions = numEvictions_;
+  return stats;
+}
+
+void RegexCache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  cache_.free(cache_.maxSize());
+}
+
+} // namespace facebook::velox::functions
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <re2/re2.h>
+
+#include "velox/common/caching/SimpleLRUCache.h"
+
+namespace facebook::velox::functions {
+
+class PatternMetadata;
+
+/// Process-wide cache of compiled regular expressions and of the metadata of
+/// LIKE patterns. Compiling a regular expression can take orders of magnitude
+/// more CPU than matching a string with it, and without sharing every driver
+/// of every query compiles the same patterns again.
+///
+/// The cached objects are immutable and shared: a caller holds a shared_ptr,
+/// so that an object stays valid after it is evicted. The cache is bounded by
+/// the approximate memory used by the entries and evicts the least recently
+/// used entries. All methods are thread-safe.
+class RegexCache {
+ public:
+  struct Stats {
+    /// Number of entries in the cache.
+    size_t numEntries{0};
+    /// Approximate memory used by the entries.
+    size_t numBytes{0};
+    /// Number of lookups that found an entry.
+    uint64_t numHits{0};
+    /// Number of lookups that compiled a new entry.
+    uint64_t numMisses{0};
+    /// Number of entries evicted to make space.
+    uint64_t numEvictions{0};
+  };
+
+  /// Returns the cache shared by all queries in the process. Its size is set
+  /// by the 'velox_regex_cache_max_bytes' flag.
+  static RegexCache& instance();
+
+  explicit RegexCache(size_t maxBytes);
+
+  /// Returns 'pattern' compiled with 'options'. The result is not checked:
+  /// callers report !ok() as they would for a regular expression they
+  /// compiled themselves. Invalid patterns are cached too, so that each
+  /// failing driver does not compile them again.
+  std::shared_ptr<const RE2> findOrCompile(
+      std::string_view pattern,
+      const RE2::Options& options);
+
+  /// Returns determinePatternKind(pattern, escapeChar).
+  std::shared_ptr<const PatternMetadata> findOrDeterminePatternKind(
+      std::string_view pattern,
+      std::optional<char> escapeChar);
+
+  Stats stats() const;
+
+  /// Removes all entries. Entries held by callers stay valid.
+  void clear();
+
+ private:
+  struct Entry {
+    std::shared_ptr<const RE2> regex;
+    std::shared_ptr<const PatternMetadata> metadata;
+  };
+
+  // Returns a copy of the entry for 'key' or std::nullopt if there is none.
+  std::optional<Entry> find(const std::string& key);
+
+  // Adds 'entry' unless another thread added an entry for 'key' first.
+  // Returns the entry for 'key'.
+  Entry insert(std::string key, Entry entry, size_t size);
+
+  mutable std::mutex mutex_;
+  SimpleLRUCache<std::string, Entry> cache_;
+  uint64_t numMisses_{0};
+  uint64_t numEvictions_{0};
+};
+
+} // namespace facebook::velox::functions
@@ -137,11 +137,16 @@ class DecimalAggregate : public exec::Aggregate {
       });
     } else if (!exec::Aggregate::numNulls_ && decodedRaw_.isIdentityMapping()) {
       const TInputType* data = decodedRaw_.data<TInputType>();
+      DecimalUtil::BatchSum batchSum;
+      if (rows.isAllSelected()) {
+        for (auto i = rows.begin(); i < rows.end(); ++i) {
+          batchSum.add(data[i]);
+        }
+      } else {
+        rows.applyToSelected([&](vector_size_t i) { batchSum.add(data[i]); });
+      }
       LongDecimalWithOverflowState accumulator;
-      rows.applyToSelected([&](vector_size_t i) {
-        accumulator.overflow += DecimalUtil::addWithOverflow(
-            accumulator.sum, data[i], accumulator.sum);
-      });
+      accumulator.overflow = batchSum.addTo(accumulator.sum);
       accumulator.count = rows.countSelected();
       std::vector<char> rawData(LongDecimalWithOverflowState::serializedSize());
       StringView serialized(
@@ -149,13 +154,12 @@ class DecimalAggregate : public exec::Aggregate {
       accumulator.serialize(serialized);
       mergeAccumulators<false>(group, serialized);
     } else {
-      LongDecimalWithOverflowState accumulator;
+      DecimalUtil::BatchSum batchSum;
       rows.applyToSelected([&](vector_size_t i) {
-        accumulator.overflow += DecimalUtil::addWithOverflow(
-            accumulator.sum,
-            decodedRaw_.valueAt<TInputType>(i),
-            accumulator.sum);
+        batchSum.add(decodedRaw_.valueAt<TInputType>(i));
       });
+      LongDecimalWithOverflowState accumulator;
+      accumulator.overflow = batchSum.addTo(accumulator.sum);
       accumulator.count = rows.countSelected();
       std::vector<char> rawData(LongDecimalWithOverflowState::serializedSize());
       StringView serialized(
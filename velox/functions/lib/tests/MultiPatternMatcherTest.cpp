@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/functions/lib/MultiPatternMatcher.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+
+namespace facebook::velox::functions {
+namespace {
+
+TEST(MultiPatternMatcherTest, ahoCorasick) {
+  AhoCorasick matcher;
+  matcher.add("he", AhoCorasick::kContains);
+  matcher.add("she", AhoCorasick::kStartsWith);
+  matcher.add("hers", AhoCorasick::kEndsWith);
+  matcher.add("his", AhoCorasick::kEquals);
+  matcher.build();
+
+  EXPECT_TRUE(matcher.match("the"));
+  EXPECT_TRUE(matcher.match("he"));
+  EXPECT_TRUE(matcher.match("shell"));
+  EXPECT_TRUE(matcher.match("ushers"));
+  EXPECT_TRUE(matcher.match("his"));
+
+  EXPECT_FALSE(matcher.match(""));
+  EXPECT_FALSE(matcher.match("h"));
+  // "she" must be a prefix and "his" the whole string.
+  EXPECT_FALSE(matcher.match("hisx"));
+  EXPECT_FALSE(matcher.match("xhis"));
+  EXPECT_FALSE(matcher.match("hirs"));
+}
+
+TEST(MultiPatternMatcherTest, ahoCorasickOverlapping) {
+  AhoCorasick matcher;
+  matcher.add("abcd", AhoCorasick::kStartsWith);
+  matcher.add("bc", AhoCorasick::kEndsWith);
+  matcher.add("cdx", AhoCorasick::kEquals);
+  matcher.build();
+
+  // "bc" is found through the failure link of "abc".
+  EXPECT_TRUE(matcher.match("abc"));
+  EXPECT_TRUE(matcher.match("abcdef"));
+  EXPECT_TRUE(matcher.match("cdx"));
+  EXPECT_TRUE(matcher.match("abcdx"));
+  EXPECT_FALSE(matcher.match("xbcd"));
+  EXPECT_FALSE(matcher.match("xabcd"));
+  EXPECT_FALSE(matcher.match("bcd"));
+}
+
+TEST(MultiPatternMatcherTest, ahoCorasickEmptyPattern) {
+  AhoCorasick equals;
+  equals.add("", AhoCorasick::kEquals);
+  equals.build();
+  EXPECT_FALSE(equals.empty());
+  EXPECT_TRUE(equals.match(""));
+  EXPECT_FALSE(equals.match("a"));
+
+  AhoCorasick contains;
+  contains.add("", AhoCorasick::kContains);
+  contains.build();
+  EXPECT_TRUE(contains.match(""));
+  EXPECT_TRUE(contains.match("a"));
+}
+
+TEST(MultiPatternMatcherTest, likePatterns) {
+  MultiPatternMatcher matcher(
+      {"apple", "ban%", "%rry", "%kiw%", "___", "a_c%d", "%x%y%"}, {});
+
+  EXPECT_TRUE(matcher.match("apple"));
+  EXPECT_TRUE(matcher.match("banana"));
+  EXPECT_TRUE(matcher.match("cherry"));
+  EXPECT_TRUE(matcher.match("a kiwi"));
+  EXPECT_TRUE(matcher.match("fig"));
+  EXPECT_TRUE(matcher.match("abc and d"));
+  EXPECT_TRUE(matcher.match("0x1y2"));
+  // '_' matches one character, not one byte.
+  EXPECT_TRUE(matcher.match("été"));
+  // '%' and '_' match new lines.
+  EXPECT_TRUE(matcher.match("a\nc\nd"));
+
+  EXPECT_FALSE(matcher.match(""));
+  EXPECT_FALSE(matcher.match("apples"));
+  EXPECT_FALSE(matcher.match("a ban"));
+  EXPECT_FALSE(matcher.match("cherry pie"));
+  EXPECT_FALSE(matcher.match("figs"));
+  EXPECT_FALSE(matcher.match("0y1x2"));
+}
+
+TEST(MultiPatternMatcherTest, lengthPatterns) {
+  MultiPatternMatcher exact({"__", "____"}, {});
+  EXPECT_FALSE(exact.match("a"));
+  EXPECT_TRUE(exact.match("ab"));
+  EXPECT_FALSE(exact.match("abc"));
+  EXPECT_TRUE(exact.match("abcd"));
+  EXPECT_FALSE(exact.match("abcde"));
+
+  MultiPatternMatcher atLeast({"___%", "%"}, {});
+  EXPECT_TRUE(atLeast.match(""));
+  EXPECT_TRUE(atLeast.match("abcde"));
+
+  MultiPatternMatcher both({"_", "___%"}, {});
+  EXPECT_FALSE(both.match(""));
+  EXPECT_TRUE(both.match("a"));
+  EXPECT_FALSE(both.match("ab"));
+  EXPECT_TRUE(both.match("abc"));
+  EXPECT_TRUE(both.match("abcdef"));
+}
+
+TEST(MultiPatternMatcherTest, regexps) {
+  MultiPatternMatcher matcher({"foo"}, {"^[0-9]+$", "b.r", "(?i)QUX"});
+
+  EXPECT_TRUE(matcher.match("foo"));
+  EXPECT_TRUE(matcher.match("12345"));
+  EXPECT_TRUE(matcher.match("a bar"));
+  EXPECT_TRUE(matcher.match("qux"));
+
+  EXPECT_FALSE(matcher.match("123a"));
+  EXPECT_FALSE(matcher.match("br"));
+  EXPECT_FALSE(matcher.match("food"));
+
+  ASSERT_TRUE(MultiPatternMatcher::isValidRegexp("a(b|c)*"));
+  ASSERT_FALSE(MultiPatternMatcher::isValidRegexp("a(b"));
+  VELOX_ASSERT_THROW(
+      MultiPatternMatcher({}, {"a(b"}), "invalid regular expression");
+}
+
+TEST(MultiPatternMatcherTest, manyPatterns) {
+  std::vector<std::string> likePatterns;
+  std::vector<std::string> regexps;
+  for (auto i = 0; i < 1'000; ++i) {
+    likePatterns.push_back(fmt::format("%token{}!%", i * 7));
+    likePatterns.push_back(fmt::format("_prefix{}%", i));
+    regexps.push_back(fmt::format("^id{}-[a-z]+$", i * 3));
+  }
+  MultiPatternMatcher matcher(likePatterns, regexps);
+
+  EXPECT_TRUE(matcher.match("xx token700! yy"));
+  EXPECT_TRUE(matcher.match("xprefix999 and more"));
+  EXPECT_TRUE(matcher.match("id2997-abc"));
+
+  EXPECT_FALSE(matcher.match("xx token701! yy"));
+  EXPECT_FALSE(matcher.match("prefix999"));
+  EXPECT_FALSE(matcher.match("id2998-abc"));
+  EXPECT_FALSE(matcher.match("id3-abc1"));
+}
+
+} // namespace
+} // namespace facebook::velox::functions
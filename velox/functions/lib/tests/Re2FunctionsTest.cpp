@@ -15,6 +15,7 @@
  */
 #include "velox/functions/lib/Re2Functions.h"
 
+#include <folly/String.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <velox/type/Type.h>
@@ -1536,6 +1537,93 @@ TEST_F(Re2FunctionsTest, limit) {
   ASSERT_NO_THROW(evaluate("regexp_like(c0, c2)", data));
 }
 
+TEST_F(Re2FunctionsTest, likeDisjunction) {
+  auto data = makeRowVector({
+      makeNullableFlatVector<std::string>(
+          {"apple pie",
+           "banana",
+           std::nullopt,
+           "cherry",
+           "date",
+           "elderberry",
+           "fig",
+           "grape\nfruit",
+           "",
+           "12345"}),
+      makeFlatVector<int64_t>({1, 2, 3, 4, 5, 6, 7, 8, 9, 10}),
+  });
+
+  // Evaluates each disjunct on its own and ORs the results.
+  auto testDisjunction = [&](const std::vector<std::string>& disjuncts,
+                             bool rewritten) {
+    const auto expression = folly::join(" OR ", disjuncts);
+    auto exprSet = compileExpression(expression, asRowType(data->type()));
+    ASSERT_EQ(
+        exprSet->exprs()[0]->toString().find("$internal$like_any") !=
+            std::string::npos,
+        rewritten)
+        << expression;
+
+    std::vector<std::optional<bool>> expected(data->size(), false);
+    for (const auto& disjunct : disjuncts) {
+      auto result = evaluate<SimpleVector<bool>>(disjunct, data);
+      for (auto i = 0; i < data->size(); ++i) {
+        if (expected[i] == true) {
+          continue;
+        }
+        if (result->isNullAt(i)) {
+          expected[i] = std::nullopt;
+        } else if (result->valueAt(i)) {
+          expected[i] = true;
+        }
+      }
+    }
+    assertEqualVectors(
+        makeNullableFlatVector<bool>(expected), evaluate(expression, data));
+  };
+
+  testDisjunction(
+      {"c0 like 'apple%'",
+       "c0 like '%rry'",
+       "c0 like '%an%'",
+       "c0 like '___'",
+       "c0 like 'd_t%'",
+       "regexp_like(c0, '^[0-9]+$')",
+       "regexp_like(c0, 'e.f')"},
+      true);
+  // Other disjuncts are kept.
+  testDisjunction(
+      {"c0 like 'fig'",
+       "c1 > 8",
+       "c0 like 'x%'",
+       "regexp_like(c0, 'ra')",
+       "c0 like '%e'"},
+      true);
+  testDisjunction(
+      {"c0 like 'fig'",
+       "c0 like 'apple%'",
+       "regexp_like(c0, 'ra')",
+       "c0 like ''"},
+      true);
+  // Too few patterns.
+  testDisjunction(
+      {"c0 like 'fig'", "c0 like 'apple%'", "regexp_like(c0, 'ra')"}, false);
+  // LIKE with an escape character and invalid regular expressions are not
+  // rewritten.
+  testDisjunction(
+      {"c0 like 'fig'",
+       "c0 like 'apple%'",
+       "c0 like 'a#%' escape '#'",
+       "regexp_like(c0, 'ra')"},
+      false);
+  VELOX_ASSERT_THROW(
+      evaluate(
+          "c0 like 'fig' OR c0 like 'apple%' OR c0 like '%e' OR "
+          "regexp_like(c0, 'ra') OR regexp_like(c0, 'a(b')",
+          data),
+      "invalid regular expression");
+}
+
 TEST_F(Re2FunctionsTest, parseSubstrings) {
   auto test = [&](const std::string& input,
                   const std::vector<std::string>& expected) {
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/functions/lib/RegexCache.h"
+
+#include <gtest/gtest.h>
+#include <thread>
+
+#include "velox/functions/lib/Re2Functions.h"
+
+namespace facebook::velox::functions {
+namespace {
+
+TEST(RegexCacheTest, findOrCompile) {
+  RegexCache cache(1 << 20);
+
+  auto re = cache.findOrCompile("a+b", RE2::Quiet);
+  ASSERT_TRUE(re->ok());
+  ASSERT_TRUE(RE2::FullMatch("aaab", *re));
+  ASSERT_EQ(cache.findOrCompile("a+b", RE2::Quiet), re);
+
+  // Different options give a different regex.
+  RE2::Options options{RE2::Quiet};
+  options.set_case_sensitive(false);
+  auto caseInsensitive = cache.findOrCompile("a+b", options);
+  ASSERT_NE(caseInsensitive, re);
+  ASSERT_TRUE(RE2::FullMatch("AAB", *caseInsensitive));
+  ASSERT_FALSE(RE2::FullMatch("AAB", *re));
+
+  // Invalid patterns are cached and reported by the caller.
+  auto invalid = cache.findOrCompile("a(b", RE2::Quiet);
+  ASSERT_FALSE(invalid->ok());
+  ASSERT_EQ(cache.findOrCompile("a(b", RE2::Quiet), invalid);
+
+  auto stats = cache.stats();
+  ASSERT_EQ(stats.numEntries, 3);
+  ASSERT_EQ(stats.numHits, 2);
+  ASSERT_EQ(stats.numMisses, 3);
+  ASSERT_EQ(stats.numEvictions, 0);
+  ASSERT_GT(stats.numBytes, 0);
+}
+
+TEST(RegexCacheTest, patternMetadata) {
+  RegexCache cache(1 << 20);
+
+  auto metadata = cache.findOrDeterminePatternKind("abc%", std::nullopt);
+  ASSERT_EQ(metadata->patternKind(), PatternKind::kPrefix);
+  ASSERT_EQ(metadata->fixedPattern(), "abc");
+  ASSERT_EQ(cache.findOrDeterminePatternKind("abc%", std::nullopt), metadata);
+
+  // The escape character is part of the key.
+  auto escaped = cache.findOrDeterminePatternKind("abc%", '\\');
+  ASSERT_NE(escaped, metadata);
+  ASSERT_EQ(escaped->patternKind(), PatternKind::kPrefix);
+
+  // A regex with the same text as a LIKE pattern is a different entry.
+  ASSERT_TRUE(cache.findOrCompile("abc%", RE2::Quiet)->ok());
+  ASSERT_EQ(cache.stats().numEntries, 3);
+
+  ASSERT_THROW(cache.findOrDeterminePatternKind("abc#", '#'), VeloxUserError);
+}
+
+TEST(RegexCacheTest, eviction) {
+  RegexCache cache(4 << 10);
+
+  std::vector<std::shared_ptr<const RE2>> regexes;
+  for (auto i = 0; i < 100; ++i) {
+    regexes.push_back(
+        cache.findOrCompile(fmt::format("[a-z]+{}[0-9]*", i), RE2::Quiet));
+  }
+  auto stats = cache.stats();
+  ASSERT_LT(stats.numEntries, 100);
+  ASSERT_GT(stats.numEvictions, 0);
+  ASSERT_LE(stats.numBytes, 4 << 10);
+  ASSERT_EQ(stats.numEntries + stats.numEvictions, 100);
+
+  // Evicted regexes stay valid.
+  for (auto i = 0; i < 100; ++i) {
+    ASSERT_TRUE(RE2::FullMatch(fmt::format("abc{}12", i), *regexes[i]));
+  }
+
+  cache.clear();
+  ASSERT_EQ(cache.stats().numEntries, 0);
+  ASSERT_TRUE(RE2::FullMatch("x99", *regexes[99]));
+}
+
+TEST(RegexCacheTest, concurrent) {
+  RegexCache cache(1 << 20);
+
+  constexpr int kNumThreads = 8;
+  constexpr int kNumPatterns = 50;
+  std::vector<std::vector<std::shared_ptr<const RE2>>> results(kNumThreads);
+  std::vector<std::thread> threads;
+  for (auto t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&, t]() {
+      for (auto i = 0; i < kNumPatterns; ++i) {
+        auto re = cache.findOrCompile(fmt::format("x{}y", i), RE2::Quiet);
+        EXPECT_TRUE(RE2::FullMatch(fmt::format("x{}y", i), *re));
+        results[t].push_back(std::move(re));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(cache.stats().numEntries, kNumPatterns);
+  // All threads share the regexes that were compiled once.
+  for (auto i = 0; i < kNumPatterns; ++i) {
+    auto re = cache.findOrCompile(fmt::format("x{}y", i), RE2::Quiet);
+    for (auto t = 0; t < kNumThreads; ++t) {
+      ASSERT_EQ(results[t][i], re);
+    }
+  }
+}
+
+} // namespace
+} // namespace facebook::velox::functions
@@ -27,6 +27,7 @@
 #include <type_traits>
 
 #include "folly/CPortability.h"
+#include "folly/Range.h"
 #include "velox/common/base/Doubles.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/functions/Macros.h"
@@ -55,6 +56,16 @@ struct PlusFunction {
   call(TInput& result, const TInput& a, const TInput& b) {
     result = plus(a, b);
   }
+
+  template <typename TInput>
+  void callBatch(
+      folly::Range<TInput*> result,
+      folly::Range<const TInput*> a,
+      folly::Range<const TInput*> b) {
+    for (size_t i = 0; i < result.size(); ++i) {
+      result[i] = plus(a[i], b[i]);
+    }
+  }
 };
 
 template <typename T>
@@ -64,6 +75,16 @@ struct MinusFunction {
   call(TInput& result, const TInput& a, const TInput& b) {
     result = minus(a, b);
   }
+
+  template <typename TInput>
+  void callBatch(
+      folly::Range<TInput*> result,
+      folly::Range<const TInput*> a,
+      folly::Range<const TInput*> b) {
+    for (size_t i = 0; i < result.size(); ++i) {
+      result[i] = minus(a[i], b[i]);
+    }
+  }
 };
 
 template <typename T>
@@ -73,6 +94,16 @@ struct MultiplyFunction {
   call(TInput& result, const TInput& a, const TInput& b) {
     result = multiply(a, b);
   }
+
+  template <typename TInput>
+  void callBatch(
+      folly::Range<TInput*> result,
+      folly::Range<const TInput*> a,
+      folly::Range<const TInput*> b) {
+    for (size_t i = 0; i < result.size(); ++i) {
+      result[i] = multiply(a[i], b[i]);
+    }
+  }
 };
 
 // Multiply function for IntervalDayTime * Double, Double * IntervalDayTime,
@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <folly/Range.h>
+
 #include "velox/functions/Macros.h"
 namespace facebook::velox::functions {
 
@@ -25,6 +27,16 @@ struct BitwiseAndFunction {
     result = a & b;
     return true;
   }
+
+  template <typename TInput>
+  void callBatch(
+      folly::Range<int64_t*> result,
+      folly::Range<const TInput*> a,
+      folly::Range<const TInput*> b) {
+    for (size_t i = 0; i < result.size(); ++i) {
+      result[i] = a[i] & b[i];
+    }
+  }
 };
 
 template <typename T>
@@ -57,6 +69,13 @@ struct BitwiseNotFunction {
     result = ~a;
     return true;
   }
+
+  template <typename TInput>
+  void callBatch(folly::Range<int64_t*> result, folly::Range<const TInput*> a) {
+    for (size_t i = 0; i < result.size(); ++i) {
+      result[i] = ~a[i];
+    }
+  }
 };
 
 template <typename T>
@@ -66,6 +85,16 @@ struct BitwiseOrFunction {
     result = a | b;
     return true;
   }
+
+  template <typename TInput>
+  void callBatch(
+      folly::Range<int64_t*> result,
+      folly::Range<const TInput*> a,
+      folly::Range<const TInput*> b) {
+    for (size_t i = 0; i < result.size(); ++i) {
+      result[i] = a[i] | b[i];
+    }
+  }
 };
 
 template <typename T>
@@ -75,6 +104,16 @@ struct BitwiseXorFunction {
     result = a ^ b;
     return true;
   }
+
+  template <typename TInput>
+  void callBatch(
+      folly::Range<int64_t*> result,
+      folly::Range<const TInput*> a,
+      folly::Range<const TInput*> b) {
+    for (size_t i = 0; i < result.size(); ++i) {
+      result[i] = a[i] ^ b[i];
+    }
+  }
 };
 
 template <typename T>
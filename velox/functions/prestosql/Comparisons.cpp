@@ -86,6 +86,14 @@ struct SimdComparator {
     static const bool isTypeNotSupported =
         std::is_same_v<T, int128_t> || std::is_floating_point_v<T>;
 
+    if constexpr (std::is_same_v<T, int128_t>) {
+      if (isSimdizable) {
+        applyHugeintComparison(rows.end(), lhs, rhs, rawResult);
+        resultVector->clearNulls(rows);
+        return;
+      }
+    }
+
     if (!isSimdizable || isTypeNotSupported) {
       exec::LocalDecodedVector lhsDecoded(context, lhs, rows);
       exec::LocalDecodedVector rhsDecoded(context, rhs, rows);
@@ -126,6 +134,59 @@ struct SimdComparator {
     }
   }
 
+  // Compares flat or constant 128-bit values, e.g. long decimals, which have
+  // no SIMD comparison. The result is built 8 rows at a time without branches.
+  template <bool lhsConstant, bool rhsConstant>
+  static void applyHugeintComparison(
+      vector_size_t size,
+      const int128_t* lhs,
+      const int128_t* rhs,
+      uint8_t* rawResult) {
+    const ComparisonOp op;
+    for (vector_size_t i = 0; i < size; i += 8) {
+      const auto end = std::min(size, i + 8);
+      uint8_t byte = 0;
+      for (auto j = i; j < end; ++j) {
+        byte |= static_cast<uint8_t>(
+                    op(lhs[lhsConstant ? 0 : j], rhs[rhsConstant ? 0 : j]))
+            << (j - i);
+      }
+      rawResult[i / 8] = byte;
+    }
+  }
+
+  static void applyHugeintComparison(
+      vector_size_t size,
+      BaseVector& lhs,
+      BaseVector& rhs,
+      uint8_t* rawResult) {
+    if (lhs.isConstantEncoding() && rhs.isConstantEncoding()) {
+      const auto l = lhs.asUnchecked<ConstantVector<int128_t>>()->valueAt(0);
+      const auto r = rhs.asUnchecked<ConstantVector<int128_t>>()->valueAt(0);
+      applyHugeintComparison<true, true>(size, &l, &r, rawResult);
+    } else if (lhs.isConstantEncoding()) {
+      const auto l = lhs.asUnchecked<ConstantVector<int128_t>>()->valueAt(0);
+      applyHugeintComparison<true, false>(
+          size,
+          &l,
+          rhs.asUnchecked<FlatVector<int128_t>>()->rawValues(),
+          rawResult);
+    } else if (rhs.isConstantEncoding()) {
+      const auto r = rhs.asUnchecked<ConstantVector<int128_t>>()->valueAt(0);
+      applyHugeintComparison<false, true>(
+          size,
+          lhs.asUnchecked<FlatVector<int128_t>>()->rawValues(),
+          &r,
+          rawResult);
+    } else {
+      applyHugeintComparison<false, false>(
+          size,
+          lhs.asUnchecked<FlatVector<int128_t>>()->rawValues(),
+          rhs.asUnchecked<FlatVector<int128_t>>()->rawValues(),
+          rawResult);
+    }
+  }
+
   template <
       TypeKind kind,
       typename std::enable_if_t<
@@ -24,6 +24,13 @@
 namespace facebook::velox::functions {
 namespace {
 
+// Branch-free DecimalUtil::valueInRange for callBatch().
+template <typename T>
+FOLLY_ALWAYS_INLINE bool inLongDecimalRange(T value) {
+  return (value >= DecimalUtil::kLongDecimalMin) &
+      (value <= DecimalUtil::kLongDecimalMax);
+}
+
 template <typename TExec>
 struct DecimalPlusFunction {
   VELOX_DEFINE_FUNCTION_TYPES(TExec);
@@ -62,6 +69,29 @@ struct DecimalPlusFunction {
     DecimalUtil::valueInRange(out);
   }
 
+  // Rows that overflow fail one at a time.
+  template <typename R, typename A, typename B>
+  bool callBatch(
+      folly::Range<R*> out,
+      folly::Range<const A*> a,
+      folly::Range<const B*> b) {
+    const int128_t aFactor = DecimalUtil::kPowersOfTen[aRescale_];
+    const int128_t bFactor = DecimalUtil::kPowersOfTen[bRescale_];
+    bool overflow = false;
+    for (size_t i = 0; i < out.size(); ++i) {
+      int128_t aRescaled;
+      int128_t bRescaled;
+      R result;
+      overflow |= __builtin_mul_overflow(a[i], aFactor, &aRescaled);
+      overflow |= __builtin_mul_overflow(b[i], bFactor, &bRescaled);
+      overflow |=
+          __builtin_add_overflow(R(aRescaled), R(bRescaled), &result);
+      overflow |= !inLongDecimalRange(result);
+      out[i] = result;
+    }
+    return !overflow;
+  }
+
  private:
   inline static uint8_t computeRescaleFactor(
       uint8_t fromScale,
@@ -111,6 +141,29 @@ struct DecimalMinusFunction {
     DecimalUtil::valueInRange(out);
   }
 
+  // Rows that overflow fail one at a time.
+  template <typename R, typename A, typename B>
+  bool callBatch(
+      folly::Range<R*> out,
+      folly::Range<const A*> a,
+      folly::Range<const B*> b) {
+    const int128_t aFactor = DecimalUtil::kPowersOfTen[aRescale_];
+    const int128_t bFactor = DecimalUtil::kPowersOfTen[bRescale_];
+    bool overflow = false;
+    for (size_t i = 0; i < out.size(); ++i) {
+      int128_t aRescaled;
+      int128_t bRescaled;
+      R result;
+      overflow |= __builtin_mul_overflow(a[i], aFactor, &aRescaled);
+      overflow |= __builtin_mul_overflow(b[i], bFactor, &bRescaled);
+      overflow |=
+          __builtin_sub_overflow(R(aRescaled), R(bRescaled), &result);
+      overflow |= !inLongDecimalRange(result);
+      out[i] = result;
+    }
+    return !overflow;
+  }
+
  private:
   inline static uint8_t computeRescaleFactor(
       uint8_t fromScale,
@@ -131,6 +184,22 @@ struct DecimalMultiplyFunction {
     out = checkedMultiply<R>(checkedMultiply<R>(R(a), R(b)), R(1));
     DecimalUtil::valueInRange(out);
   }
+
+  // Rows that overflow fail one at a time.
+  template <typename R, typename A, typename B>
+  bool callBatch(
+      folly::Range<R*> out,
+      folly::Range<const A*> a,
+      folly::Range<const B*> b) {
+    bool overflow = false;
+    for (size_t i = 0; i < out.size(); ++i) {
+      R result;
+      overflow |= __builtin_mul_overflow(R(a[i]), R(b[i]), &result);
+      overflow |= !inLongDecimalRange(result);
+      out[i] = result;
+    }
+    return !overflow;
+  }
 };
 
 template <typename TExec>
@@ -15,6 +15,8 @@
  */
 #include <glog/logging.h>
 
+#include "velox/functions/prestosql/JsonFunctions.h"
+
 #include "velox/common/base/SortingNetwork.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/expression/VectorWriters.h"
@@ -862,8 +864,90 @@ class JsonInternalCastFunction : public exec::VectorFunction {
   mutable JsonCastOperator jsonCastOperator_;
 };
 
+// Evaluates json_extract_scalar for several paths with one parse of each
+// document. The document is rewound before each path.
+class JsonExtractScalarExtractor : public exec::MultiPathExtractor {
+ public:
+  explicit JsonExtractScalarExtractor(
+      std::vector<std::unique_ptr<SIMDJsonExtractor>> extractors)
+      : extractors_(std::move(extractors)) {}
+
+  void extract(
+      const SelectivityVector& rows,
+      const DecodedVector& input,
+      exec::EvalCtx& context,
+      std::vector<VectorPtr>& results) const override {
+    std::vector<FlatVector<StringView>*> flatResults(extractors_.size());
+    for (auto i = 0; i < extractors_.size(); ++i) {
+      context.ensureWritable(rows, VARCHAR(), results[i]);
+      flatResults[i] = results[i]->asFlatVector<StringView>();
+    }
+
+    std::optional<std::string> resultStr;
+    rows.applyToSelected([&](auto row) {
+      if (input.isNullAt(row)) {
+        for (auto* flatResult : flatResults) {
+          flatResult->setNull(row, true);
+        }
+        return;
+      }
+      const auto json = input.valueAt<StringView>(row);
+      simdjson::padded_string paddedJson(json.data(), json.size());
+      simdjson::ondemand::document jsonDoc;
+      bool parsed = !simdjsonParse(paddedJson).get(jsonDoc);
+      bool atStart = true;
+      for (auto i = 0; i < extractors_.size(); ++i) {
+        if (!parsed) {
+          flatResults[i]->setNull(row, true);
+          continue;
+        }
+        if (!atStart) {
+          jsonDoc.rewind();
+        }
+        atStart = false;
+        resultStr.reset();
+        const auto error =
+            detail::extractScalar(*extractors_[i], jsonDoc, resultStr);
+        if (error == simdjson::SUCCESS) {
+          flatResults[i]->set(row, StringView(*resultStr));
+          continue;
+        }
+        flatResults[i]->setNull(row, true);
+        if (error != simdjson::NO_SUCH_FIELD) {
+          // Errors from malformed documents may leave the iterator in a state
+          // that rewind() does not reset. Parse again for the next path.
+          parsed = !simdjsonParse(paddedJson).get(jsonDoc);
+          atStart = true;
+        }
+      }
+    });
+  }
+
+ private:
+  const std::vector<std::unique_ptr<SIMDJsonExtractor>> extractors_;
+};
+
 } // namespace
 
+std::unique_ptr<exec::MultiPathExtractor> makeJsonExtractScalarExtractor(
+    const std::vector<std::string>& paths,
+    const TypePtr& resultType) {
+  if (!resultType->isVarchar()) {
+    return nullptr;
+  }
+  std::vector<std::unique_ptr<SIMDJsonExtractor>> extractors;
+  extractors.reserve(paths.size());
+  for (const auto& path : paths) {
+    try {
+      extractors.push_back(SIMDJsonExtractor::create(path));
+    } catch (const VeloxUserError&) {
+      // The call reports the invalid path if it is evaluated.
+      return nullptr;
+    }
+  }
+  return std::make_unique<JsonExtractScalarExtractor>(std::move(extractors));
+}
+
 VELOX_DECLARE_VECTOR_FUNCTION(
     udf_json_format,
     JsonFormatFunction::signatures(),
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "velox/expression/MultiPathExtractExpr.h"
 #include "velox/functions/Macros.h"
 #include "velox/functions/UDFOutputString.h"
 #include "velox/functions/prestosql/json/JsonPathTokenizer.h"
@@ -169,6 +170,59 @@ struct JsonArrayGetFunction {
   }
 };
 
+namespace detail {
+
+// Extracts the value of json_extract_scalar for the path of 'extractor' from
+// 'jsonDoc' into 'resultStr'. Returns NO_SUCH_FIELD if the path does not
+// select exactly one boolean, number or string.
+inline simdjson::error_code extractScalar(
+    SIMDJsonExtractor& extractor,
+    simdjson::ondemand::document& jsonDoc,
+    std::optional<std::string>& resultStr) {
+  bool resultPopulated = false;
+
+  auto consumer = [&resultStr, &resultPopulated](auto& v) {
+    if (resultPopulated) {
+      // We should just get a single value, if we see multiple, it's an error
+      // and we should return null.
+      resultStr = std::nullopt;
+      return simdjson::SUCCESS;
+    }
+
+    resultPopulated = true;
+
+    SIMDJSON_ASSIGN_OR_RAISE(auto vtype, v.type());
+    switch (vtype) {
+      case simdjson::ondemand::json_type::boolean: {
+        SIMDJSON_ASSIGN_OR_RAISE(bool vbool, v.get_bool());
+        resultStr = vbool ? "true" : "false";
+        break;
+      }
+      case simdjson::ondemand::json_type::string: {
+        SIMDJSON_ASSIGN_OR_RAISE(resultStr, v.get_string());
+        break;
+      }
+      case simdjson::ondemand::json_type::object:
+      case simdjson::ondemand::json_type::array:
+      case simdjson::ondemand::json_type::null:
+        // Do nothing.
+        break;
+      default: {
+        SIMDJSON_ASSIGN_OR_RAISE(resultStr, simdjson::to_json_string(v));
+      }
+    }
+    return simdjson::SUCCESS;
+  };
+
+  bool isDefinitePath = true;
+  SIMDJSON_TRY(
+      extractor.extractFromDocument(jsonDoc, consumer, isDefinitePath));
+
+  return resultStr.has_value() ? simdjson::SUCCESS : simdjson::NO_SUCH_FIELD;
+}
+
+} // namespace detail
+
 // json_extract_scalar(json, json_path) -> varchar
 // Like json_extract(), but returns the result value as a string (as opposed
 // to being encoded as JSON). The value referenced by json_path must be a scalar
@@ -189,42 +243,6 @@ struct JsonExtractScalarFunction {
       out_type<Varchar>& result,
       const arg_type<Json>& json,
       const arg_type<Varchar>& jsonPath) {
-    bool resultPopulated = false;
-    std::optional<std::string> resultStr;
-
-    auto consumer = [&resultStr, &resultPopulated](auto& v) {
-      if (resultPopulated) {
-        // We should just get a single value, if we see multiple, it's an error
-        // and we should return null.
-        resultStr = std::nullopt;
-        return simdjson::SUCCESS;
-      }
-
-      resultPopulated = true;
-
-      SIMDJSON_ASSIGN_OR_RAISE(auto vtype, v.type());
-      switch (vtype) {
-        case simdjson::ondemand::json_type::boolean: {
-          SIMDJSON_ASSIGN_OR_RAISE(bool vbool, v.get_bool());
-          resultStr = vbool ? "true" : "false";
-          break;
-        }
-        case simdjson::ondemand::json_type::string: {
-          SIMDJSON_ASSIGN_OR_RAISE(resultStr, v.get_string());
-          break;
-        }
-        case simdjson::ondemand::json_type::object:
-        case simdjson::ondemand::json_type::array:
-        case simdjson::ondemand::json_type::null:
-          // Do nothing.
-          break;
-        default: {
-          SIMDJSON_ASSIGN_OR_RAISE(resultStr, simdjson::to_json_string(v));
-        }
-      }
-      return simdjson::SUCCESS;
-    };
-
     auto& extractor = SIMDJsonExtractor::getInstance(jsonPath);
 
     // Check for valid json
@@ -237,18 +255,21 @@ struct JsonExtractScalarFunction {
       }
     }
 
-    bool isDefinitePath = true;
-    SIMDJSON_TRY(extractor.extract(paddedJson, consumer, isDefinitePath));
+    SIMDJSON_ASSIGN_OR_RAISE(auto jsonDoc, simdjsonParse(paddedJson));
+    std::optional<std::string> resultStr;
+    SIMDJSON_TRY(detail::extractScalar(extractor, jsonDoc, resultStr));
 
-    if (resultStr.has_value()) {
-      result.copy_from(*resultStr);
-      return simdjson::SUCCESS;
-    } else {
-      return simdjson::NO_SUCH_FIELD;
-    }
+    result.copy_from(*resultStr);
+    return simdjson::SUCCESS;
   }
 };
 
+/// Makes an extractor that evaluates json_extract_scalar for several paths
+/// with one parse of each document. Returns nullptr if some path is invalid.
+std::unique_ptr<exec::MultiPathExtractor> makeJsonExtractScalarExtractor(
+    const std::vector<std::string>& paths,
+    const TypePtr& resultType);
+
 template <typename T>
 struct JsonSizeFunction {
   VELOX_DEFINE_FUNCTION_TYPES(T);
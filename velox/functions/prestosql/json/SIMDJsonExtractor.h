@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 
 #include "folly/Range.h"
@@ -68,6 +69,15 @@ class SIMDJsonExtractor {
       TConsumer& consumer,
       bool& isDefinitePath);
 
+  /// Like extract() but on a document that is already parsed, e.g. to extract
+  /// several paths with one parse. The document must be at its start, e.g.
+  /// after a call to rewind().
+  template <typename TConsumer>
+  simdjson::error_code extractFromDocument(
+      simdjson::ondemand::document& jsonDoc,
+      TConsumer& consumer,
+      bool& isDefinitePath);
+
   /// Returns true if this extractor was initialized with the trivial path "$".
   bool isRootOnlyPath() {
     return tokens_.empty();
@@ -78,6 +88,11 @@ class SIMDJsonExtractor {
   /// instance is not passed between threads.
   static SIMDJsonExtractor& getInstance(folly::StringPiece path);
 
+  /// Returns a new instance for 'path' that is not cached, for callers that
+  /// hold on to the extractors of many paths at once. Throws if 'path' is
+  /// invalid.
+  static std::unique_ptr<SIMDJsonExtractor> create(folly::StringPiece path);
+
  private:
   // Shouldn't instantiate directly - use getInstance().
   explicit SIMDJsonExtractor(const std::string& path) {
@@ -127,6 +142,14 @@ simdjson::error_code SIMDJsonExtractor::extract(
     TConsumer& consumer,
     bool& isDefinitePath) {
   SIMDJSON_ASSIGN_OR_RAISE(auto jsonDoc, simdjsonParse(paddedJson));
+  return extractFromDocument(jsonDoc, consumer, isDefinitePath);
+}
+
+template <typename TConsumer>
+simdjson::error_code SIMDJsonExtractor::extractFromDocument(
+    simdjson::ondemand::document& jsonDoc,
+    TConsumer& consumer,
+    bool& isDefinitePath) {
   SIMDJSON_ASSIGN_OR_RAISE(auto isScalar, jsonDoc.is_scalar());
   if (isScalar) {
     // Note, we cannot convert this to a value as this is not supported if the
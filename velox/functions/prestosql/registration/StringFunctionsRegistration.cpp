@@ -221,6 +221,11 @@ void registerStringFunctions(const std::string& prefix) {
       makeRe2ExtractAll);
   exec::registerStatefulVectorFunction(
       prefix + "regexp_like", re2SearchSignatures(), makeRe2Search);
+  exec::registerStatefulVectorFunction(
+      "$internal$like_any", likeAnySignatures(), makeLikeAny);
+  exec::registerExpressionRewrite([prefix](const auto& expr) {
+    return rewriteLikeDisjunction(prefix, expr);
+  });
 
   registerFunction<StrLPosFunction, int64_t, Varchar, Varchar>(
       {prefix + "strpos"});
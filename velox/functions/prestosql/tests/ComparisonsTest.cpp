@@ -471,6 +471,23 @@ TEST_F(ComparisonsTest, gtLtDecimal) {
   // Gte/Lte
   runAndCompare("c0 >= c1", longDecimalsInputs, expectedGteLte);
   runAndCompare("c1 <= c0", longDecimalsInputs, expectedGteLte);
+
+  // Long decimals without nulls are compared in batches of 8 rows.
+  std::vector<int128_t> lhs;
+  std::vector<int128_t> rhs;
+  std::vector<bool> expectedGt;
+  for (auto i = 0; i < 21; ++i) {
+    lhs.push_back(HugeInt::build(i % 3 - 1, i * 7));
+    rhs.push_back(HugeInt::build(0, 70));
+    expectedGt.push_back(lhs.back() > rhs.back());
+  }
+  std::vector<VectorPtr> flatInputs = {
+      makeFlatVector(lhs, DECIMAL(38, 5)), makeFlatVector(rhs, DECIMAL(38, 5))};
+  runAndCompare("c0 > c1", flatInputs, makeFlatVector(expectedGt));
+  runAndCompare(
+      "c0 > cast(0.00070 as decimal(38, 5))",
+      flatInputs,
+      makeFlatVector(expectedGt));
 };
 
 TEST_F(ComparisonsTest, eqNeqArray) {
@@ -15,6 +15,7 @@
  */
 
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/expression/MultiPathExtractExpr.h"
 #include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
 #include "velox/functions/prestosql/types/JsonType.h"
 
@@ -239,6 +240,113 @@ TEST_F(JsonExtractScalarTest, wildcardSelect) {
       std::nullopt);
 }
 
+TEST_F(JsonExtractScalarTest, multiplePaths) {
+  auto data = makeRowVector({
+      makeNullableFlatVector<std::string>(
+          {R"({"a": 1, "b": "x", "c": {"d": [true, false]}})",
+           std::nullopt,
+           R"({"a": "a long string value that is not inlined", "c": {}})",
+           R"({"b": 2.5, "a": null})",
+           R"({"a": 1, "b": )",
+           R"([1, 2, 3])",
+           R"({"c": {"d": [1, 2]}, "a": [1], "b": false})"},
+          JSON()),
+      makeFlatVector<std::string>({"1", "2", "3", "4", "5", "6", "7"}),
+  });
+  const std::vector<std::string> expressions = {
+      "json_extract_scalar(c0, '$.a')",
+      "json_extract_scalar(c0, '$.b')",
+      "json_extract_scalar(c0, '$.c.d[1]')",
+      "json_extract_scalar(c0, '$[2]')",
+      "json_extract_scalar(c0, '$.missing')",
+      "json_extract_scalar(c1, '$')",
+  };
+  // Calls in different branches are evaluated on different rows.
+  const std::string conditional =
+      "if(c1 <> '3', json_extract_scalar(c0, '$.a'), "
+      "json_extract_scalar(c0, '$.b'))";
+
+  std::vector<VectorPtr> expected;
+  for (const auto& expression : expressions) {
+    expected.push_back(evaluate(expression, data));
+  }
+  auto expectedConditional = evaluate(conditional, data);
+
+  queryCtx_->testingOverrideConfigUnsafe({
+      {core::QueryConfig::kExprMultiPathExtractEnabled, "true"},
+  });
+  auto exprSet = compileExpressions(expressions, asRowType(data->type()));
+  // The calls on c0 share one parse of each document. The only call on c1 is
+  // not grouped.
+  for (auto i = 0; i < expressions.size(); ++i) {
+    ASSERT_EQ(
+        exprSet->exprs()[i]->is<exec::MultiPathExtractExpr>(),
+        i < expressions.size() - 1);
+  }
+
+  exec::EvalCtx context(&execCtx_, exprSet.get(), data.get());
+  std::vector<VectorPtr> results(expressions.size());
+  exprSet->eval(SelectivityVector(data->size()), context, results);
+  for (auto i = 0; i < expressions.size(); ++i) {
+    velox::test::assertEqualVectors(expected[i], results[i]);
+  }
+
+  velox::test::assertEqualVectors(
+      expectedConditional, evaluate(conditional, data));
+}
+
+TEST_F(JsonExtractScalarTest, multiplePathsReusedInput) {
+  queryCtx_->testingOverrideConfigUnsafe({
+      {core::QueryConfig::kExprMultiPathExtractEnabled, "true"},
+  });
+  // Readers may refill the same input vectors for each batch.
+  std::vector<std::string> documents = {
+      R"({"a": "first a0", "b": "first b0"})",
+      R"({"a": "first a1", "b": "first b1"})",
+      R"({"a": "first a2", "b": "first b2"})",
+  };
+  auto json = makeFlatVector<std::string>(documents, JSON());
+  auto condition = makeFlatVector<bool>({true, false, false});
+  auto data = makeRowVector({json, condition});
+
+  auto exprSet = compileExpressions(
+      {"if(c1, json_extract_scalar(c0, '$.a'), "
+       "json_extract_scalar(c0, '$.b'))"},
+      asRowType(data->type()));
+  ASSERT_TRUE(
+      exprSet->exprs()[0]->inputs()[1]->is<exec::MultiPathExtractExpr>());
+
+  auto evaluateBatch = [&]() {
+    exec::EvalCtx context(&execCtx_, exprSet.get(), data.get());
+    std::vector<VectorPtr> results(1);
+    exprSet->eval(SelectivityVector(data->size()), context, results);
+    return results[0];
+  };
+
+  // The else branch extracts both paths for rows 1 and 2 and keeps the values
+  // of '$.a' it does not use.
+  velox::test::assertEqualVectors(
+      makeFlatVector<std::string>({"first a0", "first b1", "first b2"}),
+      evaluateBatch());
+
+  documents = {
+      R"({"a": "second a0", "b": "second b0"})",
+      R"({"a": "second a1", "b": "second b1"})",
+      R"({"a": "second a2", "b": "second b2"})",
+  };
+  for (auto i = 0; i < documents.size(); ++i) {
+    json->set(i, StringView(documents[i]));
+  }
+  condition->set(0, false);
+  condition->set(1, true);
+
+  // The then branch now runs on row 1 only, which is among the rows extracted
+  // for the previous batch.
+  velox::test::assertEqualVectors(
+      makeFlatVector<std::string>({"second b0", "second a1", "second b2"}),
+      evaluateBatch());
+}
+
 } // namespace
 
 } // namespace facebook::velox::functions::prestosql
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/functions/sparksql/GetJsonObject.h"
+
+namespace facebook::velox::functions::sparksql {
+namespace {
+
+using GetJsonObject = GetJsonObjectFunction<exec::VectorExec>;
+
+// Evaluates get_json_object for several paths with one parse of each
+// document. The document is rewound before each path.
+class GetJsonObjectExtractor : public exec::MultiPathExtractor {
+ public:
+  explicit GetJsonObjectExtractor(const std::vector<std::string>& paths) {
+    formattedPaths_.reserve(paths.size());
+    for (const auto& path : paths) {
+      StringView pathView(path);
+      if (!GetJsonObject::checkJsonPath(pathView)) {
+        formattedPaths_.emplace_back(std::nullopt);
+      } else if (path.size() == 1) {
+        // The path "$" selects the whole document.
+        formattedPaths_.emplace_back("");
+      } else {
+        formattedPaths_.emplace_back(
+            GetJsonObject::normalizeJsonPath(pathView));
+      }
+    }
+  }
+
+  void extract(
+      const SelectivityVector& rows,
+      const DecodedVector& input,
+      exec::EvalCtx& context,
+      std::vector<VectorPtr>& results) const override {
+    std::vector<FlatVector<StringView>*> flatResults(formattedPaths_.size());
+    for (auto i = 0; i < formattedPaths_.size(); ++i) {
+      context.ensureWritable(rows, VARCHAR(), results[i]);
+      flatResults[i] = results[i]->asFlatVector<StringView>();
+    }
+
+    std::string value;
+    rows.applyToSelected([&](auto row) {
+      if (input.isNullAt(row)) {
+        for (auto* flatResult : flatResults) {
+          flatResult->setNull(row, true);
+        }
+        return;
+      }
+      const auto json = input.valueAt<StringView>(row);
+      simdjson::padded_string paddedJson(json.data(), json.size());
+      simdjson::ondemand::document jsonDoc;
+      std::optional<bool> parsed;
+      bool atStart = true;
+      for (auto i = 0; i < formattedPaths_.size(); ++i) {
+        const auto& formattedPath = formattedPaths_[i];
+        if (!formattedPath.has_value()) {
+          flatResults[i]->setNull(row, true);
+          continue;
+        }
+        if (formattedPath->empty()) {
+          flatResults[i]->set(row, json);
+          continue;
+        }
+        // Parses on first use, so that a document is not parsed if all paths
+        // are invalid or "$".
+        if (!parsed.has_value()) {
+          parsed = !simdjsonParseIncomplete(paddedJson).get(jsonDoc);
+        }
+        if (!parsed.value()) {
+          flatResults[i]->setNull(row, true);
+          continue;
+        }
+        if (!atStart) {
+          jsonDoc.rewind();
+        }
+        atStart = false;
+        value.clear();
+        const auto error =
+            GetJsonObject::extractFromDocument(jsonDoc, *formattedPath, value);
+        if (error == simdjson::SUCCESS) {
+          flatResults[i]->set(row, StringView(value));
+          continue;
+        }
+        flatResults[i]->setNull(row, true);
+        if (error != simdjson::NO_SUCH_FIELD) {
+          parsed.reset();
+          atStart = true;
+        }
+      }
+    });
+  }
+
+ private:
+  // The normalized path for each path, std::nullopt for an invalid path and
+  // an empty string for "$".
+  std::vector<std::optional<std::string>> formattedPaths_;
+};
+
+} // namespace
+
+std::unique_ptr<exec::MultiPathExtractor> makeGetJsonObjectExtractor(
+    const std::vector<std::string>& paths,
+    const TypePtr& resultType) {
+  if (!resultType->isVarchar()) {
+    return nullptr;
+  }
+  return std::make_unique<GetJsonObjectExtractor>(paths);
+}
+
+} // namespace facebook::velox::functions::sparksql
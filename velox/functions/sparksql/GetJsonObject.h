@@ -17,6 +17,7 @@
 #pragma once
 
 #include <boost/regex.hpp>
+#include "velox/expression/MultiPathExtractExpr.h"
 #include "velox/functions/Macros.h"
 #include "velox/functions/prestosql/json/SIMDJsonUtil.h"
 
@@ -62,42 +63,73 @@ struct GetJsonObjectFunction {
     }
     const auto formattedJsonPath =
         jsonPath_.has_value() ? jsonPath_.value() : normalizeJsonPath(jsonPath);
+    return extractFromDocument(jsonDoc, formattedJsonPath, result) ==
+        simdjson::SUCCESS;
+  }
+
+  FOLLY_ALWAYS_INLINE static bool checkJsonPath(StringView jsonPath) {
+    // Spark requires the first char in jsonPath is '$'.
+    if (jsonPath.empty() || jsonPath.data()[0] != '$') {
+      return false;
+    }
+    return true;
+  }
+
+  // Normalizes the JSON path to be Spark-compatible:
+  // - Removes single quotes in bracket notation
+  // - Removes spaces after dots (e.g., "$. a" -> "$.a")
+  static std::string normalizeJsonPath(StringView jsonPath) {
+    // First, remove single quotes for bracket notation
+    const std::string& path = removeSingleQuotes(jsonPath);
+    if (path == "-1") {
+      return path;
+    }
+
+    // Use Boost regex to find and remove spaces after dots
+    // Pattern: "dot + one or more spaces" -> "dot"
+    static const boost::regex dotSpaceRegex("\\.\\s+");
+    return boost::regex_replace(path, dotSpaceRegex, ".");
+  }
+
+  // Extracts the value at 'formattedJsonPath' from 'jsonDoc' and appends it to
+  // 'result'. 'jsonDoc' must be at its start, so that several paths can be
+  // extracted from one parse by rewinding the document in between. Returns
+  // NO_SUCH_FIELD if the path has no value. Other errors may leave 'jsonDoc'
+  // in a state that rewind() does not reset.
+  template <typename TResult>
+  static simdjson::error_code extractFromDocument(
+      simdjson::ondemand::document& jsonDoc,
+      const std::string& formattedJsonPath,
+      TResult& result) {
     try {
       // Can return error result or throw exception possibly.
       auto rawResult = jsonDoc.at_path(formattedJsonPath);
       if (rawResult.error()) {
-        return false;
+        return rawResult.error();
       }
 
       if (!extractStringResult(rawResult, result)) {
-        return false;
+        return simdjson::INCORRECT_TYPE;
       }
-    } catch (simdjson::simdjson_error&) {
-      return false;
+    } catch (simdjson::simdjson_error& e) {
+      return e.error();
     }
 
     const char* currentPos;
-    if (jsonDoc.current_location().get(currentPos)) {
-      return false;
+    if (auto error = jsonDoc.current_location().get(currentPos)) {
+      return error;
     }
 
-    return isValidEndingCharacter(currentPos);
+    return isValidEndingCharacter(currentPos) ? simdjson::SUCCESS
+                                              : simdjson::TAPE_ERROR;
   }
 
  private:
-  FOLLY_ALWAYS_INLINE bool checkJsonPath(StringView jsonPath) {
-    // Spark requires the first char in jsonPath is '$'.
-    if (jsonPath.empty() || jsonPath.data()[0] != '$') {
-      return false;
-    }
-    return true;
-  }
-
   // Spark's json path requires field name surrounded by single quotes if it is
   // specified in "[]". But simdjson lib requires not. This method just removes
   // such single quotes to adapt to simdjson lib, e.g., converts "['a']['b']" to
   // "[a][b]".
-  std::string removeSingleQuotes(StringView jsonPath) {
+  static std::string removeSingleQuotes(StringView jsonPath) {
     // Skip the initial "$".
     std::string result(jsonPath.data() + 1, jsonPath.size() - 1);
     size_t pairEnd = 0;
@@ -118,28 +150,13 @@ struct GetJsonObjectFunction {
     return result;
   }
 
-  // Normalizes the JSON path to be Spark-compatible:
-  // - Removes single quotes in bracket notation
-  // - Removes spaces after dots (e.g., "$. a" -> "$.a")
-  std::string normalizeJsonPath(StringView jsonPath) {
-    // First, remove single quotes for bracket notation
-    const std::string& path = removeSingleQuotes(jsonPath);
-    if (path == "-1") {
-      return path;
-    }
-
-    // Use Boost regex to find and remove spaces after dots
-    // Pattern: "dot + one or more spaces" -> "dot"
-    static const boost::regex dotSpaceRegex("\\.\\s+");
-    return boost::regex_replace(path, dotSpaceRegex, ".");
-  }
-
   // Extracts a string representation from a simdjson result. Handles various
   // JSON types including numbers, booleans, strings, objects, and arrays.
   // Returns true if the conversion is successful. Otherwise, returns false.
-  bool extractStringResult(
+  template <typename TResult>
+  static bool extractStringResult(
       simdjson::simdjson_result<simdjson::ondemand::value> rawResult,
-      out_type<Varchar>& result) {
+      TResult& result) {
     std::stringstream ss;
     switch (rawResult.type()) {
       // For number and bool types, we need to explicitly get the value
@@ -216,7 +233,7 @@ struct GetJsonObjectFunction {
   // On-Demand API we are using ignores json format validation for characters
   // following the current parsing position. As json doc is padded with NULL
   // characters, it's safe to do recursively check.
-  bool isValidEndingCharacter(const char* currentPos) {
+  static bool isValidEndingCharacter(const char* currentPos) {
     char endingChar = *currentPos;
     if (endingChar == ',' || endingChar == '}' || endingChar == ']') {
       return true;
@@ -234,4 +251,10 @@ struct GetJsonObjectFunction {
   std::optional<std::string> jsonPath_;
 };
 
+/// Makes an extractor that evaluates get_json_object for several paths with
+/// one parse of each document.
+std::unique_ptr<exec::MultiPathExtractor> makeGetJsonObjectExtractor(
+    const std::vector<std::string>& paths,
+    const TypePtr& resultType);
+
 } // namespace facebook::velox::functions::sparksql
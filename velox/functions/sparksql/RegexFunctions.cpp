@@ -66,7 +66,7 @@ struct RegexpReplaceFunction {
       const arg_type<int32_t>* /*position*/) {
     if (pattern) {
       const auto processedPattern = prepareRegexpReplacePattern(*pattern);
-      re_.emplace(processedPattern, RE2::Quiet);
+      re_ = RegexCache::instance().findOrCompile(processedPattern, RE2::Quiet);
       VELOX_USER_CHECK(
           re_->ok(),
           "Invalid regular expression {}: {}.",
@@ -78,7 +78,7 @@ struct RegexpReplaceFunction {
         // be processed during initialization; otherwise, each row needs to be
         // processed separately.
         constantReplacement_ =
-            prepareRegexpReplaceReplacement(re_.value(), *replacement);
+            prepareRegexpReplaceReplacement(*re_, *replacement);
       }
     }
     cache_.setMaxCompiledRegexes(config.exprMaxCompiledRegexes());
@@ -172,16 +172,16 @@ struct RegexpReplaceFunction {
     result = prefix + targetString;
   }
 
-  RE2& ensurePattern(const arg_type<Varchar>& pattern) {
-    if (re_.has_value()) {
-      return re_.value();
+  const RE2& ensurePattern(const arg_type<Varchar>& pattern) {
+    if (re_ != nullptr) {
+      return *re_;
     }
     auto processedPattern = prepareRegexpReplacePattern(pattern);
     return *cache_.findOrCompile(StringView(processedPattern));
   }
 
   // Used when pattern is constant.
-  std::optional<RE2> re_;
+  std::shared_ptr<const RE2> re_;
 
   // Used when replacement is constant.
   std::optional<std::string> constantReplacement_;
@@ -24,6 +24,8 @@ namespace facebook::velox::functions::sparksql {
 void registerJsonFunctions(const std::string& prefix) {
   registerFunction<GetJsonObjectFunction, Varchar, Varchar, Varchar>(
       {prefix + "get_json_object"});
+  exec::registerMultiPathFunction(
+      prefix + "get_json_object", makeGetJsonObjectExtractor);
   registerFunction<JsonObjectKeysFunction, Array<Varchar>, Varchar>(
       {prefix + "json_object_keys"});
   registerFunction<JsonArrayLengthFunction, int32_t, Varchar>(
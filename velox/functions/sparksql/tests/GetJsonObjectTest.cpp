@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include <stdint.h>
+#include "velox/expression/MultiPathExtractExpr.h"
 #include "velox/functions/sparksql/tests/SparkFunctionBaseTest.h"
 #include "velox/type/Type.h"
 
@@ -162,5 +163,47 @@ TEST_F(GetJsonObjectTest, incompleteJson) {
       R"({"name": "Alice", "age": "5", "id": "001"})");
 }
 
+TEST_F(GetJsonObjectTest, multiplePaths) {
+  auto data = makeRowVector({
+      makeNullableFlatVector<std::string>(
+          {R"({"a": 1, "b": "x", "c": {"d": [true, false]}})",
+           std::nullopt,
+           R"({"a": "a long string value that is not inlined", "c": {}})",
+           R"({"b": 2.5, "a": null})",
+           R"({"a": 1, "b": )",
+           R"({"hello": "boy","taskSort":"2"},,,,,)",
+           R"({"c": {"d": [1, 2]}, "a": [1], "b": false})"}),
+  });
+  const std::vector<std::string> expressions = {
+      "get_json_object(c0, '$.a')",
+      "get_json_object(c0, '$.b')",
+      "get_json_object(c0, '$.c.d[1]')",
+      "get_json_object(c0, '$[''c'']')",
+      "get_json_object(c0, '$.hello')",
+      "get_json_object(c0, '$')",
+      "get_json_object(c0, 'a')",
+  };
+
+  std::vector<VectorPtr> expected;
+  for (const auto& expression : expressions) {
+    expected.push_back(evaluate(expression, data));
+  }
+
+  queryCtx_->testingOverrideConfigUnsafe({
+      {core::QueryConfig::kExprMultiPathExtractEnabled, "true"},
+  });
+  auto exprSet = compileExpressions(expressions, asRowType(data->type()));
+  for (const auto& expr : exprSet->exprs()) {
+    ASSERT_TRUE(expr->is<exec::MultiPathExtractExpr>());
+  }
+
+  exec::EvalCtx context(&execCtx_, exprSet.get(), data.get());
+  std::vector<VectorPtr> results(expressions.size());
+  exprSet->eval(SelectivityVector(data->size()), context, results);
+  for (auto i = 0; i < expressions.size(); ++i) {
+    velox::test::assertEqualVectors(expected[i], results[i]);
+  }
+}
+
 } // namespace
 } // namespace facebook::velox::functions::sparksql::test
@@ -60,6 +60,33 @@ writeString(const StringView& value, char* buffer, size_t& offset) {
   offset += kSizeBytes + value.size();
 }
 
+// Adds the serialized sizes of non-null strings at 'rows' of 'decoded' to
+// 'sizes'.
+void addStringSizes(
+    const DecodedVector& decoded,
+    const raw_vector<vector_size_t>& rows,
+    vector_size_t* sizes) {
+  const auto* values = decoded.data<StringView>();
+  const auto numRows = rows.size();
+  if (!decoded.mayHaveNulls()) {
+    if (decoded.isIdentityMapping()) {
+      for (auto i = 0; i < numRows; ++i) {
+        sizes[i] += kSizeBytes + values[rows[i]].size();
+      }
+    } else {
+      for (auto i = 0; i < numRows; ++i) {
+        sizes[i] += kSizeBytes + values[decoded.index(rows[i])].size();
+      }
+    }
+    return;
+  }
+  for (auto i = 0; i < numRows; ++i) {
+    if (!decoded.isNullAt(rows[i])) {
+      sizes[i] += kSizeBytes + values[decoded.index(rows[i])].size();
+    }
+  }
+}
+
 // Serialize the child vector of a row type within a range of consecutive rows.
 // Write the serialized data at offsets of buffer row by row.
 // Update offsets with the actual serialized size.
@@ -328,6 +355,42 @@ int32_t CompactRow::rowRowSize(vector_size_t index) const {
   return size;
 }
 
+void CompactRow::rowSizes(
+    const folly::Range<const vector_size_t*>& rows,
+    vector_size_t* sizes) const {
+  const auto numRows = rows.size();
+  raw_vector<vector_size_t> childRows(numRows);
+  for (auto i = 0; i < numRows; ++i) {
+    childRows[i] = decoded_.index(rows[i]);
+  }
+
+  int32_t fixedSize = rowNullBytes_;
+  for (auto i = 0; i < children_.size(); ++i) {
+    if (childIsFixedWidth_[i]) {
+      fixedSize += children_[i].valueBytes_;
+    }
+  }
+  std::fill(sizes, sizes + numRows, fixedSize);
+
+  for (auto childIdx = 0; childIdx < children_.size(); ++childIdx) {
+    if (childIsFixedWidth_[childIdx]) {
+      continue;
+    }
+    const auto& child = children_[childIdx];
+    if (child.typeKind_ == TypeKind::VARCHAR ||
+        child.typeKind_ == TypeKind::VARBINARY) {
+      addStringSizes(child.decoded_, childRows, sizes);
+      continue;
+    }
+    const bool mayHaveNulls = child.decoded_.mayHaveNulls();
+    for (auto i = 0; i < numRows; ++i) {
+      if (!mayHaveNulls || !child.isNullAt(childRows[i])) {
+        sizes[i] += child.variableWidthRowSize(childRows[i]);
+      }
+    }
+  }
+}
+
 void CompactRow::serializedRowSizes(
     const folly::Range<const vector_size_t*>& rows,
     vector_size_t** sizes) const {
@@ -339,8 +402,10 @@ void CompactRow::serializedRowSizes(
     return;
   }
 
-  for (const auto& row : rows) {
-    *sizes[row] = rowSize(row) + sizeof(TRowSize);
+  raw_vector<vector_size_t> rowSizesScratch(rows.size());
+  rowSizes(rows, rowSizesScratch.data());
+  for (auto i = 0; i < rows.size(); ++i) {
+    *sizes[rows[i]] = rowSizesScratch[i] + sizeof(TRowSize);
   }
 }
 
@@ -381,17 +446,17 @@ int32_t CompactRow::serializeRow(vector_size_t index, char* buffer) const {
 }
 
 void CompactRow::serializeRow(
-    vector_size_t offset,
-    vector_size_t size,
+    const folly::Range<const vector_size_t*>& topRows,
     char* buffer,
     const size_t* bufferOffsets) const {
+  const auto size = topRows.size();
   raw_vector<vector_size_t> rows(size);
   raw_vector<uint8_t*> nulls(size);
   if (decoded_.isIdentityMapping()) {
-    std::iota(rows.begin(), rows.end(), offset);
+    std::copy(topRows.begin(), topRows.end(), rows.begin());
   } else {
     for (auto i = 0; i < size; ++i) {
-      rows[i] = decoded_.index(offset + i);
+      rows[i] = decoded_.index(topRows[i]);
     }
   }
 
@@ -661,7 +726,19 @@ void CompactRow::serialize(
     vector_size_t size,
     const size_t* bufferOffsets,
     char* buffer) const {
-  serializeRow(offset, size, buffer, bufferOffsets);
+  raw_vector<vector_size_t> rows(size);
+  std::iota(rows.begin(), rows.end(), offset);
+  serializeRow(
+      folly::Range<const vector_size_t*>(rows.data(), rows.size()),
+      buffer,
+      bufferOffsets);
+}
+
+void CompactRow::serialize(
+    const folly::Range<const vector_size_t*>& rows,
+    const size_t* bufferOffsets,
+    char* buffer) const {
+  serializeRow(rows, buffer, bufferOffsets);
 }
 
 void CompactRow::serializeFixedWidth(vector_size_t index, char* buffer) const {
@@ -744,6 +821,21 @@ void readFixedWidthValue(
   }
 }
 
+// Reads single fixed-width value from buffer into rawValues[index].
+template <typename T>
+void readFixedWidthValue(
+    const char* buffer,
+    T* rawValues,
+    vector_size_t index) {
+  if constexpr (std::is_same_v<T, Timestamp>) {
+    int64_t micros;
+    ::memcpy(&micros, buffer, sizeof(int64_t));
+    rawValues[index] = Timestamp::fromMicros(micros);
+  } else {
+    ::memcpy(rawValues + index, buffer, sizeof(T));
+  }
+}
+
 template <typename T>
 int32_t valueSize() {
   if constexpr (std::is_same_v<T, Timestamp>) {
@@ -772,11 +864,25 @@ VectorPtr deserializeFixedWidth(
   auto flatVector = BaseVector::create<FlatVector<T>>(type, numRows, pool);
 
   auto* rawNulls = nulls->as<uint64_t>();
+  const bool hasNulls = !bits::isAllSet(rawNulls, 0, numRows);
+  if (hasNulls) {
+    flatVector->setNulls(nulls);
+  }
 
-  for (auto i = 0; i < numRows; ++i) {
-    const bool isNull = bits::isBitNull(rawNulls, i);
-    readFixedWidthValue<T>(
-        isNull, data[i].data() + offsets[i], flatVector.get(), i);
+  if constexpr (std::is_same_v<T, bool>) {
+    auto* rawValues = flatVector->template mutableRawValues<uint64_t>();
+    for (auto i = 0; i < numRows; ++i) {
+      if (!hasNulls || !bits::isBitNull(rawNulls, i)) {
+        bits::setBit(rawValues, i, data[i][offsets[i]] != 0);
+      }
+    }
+  } else {
+    auto* rawValues = flatVector->mutableRawValues();
+    for (auto i = 0; i < numRows; ++i) {
+      if (!hasNulls || !bits::isBitNull(rawNulls, i)) {
+        readFixedWidthValue<T>(data[i].data() + offsets[i], rawValues, i);
+      }
+    }
   }
 
   return flatVector;
@@ -878,14 +984,41 @@ VectorPtr deserializeStrings(
       BaseVector::create<FlatVector<StringView>>(type, numRows, pool);
 
   auto* rawNulls = nulls->as<uint64_t>();
+  const bool hasNulls = !bits::isAllSet(rawNulls, 0, numRows);
+  if (hasNulls) {
+    flatVector->setNulls(nulls);
+  }
+
+  // Copies the strings that are not inlined into a single buffer.
+  size_t totalBytes = 0;
+  for (auto i = 0; i < numRows; ++i) {
+    if (!hasNulls || !bits::isBitNull(rawNulls, i)) {
+      const uint32_t size = readInt32(data[i].data() + offsets[i]);
+      if (!StringView::isInline(size)) {
+        totalBytes += size;
+      }
+    }
+  }
+  char* rawBuffer = totalBytes > 0
+      ? flatVector->getRawStringBufferWithSpace(totalBytes, true)
+      : nullptr;
 
+  auto* rawValues = flatVector->mutableRawValues();
   for (auto i = 0; i < numRows; ++i) {
-    if (bits::isBitNull(rawNulls, i)) {
-      flatVector->setNull(i, true);
+    if (hasNulls && bits::isBitNull(rawNulls, i)) {
+      rawValues[i] = StringView();
+      continue;
+    }
+    const auto* buffer = data[i].data() + offsets[i];
+    const uint32_t size = readInt32(buffer);
+    if (StringView::isInline(size)) {
+      rawValues[i] = StringView(buffer + kSizeBytes, size);
     } else {
-      offsets[i] +=
-          readString(data[i].data() + offsets[i], flatVector.get(), i);
+      ::memcpy(rawBuffer, buffer + kSizeBytes, size);
+      rawValues[i] = StringView(rawBuffer, size);
+      rawBuffer += size;
     }
+    offsets[i] += kSizeBytes + size;
   }
 
   return flatVector;
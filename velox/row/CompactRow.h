@@ -25,8 +25,6 @@ class CompactRow {
   explicit CompactRow(const RowVectorPtr& vector);
 
   /// Returns the serialized sizes of the rows at specified indexes.
-  ///
-  /// TODO: optimizes using columnar serialization size calculation.
   void serializedRowSizes(
       const folly::Range<const vector_size_t*>& rows,
       vector_size_t** sizes) const;
@@ -39,6 +37,13 @@ class CompactRow {
   /// 'fixedRowSize' returned std::nullopt.
   int32_t rowSize(vector_size_t index) const;
 
+  /// Sets 'sizes[i]' to the serialized size of row 'rows[i]'. Computes the
+  /// sizes one column at a time for all rows. Use only if 'fixedRowSize'
+  /// returned std::nullopt.
+  void rowSizes(
+      const folly::Range<const vector_size_t*>& rows,
+      vector_size_t* sizes) const;
+
   /// Serializes row at specified index into 'buffer'.
   /// 'buffer' must have sufficient capacity and set to all zeros.
   int32_t serialize(vector_size_t index, char* buffer) const;
@@ -55,6 +60,14 @@ class CompactRow {
       const size_t* bufferOffsets,
       char* buffer) const;
 
+  /// Serializes rows 'rows' into 'buffer' at given 'bufferOffsets' one column
+  /// at a time. 'bufferOffsets[i]' is the write offset of 'rows[i]'. Same
+  /// requirements on 'buffer' and 'bufferOffsets' as above.
+  void serialize(
+      const folly::Range<const vector_size_t*>& rows,
+      const size_t* bufferOffsets,
+      char* buffer) const;
+
   /// Deserializes multiple rows into a RowVector of specified type. The type
   /// must match the contents of the serialized rows.
   static RowVectorPtr deserialize(
@@ -130,11 +143,9 @@ class CompactRow {
   /// Serializes struct value to buffer. Value must not be null.
   int32_t serializeRow(vector_size_t index, char* buffer) const;
 
-  /// Serializes struct values in range [offset, offset + size) to buffer.
-  /// Value must not be null.
+  /// Serializes struct values at 'rows' to buffer. Values must not be null.
   void serializeRow(
-      vector_size_t offset,
-      vector_size_t size,
+      const folly::Range<const vector_size_t*>& rows,
       char* buffer,
       const size_t* bufferOffsets) const;
 
@@ -84,6 +84,16 @@ class CompactRowTest : public ::testing::Test, public VectorTestBase {
       ASSERT_EQ(serializedRowSizes[i], row.rowSize(i) + sizeof(uint32_t));
     }
 
+    if (!CompactRow::fixedRowSize(rowType).has_value()) {
+      // Compute the sizes of the rows in reverse order.
+      std::vector<vector_size_t> reversedRows(rows.rbegin(), rows.rend());
+      std::vector<vector_size_t> sizes(numRows);
+      row.rowSizes(folly::Range(reversedRows.data(), numRows), sizes.data());
+      for (auto i = 0; i < numRows; ++i) {
+        ASSERT_EQ(sizes[i], row.rowSize(reversedRows[i]));
+      }
+    }
+
     BufferPtr buffer = AlignedBuffer::allocate<char>(totalSize, pool(), 0);
     auto* rawBuffer = buffer->asMutable<char>();
     {
@@ -126,6 +136,31 @@ class CompactRowTest : public ::testing::Test, public VectorTestBase {
       auto copy = CompactRow::deserialize(serialized, rowType, pool());
       assertEqualVectors(data, copy);
     }
+    {
+      // Test serialize by row numbers. Serializes odd rows before even rows.
+      memset(rawBuffer, 0, totalSize);
+
+      std::vector<vector_size_t> shuffledRows;
+      std::vector<size_t> shuffledOffsets;
+      for (auto start : {1, 0}) {
+        for (auto i = start; i < numRows; i += 2) {
+          shuffledRows.push_back(i);
+          shuffledOffsets.push_back(offsets[i]);
+        }
+      }
+      row.serialize(
+          folly::Range(shuffledRows.data(), numRows),
+          shuffledOffsets.data(),
+          rawBuffer);
+
+      std::vector<std::string_view> serialized;
+      for (auto i = 0; i < numRows; ++i) {
+        serialized.push_back(
+            std::string_view(rawBuffer + offsets[i], rowSize[i]));
+      }
+      auto copy = CompactRow::deserialize(serialized, rowType, pool());
+      assertEqualVectors(data, copy);
+    }
   }
 };
 
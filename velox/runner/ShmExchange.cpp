@@ -0,0 +1,380 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/runner/ShmExchange.h"
+
+#include <folly/futures/Future.h>
+
+namespace facebook::velox::runner {
+namespace {
+
+// Interval between checks of a ring for new data.
+constexpr std::chrono::microseconds kPollInterval{1'000};
+
+// Maximum number of page sizes reported as remaining bytes.
+constexpr int32_t kMaxRemainingPages = 16;
+
+class ShmExchangeSource : public exec::ExchangeSource {
+ public:
+  ShmExchangeSource(
+      const std::string& taskId,
+      int destination,
+      std::shared_ptr<exec::ExchangeQueue> queue,
+      memory::MemoryPool* pool)
+      : ExchangeSource(taskId, destination, std::move(queue), pool),
+        ringName_(ShmRingBuffer::segmentName(taskId, destination)) {}
+
+  bool supportsMetrics() const override {
+    return true;
+  }
+
+  bool shouldRequestLocked() override {
+    if (atEnd_) {
+      return false;
+    }
+    return !requestPending_.exchange(true);
+  }
+
+  folly::SemiFuture<Response> request(
+      uint32_t maxBytes,
+      std::chrono::microseconds maxWait) override {
+    VELOX_CHECK(requestPending_);
+    return poll(maxBytes, std::chrono::steady_clock::now() + maxWait);
+  }
+
+  folly::SemiFuture<Response> requestDataSizes(
+      std::chrono::microseconds maxWait) override {
+    return request(0, maxWait);
+  }
+
+  void close() override {
+    std::lock_guard<std::mutex> l(mutex_);
+    closed_ = true;
+    if (ring_ != nullptr) {
+      ring_->abandon();
+    }
+  }
+
+  folly::F14FastMap<std::string, RuntimeMetric> metrics() const override {
+    return {
+        {"shmExchangeSource.numPages", RuntimeMetric(numPages_)},
+        {"shmExchangeSource.totalBytes",
+         RuntimeMetric(totalBytes_, RuntimeCounter::Unit::kBytes)},
+    };
+  }
+
+ private:
+  // Returns the pages in the ring if there are any, else checks again after
+  // kPollInterval until 'deadline'. Only sizes are returned if 'maxBytes' is
+  // 0.
+  folly::SemiFuture<Response> poll(
+      uint32_t maxBytes,
+      std::chrono::steady_clock::time_point deadline) {
+    std::shared_ptr<ShmRingBuffer> ring;
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      if (closed_) {
+        return finishRequest({}, 0, false, {});
+      }
+      if (ring_ == nullptr) {
+        // The producer may not have created the ring yet.
+        ring_ = ShmRingBuffer::open(ringName_);
+      }
+      ring = ring_;
+    }
+
+    if (ring != nullptr) {
+      if (ring->failed()) {
+        ring->acknowledge();
+        queue_->setError(fmt::format("Producer of {} failed", ring->name()));
+        return finishRequest({}, 0, false, {});
+      }
+      std::vector<std::unique_ptr<exec::SerializedPage>> pages;
+      int64_t bytes = 0;
+      if (maxBytes > 0) {
+        while (bytes < maxBytes) {
+          auto message = ring->tryRead();
+          if (!message.has_value()) {
+            break;
+          }
+          bytes += message->size;
+          pages.push_back(makePage(ring, *message));
+        }
+      }
+      const bool atEnd = ring->atEnd();
+      if (atEnd) {
+        ring->acknowledge();
+      }
+      auto remainingBytes = ring->peekSizes(kMaxRemainingPages);
+      if (!pages.empty() || atEnd ||
+          (maxBytes == 0 && !remainingBytes.empty())) {
+        return finishRequest(
+            std::move(pages), bytes, atEnd, std::move(remainingBytes));
+      }
+    }
+
+    if (std::chrono::steady_clock::now() >= deadline) {
+      return finishRequest({}, 0, false, {});
+    }
+    auto self =
+        std::static_pointer_cast<ShmExchangeSource>(shared_from_this());
+    return folly::futures::sleep(kPollInterval)
+        .deferValue([self, maxBytes, deadline](auto&& /*unused*/) {
+          return self->poll(maxBytes, deadline);
+        });
+  }
+
+  // Wraps 'message' in a page without copying. The space of the message is
+  // released in 'ring' when the last reference to the page data is gone.
+  static std::unique_ptr<exec::SerializedPage> makePage(
+      const std::shared_ptr<ShmRingBuffer>& ring,
+      const ShmRingBuffer::Message& message) {
+    struct Release {
+      std::shared_ptr<ShmRingBuffer> ring;
+      uint64_t begin;
+      uint64_t end;
+    };
+    auto iobuf = folly::IOBuf::takeOwnership(
+        const_cast<char*>(message.data),
+        message.size,
+        [](void* /*buf*/, void* userData) {
+          auto* release = reinterpret_cast<Release*>(userData);
+          release->ring->release(release->begin, release->end);
+          delete release;
+        },
+        new Release{ring, message.begin, message.end});
+    return std::make_unique<exec::SerializedPage>(std::move(iobuf));
+  }
+
+  folly::SemiFuture<Response> finishRequest(
+      std::vector<std::unique_ptr<exec::SerializedPage>> pages,
+      int64_t bytes,
+      bool atEnd,
+      std::vector<int64_t> remainingBytes) {
+    numPages_ += pages.size();
+    totalBytes_ += bytes;
+    std::vector<ContinuePromise> queuePromises;
+    {
+      std::lock_guard<std::mutex> l(queue_->mutex());
+      requestPending_ = false;
+      sequence_ += pages.size();
+      for (auto& page : pages) {
+        queue_->enqueueLocked(std::move(page), queuePromises);
+      }
+      if (atEnd) {
+        queue_->enqueueLocked(nullptr, queuePromises);
+        atEnd_ = true;
+      }
+    }
+    for (auto& promise : queuePromises) {
+      promise.setValue();
+    }
+    return folly::makeSemiFuture(
+        Response{bytes, atEnd, std::move(remainingBytes)});
+  }
+
+  const std::string ringName_;
+
+  std::mutex mutex_;
+  std::shared_ptr<ShmRingBuffer> ring_;
+  bool closed_{false};
+
+  std::atomic<int64_t> numPages_{0};
+  std::atomic<int64_t> totalBytes_{0};
+};
+} // namespace
+
+std::unique_ptr<exec::ExchangeSource> createShmExchangeSource(
+    const std::string& taskId,
+    int destination,
+    std::shared_ptr<exec::ExchangeQueue> queue,
+    memory::MemoryPool* pool) {
+  if (strncmp(taskId.c_str(), "shm://", 6) == 0) {
+    return std::make_unique<ShmExchangeSource>(
+        taskId, destination, std::move(queue), pool);
+  }
+  return nullptr;
+}
+
+void registerShmExchangeSource() {
+  exec::ExchangeSource::registerFactory(createShmExchangeSource);
+}
+
+ShmOutputBufferPublisher::ShmOutputBufferPublisher(
+    std::string taskId,
+    int numDestinations,
+    uint64_t ringCapacity,
+    std::shared_ptr<exec::OutputBufferManager> bufferManager)
+    : taskId_(std::move(taskId)),
+      bufferManager_(std::move(bufferManager)),
+      signal_(std::make_shared<Signal>()) {
+  VELOX_CHECK_NOT_NULL(bufferManager_);
+  destinations_.reserve(numDestinations);
+  for (auto i = 0; i < numDestinations; ++i) {
+    auto destination = std::make_shared<Destination>();
+    destination->ring = ShmRingBuffer::create(
+        ShmRingBuffer::segmentName(taskId_, i), ringCapacity);
+    destinations_.push_back(std::move(destination));
+  }
+  thread_ = std::thread([this]() { run(); });
+}
+
+ShmOutputBufferPublisher::~ShmOutputBufferPublisher() {
+  {
+    std::lock_guard<std::mutex> l(signal_->mutex);
+    stop_ = true;
+  }
+  signal_->condition.notify_one();
+  thread_.join();
+  for (auto i = 0; i < destinations_.size(); ++i) {
+    auto& destination = *destinations_[i];
+    {
+      std::lock_guard<std::mutex> l(destination.mutex);
+      if (destination.finished) {
+        continue;
+      }
+      destination.finished = true;
+      destination.ring->fail();
+    }
+    bufferManager_->deleteResults(taskId_, i);
+  }
+}
+
+bool ShmOutputBufferPublisher::isFinished() const {
+  for (const auto& destination : destinations_) {
+    std::lock_guard<std::mutex> l(destination->mutex);
+    if (!destination->finished || !destination->ring->acknowledged()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ShmOutputBufferPublisher::run() {
+  while (!stop_) {
+    bool progress = false;
+    bool finished = true;
+    for (auto i = 0; i < destinations_.size(); ++i) {
+      progress |= publish(i);
+      std::lock_guard<std::mutex> l(destinations_[i]->mutex);
+      finished &= destinations_[i]->finished;
+    }
+    if (finished) {
+      return;
+    }
+    if (progress) {
+      continue;
+    }
+    // Waits for data from the output buffer or for the consumers to free
+    // space in the rings.
+    std::unique_lock<std::mutex> l(signal_->mutex);
+    signal_->condition.wait_for(
+        l, kPollInterval, [&]() { return stop_ || signal_->notified; });
+    signal_->notified = false;
+  }
+}
+
+bool ShmOutputBufferPublisher::publish(int destinationIndex) {
+  auto& destination = *destinations_[destinationIndex];
+  auto& ring = *destination.ring;
+  std::unique_lock<std::mutex> l(destination.mutex);
+  if (destination.finished) {
+    return false;
+  }
+  if (ring.abandoned()) {
+    destination.finished = true;
+    l.unlock();
+    bufferManager_->deleteResults(taskId_, destinationIndex);
+    return true;
+  }
+
+  bool progress = false;
+  while (!destination.pages.empty()) {
+    auto& page = destination.pages.front();
+    if (page == nullptr) {
+      ring.close();
+    } else if (page->computeChainDataLength() > ring.maxMessageSize()) {
+      LOG(ERROR) << "Page of " << page->computeChainDataLength()
+                 << " bytes does not fit in " << ring.name() << " of "
+                 << ring.capacity() << " bytes";
+      ring.fail();
+    } else {
+      if (!ring.tryWrite(*page)) {
+        return progress;
+      }
+      destination.pages.pop_front();
+      progress = true;
+      continue;
+    }
+    destination.finished = true;
+    l.unlock();
+    bufferManager_->deleteResults(taskId_, destinationIndex);
+    return true;
+  }
+
+  if (destination.dataPending) {
+    return progress;
+  }
+  destination.dataPending = true;
+  l.unlock();
+  requestData(destinationIndex);
+  return progress;
+}
+
+void ShmOutputBufferPublisher::requestData(int destinationIndex) {
+  auto destination = destinations_[destinationIndex];
+  int64_t requestedSequence;
+  {
+    std::lock_guard<std::mutex> l(destination->mutex);
+    requestedSequence = destination->sequence;
+  }
+  // The callback may run after 'this' is destroyed.
+  auto callback = [destination, signal = signal_, requestedSequence](
+                      std::vector<std::unique_ptr<folly::IOBuf>> pages,
+                      int64_t sequence,
+                      std::vector<int64_t> /*remainingBytes*/) {
+    {
+      std::lock_guard<std::mutex> l(destination->mutex);
+      destination->dataPending = false;
+      // Skips pages that were received before.
+      const auto numSkipped =
+          std::min<int64_t>(requestedSequence - sequence, pages.size());
+      for (auto i = std::max<int64_t>(numSkipped, 0); i < pages.size(); ++i) {
+        destination->pages.push_back(std::move(pages[i]));
+      }
+      destination->sequence = std::max(
+          requestedSequence, sequence + static_cast<int64_t>(pages.size()));
+    }
+    {
+      std::lock_guard<std::mutex> l(signal->mutex);
+      signal->notified = true;
+    }
+    signal->condition.notify_one();
+  };
+
+  // Each page becomes one message, so a request is limited to what fits in
+  // the ring.
+  if (!bufferManager_->getData(
+          taskId_,
+          destinationIndex,
+          destination->ring->maxMessageSize(),
+          requestedSequence,
+          std::move(callback))) {
+    // The task has not been created yet. Retried on the next poll.
+    std::lock_guard<std::mutex> l(destination->mutex);
+    destination->dataPending = false;
+  }
+}
+} // namespace facebook::velox::runner
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <thread>
+
+#include "velox/exec/ExchangeSource.h"
+#include "velox/exec/OutputBufferManager.h"
+#include "velox/runner/ShmRingBuffer.h"
+
+/// Exchange between processes on the same host over shared memory. The
+/// producer process runs the task with a PartitionedOutput and a
+/// ShmOutputBufferPublisher for it. The consumer process runs Exchange
+/// operators that read from the task through ShmExchangeSource. Remote task
+/// ids of this transport start with "shm://" and must be the same string in
+/// both processes.
+///
+/// Each destination of the producer has a ShmRingBuffer. The publisher copies
+/// the serialized pages of the destination from the OutputBufferManager into
+/// the ring. The consumer deserializes the pages in place and releases their
+/// space when done.
+namespace facebook::velox::runner {
+
+/// Returns a ShmExchangeSource for 'taskId' if it starts with "shm://", else
+/// nullptr. To be registered with exec::ExchangeSource::registerFactory().
+std::unique_ptr<exec::ExchangeSource> createShmExchangeSource(
+    const std::string& taskId,
+    int destination,
+    std::shared_ptr<exec::ExchangeQueue> queue,
+    memory::MemoryPool* pool);
+
+/// Registers createShmExchangeSource() as an exchange source factory.
+void registerShmExchangeSource();
+
+/// Moves the output of a task in the producer process to the shared memory
+/// rings read by ShmExchangeSources. The rings are created in the constructor.
+/// The publisher should live until isFinished(). A ring is removed once both
+/// the publisher and its consumer are done with it, so that a consumer that
+/// opens its ring after the publisher is gone still sees the end or the
+/// failure. The task may be created before or after the publisher.
+class ShmOutputBufferPublisher {
+ public:
+  static constexpr uint64_t kDefaultRingCapacity = 32 << 20;
+
+  /// 'ringCapacity' must be more than twice the size of the largest page of
+  /// the task.
+  ShmOutputBufferPublisher(
+      std::string taskId,
+      int numDestinations,
+      uint64_t ringCapacity = kDefaultRingCapacity,
+      std::shared_ptr<exec::OutputBufferManager> bufferManager =
+          exec::OutputBufferManager::getInstanceRef());
+
+  /// Stops publishing. The consumers of unfinished destinations fail.
+  ~ShmOutputBufferPublisher();
+
+  /// Returns true if all destinations have been published to the end or
+  /// abandoned and their consumers have acknowledged that, i.e. read to the
+  /// end, seen the failure or abandoned the ring.
+  bool isFinished() const;
+
+ private:
+  struct Destination {
+    std::unique_ptr<ShmRingBuffer> ring;
+
+    std::mutex mutex;
+    // Pages received from the output buffer and not yet written to 'ring'. A
+    // nullptr is the end marker.
+    std::deque<std::unique_ptr<folly::IOBuf>> pages;
+    // Sequence number of the next page to get from the output buffer.
+    int64_t sequence{0};
+    // True while a getData() callback is outstanding.
+    bool dataPending{false};
+    bool finished{false};
+  };
+
+  struct Signal {
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool notified{false};
+  };
+
+  void run();
+
+  // Moves pages of destination 'destination' into its ring and requests more
+  // from the output buffer. Returns true if anything was done.
+  bool publish(int destination);
+
+  void requestData(int destination);
+
+  const std::string taskId_;
+  const std::shared_ptr<exec::OutputBufferManager> bufferManager_;
+  // Outstanding getData() callbacks hold references.
+  std::vector<std::shared_ptr<Destination>> destinations_;
+  const std::shared_ptr<Signal> signal_;
+  std::atomic_bool stop_{false};
+  std::thread thread_;
+};
+} // namespace facebook::velox::runner
@@ -0,0 +1,305 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/runner/ShmRingBuffer.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <fmt/format.h>
+#include <folly/String.h>
+#include <folly/hash/Hash.h>
+#include <glog/logging.h>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::runner {
+
+// static
+std::string ShmRingBuffer::segmentName(
+    const std::string& taskId,
+    int destination) {
+  // Task ids are too long for shared memory names, which are limited to 31
+  // characters on some platforms.
+  return fmt::format(
+      "/velox-{:016x}-{}", folly::hash::fnv64(taskId), destination);
+}
+
+// static
+std::unique_ptr<ShmRingBuffer> ShmRingBuffer::create(
+    const std::string& name,
+    uint64_t capacity) {
+  capacity = bits::roundUp(capacity, kMessageHeaderSize);
+  VELOX_CHECK_GE(capacity, 4 * kMessageHeaderSize);
+  const uint64_t mappingSize = kHeaderSize + capacity;
+  int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0 && errno == EEXIST) {
+    LOG(WARNING) << "Replacing left over shared memory segment " << name;
+    shm_unlink(name.c_str());
+    fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  }
+  VELOX_CHECK_GE(
+      fd,
+      0,
+      "Cannot create shared memory segment {}: {}",
+      name,
+      folly::errnoStr(errno));
+  struct stat stats;
+  if (fstat(fd, &stats) != 0 || ftruncate(fd, mappingSize) != 0) {
+    const auto error = errno;
+    ::close(fd);
+    shm_unlink(name.c_str());
+    VELOX_FAIL(
+        "Cannot size shared memory segment {}: {}",
+        name,
+        folly::errnoStr(error));
+  }
+  void* mapping =
+      mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  const auto error = errno;
+  ::close(fd);
+  if (mapping == MAP_FAILED) {
+    shm_unlink(name.c_str());
+    VELOX_FAIL(
+        "Cannot map shared memory segment {}: {}",
+        name,
+        folly::errnoStr(error));
+  }
+
+  auto* header = new (mapping) Header();
+  header->capacity = capacity;
+  header->closed = false;
+  header->abandoned = false;
+  header->failed = false;
+  header->acknowledged = false;
+  header->numAttached = 2;
+  header->head = 0;
+  header->tail = 0;
+  // Published last. open() fails until the header is complete.
+  header->magic.store(kMagic, std::memory_order_release);
+  return std::unique_ptr<ShmRingBuffer>(
+      new ShmRingBuffer(name, true, stats, mapping, mappingSize));
+}
+
+// static
+std::unique_ptr<ShmRingBuffer> ShmRingBuffer::open(const std::string& name) {
+  const int fd = shm_open(name.c_str(), O_RDWR, 0);
+  if (fd < 0) {
+    VELOX_CHECK_EQ(
+        errno,
+        ENOENT,
+        "Cannot open shared memory segment {}: {}",
+        name,
+        folly::errnoStr(errno));
+    return nullptr;
+  }
+  struct stat stats;
+  if (fstat(fd, &stats) != 0 ||
+      stats.st_size <= static_cast<off_t>(kHeaderSize)) {
+    // Not sized by the producer yet.
+    ::close(fd);
+    return nullptr;
+  }
+  const uint64_t mappingSize = stats.st_size;
+  void* mapping =
+      mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  const auto error = errno;
+  ::close(fd);
+  VELOX_CHECK(
+      mapping != MAP_FAILED,
+      "Cannot map shared memory segment {}: {}",
+      name,
+      folly::errnoStr(error));
+  auto* header = reinterpret_cast<Header*>(mapping);
+  if (header->magic.load(std::memory_order_acquire) != kMagic) {
+    munmap(mapping, mappingSize);
+    return nullptr;
+  }
+  VELOX_CHECK_EQ(kHeaderSize + header->capacity, mappingSize);
+  return std::unique_ptr<ShmRingBuffer>(
+      new ShmRingBuffer(name, false, stats, mapping, mappingSize));
+}
+
+ShmRingBuffer::ShmRingBuffer(
+    std::string name,
+    bool owner,
+    const struct stat& stats,
+    void* mapping,
+    uint64_t mappingSize)
+    : name_(std::move(name)),
+      owner_(owner),
+      device_(stats.st_dev),
+      inode_(stats.st_ino),
+      mapping_(mapping),
+      mappingSize_(mappingSize),
+      header_(reinterpret_cast<Header*>(mapping)),
+      data_(reinterpret_cast<char*>(mapping) + kHeaderSize),
+      capacity_(header_->capacity) {}
+
+ShmRingBuffer::~ShmRingBuffer() {
+  if (!owner_ && !detached_) {
+    abandon();
+  }
+  detach();
+  munmap(mapping_, mappingSize_);
+}
+
+void ShmRingBuffer::detach() {
+  if (detached_.exchange(true) ||
+      header_->numAttached.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+    return;
+  }
+  // Unlinks the segment unless a new producer has replaced it.
+  const int fd = shm_open(name_.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    return;
+  }
+  struct stat stats;
+  const bool same = fstat(fd, &stats) == 0 && stats.st_dev == device_ &&
+      stats.st_ino == inode_;
+  ::close(fd);
+  if (same) {
+    shm_unlink(name_.c_str());
+  }
+}
+
+char* ShmRingBuffer::tryReserve(uint64_t size, uint64_t& newHead) {
+  VELOX_CHECK_LE(
+      size, maxMessageSize(), "Message does not fit in ring {}", name_);
+  const auto messageSize =
+      kMessageHeaderSize + bits::roundUp(size, kMessageHeaderSize);
+  auto head = header_->head.load(std::memory_order_relaxed);
+  const auto tail = header_->tail.load(std::memory_order_acquire);
+  const auto offset = head % capacity_;
+  // Bytes skipped at the end of the ring to keep the message contiguous.
+  const uint64_t padding =
+      offset + messageSize > capacity_ ? capacity_ - offset : 0;
+  if (head + padding + messageSize - tail > capacity_) {
+    return nullptr;
+  }
+  if (padding > 0) {
+    *reinterpret_cast<uint64_t*>(data_ + offset) = kWrapMarker;
+    head += padding;
+  }
+  auto* message = data_ + head % capacity_;
+  *reinterpret_cast<uint64_t*>(message) = size;
+  newHead = head + messageSize;
+  return message + kMessageHeaderSize;
+}
+
+bool ShmRingBuffer::tryWrite(const folly::IOBuf& iobuf) {
+  uint64_t newHead;
+  auto* payload = tryReserve(iobuf.computeChainDataLength(), newHead);
+  if (payload == nullptr) {
+    return false;
+  }
+  for (const auto& range : iobuf) {
+    ::memcpy(payload, range.data(), range.size());
+    payload += range.size();
+  }
+  header_->head.store(newHead, std::memory_order_release);
+  return true;
+}
+
+bool ShmRingBuffer::tryWrite(const void* data, uint64_t size) {
+  uint64_t newHead;
+  auto* payload = tryReserve(size, newHead);
+  if (payload == nullptr) {
+    return false;
+  }
+  ::memcpy(payload, data, size);
+  header_->head.store(newHead, std::memory_order_release);
+  return true;
+}
+
+void ShmRingBuffer::close() {
+  header_->closed.store(true, std::memory_order_release);
+}
+
+void ShmRingBuffer::fail() {
+  header_->failed.store(true, std::memory_order_release);
+  close();
+}
+
+std::optional<ShmRingBuffer::Message> ShmRingBuffer::tryRead() {
+  const auto head = header_->head.load(std::memory_order_acquire);
+  if (readPosition_ == head) {
+    return std::nullopt;
+  }
+  const auto begin = readPosition_;
+  auto position = begin;
+  auto size = sizeAt(position);
+  if (size == kWrapMarker) {
+    position += capacity_ - position % capacity_;
+    size = sizeAt(position);
+  }
+  const auto* data = data_ + position % capacity_ + kMessageHeaderSize;
+  readPosition_ =
+      position + kMessageHeaderSize + bits::roundUp(size, kMessageHeaderSize);
+  return Message{data, size, begin, readPosition_};
+}
+
+std::vector<int64_t> ShmRingBuffer::peekSizes(int32_t maxMessages) const {
+  std::vector<int64_t> sizes;
+  const auto head = header_->head.load(std::memory_order_acquire);
+  auto position = readPosition_;
+  while (position < head && sizes.size() < maxMessages) {
+    auto size = sizeAt(position);
+    if (size == kWrapMarker) {
+      position += capacity_ - position % capacity_;
+      continue;
+    }
+    sizes.push_back(size);
+    position += kMessageHeaderSize + bits::roundUp(size, kMessageHeaderSize);
+  }
+  return sizes;
+}
+
+bool ShmRingBuffer::atEnd() const {
+  // 'head' is final once 'closed' is seen.
+  return header_->closed.load(std::memory_order_acquire) &&
+      readPosition_ == header_->head.load(std::memory_order_acquire);
+}
+
+void ShmRingBuffer::release(uint64_t begin, uint64_t end) {
+  std::lock_guard<std::mutex> l(releaseMutex_);
+  auto tail = header_->tail.load(std::memory_order_relaxed);
+  if (begin != tail) {
+    released_[begin] = end;
+    return;
+  }
+  tail = end;
+  for (auto it = released_.find(tail); it != released_.end();
+       it = released_.find(tail)) {
+    tail = it->second;
+    released_.erase(it);
+  }
+  header_->tail.store(tail, std::memory_order_release);
+}
+
+void ShmRingBuffer::abandon() {
+  header_->abandoned.store(true, std::memory_order_release);
+  acknowledge();
+}
+
+void ShmRingBuffer::acknowledge() {
+  VELOX_CHECK(!owner_);
+  header_->acknowledged.store(true, std::memory_order_release);
+  detach();
+}
+} // namespace facebook::velox::runner
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <sys/stat.h>
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <optional>
+
+#include <folly/io/IOBuf.h>
+
+namespace facebook::velox::runner {
+
+/// Single producer, single consumer queue of variable size messages in a
+/// POSIX shared memory segment. The producer and the consumer may be in
+/// different processes on the same host.
+///
+/// A message is stored contiguously so that the consumer can use it in place.
+/// The consumer reads messages in order and releases their space when done
+/// with them. Messages may be released in any order, the space becomes
+/// available to the producer in message order.
+///
+/// The segment is created by the producer. The producer and the consumer each
+/// detach from it when done, the last one unlinks it. A producer that goes
+/// away first leaves the segment for a consumer that has not opened it yet,
+/// so that the consumer still sees the end or the failure. Mappings stay
+/// valid after the segment is unlinked.
+class ShmRingBuffer {
+ public:
+  /// Returns the shared memory segment name for 'destination' of 'taskId'.
+  static std::string segmentName(const std::string& taskId, int destination);
+
+  /// Creates segment 'name' with room for 'capacity' bytes of messages
+  /// including an 8 byte header per message. An existing segment of the same
+  /// name is left over by a producer that did not detach, e.g. after a crash,
+  /// and is replaced.
+  static std::unique_ptr<ShmRingBuffer> create(
+      const std::string& name,
+      uint64_t capacity);
+
+  /// Opens segment 'name' created by create(). Returns nullptr if the segment
+  /// does not exist or is not initialized yet.
+  static std::unique_ptr<ShmRingBuffer> open(const std::string& name);
+
+  /// Detaches from the segment. A consumer abandons the ring first unless it
+  /// has acknowledged it.
+  ~ShmRingBuffer();
+
+  const std::string& name() const {
+    return name_;
+  }
+
+  uint64_t capacity() const {
+    return capacity_;
+  }
+
+  /// Largest message that can be written.
+  uint64_t maxMessageSize() const {
+    return capacity_ / 2 - kMessageHeaderSize;
+  }
+
+  /// Producer side. Appends the bytes of 'iobuf' as one message. Returns false
+  /// if there is not enough free space.
+  bool tryWrite(const folly::IOBuf& iobuf);
+
+  /// Producer side. Same as above for 'size' bytes at 'data'.
+  bool tryWrite(const void* data, uint64_t size);
+
+  /// Producer side. Marks the end of the messages.
+  void close();
+
+  /// Producer side. Marks the end of the messages after an error. The
+  /// consumer fails instead of reading the remaining messages.
+  void fail();
+
+  /// Consumer side. Returns true if the producer has failed.
+  bool failed() const {
+    return header_->failed.load(std::memory_order_acquire);
+  }
+
+  /// Producer side. Returns true if the consumer has abandoned the messages.
+  /// The producer stops writing then.
+  bool abandoned() const {
+    return header_->abandoned.load(std::memory_order_acquire);
+  }
+
+  struct Message {
+    const char* data;
+    uint64_t size;
+    // Ring positions to pass to release().
+    uint64_t begin;
+    uint64_t end;
+  };
+
+  /// Consumer side. Returns the next message or std::nullopt if there is
+  /// none. The message stays valid until released.
+  std::optional<Message> tryRead();
+
+  /// Consumer side. Returns the sizes of up to 'maxMessages' messages that
+  /// tryRead() would return next.
+  std::vector<int64_t> peekSizes(int32_t maxMessages) const;
+
+  /// Consumer side. Returns true if the producer has closed the ring and all
+  /// messages have been read.
+  bool atEnd() const;
+
+  /// Consumer side. Releases the space of a message returned by tryRead().
+  /// Thread safe.
+  void release(uint64_t begin, uint64_t end);
+
+  /// Consumer side. Tells the producer that no more messages will be read.
+  /// Acknowledges the ring.
+  void abandon();
+
+  /// Consumer side. Tells the producer that the consumer has read to the end,
+  /// seen the failure or abandoned the ring, and detaches from the segment.
+  /// Messages that are not released stay valid.
+  void acknowledge();
+
+  /// Producer side. Returns true if the consumer has acknowledged the ring.
+  bool acknowledged() const {
+    return header_->acknowledged.load(std::memory_order_acquire);
+  }
+
+ private:
+  static constexpr uint64_t kMagic = 0x5645'4c4f'5853'484dULL;
+  static constexpr uint64_t kMessageHeaderSize = sizeof(uint64_t);
+  // Message size value that tells to continue at the start of the ring.
+  static constexpr uint64_t kWrapMarker = ~0ULL;
+
+  struct Header {
+    // Set to kMagic once the header is initialized.
+    std::atomic<uint64_t> magic;
+    uint64_t capacity;
+    std::atomic_bool closed;
+    std::atomic_bool abandoned;
+    std::atomic_bool failed;
+    // Set by the consumer in acknowledge().
+    std::atomic_bool acknowledged;
+    // Number of the producer and the consumer that have not detached.
+    std::atomic<uint32_t> numAttached;
+    // End of the published messages. Written by the producer.
+    alignas(64) std::atomic<uint64_t> head;
+    // Start of the unreleased messages. Written by the consumer.
+    alignas(64) std::atomic<uint64_t> tail;
+  };
+  static constexpr uint64_t kHeaderSize = 192;
+  static_assert(sizeof(Header) <= kHeaderSize);
+
+  ShmRingBuffer(
+      std::string name,
+      bool owner,
+      const struct stat& stats,
+      void* mapping,
+      uint64_t mappingSize);
+
+  // Drops the reference of this side to the segment. The last side to detach
+  // unlinks the segment.
+  void detach();
+
+  // Reserves space for a message of 'size' bytes at the head and writes its
+  // header. Returns the address for the payload and sets 'newHead' to the
+  // head to publish after the payload is written. Returns nullptr if there is
+  // not enough free space.
+  char* tryReserve(uint64_t size, uint64_t& newHead);
+
+  uint64_t sizeAt(uint64_t position) const {
+    return *reinterpret_cast<const uint64_t*>(data_ + position % capacity_);
+  }
+
+  const std::string name_;
+  // True for the producer.
+  const bool owner_;
+  // Identify the segment. A segment of the same name may replace it after it
+  // is left over, see create().
+  const dev_t device_;
+  const ino_t inode_;
+  void* const mapping_;
+  const uint64_t mappingSize_;
+  Header* const header_;
+  char* const data_;
+  const uint64_t capacity_;
+
+  // Position of the next message to read. Consumer side.
+  uint64_t readPosition_{0};
+
+  std::atomic_bool detached_{false};
+
+  // Released messages that are not at the tail, by begin position.
+  std::mutex releaseMutex_;
+  std::map<uint64_t, uint64_t> released_;
+};
+} // namespace facebook::velox::runner
@@ -0,0 +1,410 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/runner/ShmExchange.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <future>
+
+#include <gtest/gtest.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/exec/Exchange.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/QueryAssertions.h"
+
+namespace facebook::velox::runner {
+namespace {
+
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+// Returns a segment name that does not collide with concurrent test runs.
+std::string testSegmentName(const std::string& suffix) {
+  return fmt::format("/velox-test-{}-{}", getpid(), suffix);
+}
+
+std::string toString(const ShmRingBuffer::Message& message) {
+  return std::string(message.data, message.size);
+}
+
+TEST(ShmRingBufferTest, basic) {
+  const auto name = testSegmentName("basic");
+  EXPECT_EQ(ShmRingBuffer::open(name), nullptr);
+  auto producer = ShmRingBuffer::create(name, 1024);
+  auto consumer = ShmRingBuffer::open(name);
+  ASSERT_NE(consumer, nullptr);
+  EXPECT_EQ(consumer->capacity(), 1024);
+
+  EXPECT_FALSE(consumer->tryRead().has_value());
+  EXPECT_FALSE(consumer->atEnd());
+
+  ASSERT_TRUE(producer->tryWrite("abc", 3));
+  auto iobuf = folly::IOBuf::copyBuffer("defg");
+  iobuf->appendToChain(folly::IOBuf::copyBuffer("hi"));
+  ASSERT_TRUE(producer->tryWrite(*iobuf));
+  EXPECT_EQ(consumer->peekSizes(10), (std::vector<int64_t>{3, 6}));
+  EXPECT_EQ(consumer->peekSizes(1), (std::vector<int64_t>{3}));
+
+  auto first = consumer->tryRead();
+  ASSERT_TRUE(first.has_value());
+  EXPECT_EQ(toString(*first), "abc");
+  auto second = consumer->tryRead();
+  ASSERT_TRUE(second.has_value());
+  EXPECT_EQ(toString(*second), "defghi");
+  EXPECT_FALSE(consumer->tryRead().has_value());
+  EXPECT_TRUE(consumer->peekSizes(10).empty());
+
+  producer->close();
+  EXPECT_TRUE(consumer->atEnd());
+  EXPECT_FALSE(consumer->failed());
+  consumer->release(first->begin, first->end);
+  consumer->release(second->begin, second->end);
+
+  EXPECT_FALSE(producer->abandoned());
+  EXPECT_FALSE(producer->acknowledged());
+  consumer->abandon();
+  EXPECT_TRUE(producer->abandoned());
+  EXPECT_TRUE(producer->acknowledged());
+
+  // The producer detaches last and removes the segment. The consumer mapping
+  // stays valid.
+  producer.reset();
+  EXPECT_EQ(ShmRingBuffer::open(name), nullptr);
+  EXPECT_EQ(toString(*second), "defghi");
+}
+
+TEST(ShmRingBufferTest, producerFirst) {
+  const auto name = testSegmentName("producerFirst");
+  auto producer = ShmRingBuffer::create(name, 1024);
+  ASSERT_TRUE(producer->tryWrite("abc", 3));
+  producer->close();
+
+  // The segment stays for the consumer, which removes it when done.
+  producer.reset();
+  auto consumer = ShmRingBuffer::open(name);
+  ASSERT_NE(consumer, nullptr);
+  auto message = consumer->tryRead();
+  ASSERT_TRUE(message.has_value());
+  EXPECT_EQ(toString(*message), "abc");
+  EXPECT_TRUE(consumer->atEnd());
+  consumer->acknowledge();
+  EXPECT_EQ(ShmRingBuffer::open(name), nullptr);
+  EXPECT_EQ(toString(*message), "abc");
+}
+
+TEST(ShmRingBufferTest, leftOver) {
+  const auto name = testSegmentName("leftOver");
+  // A producer that crashed before sizing the segment.
+  const int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  ASSERT_GE(fd, 0);
+  ::close(fd);
+  EXPECT_EQ(ShmRingBuffer::open(name), nullptr);
+
+  // A producer that crashed with the consumer still attached.
+  auto stale = ShmRingBuffer::create(name, 1024);
+  auto staleConsumer = ShmRingBuffer::open(name);
+  ASSERT_TRUE(stale->tryWrite("abc", 3));
+
+  auto producer = ShmRingBuffer::create(name, 1024);
+  auto consumer = ShmRingBuffer::open(name);
+  ASSERT_NE(consumer, nullptr);
+  EXPECT_FALSE(consumer->tryRead().has_value());
+
+  // The stale segment does not remove the new one of the same name.
+  stale.reset();
+  staleConsumer.reset();
+  ASSERT_TRUE(producer->tryWrite("defg", 4));
+  EXPECT_EQ(toString(consumer->tryRead().value()), "defg");
+  auto other = ShmRingBuffer::open(name);
+  ASSERT_NE(other, nullptr);
+  EXPECT_EQ(other->capacity(), 1024);
+}
+
+TEST(ShmRingBufferTest, fullAndWrapAround) {
+  auto producer = ShmRingBuffer::create(testSegmentName("wrap"), 256);
+  auto consumer = ShmRingBuffer::open(producer->name());
+  ASSERT_NE(consumer, nullptr);
+  EXPECT_EQ(producer->maxMessageSize(), 120);
+  VELOX_ASSERT_THROW(
+      producer->tryWrite(std::string(121, 'x').data(), 121),
+      "Message does not fit in ring");
+
+  // Messages take 8 + 88 = 96 bytes.
+  std::string data(88, 'a');
+  ASSERT_TRUE(producer->tryWrite(data.data(), data.size()));
+  data[0] = 'b';
+  ASSERT_TRUE(producer->tryWrite(data.data(), data.size()));
+  // The 64 bytes at the end of the ring are too few for the next message. It
+  // goes to the start of the ring once that is released.
+  data[0] = 'c';
+  ASSERT_FALSE(producer->tryWrite(data.data(), data.size()));
+  const auto first = consumer->tryRead().value();
+  const auto second = consumer->tryRead().value();
+  EXPECT_EQ(second.data[0], 'b');
+  ASSERT_FALSE(producer->tryWrite(data.data(), data.size()));
+  consumer->release(first.begin, first.end);
+  ASSERT_TRUE(producer->tryWrite(data.data(), data.size()));
+  EXPECT_EQ(consumer->peekSizes(10), (std::vector<int64_t>{88}));
+
+  const auto third = consumer->tryRead().value();
+  EXPECT_EQ(third.data[0], 'c');
+  EXPECT_EQ(third.size, 88);
+  EXPECT_EQ(third.data, first.data);
+  // The skipped end of the ring is freed with the message after it.
+  ASSERT_FALSE(producer->tryWrite("x", 1));
+  consumer->release(second.begin, second.end);
+  ASSERT_TRUE(producer->tryWrite("x", 1));
+  ASSERT_FALSE(producer->tryWrite(data.data(), data.size()));
+  consumer->release(third.begin, third.end);
+  ASSERT_TRUE(producer->tryWrite(data.data(), data.size()));
+}
+
+TEST(ShmRingBufferTest, outOfOrderRelease) {
+  auto producer = ShmRingBuffer::create(testSegmentName("release"), 256);
+  auto consumer = ShmRingBuffer::open(producer->name());
+  std::string data(56, 'a');
+  std::vector<ShmRingBuffer::Message> messages;
+  for (auto i = 0; i < 4; ++i) {
+    ASSERT_TRUE(producer->tryWrite(data.data(), data.size()));
+    messages.push_back(consumer->tryRead().value());
+  }
+
+  // Space is freed in message order.
+  consumer->release(messages[2].begin, messages[2].end);
+  consumer->release(messages[1].begin, messages[1].end);
+  ASSERT_FALSE(producer->tryWrite(data.data(), data.size()));
+  consumer->release(messages[0].begin, messages[0].end);
+  for (auto i = 0; i < 3; ++i) {
+    ASSERT_TRUE(producer->tryWrite(data.data(), data.size()));
+  }
+  ASSERT_FALSE(producer->tryWrite(data.data(), data.size()));
+  consumer->release(messages[3].begin, messages[3].end);
+  ASSERT_TRUE(producer->tryWrite(data.data(), data.size()));
+}
+
+TEST(ShmRingBufferTest, crossProcess) {
+  constexpr int32_t kNumMessages = 10'000;
+  auto producer = ShmRingBuffer::create(testSegmentName("fork"), 4096);
+
+  const auto pid = fork();
+  ASSERT_GE(pid, 0);
+  if (pid == 0) {
+    // The consumer checks that the messages arrive in order and intact.
+    auto consumer = ShmRingBuffer::open(producer->name());
+    int32_t expected = 0;
+    while (!consumer->atEnd()) {
+      auto message = consumer->tryRead();
+      if (!message.has_value()) {
+        continue;
+      }
+      const auto numValues = message->size / sizeof(int32_t);
+      const auto* values = reinterpret_cast<const int32_t*>(message->data);
+      if (numValues != static_cast<size_t>(expected % 100 + 1)) {
+        _exit(1);
+      }
+      for (auto i = 0; i < numValues; ++i) {
+        if (values[i] != expected) {
+          _exit(1);
+        }
+      }
+      consumer->release(message->begin, message->end);
+      ++expected;
+    }
+    consumer.reset();
+    _exit(expected == kNumMessages ? 0 : 1);
+  }
+
+  std::vector<int32_t> values;
+  for (auto i = 0; i < kNumMessages; ++i) {
+    values.assign(i % 100 + 1, i);
+    while (!producer->tryWrite(
+        values.data(), values.size() * sizeof(int32_t))) {
+      std::this_thread::yield();
+    }
+  }
+  producer->close();
+  int status;
+  ASSERT_EQ(waitpid(pid, &status, 0), pid);
+  ASSERT_TRUE(WIFEXITED(status));
+  EXPECT_EQ(WEXITSTATUS(status), 0);
+}
+
+class ShmExchangeTest : public OperatorTestBase {
+ protected:
+  void SetUp() override {
+    OperatorTestBase::SetUp();
+    exec::ExchangeSource::factories().clear();
+    registerShmExchangeSource();
+  }
+
+  std::string makeTaskId(const std::string& name) {
+    return fmt::format("shm://{}-{}", name, getpid());
+  }
+
+  std::shared_ptr<Task> makeTask(
+      const std::string& taskId,
+      const core::PlanNodePtr& plan) {
+    return Task::create(
+        taskId,
+        core::PlanFragment{plan},
+        0,
+        core::QueryCtx::create(driverExecutor_.get()),
+        Task::ExecutionMode::kParallel);
+  }
+
+  std::vector<RowVectorPtr> makeData(int32_t numVectors) {
+    std::vector<RowVectorPtr> data;
+    for (auto i = 0; i < numVectors; ++i) {
+      data.push_back(makeRowVector({
+          makeFlatVector<int64_t>(1'000, [&](auto row) { return i + row; }),
+          makeFlatVector<StringView>(
+              1'000,
+              [&](auto row) {
+                return StringView::makeInline(std::to_string(row % 97));
+              }),
+      }));
+    }
+    return data;
+  }
+};
+
+TEST_F(ShmExchangeTest, partitionedOutput) {
+  constexpr int32_t kNumDestinations = 3;
+  const auto data = makeData(50);
+  const auto taskId = makeTaskId("partitioned");
+  auto producer = makeTask(
+      taskId,
+      PlanBuilder()
+          .values(data)
+          .partitionedOutput({"c0"}, kNumDestinations)
+          .planNode());
+  ShmOutputBufferPublisher publisher(taskId, kNumDestinations, 4 << 20);
+  producer->start(1);
+
+  std::vector<RowVectorPtr> results;
+  const auto exchangePlan =
+      PlanBuilder()
+          .exchange(asRowType(data[0]->type()), VectorSerde::Kind::kPresto)
+          .planNode();
+  for (auto i = 0; i < kNumDestinations; ++i) {
+    results.push_back(
+        AssertQueryBuilder(exchangePlan)
+            .destination(i)
+            .split(Split(std::make_shared<RemoteConnectorSplit>(taskId)))
+            .copyResults(pool()));
+    EXPECT_GT(results.back()->size(), 0);
+  }
+  assertEqualResults(data, results);
+  ASSERT_TRUE(waitForTaskCompletion(producer.get()));
+  EXPECT_TRUE(publisher.isFinished());
+}
+
+TEST_F(ShmExchangeTest, consumerFirst) {
+  const auto data = makeData(5);
+  const auto taskId = makeTaskId("consumerFirst");
+  const auto exchangePlan =
+      PlanBuilder()
+          .exchange(asRowType(data[0]->type()), VectorSerde::Kind::kPresto)
+          .planNode();
+
+  // The consumer waits for the producer to create the ring and the task.
+  auto result = std::async(std::launch::async, [&]() {
+    return AssertQueryBuilder(exchangePlan)
+        .split(Split(std::make_shared<RemoteConnectorSplit>(taskId)))
+        .copyResults(pool());
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  ShmOutputBufferPublisher publisher(taskId, 1, 1 << 20);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  auto producer = makeTask(
+      taskId, PlanBuilder().values(data).partitionedOutput({}, 1).planNode());
+  producer->start(1);
+
+  assertEqualResults(data, {result.get()});
+  ASSERT_TRUE(waitForTaskCompletion(producer.get()));
+}
+
+TEST_F(ShmExchangeTest, pageTooLarge) {
+  const auto data = makeData(5);
+  const auto taskId = makeTaskId("pageTooLarge");
+  ShmOutputBufferPublisher publisher(taskId, 1, 256);
+  auto producer = makeTask(
+      taskId, PlanBuilder().values(data).partitionedOutput({}, 1).planNode());
+  producer->start(1);
+
+  const auto exchangePlan =
+      PlanBuilder()
+          .exchange(asRowType(data[0]->type()), VectorSerde::Kind::kPresto)
+          .planNode();
+  VELOX_ASSERT_THROW(
+      AssertQueryBuilder(exchangePlan)
+          .split(Split(std::make_shared<RemoteConnectorSplit>(taskId)))
+          .copyResults(pool()),
+      "failed");
+  ASSERT_TRUE(waitForTaskCompletion(producer.get()));
+  EXPECT_TRUE(publisher.isFinished());
+}
+
+TEST_F(ShmExchangeTest, finishedAfterConsumer) {
+  const auto data = makeData(5);
+  const auto taskId = makeTaskId("finishedAfterConsumer");
+  ShmOutputBufferPublisher publisher(taskId, 1, 4 << 20);
+  auto producer = makeTask(
+      taskId, PlanBuilder().values(data).partitionedOutput({}, 1).planNode());
+  producer->start(1);
+  ASSERT_TRUE(waitForTaskCompletion(producer.get()));
+  // All pages are in the ring but the consumer has not read them.
+  EXPECT_FALSE(publisher.isFinished());
+
+  const auto exchangePlan =
+      PlanBuilder()
+          .exchange(asRowType(data[0]->type()), VectorSerde::Kind::kPresto)
+          .planNode();
+  auto result =
+      AssertQueryBuilder(exchangePlan)
+          .split(Split(std::make_shared<RemoteConnectorSplit>(taskId)))
+          .copyResults(pool());
+  assertEqualResults(data, {result});
+  EXPECT_TRUE(publisher.isFinished());
+}
+
+TEST_F(ShmExchangeTest, publisherGone) {
+  const auto data = makeData(1);
+  const auto taskId = makeTaskId("publisherGone");
+  std::make_unique<ShmOutputBufferPublisher>(taskId, 1, 1 << 20).reset();
+
+  // The consumer that comes after the publisher sees the failure.
+  const auto exchangePlan =
+      PlanBuilder()
+          .exchange(asRowType(data[0]->type()), VectorSerde::Kind::kPresto)
+          .planNode();
+  VELOX_ASSERT_THROW(
+      AssertQueryBuilder(exchangePlan)
+          .split(Split(std::make_shared<RemoteConnectorSplit>(taskId)))
+          .copyResults(pool()),
+      "failed");
+  EXPECT_EQ(
+      ShmRingBuffer::open(ShmRingBuffer::segmentName(taskId, 0)), nullptr);
+}
+} // namespace
+} // namespace facebook::velox::runner
@@ -0,0 +1,523 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/serializers/ArrowIpcSerializer.h"
+
+#include <arrow/buffer.h>
+#include <arrow/c/bridge.h>
+#include <arrow/io/memory.h>
+#include <arrow/ipc/reader.h>
+#include <arrow/ipc/writer.h>
+#include <arrow/record_batch.h>
+#include <arrow/util/compression.h>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/vector/arrow/Bridge.h"
+
+namespace facebook::velox::serializer {
+namespace {
+
+// Arrow IPC streams need 8 byte aligned buffers to be read without copying.
+constexpr int32_t kIpcAlignment = 8;
+
+void checkArrowStatus(const ::arrow::Status& status) {
+  VELOX_CHECK(status.ok(), "Arrow IPC error: {}", status.ToString());
+}
+
+template <typename T>
+T valueOrThrow(::arrow::Result<T> result) {
+  checkArrowStatus(result.status());
+  return std::move(result).ValueUnsafe();
+}
+
+// Constant vectors have no IPC representation and are flattened. Dictionary
+// encoded vectors are kept and become IPC dictionary batches. Timestamps are
+// written in milliseconds, the precision of the Presto serde. Nanoseconds
+// would only cover the years 1677 to 2262.
+ArrowOptions arrowOptions() {
+  ArrowOptions options;
+  options.flattenDictionary = false;
+  options.flattenConstant = true;
+  options.timestampUnit = TimestampUnit::kMilli;
+  return options;
+}
+
+::arrow::Compression::type toArrowCompression(
+    common::CompressionKind compressionKind) {
+  switch (compressionKind) {
+    case common::CompressionKind::CompressionKind_NONE:
+      return ::arrow::Compression::UNCOMPRESSED;
+    case common::CompressionKind::CompressionKind_LZ4:
+      return ::arrow::Compression::LZ4_FRAME;
+    case common::CompressionKind::CompressionKind_ZSTD:
+      return ::arrow::Compression::ZSTD;
+    default:
+      VELOX_USER_FAIL(
+          "Arrow IPC supports only LZ4 and ZSTD compression, got: {}",
+          common::compressionKindToString(compressionKind));
+  }
+}
+
+::arrow::ipc::IpcWriteOptions toIpcWriteOptions(
+    const VectorSerde::Options* options) {
+  auto writeOptions = ::arrow::ipc::IpcWriteOptions::Defaults();
+  if (options == nullptr) {
+    return writeOptions;
+  }
+  const auto compression = toArrowCompression(options->compressionKind);
+  if (compression != ::arrow::Compression::UNCOMPRESSED) {
+    writeOptions.codec =
+        valueOrThrow(::arrow::util::Codec::Create(compression));
+    // Buffers that do not shrink by at least this much are written
+    // uncompressed.
+    writeOptions.min_space_savings = 1.0 - options->minCompressionRatio;
+  }
+  return writeOptions;
+}
+
+// Writes 'vector' as a self-contained Arrow IPC stream and returns the
+// stream bytes.
+std::shared_ptr<::arrow::Buffer> toArrowIpc(
+    const RowVectorPtr& vector,
+    const ::arrow::ipc::IpcWriteOptions& writeOptions,
+    memory::MemoryPool* pool) {
+  ArrowSchema arrowSchema;
+  ArrowArray arrowArray;
+  const auto options = arrowOptions();
+  exportToArrow(vector, arrowSchema, options);
+  exportToArrow(vector, arrowArray, pool, options);
+  const auto batch =
+      valueOrThrow(::arrow::ImportRecordBatch(&arrowArray, &arrowSchema));
+
+  auto sink = valueOrThrow(::arrow::io::BufferOutputStream::Create());
+  auto writer = valueOrThrow(
+      ::arrow::ipc::MakeStreamWriter(sink, batch->schema(), writeOptions));
+  checkArrowStatus(writer->WriteRecordBatch(*batch));
+  checkArrowStatus(writer->Close());
+  return valueOrThrow(sink->Finish());
+}
+
+// The length prefix is 8 bytes so that the IPC stream stays 8 byte aligned
+// relative to the start of the page.
+void writePage(const ::arrow::Buffer& ipcStream, OutputStream* stream) {
+  const int64_t size = ipcStream.size();
+  stream->write(reinterpret_cast<const char*>(&size), sizeof(size));
+  stream->write(reinterpret_cast<const char*>(ipcStream.data()), size);
+}
+
+// Arrow buffer over memory kept alive by 'owner'.
+class OwnedArrowBuffer : public ::arrow::Buffer {
+ public:
+  OwnedArrowBuffer(
+      const uint8_t* data,
+      int64_t size,
+      std::shared_ptr<void> owner)
+      : ::arrow::Buffer(data, size), owner_(std::move(owner)) {}
+
+ private:
+  const std::shared_ptr<void> owner_;
+};
+
+// Returns the next 'size' bytes of 'source' as an Arrow buffer. The bytes are
+// wrapped in place if 'source' owns contiguous, aligned memory and copied into
+// a buffer from 'pool' otherwise.
+std::shared_ptr<::arrow::Buffer> readIpcStream(
+    ByteInputStream* source,
+    int64_t size,
+    memory::MemoryPool* pool) {
+  const auto& memoryOwner = source->memoryOwner();
+  if (memoryOwner != nullptr) {
+    const auto position = source->tellp();
+    const auto view = source->nextView(size);
+    if (view.size() == size &&
+        reinterpret_cast<uintptr_t>(view.data()) % kIpcAlignment == 0) {
+      return std::make_shared<OwnedArrowBuffer>(
+          reinterpret_cast<const uint8_t*>(view.data()), size, memoryOwner);
+    }
+    source->seekp(position);
+  }
+  auto buffer = AlignedBuffer::allocate<uint8_t>(size, pool);
+  source->readBytes(buffer->asMutable<uint8_t>(), size);
+  const auto* data = buffer->as<uint8_t>();
+  return std::make_shared<OwnedArrowBuffer>(
+      data, size, std::shared_ptr<void>(buffer.get(), [buffer](void*) {}));
+}
+
+// Arrow has no representation of custom types such as JSON, which are
+// imported as their physical type. Returns true if 'imported' is equivalent to
+// 'expected' in every node, or is the physical type where 'expected' has a
+// custom scalar type.
+bool isImportOf(const Type& imported, const Type& expected) {
+  if (imported.kind() != expected.kind() ||
+      imported.size() != expected.size()) {
+    return false;
+  }
+  if (imported.size() == 0) {
+    return imported.equivalent(expected) ||
+        imported.equivalent(*createScalarType(imported.kind()));
+  }
+  for (uint32_t i = 0; i < imported.size(); ++i) {
+    if (!isImportOf(*imported.childAt(i), *expected.childAt(i))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Gives 'vector' and the vectors it wraps or contains the logical types of
+// 'type', which 'vector' was imported as per isImportOf().
+void setLogicalType(BaseVector& vector, const TypePtr& type) {
+  switch (vector.encoding()) {
+    case VectorEncoding::Simple::DICTIONARY:
+      setLogicalType(*vector.valueVector(), type);
+      break;
+    case VectorEncoding::Simple::ROW: {
+      const auto& children = vector.asUnchecked<RowVector>()->children();
+      for (auto i = 0; i < children.size(); ++i) {
+        setLogicalType(*children[i], type->childAt(i));
+      }
+      break;
+    }
+    case VectorEncoding::Simple::ARRAY:
+      setLogicalType(
+          *vector.asUnchecked<ArrayVector>()->elements(), type->childAt(0));
+      break;
+    case VectorEncoding::Simple::MAP: {
+      auto* map = vector.asUnchecked<MapVector>();
+      setLogicalType(*map->mapKeys(), type->childAt(0));
+      setLogicalType(*map->mapValues(), type->childAt(1));
+      break;
+    }
+    default:
+      break;
+  }
+  vector.setType(type);
+}
+
+// Appends the rows of 'source' to the dictionary encoded 'target' from row
+// 'offset' on. The values 'source' refers to are added to the dictionary, so
+// that the existing rows keep their indices and 'target' stays dictionary
+// encoded. Only the dictionary values are copied.
+void appendToDictionary(
+    VectorPtr& target,
+    vector_size_t offset,
+    const VectorPtr& source,
+    memory::MemoryPool* pool) {
+  const auto& dictionary = target->valueVector();
+  const auto numDictionaryValues = dictionary->size();
+  const auto numRows = source->size();
+  const bool sourceIsDictionary =
+      source->encoding() == VectorEncoding::Simple::DICTIONARY;
+  const auto& sourceValues =
+      sourceIsDictionary ? source->valueVector() : source;
+
+  auto values = BaseVector::create(
+      dictionary->type(), numDictionaryValues + sourceValues->size(), pool);
+  values->copy(dictionary.get(), 0, 0, numDictionaryValues);
+  values->copy(
+      sourceValues.get(), numDictionaryValues, 0, sourceValues->size());
+
+  auto indices = allocateIndices(offset + numRows, pool);
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  std::copy_n(target->wrapInfo()->as<vector_size_t>(), offset, rawIndices);
+  const auto* sourceIndices =
+      sourceIsDictionary ? source->wrapInfo()->as<vector_size_t>() : nullptr;
+  for (vector_size_t row = 0; row < numRows; ++row) {
+    rawIndices[offset + row] =
+        numDictionaryValues + (sourceIndices ? sourceIndices[row] : row);
+  }
+
+  // Nulls of the source values are copied with the values. Only nulls set on
+  // the dictionaries themselves are kept here.
+  const auto* sourceNulls = sourceIsDictionary ? source->rawNulls() : nullptr;
+  BufferPtr nulls;
+  if (target->rawNulls() != nullptr || sourceNulls != nullptr) {
+    nulls = allocateNulls(offset + numRows, pool);
+    auto* rawNulls = nulls->asMutable<uint64_t>();
+    if (target->rawNulls() != nullptr) {
+      bits::copyBits(target->rawNulls(), 0, rawNulls, 0, offset);
+    }
+    if (sourceNulls != nullptr) {
+      bits::copyBits(sourceNulls, 0, rawNulls, offset, numRows);
+    }
+  }
+  target = BaseVector::wrapInDictionary(
+      std::move(nulls), std::move(indices), offset + numRows, values);
+}
+
+class ArrowIpcIterativeSerializer : public IterativeVectorSerializer {
+ public:
+  ArrowIpcIterativeSerializer(
+      RowTypePtr type,
+      memory::MemoryPool* pool,
+      const VectorSerde::Options* options)
+      : type_(std::move(type)),
+        pool_(pool),
+        writeOptions_(toIpcWriteOptions(options)),
+        rows_(BaseVector::create<RowVector>(type_, 0, pool_)) {}
+
+  void append(
+      const RowVectorPtr& vector,
+      const folly::Range<const IndexRange*>& ranges,
+      Scratch& /*scratch*/) override {
+    std::vector<BaseVector::CopyRange> copyRanges;
+    copyRanges.reserve(ranges.size());
+    vector_size_t targetIndex = rows_->size();
+    for (const auto& range : ranges) {
+      if (range.size > 0) {
+        copyRanges.push_back({range.begin, targetIndex, range.size});
+        targetIndex += range.size;
+      }
+    }
+    appendRanges(vector, copyRanges, targetIndex);
+  }
+
+  void append(
+      const RowVectorPtr& vector,
+      const folly::Range<const vector_size_t*>& rows,
+      Scratch& /*scratch*/) override {
+    std::vector<BaseVector::CopyRange> copyRanges;
+    vector_size_t targetIndex = rows_->size();
+    for (const auto row : rows) {
+      if (!copyRanges.empty() &&
+          copyRanges.back().sourceIndex + copyRanges.back().count == row) {
+        ++copyRanges.back().count;
+      } else {
+        copyRanges.push_back({row, targetIndex, 1});
+      }
+      ++targetIndex;
+    }
+    appendRanges(vector, copyRanges, targetIndex);
+  }
+
+  bool supportsAppendRows() const override {
+    return true;
+  }
+
+  size_t maxSerializedSize() const override {
+    return sizeof(int64_t) + serialized()->size();
+  }
+
+  void flush(OutputStream* stream) override {
+    writePage(*serialized(), stream);
+  }
+
+  void clear() override {
+    rows_ = BaseVector::create<RowVector>(type_, 0, pool_);
+    serialized_.reset();
+  }
+
+ private:
+  void appendRanges(
+      const RowVectorPtr& vector,
+      const std::vector<BaseVector::CopyRange>& copyRanges,
+      vector_size_t newSize) {
+    if (copyRanges.empty()) {
+      return;
+    }
+    rows_->resize(newSize);
+    rows_->copyRanges(vector.get(), copyRanges);
+    serialized_.reset();
+  }
+
+  // Returns the IPC stream for the rows appended so far. The stream is built
+  // on first use and reused until the next append or clear.
+  const std::shared_ptr<::arrow::Buffer>& serialized() const {
+    if (serialized_ == nullptr) {
+      serialized_ = toArrowIpc(rows_, writeOptions_, pool_);
+    }
+    return serialized_;
+  }
+
+  const RowTypePtr type_;
+  memory::MemoryPool* const pool_;
+  const ::arrow::ipc::IpcWriteOptions writeOptions_;
+
+  // Rows appended since construction or the last clear.
+  RowVectorPtr rows_;
+  mutable std::shared_ptr<::arrow::Buffer> serialized_;
+};
+
+class ArrowIpcBatchSerializer : public BatchVectorSerializer {
+ public:
+  ArrowIpcBatchSerializer(
+      VectorSerde* serde,
+      memory::MemoryPool* pool,
+      const VectorSerde::Options* options)
+      : serde_(serde), pool_(pool), writeOptions_(toIpcWriteOptions(options)) {}
+
+  void serialize(
+      const RowVectorPtr& vector,
+      const folly::Range<const IndexRange*>& ranges,
+      Scratch& /*scratch*/,
+      OutputStream* stream) override {
+    writePage(
+        *toArrowIpc(selectRows(vector, ranges), writeOptions_, pool_), stream);
+  }
+
+  void estimateSerializedSize(
+      VectorPtr vector,
+      const folly::Range<const IndexRange*>& ranges,
+      vector_size_t** sizes,
+      Scratch& scratch) override {
+    serde_->estimateSerializedSize(vector.get(), ranges, sizes, scratch);
+  }
+
+ private:
+  // Returns the rows of 'vector' in 'ranges'. A single range is returned as a
+  // slice so that dictionary encoded columns stay encoded.
+  RowVectorPtr selectRows(
+      const RowVectorPtr& vector,
+      const folly::Range<const IndexRange*>& ranges) const {
+    if (ranges.size() == 1) {
+      if (ranges[0].begin == 0 && ranges[0].size == vector->size()) {
+        return vector;
+      }
+      return std::static_pointer_cast<RowVector>(
+          vector->slice(ranges[0].begin, ranges[0].size));
+    }
+    std::vector<BaseVector::CopyRange> copyRanges;
+    copyRanges.reserve(ranges.size());
+    vector_size_t targetIndex = 0;
+    for (const auto& range : ranges) {
+      copyRanges.push_back({range.begin, targetIndex, range.size});
+      targetIndex += range.size;
+    }
+    auto rows =
+        BaseVector::create<RowVector>(vector->type(), targetIndex, pool_);
+    rows->copyRanges(vector.get(), copyRanges);
+    return rows;
+  }
+
+  VectorSerde* const serde_;
+  memory::MemoryPool* const pool_;
+  const ::arrow::ipc::IpcWriteOptions writeOptions_;
+};
+} // namespace
+
+void ArrowIpcVectorSerde::estimateSerializedSize(
+    const BaseVector* vector,
+    const folly::Range<const vector_size_t*>& rows,
+    vector_size_t** sizes,
+    Scratch& scratch) {
+  prestoSerde_.estimateSerializedSize(vector, rows, sizes, scratch);
+}
+
+void ArrowIpcVectorSerde::estimateSerializedSize(
+    const BaseVector* vector,
+    const folly::Range<const IndexRange*>& ranges,
+    vector_size_t** sizes,
+    Scratch& scratch) {
+  prestoSerde_.estimateSerializedSize(vector, ranges, sizes, scratch);
+}
+
+std::unique_ptr<IterativeVectorSerializer>
+ArrowIpcVectorSerde::createIterativeSerializer(
+    RowTypePtr type,
+    int32_t /*numRows*/,
+    StreamArena* streamArena,
+    const Options* options) {
+  return std::make_unique<ArrowIpcIterativeSerializer>(
+      std::move(type), streamArena->pool(), options);
+}
+
+std::unique_ptr<BatchVectorSerializer>
+ArrowIpcVectorSerde::createBatchSerializer(
+    memory::MemoryPool* pool,
+    const Options* options) {
+  return std::make_unique<ArrowIpcBatchSerializer>(this, pool, options);
+}
+
+void ArrowIpcVectorSerde::deserialize(
+    ByteInputStream* source,
+    velox::memory::MemoryPool* pool,
+    RowTypePtr type,
+    RowVectorPtr* result,
+    vector_size_t resultOffset,
+    const Options* /*options*/) {
+  const auto size = source->read<int64_t>();
+  VELOX_CHECK_GE(size, 0, "Invalid Arrow IPC page size");
+  auto input = std::make_shared<::arrow::io::BufferReader>(
+      readIpcStream(source, size, pool));
+  auto reader =
+      valueOrThrow(::arrow::ipc::RecordBatchStreamReader::Open(input));
+  std::shared_ptr<::arrow::RecordBatch> batch;
+  checkArrowStatus(reader->ReadNext(&batch));
+  VELOX_CHECK_NOT_NULL(batch, "Arrow IPC page has no record batch");
+
+  ArrowSchema arrowSchema;
+  ArrowArray arrowArray;
+  checkArrowStatus(
+      ::arrow::ExportRecordBatch(*batch, &arrowArray, &arrowSchema));
+  const auto imported = std::dynamic_pointer_cast<RowVector>(
+      importFromArrowAsOwner(arrowSchema, arrowArray, pool));
+  VELOX_CHECK_NOT_NULL(imported);
+  VELOX_CHECK(
+      isImportOf(*imported->type(), *type),
+      "Arrow IPC page type {} does not match the expected type {}",
+      imported->type()->toString(),
+      type->toString());
+  setLogicalType(*imported, type);
+
+  const auto numRows = imported->size();
+  if (resultOffset == 0) {
+    // Take over the imported columns, which reference the IPC buffers.
+    *result = std::make_shared<RowVector>(
+        pool, type, nullptr, numRows, imported->children());
+    return;
+  }
+  VELOX_CHECK_NOT_NULL(*result);
+  VELOX_CHECK(
+      (*result)->type()->equivalent(*type),
+      "Cannot append an Arrow IPC page of type {} to a vector of type {}",
+      type->toString(),
+      (*result)->type()->toString());
+  VELOX_CHECK_EQ((*result)->size(), resultOffset);
+
+  // Columns taken over from an earlier page may be dictionary encoded. These
+  // are extended with the new values rather than flattened. The other columns
+  // are copied into in place.
+  auto& children = (*result)->children();
+  std::vector<bool> appended(children.size(), false);
+  for (auto i = 0; i < children.size(); ++i) {
+    if (children[i]->encoding() == VectorEncoding::Simple::DICTIONARY) {
+      appendToDictionary(children[i], resultOffset, imported->childAt(i), pool);
+      appended[i] = true;
+    } else {
+      // Dictionaries nested in complex types cannot be copied into.
+      BaseVector::flattenVector(children[i]);
+    }
+  }
+  (*result)->resize(resultOffset + numRows);
+  for (auto i = 0; i < children.size(); ++i) {
+    if (!appended[i]) {
+      children[i]->copy(
+          imported->childAt(i).get(), resultOffset, 0, numRows);
+    }
+  }
+}
+
+// static
+void ArrowIpcVectorSerde::registerVectorSerde() {
+  velox::registerVectorSerde(std::make_unique<ArrowIpcVectorSerde>());
+}
+
+// static
+void ArrowIpcVectorSerde::registerNamedVectorSerde() {
+  velox::registerNamedVectorSerde(
+      VectorSerde::Kind::kArrowIpc, std::make_unique<ArrowIpcVectorSerde>());
+}
+
+} // namespace facebook::velox::serializer
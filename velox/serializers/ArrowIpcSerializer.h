@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/serializers/PrestoSerializer.h"
+#include "velox/vector/ComplexVector.h"
+#include "velox/vector/VectorStream.h"
+
+namespace facebook::velox::serializer {
+
+/// Serializes RowVectors as Arrow IPC streams so that exchange pages can be
+/// produced and consumed by Arrow-native engines without a format conversion.
+///
+/// Each flushed page is an 8 byte length followed by a complete, self-contained
+/// Arrow IPC stream (schema message, dictionary batches if any, one record
+/// batch and the end-of-stream marker). The batch serializer keeps dictionary
+/// encoded columns encoded and writes them as Arrow dictionary batches. The
+/// iterative serializer gathers rows from many inputs and writes flat columns.
+/// Compression uses the IPC body compression with LZ4_FRAME or ZSTD, chosen
+/// from Options::compressionKind.
+///
+/// Deserialization reads the IPC stream in place when the input stream owns
+/// contiguous memory, so that fixed width and string buffers are wrapped
+/// rather than copied.
+class ArrowIpcVectorSerde : public VectorSerde {
+ public:
+  ArrowIpcVectorSerde() : VectorSerde(VectorSerde::Kind::kArrowIpc) {}
+
+  /// Arrow buffers have the same per-row footprint as the Presto columnar
+  /// format up to a small constant per column, so the Presto estimates are
+  /// used.
+  void estimateSerializedSize(
+      const BaseVector* vector,
+      const folly::Range<const vector_size_t*>& rows,
+      vector_size_t** sizes,
+      Scratch& scratch) override;
+
+  void estimateSerializedSize(
+      const BaseVector* vector,
+      const folly::Range<const IndexRange*>& ranges,
+      vector_size_t** sizes,
+      Scratch& scratch) override;
+
+  std::unique_ptr<IterativeVectorSerializer> createIterativeSerializer(
+      RowTypePtr type,
+      int32_t numRows,
+      StreamArena* streamArena,
+      const Options* options) override;
+
+  std::unique_ptr<BatchVectorSerializer> createBatchSerializer(
+      memory::MemoryPool* pool,
+      const Options* options) override;
+
+  bool supportsAppendInDeserialize() const override {
+    return true;
+  }
+
+  void deserialize(
+      ByteInputStream* source,
+      velox::memory::MemoryPool* pool,
+      RowTypePtr type,
+      RowVectorPtr* result,
+      const Options* options) override {
+    deserialize(source, pool, type, result, 0, options);
+  }
+
+  void deserialize(
+      ByteInputStream* source,
+      velox::memory::MemoryPool* pool,
+      RowTypePtr type,
+      RowVectorPtr* result,
+      vector_size_t resultOffset,
+      const Options* options) override;
+
+  static void registerVectorSerde();
+  static void registerNamedVectorSerde();
+
+ private:
+  presto::PrestoVectorSerde prestoSerde_;
+};
+
+} // namespace facebook::velox::serializer
@@ -32,34 +32,54 @@ class CompactRowVectorSerializer : public RowSerializer<row::CompactRow> {
       : RowSerializer<row::CompactRow>(pool, options) {}
 
  private:
+  void computeRowSizes(
+      const row::CompactRow& row,
+      const folly::Range<const IndexRange*>& ranges,
+      std::vector<vector_size_t>& rowSize) override {
+    const auto rows = flattenRanges(ranges);
+    row.rowSizes(
+        folly::Range<const vector_size_t*>(rows.data(), rows.size()),
+        rowSize.data());
+  }
+
   void serializeRanges(
       const row::CompactRow& row,
       const folly::Range<const IndexRange*>& ranges,
       char* rawBuffer,
       const std::vector<vector_size_t>& rowSize) override {
+    const auto rows = flattenRanges(ranges);
+    if (rows.size() == 1) {
+      // Fast path for single-row serialization.
+      *reinterpret_cast<TRowSize*>(rawBuffer) = folly::Endian::big(rowSize[0]);
+      row.serialize(rows[0], rawBuffer + sizeof(TRowSize));
+      return;
+    }
+
+    // Serializes all rows one column at a time.
+    raw_vector<size_t> offsets(rows.size(), pool_);
     size_t offset = 0;
-    vector_size_t index = 0;
+    for (auto i = 0; i < rows.size(); ++i) {
+      // Write raw size. Needs to be in big endian order.
+      *(TRowSize*)(rawBuffer + offset) = folly::Endian::big(rowSize[i]);
+      offsets[i] = offset + sizeof(TRowSize);
+      offset += rowSize[i] + sizeof(TRowSize);
+    }
+    row.serialize(
+        folly::Range<const vector_size_t*>(rows.data(), rows.size()),
+        offsets.data(),
+        rawBuffer);
+  }
+
+  // Returns the row numbers in 'ranges'.
+  raw_vector<vector_size_t> flattenRanges(
+      const folly::Range<const IndexRange*>& ranges) {
+    raw_vector<vector_size_t> rows(pool_);
     for (const auto& range : ranges) {
-      if (range.size == 1) {
-        // Fast path for single-row serialization.
-        *reinterpret_cast<TRowSize*>(rawBuffer + offset) =
-            folly::Endian::big(rowSize[index]);
-        auto size =
-            row.serialize(range.begin, rawBuffer + offset + sizeof(TRowSize));
-        offset += size + sizeof(TRowSize);
-        ++index;
-      } else {
-        raw_vector<size_t> offsets(range.size, pool_);
-        for (auto i = 0; i < range.size; ++i, ++index) {
-          // Write raw size. Needs to be in big endian order.
-          *(TRowSize*)(rawBuffer + offset) = folly::Endian::big(rowSize[index]);
-          offsets[i] = offset + sizeof(TRowSize);
-          offset += rowSize[index] + sizeof(TRowSize);
-        }
-        // Write row data for all rows in range.
-        row.serialize(range.begin, range.size, offsets.data(), rawBuffer);
+      for (auto i = 0; i < range.size; ++i) {
+        rows.push_back(range.begin + i);
       }
     }
+    return rows;
   }
 };
 
@@ -16,11 +16,83 @@
 
 #include "velox/serializers/PrestoBatchVectorSerializer.h"
 
+#include <folly/container/F14Map.h>
+#include <folly/container/F14Set.h>
+
 #include "velox/serializers/PrestoSerializerEstimationUtils.h"
 #include "velox/serializers/PrestoSerializerSerializationUtils.h"
 #include "velox/serializers/VectorStream.h"
 
 namespace facebook::velox::serializer::presto::detail {
+namespace {
+// Returns 'vector' dictionary encoded over its distinct values in 'ranges' if
+// it is a flat string vector without nulls that has at least
+// kMinRowsPerValue rows per distinct value. Returns nullptr otherwise. The
+// dictionary values reference the string buffers of 'vector'.
+VectorPtr encodeLowCardinalityStrings(
+    const VectorPtr& vector,
+    const folly::Range<const IndexRange*>& ranges,
+    vector_size_t numRows,
+    memory::MemoryPool* pool) {
+  constexpr vector_size_t kMinRows = 64;
+  constexpr vector_size_t kMinRowsPerValue = 4;
+  // Number of leading rows checked before building the dictionary. Gives up
+  // early on columns where most of these are distinct.
+  constexpr vector_size_t kSampleRows = 256;
+  if (numRows < kMinRows ||
+      vector->encoding() != VectorEncoding::Simple::FLAT ||
+      (vector->typeKind() != TypeKind::VARCHAR &&
+       vector->typeKind() != TypeKind::VARBINARY) ||
+      vector->mayHaveNulls()) {
+    return nullptr;
+  }
+
+  const auto* flat = vector->asUnchecked<FlatVector<StringView>>();
+  const auto* rawValues = flat->rawValues();
+  const auto numSampleRows = std::min(numRows, kSampleRows);
+  folly::F14FastSet<StringView> sample;
+  vector_size_t numSampled = 0;
+  for (const auto& range : ranges) {
+    for (auto row = range.begin;
+         row < range.begin + range.size && numSampled < numSampleRows;
+         ++row, ++numSampled) {
+      sample.insert(rawValues[row]);
+    }
+  }
+  if (sample.size() > static_cast<size_t>(numSampleRows / 2)) {
+    return nullptr;
+  }
+
+  const size_t maxDistinct = numRows / kMinRowsPerValue;
+  folly::F14FastMap<StringView, vector_size_t> distinctIndices;
+  std::vector<StringView> distinctValues;
+  auto indices = allocateIndices(vector->size(), pool);
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  for (const auto& range : ranges) {
+    for (auto row = range.begin; row < range.begin + range.size; ++row) {
+      const auto [it, inserted] =
+          distinctIndices.emplace(rawValues[row], distinctValues.size());
+      if (inserted) {
+        if (distinctValues.size() == maxDistinct) {
+          return nullptr;
+        }
+        distinctValues.push_back(rawValues[row]);
+      }
+      rawIndices[row] = it->second;
+    }
+  }
+
+  auto values = BaseVector::create<FlatVector<StringView>>(
+      vector->type(), distinctValues.size(), pool);
+  values->setStringBuffers(flat->stringBuffers());
+  for (auto i = 0; i < distinctValues.size(); ++i) {
+    values->setNoCopy(i, distinctValues[i]);
+  }
+  return BaseVector::wrapInDictionary(
+      nullptr, std::move(indices), vector->size(), std::move(values));
+}
+} // namespace
+
 void PrestoBatchVectorSerializer::serialize(
     const RowVectorPtr& vector,
     const folly::Range<const IndexRange*>& ranges,
@@ -60,21 +132,31 @@ void PrestoBatchVectorSerializer::serialize(
   std::vector<VectorStream> streams;
   streams.reserve(numChildren);
   for (int i = 0; i < numChildren; i++) {
+    auto child = vector->childAt(i);
+    if (opts_.adaptiveCompression && !opts_.preserveEncodings) {
+      // A dictionary is cheaper than a codec and makes the page smaller
+      // whether or not it is compressed afterwards.
+      if (auto encoded =
+              encodeLowCardinalityStrings(child, ranges, numRows, pool_)) {
+        child = std::move(encoded);
+      }
+    }
     streams.emplace_back(
-        rowType->childAt(i),
-        std::nullopt,
-        vector->childAt(i),
-        &arena,
-        numRows,
-        opts_);
+        rowType->childAt(i), std::nullopt, child, &arena, numRows, opts_);
 
     if (numRows > 0) {
-      serializeColumn(vector->childAt(i), ranges, &streams[i], scratch);
+      serializeColumn(child, ranges, &streams[i], scratch);
     }
   }
 
   flushStreams(
-      streams, numRows, arena, *codec_, opts_.minCompressionRatio, stream);
+      streams,
+      numRows,
+      arena,
+      *codec_,
+      opts_.minCompressionRatio,
+      stream,
+      estimator_.get());
 }
 
 void PrestoBatchVectorSerializer::estimateSerializedSizeImpl(
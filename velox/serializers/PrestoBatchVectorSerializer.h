@@ -16,6 +16,7 @@
 #pragma once
 
 #include <folly/ThreadLocal.h>
+#include "velox/serializers/PrestoCompressionEstimator.h"
 #include "velox/serializers/PrestoSerializer.h"
 #include "velox/vector/VectorStream.h"
 
@@ -27,7 +28,13 @@ class PrestoBatchVectorSerializer : public BatchVectorSerializer {
       const PrestoVectorSerde::PrestoOptions& opts)
       : pool_(pool),
         codec_(common::compressionKindToCodec(opts.compressionKind)),
-        opts_(opts) {}
+        opts_(opts) {
+    if (opts_.adaptiveCompression &&
+        codec_->type() != folly::compression::CodecType::NO_COMPRESSION) {
+      estimator_ = std::make_unique<CompressionEstimator>(
+          *codec_, opts_.minCompressionRatio);
+    }
+  }
 
   void serialize(
       const RowVectorPtr& vector,
@@ -53,6 +60,8 @@ class PrestoBatchVectorSerializer : public BatchVectorSerializer {
   memory::MemoryPool* const pool_;
   const std::unique_ptr<folly::compression::Codec> codec_;
   const PrestoVectorSerde::PrestoOptions opts_;
+  // Set if 'opts_.adaptiveCompression' is set and there is a codec.
+  std::unique_ptr<CompressionEstimator> estimator_;
   // Used to protect against concurrent calls to serailize which can lead to
   // concurrency bugs.
   std::atomic_bool inUse{false};
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/serializers/PrestoCompressionEstimator.h"
+
+#include <folly/io/Cursor.h>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::serializer::presto::detail {
+CompressionEstimator::CompressionEstimator(
+    folly::compression::Codec& codec,
+    float minCompressionRatio)
+    : codec_(codec), minCompressionRatio_(minCompressionRatio) {}
+
+bool CompressionEstimator::shouldCompress(
+    const folly::IOBuf& body,
+    const std::vector<int64_t>& columnOffsets) {
+  VELOX_CHECK(!columnOffsets.empty());
+  const auto numColumns = columnOffsets.size() - 1;
+  if (columns_.size() != numColumns) {
+    columns_.clear();
+    columns_.resize(numColumns);
+  }
+
+  const int64_t totalSize = body.computeChainDataLength();
+  // Bytes outside of the columns, e.g. the number of columns, are counted as
+  // incompressible.
+  double predictedSize =
+      totalSize - (columnOffsets.back() - columnOffsets.front());
+  std::vector<std::pair<int64_t, int64_t>> smallRanges;
+  int64_t smallSize = 0;
+  for (auto i = 0; i < numColumns; ++i) {
+    const auto size = columnOffsets[i + 1] - columnOffsets[i];
+    if (size < kMinSampleBytes) {
+      if (size > 0) {
+        smallRanges.emplace_back(columnOffsets[i], size);
+        smallSize += size;
+      }
+      continue;
+    }
+    auto& column = columns_[i];
+    maybeSample(column, body, {{columnOffsets[i], size}});
+    predictedSize += size * column.ratio;
+  }
+  // The small columns are sampled together once they add up to a sample.
+  if (smallSize >= kMinSampleBytes) {
+    maybeSample(smallColumns_, body, smallRanges);
+  } else {
+    ++smallColumns_.pagesSinceSample;
+  }
+  predictedSize += smallSize * smallColumns_.ratio;
+
+  if (predictedSize > totalSize * minCompressionRatio_) {
+    return false;
+  }
+  predictedSize_ = predictedSize;
+  return true;
+}
+
+void CompressionEstimator::recordCompressed(
+    int64_t uncompressedSize,
+    int64_t compressedSize) {
+  if (compressedSize <= uncompressedSize * minCompressionRatio_ &&
+      compressedSize <= 2 * predictedSize_) {
+    return;
+  }
+  // The samples no longer represent the data. Resample all columns on the
+  // next page.
+  for (auto& column : columns_) {
+    column.pagesSinceSample = kResamplePages;
+  }
+  smallColumns_.pagesSinceSample = kResamplePages;
+}
+
+void CompressionEstimator::maybeSample(
+    Column& column,
+    const folly::IOBuf& body,
+    const std::vector<std::pair<int64_t, int64_t>>& ranges) {
+  if (column.sampled && column.pagesSinceSample < kResamplePages) {
+    ++column.pagesSinceSample;
+    return;
+  }
+  column.ratio = sampleRatio(body, ranges);
+  column.sampled = true;
+  column.pagesSinceSample = 0;
+}
+
+float CompressionEstimator::sampleRatio(
+    const folly::IOBuf& body,
+    const std::vector<std::pair<int64_t, int64_t>>& ranges) {
+  folly::io::Cursor cursor(&body);
+  int64_t position = 0;
+  std::unique_ptr<folly::IOBuf> sample;
+  int64_t sampleSize = 0;
+  for (const auto& [begin, size] : ranges) {
+    if (sampleSize >= kSampleBytes) {
+      break;
+    }
+    cursor.skip(begin - position);
+    const auto rangeSize = std::min(size, kSampleBytes - sampleSize);
+    std::unique_ptr<folly::IOBuf> range;
+    cursor.clone(range, rangeSize);
+    position = begin + rangeSize;
+    sampleSize += rangeSize;
+    if (sample == nullptr) {
+      sample = std::move(range);
+    } else {
+      sample->appendToChain(std::move(range));
+    }
+  }
+  VELOX_CHECK_GT(sampleSize, 0);
+  const auto compressed = codec_.compress(sample.get());
+  return static_cast<float>(compressed->computeChainDataLength()) /
+      sampleSize;
+}
+} // namespace facebook::velox::serializer::presto::detail
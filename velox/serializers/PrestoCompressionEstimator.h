@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/compression/Compression.h>
+#include <folly/io/IOBuf.h>
+
+namespace facebook::velox::serializer::presto::detail {
+
+/// Decides whether compressing a page pays off from the compressibility of
+/// its columns. A PrestoPage has a single codec, so the decision is per page,
+/// but it is made from per column compression ratios: a slice of the
+/// serialized bytes of each column is compressed and the ratio is kept for
+/// the pages that follow. A page is compressed if the ratios predict at least
+/// 'minCompressionRatio' savings. Pages dominated by incompressible columns,
+/// e.g. hashes or doubles, are sent uncompressed without running the codec
+/// over them.
+///
+/// Columns with too few bytes for a sample of their own are sampled together
+/// and share one ratio, so that pages of many narrow columns are estimated
+/// too.
+///
+/// Columns are resampled every kResamplePages pages and after a page
+/// compressed worse than predicted.
+class CompressionEstimator {
+ public:
+  CompressionEstimator(
+      folly::compression::Codec& codec,
+      float minCompressionRatio);
+
+  /// Returns true if page body 'body' should be compressed. The serialized
+  /// bytes of column 'i' are at ['columnOffsets[i]', 'columnOffsets[i + 1]')
+  /// in 'body'.
+  bool shouldCompress(
+      const folly::IOBuf& body,
+      const std::vector<int64_t>& columnOffsets);
+
+  /// Records the sizes of a page that was compressed after shouldCompress()
+  /// returned true.
+  void recordCompressed(int64_t uncompressedSize, int64_t compressedSize);
+
+  /// Returns the sampled compression ratio of 'column', or 1 if not sampled.
+  float columnRatio(int32_t column) const {
+    return column < columns_.size() ? columns_[column].ratio : 1;
+  }
+
+  /// Returns the compression ratio sampled from the columns under
+  /// kMinSampleBytes, or 1 if not sampled.
+  float smallColumnsRatio() const {
+    return smallColumns_.ratio;
+  }
+
+  /// Maximum number of bytes of a column compressed per sample.
+  static constexpr int64_t kSampleBytes = 32 << 10;
+
+  /// Columns with fewer serialized bytes in a page are not sampled on their
+  /// own but together with the other such columns.
+  static constexpr int64_t kMinSampleBytes = 1 << 10;
+
+  static constexpr int32_t kResamplePages = 16;
+
+ private:
+  struct Column {
+    float ratio{1};
+    bool sampled{false};
+    int32_t pagesSinceSample{0};
+  };
+
+  // Returns the ratio of compressing up to kSampleBytes of 'body' from the
+  // ascending, non-overlapping ranges of (offset, size) in 'ranges'.
+  float sampleRatio(
+      const folly::IOBuf& body,
+      const std::vector<std::pair<int64_t, int64_t>>& ranges);
+
+  // Samples 'column' from 'ranges' if it has not been sampled recently.
+  void maybeSample(
+      Column& column,
+      const folly::IOBuf& body,
+      const std::vector<std::pair<int64_t, int64_t>>& ranges);
+
+  folly::compression::Codec& codec_;
+  const float minCompressionRatio_;
+
+  std::vector<Column> columns_;
+  // The columns under kMinSampleBytes.
+  Column smallColumns_;
+  // Predicted compressed size of the last page accepted by shouldCompress().
+  int64_t predictedSize_{0};
+};
+} // namespace facebook::velox::serializer::presto::detail
@@ -35,6 +35,10 @@ PrestoIterativeVectorSerializer::PrestoIterativeVectorSerializer(
     streams_.emplace_back(
         types[i], std::nullopt, std::nullopt, streamArena, numRows, opts);
   }
+  if (opts_.adaptiveCompression && needCompression(*codec_)) {
+    estimator_ = std::make_unique<CompressionEstimator>(
+        *codec_, opts_.minCompressionRatio);
+  }
 }
 
 void PrestoIterativeVectorSerializer::append(
@@ -90,25 +94,45 @@ void PrestoIterativeVectorSerializer::flush(OutputStream* out) {
         *codec_,
         opts_.minCompressionRatio,
         out);
+  } else if (estimator_ != nullptr) {
+    const auto sizes = flushStreams(
+        streams_,
+        numRows_,
+        *streamArena_,
+        *codec_,
+        opts_.minCompressionRatio,
+        out,
+        estimator_.get());
+    if (sizes.compressionSkipped) {
+      stats_.compressionSkippedBytes += sizes.uncompressedSize;
+      ++stats_.numCompressionSkipped;
+    } else {
+      stats_.compressionInputBytes += sizes.uncompressedSize;
+      stats_.compressedBytes += sizes.compressedSize;
+    }
+    stats_.compressionNanos += sizes.compressionNanos;
   } else {
     if (numCompressionToSkip_ > 0) {
       const auto noCompressionCodec = common::compressionKindToCodec(
           common::CompressionKind::CompressionKind_NONE);
-      auto [size, ignore] = flushStreams(
+      const auto sizes = flushStreams(
           streams_, numRows_, *streamArena_, *noCompressionCodec, 1, out);
-      stats_.compressionSkippedBytes += size;
+      stats_.compressionSkippedBytes += sizes.uncompressedSize;
       --numCompressionToSkip_;
       ++stats_.numCompressionSkipped;
     } else {
-      auto [size, compressedSize] = flushStreams(
+      const auto sizes = flushStreams(
           streams_,
           numRows_,
           *streamArena_,
           *codec_,
           opts_.minCompressionRatio,
           out);
+      const auto size = sizes.uncompressedSize;
+      const auto compressedSize = sizes.compressedSize;
       stats_.compressionInputBytes += size;
       stats_.compressedBytes += compressedSize;
+      stats_.compressionNanos += sizes.compressionNanos;
       if (compressedSize > size * opts_.minCompressionRatio) {
         numCompressionToSkip_ = std::min<int64_t>(
             kMaxCompressionAttemptsToSkip, 1 + stats_.numCompressionSkipped);
@@ -137,6 +161,11 @@ PrestoIterativeVectorSerializer::runtimeStats() {
         RuntimeCounter(
             stats_.compressionSkippedBytes, RuntimeCounter::Unit::kBytes));
   }
+  if (stats_.compressionNanos != 0) {
+    map.emplace(
+        kCompressionNanos,
+        RuntimeCounter(stats_.compressionNanos, RuntimeCounter::Unit::kNanos));
+  }
   return map;
 }
 
@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/serializers/PrestoCompressionEstimator.h"
 #include "velox/serializers/PrestoSerializer.h"
 #include "velox/serializers/VectorStream.h"
 #include "velox/vector/VectorStream.h"
@@ -58,6 +59,11 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
   int32_t numRows_{0};
   std::vector<VectorStream, memory::StlAllocator<VectorStream>> streams_;
 
+  // Decides per page whether to compress if 'opts_.adaptiveCompression' is
+  // set. Otherwise compression is skipped for a number of pages after a page
+  // did not compress well.
+  std::unique_ptr<CompressionEstimator> estimator_;
+
   // Count of forthcoming compressions to skip.
   int32_t numCompressionToSkip_{0};
   CompressionStats stats_;
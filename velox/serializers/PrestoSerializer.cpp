@@ -187,10 +187,11 @@ void PrestoVectorSerde::deserialize(
     compressBuf->append(header.compressedSize);
 
     // Process chained uncompressed results IOBufs.
-    auto uncompress =
+    std::shared_ptr<folly::IOBuf> uncompress =
         codec->uncompress(compressBuf.get(), header.uncompressedSize);
     auto uncompressedSource = std::make_unique<BufferInputStream>(
-        byteRangesFromIOBuf(uncompress.get()));
+        byteRangesFromIOBuf(uncompress.get()),
+        prestoOptions.zeroCopy ? uncompress : nullptr);
     detail::readTopColumns(
         *uncompressedSource, type, pool, *result, resultOffset, prestoOptions);
   }
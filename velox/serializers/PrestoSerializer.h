@@ -80,6 +80,23 @@ class PrestoVectorSerde : public VectorSerde {
     /// affect the encoding of the input vectors. This is only relevant when
     /// using BatchVectorSerializer.
     bool preserveEncodings{false};
+
+    /// If true, deserialization references the memory of the input stream
+    /// instead of copying it into the result where possible, i.e. for the
+    /// values of fixed-width columns without nulls and for string payloads
+    /// that are contiguous and suitably aligned in the input. This only
+    /// applies to input streams that own their memory, see
+    /// ByteInputStream::memoryOwner(), and keeps the input memory alive for
+    /// as long as the result references it.
+    bool zeroCopy{false};
+
+    /// If true and 'compressionKind' is set, the serializers sample the
+    /// compressibility of each column and skip the codec for pages that are
+    /// predicted not to compress by 'minCompressionRatio'. The batch
+    /// serializer also dictionary encodes flat string columns with few
+    /// distinct values unless 'preserveEncodings' is set. The output is a
+    /// regular PrestoPage.
+    bool adaptiveCompression{false};
   };
 
   PrestoVectorSerde() : VectorSerde(Kind::kPresto) {}
@@ -596,6 +596,70 @@ void readLosslessTimestampValues(
   }
 }
 
+// Keeps the memory of an input stream alive while a BufferView over it is
+// referenced.
+class StreamMemoryReleaser {
+ public:
+  explicit StreamMemoryReleaser(std::shared_ptr<void> memoryOwner)
+      : memoryOwner_(std::move(memoryOwner)) {}
+
+  void addRef() const {}
+
+  void release() const {}
+
+ private:
+  const std::shared_ptr<void> memoryOwner_;
+};
+
+// Returns a buffer over the next 'size' bytes of 'source' without copying
+// them and moves 'source' past these. Returns null and leaves 'source'
+// unchanged if 'source' does not own its memory, or if the bytes are not
+// contiguous or not aligned to 'alignment'.
+BufferPtr readBufferView(
+    ByteInputStream* source,
+    int32_t size,
+    int32_t alignment) {
+  const auto& memoryOwner = source->memoryOwner();
+  if (memoryOwner == nullptr || size == 0) {
+    return nullptr;
+  }
+  const auto position = source->tellp();
+  const auto view = source->nextView(size);
+  if (view.size() != size ||
+      reinterpret_cast<uintptr_t>(view.data()) % alignment != 0) {
+    source->seekp(position);
+    return nullptr;
+  }
+  return BufferView<StreamMemoryReleaser>::create(
+      reinterpret_cast<const uint8_t*>(view.data()),
+      size,
+      StreamMemoryReleaser(memoryOwner));
+}
+
+// Returns the values of 'flatResult' for writing. Values before
+// 'resultOffset' are kept. If there are none, a buffer that cannot be written
+// in place, e.g. a view on a previous page, is replaced without copying it.
+template <typename T>
+BufferPtr mutableValues(FlatVector<T>& flatResult, vector_size_t resultOffset) {
+  if (resultOffset == 0) {
+    const auto& values = flatResult.values();
+    if (values != nullptr && (values->isView() || !values->unique())) {
+      flatResult.unsafeSetValues(nullptr);
+    }
+  }
+  return flatResult.mutableValues();
+}
+
+// Returns true if values of 'type' are serialized in a layout other than the
+// in-memory one of 'T'.
+template <typename T>
+bool hasSerializedLayout(const TypePtr& type) {
+  if constexpr (std::is_same_v<T, int128_t>) {
+    return type->isLongDecimal() || isUuidType(type) || isIPAddressType(type);
+  }
+  return false;
+}
+
 template <typename T>
 void readValues(
     ByteInputStream* source,
@@ -706,7 +770,20 @@ void read(
   auto nullCount = readNulls(
       source, size, resultOffset, incomingNulls, numIncomingNulls, *flatResult);
 
-  BufferPtr values = flatResult->mutableValues();
+  if constexpr (!std::is_same_v<T, bool> && !std::is_same_v<T, Timestamp>) {
+    // Without nulls the serialized values have the in-memory layout, so the
+    // result can reference them if it consists of this page only.
+    if (opts.zeroCopy && resultOffset == 0 && nullCount == 0 &&
+        !hasSerializedLayout<T>(type)) {
+      if (auto view =
+              readBufferView(source, numNewValues * sizeof(T), alignof(T))) {
+        flatResult->unsafeSetValues(std::move(view));
+        return;
+      }
+    }
+  }
+
+  BufferPtr values = mutableValues(*flatResult, resultOffset);
   if constexpr (std::is_same_v<T, Timestamp>) {
     if (opts.useLosslessTimestamp) {
       readLosslessTimestampValues(
@@ -780,7 +857,7 @@ void read<StringView>(
   result->resize(resultOffset + numNewValues);
 
   auto flatResult = result->as<FlatVector<StringView>>();
-  BufferPtr values = flatResult->mutableValues();
+  BufferPtr values = mutableValues(*flatResult, resultOffset);
   auto rawValues = values->asMutable<StringView>();
   int32_t lastOffset = 0;
   for (int32_t i = 0; i < numNewValues; ++i) {
@@ -800,12 +877,17 @@ void read<StringView>(
     return;
   }
 
-  auto* rawStrings =
-      flatResult->getRawStringBufferWithSpace(dataSize, true /*exactSize*/);
-
-  source->readBytes(rawStrings, dataSize);
+  char* rawChars;
+  if (auto view = opts.zeroCopy ? readBufferView(source, dataSize, 1)
+                                : nullptr) {
+    rawChars = const_cast<char*>(view->as<char>());
+    flatResult->addStringBuffer(view);
+  } else {
+    rawChars =
+        flatResult->getRawStringBufferWithSpace(dataSize, true /*exactSize*/);
+    source->readBytes(rawChars, dataSize);
+  }
   int32_t previousOffset = 0;
-  auto rawChars = reinterpret_cast<char*>(rawStrings);
   for (int32_t i = 0; i < numNewValues; ++i) {
     int32_t offset = rawValues[resultOffset + i].size();
     rawValues[resultOffset + i] =
@@ -837,7 +919,7 @@ void read<OpaqueType>(
   auto deserialization = opaqueType->getDeserializeFunc();
 
   auto flatResult = result->as<FlatVector<std::shared_ptr<void>>>();
-  BufferPtr values = flatResult->mutableValues();
+  BufferPtr values = mutableValues(*flatResult, resultOffset);
 
   auto rawValues = values->asMutable<std::shared_ptr<void>>();
   std::vector<int32_t> offsets;
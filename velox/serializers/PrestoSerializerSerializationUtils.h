@@ -17,7 +17,9 @@
 #include <folly/IPAddressV6.h>
 
 #include "velox/common/memory/ByteStream.h"
+#include "velox/common/time/Timer.h"
 #include "velox/functions/prestosql/types/IPPrefixType.h"
+#include "velox/serializers/PrestoCompressionEstimator.h"
 #include "velox/serializers/PrestoSerializer.h"
 #include "velox/serializers/VectorStream.h"
 #include "velox/type/DecimalUtil.h"
@@ -157,6 +159,10 @@ vector_size_t computeSelectedIndices(
 struct FlushSizes {
   int64_t uncompressedSize;
   int64_t compressedSize;
+  // True if a CompressionEstimator decided not to run the codec.
+  bool compressionSkipped{false};
+  // Time spent in the codec, including sampling by a CompressionEstimator.
+  uint64_t compressionNanos{0};
 };
 
 FOLLY_ALWAYS_INLINE bool needCompression(
@@ -283,7 +289,8 @@ inline FlushSizes flushCompressed(
     int32_t numRows,
     float minCompressionRatio,
     OutputStream* output,
-    PrestoOutputStreamListener* listener) {
+    PrestoOutputStreamListener* listener,
+    CompressionEstimator* estimator) {
   char codecMask = kCompressedBitMask;
   if (listener) {
     codecMask |= kCheckSumBitMask;
@@ -299,8 +306,17 @@ inline FlushSizes flushCompressed(
   IOBufOutputStream out(*(arena.pool()), nullptr, arena.size());
   writeInt32(&out, streams.size());
 
+  // Start offsets of the columns followed by the end offset of the last one.
+  std::vector<int64_t> columnOffsets;
+  if (estimator != nullptr) {
+    columnOffsets.reserve(streams.size() + 1);
+    columnOffsets.push_back(out.tellp());
+  }
   for (auto& stream : streams) {
     stream.flush(&out);
+    if (estimator != nullptr) {
+      columnOffsets.push_back(out.tellp());
+    }
   }
 
   const int32_t uncompressedSize = out.tellp();
@@ -309,8 +325,34 @@ inline FlushSizes flushCompressed(
       codec.maxUncompressedLength(),
       "UncompressedSize exceeds limit");
   auto iobuf = out.getIOBuf();
-  const auto compressedBuffer = codec.compress(iobuf.get());
+  uint64_t compressionNanos{0};
+  if (estimator != nullptr) {
+    bool compress;
+    {
+      NanosecondTimer timer(&compressionNanos);
+      compress = estimator->shouldCompress(*iobuf, columnOffsets);
+    }
+    if (!compress) {
+      flushSerialization(
+          numRows,
+          uncompressedSize,
+          uncompressedSize,
+          codecMask & ~kCompressedBitMask,
+          iobuf,
+          output,
+          listener);
+      return {uncompressedSize, uncompressedSize, true, compressionNanos};
+    }
+  }
+  std::unique_ptr<folly::IOBuf> compressedBuffer;
+  {
+    NanosecondTimer timer(&compressionNanos);
+    compressedBuffer = codec.compress(iobuf.get());
+  }
   const int32_t compressedSize = compressedBuffer->computeChainDataLength();
+  if (estimator != nullptr) {
+    estimator->recordCompressed(uncompressedSize, compressedSize);
+  }
   if (compressedSize > uncompressedSize * minCompressionRatio) {
     flushSerialization(
         numRows,
@@ -320,7 +362,7 @@ inline FlushSizes flushCompressed(
         iobuf,
         output,
         listener);
-    return {uncompressedSize, uncompressedSize};
+    return {uncompressedSize, uncompressedSize, false, compressionNanos};
   }
   flushSerialization(
       numRows,
@@ -330,7 +372,7 @@ inline FlushSizes flushCompressed(
       compressedBuffer,
       output,
       listener);
-  return {uncompressedSize, compressedSize};
+  return {uncompressedSize, compressedSize, false, compressionNanos};
 }
 
 template <typename Allocator>
@@ -340,7 +382,8 @@ inline FlushSizes flushStreams(
     const StreamArena& arena,
     folly::compression::Codec& codec,
     float minCompressionRatio,
-    OutputStream* out) {
+    OutputStream* out,
+    CompressionEstimator* estimator = nullptr) {
   auto listener = dynamic_cast<PrestoOutputStreamListener*>(out->listener());
   // Reset CRC computation
   if (listener) {
@@ -352,7 +395,14 @@ inline FlushSizes flushStreams(
     return {size, size};
   } else {
     return flushCompressed(
-        streams, arena, codec, numRows, minCompressionRatio, out, listener);
+        streams,
+        arena,
+        codec,
+        numRows,
+        minCompressionRatio,
+        out,
+        listener,
+        estimator);
   }
 }
 
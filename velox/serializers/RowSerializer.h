@@ -71,12 +71,9 @@ class RowSerializer : public IterativeVectorSerializer {
       totalSize += (fixedRowSize.value() + sizeof(TRowSize)) * totalRows;
       std::fill(rowSize.begin(), rowSize.end(), fixedRowSize.value());
     } else {
-      vector_size_t index = 0;
-      for (const auto& range : ranges) {
-        for (auto i = 0; i < range.size; ++i, ++index) {
-          rowSize[index] = row.rowSize(range.begin + i);
-          totalSize += rowSize[index] + sizeof(TRowSize);
-        }
+      computeRowSizes(row, ranges, rowSize);
+      for (const auto size : rowSize) {
+        totalSize += size + sizeof(TRowSize);
       }
     }
 
@@ -194,6 +191,20 @@ class RowSerializer : public IterativeVectorSerializer {
   void clear() override {}
 
  protected:
+  /// Sets 'rowSize' to the serialized sizes of the rows in 'ranges' without
+  /// the size prefix. Called only for rows that are not fixed-width.
+  virtual void computeRowSizes(
+      const Serializer& rowSerializer,
+      const folly::Range<const IndexRange*>& ranges,
+      std::vector<vector_size_t>& rowSize) {
+    vector_size_t index = 0;
+    for (const auto& range : ranges) {
+      for (auto i = 0; i < range.size; ++i, ++index) {
+        rowSize[index] = rowSerializer.rowSize(range.begin + i);
+      }
+    }
+  }
+
   virtual void serializeRanges(
       const Serializer& rowSerializer,
       const folly::Range<const IndexRange*>& ranges,
@@ -0,0 +1,268 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/serializers/ArrowIpcSerializer.h"
+#include <gtest/gtest.h>
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/functions/prestosql/types/JsonType.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+namespace facebook::velox::serializer {
+namespace {
+
+class ArrowIpcSerializerTest
+    : public ::testing::Test,
+      public velox::test::VectorTestBase,
+      public testing::WithParamInterface<common::CompressionKind> {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance(memory::MemoryManager::Options{});
+  }
+
+  void SetUp() override {
+    serde_ = std::make_unique<ArrowIpcVectorSerde>();
+    options_ = std::make_unique<VectorSerde::Options>(GetParam(), 0.8);
+  }
+
+  RowVectorPtr makeTestVector(vector_size_t size) {
+    return makeRowVector({
+        makeFlatVector<int64_t>(
+            size, [](auto row) { return row; }, nullEvery(7)),
+        makeFlatVector<std::string>(
+            size,
+            [](auto row) { return fmt::format("string value {}", row % 13); },
+            nullEvery(11)),
+        makeArrayVector<int32_t>(
+            size,
+            [](auto row) { return row % 5; },
+            [](auto row) { return row; },
+            nullEvery(9)),
+        makeFlatVector<double>(size, [](auto row) { return row * 0.5; }),
+    });
+  }
+
+  std::string serialize(
+      const RowVectorPtr& vector,
+      std::optional<std::vector<vector_size_t>> rows = std::nullopt) {
+    StreamArena arena(pool());
+    auto serializer = serde_->createIterativeSerializer(
+        asRowType(vector->type()), vector->size(), &arena, options_.get());
+    Scratch scratch;
+    if (rows.has_value()) {
+      serializer->append(
+          vector, folly::Range(rows->data(), rows->size()), scratch);
+    } else {
+      serializer->append(vector);
+    }
+    const auto maxSize = serializer->maxSerializedSize();
+    std::ostringstream out;
+    OStreamOutputStream output(&out);
+    serializer->flush(&output);
+    EXPECT_EQ(maxSize, out.str().size());
+    return out.str();
+  }
+
+  std::string batchSerialize(const RowVectorPtr& vector) {
+    auto serializer = serde_->createBatchSerializer(pool(), options_.get());
+    std::ostringstream out;
+    OStreamOutputStream output(&out);
+    serializer->serialize(vector, &output);
+    return out.str();
+  }
+
+  RowVectorPtr deserialize(
+      const std::string& serialized,
+      const RowTypePtr& type,
+      RowVectorPtr result = nullptr,
+      vector_size_t resultOffset = 0) {
+    ByteRange byteRange{
+        reinterpret_cast<uint8_t*>(const_cast<char*>(serialized.data())),
+        (int32_t)serialized.size(),
+        0};
+    BufferInputStream input(std::vector<ByteRange>{byteRange});
+    serde_->deserialize(
+        &input, pool(), type, &result, resultOffset, options_.get());
+    EXPECT_TRUE(input.atEnd());
+    return result;
+  }
+
+  std::unique_ptr<ArrowIpcVectorSerde> serde_;
+  std::unique_ptr<VectorSerde::Options> options_;
+};
+
+TEST_P(ArrowIpcSerializerTest, roundTrip) {
+  const auto vector = makeTestVector(1'000);
+  const auto type = asRowType(vector->type());
+  assertEqualVectors(vector, deserialize(serialize(vector), type));
+
+  // Empty pages round trip too.
+  const auto empty = makeTestVector(0);
+  ASSERT_EQ(deserialize(serialize(empty), type)->size(), 0);
+}
+
+TEST_P(ArrowIpcSerializerTest, appendRows) {
+  const auto vector = makeTestVector(1'000);
+  std::vector<vector_size_t> rows;
+  for (auto i = 0; i < vector->size(); i += 3) {
+    rows.push_back(i);
+    if (i + 1 < vector->size()) {
+      rows.push_back(i + 1);
+    }
+  }
+  const auto result =
+      deserialize(serialize(vector, rows), asRowType(vector->type()));
+  ASSERT_EQ(result->size(), rows.size());
+  for (auto i = 0; i < rows.size(); ++i) {
+    ASSERT_TRUE(result->equalValueAt(vector.get(), i, rows[i]));
+  }
+}
+
+TEST_P(ArrowIpcSerializerTest, dictionaryBatch) {
+  const auto base = makeFlatVector<std::string>(
+      {"apple", "banana", "cherry", "a string longer than inline"});
+  const auto indices = makeIndices(1'000, [](auto row) { return row % 4; });
+  const auto vector = makeRowVector(
+      {makeFlatVector<int32_t>(1'000, [](auto row) { return row; }),
+       wrapInDictionary(indices, base)});
+
+  const auto result =
+      deserialize(batchSerialize(vector), asRowType(vector->type()));
+  ASSERT_EQ(
+      result->childAt(1)->encoding(), VectorEncoding::Simple::DICTIONARY);
+  assertEqualVectors(vector, result);
+}
+
+TEST_P(ArrowIpcSerializerTest, appendInDeserialize) {
+  ASSERT_TRUE(serde_->supportsAppendInDeserialize());
+  const auto first = makeTestVector(100);
+  const auto second = makeTestVector(200);
+  const auto type = asRowType(first->type());
+
+  auto result = deserialize(serialize(first), type);
+  result = deserialize(serialize(second), type, result, result->size());
+  ASSERT_EQ(result->size(), 300);
+  assertEqualVectors(first, result->slice(0, 100));
+  assertEqualVectors(second, result->slice(100, 200));
+}
+
+TEST_P(ArrowIpcSerializerTest, appendToDictionary) {
+  const auto base = makeFlatVector<std::string>(
+      {"apple", "banana", "cherry", "a string longer than inline"});
+  auto makeDictionaryVector = [&](vector_size_t size, int32_t shift) {
+    return makeRowVector({wrapInDictionary(
+        makeIndices(size, [&](auto row) { return (row + shift) % 4; }),
+        base)});
+  };
+  const auto first = makeDictionaryVector(100, 0);
+  const auto second = makeDictionaryVector(50, 1);
+  const auto third = makeRowVector({makeFlatVector<std::string>(
+      20, [](auto row) { return fmt::format("flat {}", row); })});
+  const auto type = asRowType(first->type());
+
+  auto result = deserialize(batchSerialize(first), type);
+  result = deserialize(batchSerialize(second), type, result, result->size());
+  result = deserialize(batchSerialize(third), type, result, result->size());
+  ASSERT_EQ(result->size(), 170);
+  // The existing rows keep their dictionary encoding.
+  ASSERT_EQ(
+      result->childAt(0)->encoding(), VectorEncoding::Simple::DICTIONARY);
+  assertEqualVectors(first, result->slice(0, 100));
+  assertEqualVectors(second, result->slice(100, 50));
+  assertEqualVectors(third, result->slice(150, 20));
+}
+
+TEST_P(ArrowIpcSerializerTest, customType) {
+  const auto vector = makeRowVector({
+      makeFlatVector<std::string>({"{\"a\":1}", "[1,2]", "null"}, JSON()),
+      makeArrayVector<std::string>({{"1", "{}"}, {}, {"\"x\""}}, JSON()),
+  });
+  const auto type = asRowType(vector->type());
+  auto result = deserialize(serialize(vector), type);
+  ASSERT_EQ(*result->childAt(0)->type(), *JSON());
+  ASSERT_EQ(*result->childAt(1)->type(), *ARRAY(JSON()));
+  ASSERT_EQ(
+      *result->childAt(1)->asUnchecked<ArrayVector>()->elements()->type(),
+      *JSON());
+  assertEqualVectors(vector, result);
+
+  result = deserialize(serialize(vector), type, result, result->size());
+  ASSERT_EQ(result->size(), 6);
+  assertEqualVectors(vector, result->slice(3, 3));
+
+  // Physical types only match custom types.
+  VELOX_ASSERT_THROW(
+      deserialize(
+          serialize(makeRowVector({makeFlatVector<int64_t>(
+              {1, 2}, DECIMAL(10, 2))})),
+          ROW({"c0"}, {DECIMAL(12, 4)})),
+      "does not match the expected type");
+}
+
+TEST_P(ArrowIpcSerializerTest, zeroCopy) {
+  if (GetParam() != common::CompressionKind_NONE) {
+    return;
+  }
+  const auto vector = makeTestVector(1'000);
+  auto input = std::make_shared<std::string>(serialize(vector));
+  ByteRange byteRange{
+      reinterpret_cast<uint8_t*>(input->data()), (int32_t)input->size(), 0};
+  BufferInputStream stream(std::vector<ByteRange>{byteRange}, input);
+  RowVectorPtr result;
+  serde_->deserialize(
+      &stream,
+      pool(),
+      asRowType(vector->type()),
+      &result,
+      0,
+      options_.get());
+
+  // The values of the first column point into the serialized page.
+  const auto* values = result->childAt(0)->values()->as<char>();
+  ASSERT_GE(values, input->data());
+  ASSERT_LT(values, input->data() + input->size());
+  input.reset();
+  assertEqualVectors(vector, result);
+}
+
+TEST_P(ArrowIpcSerializerTest, timestamp) {
+  // Outside the range of nanoseconds since the UNIX epoch.
+  const auto vector = makeRowVector({makeNullableFlatVector<Timestamp>({
+      Timestamp(-14'831'769'600, 123'000'000), // 1500-01-01 00:00:00.123
+      std::nullopt,
+      Timestamp(32'503'680'000, 0), // 3000-01-01 00:00:00
+      Timestamp(0, 999'000'000),
+  })});
+  const auto type = asRowType(vector->type());
+  assertEqualVectors(vector, deserialize(serialize(vector), type));
+  assertEqualVectors(vector, deserialize(batchSerialize(vector), type));
+}
+
+TEST_P(ArrowIpcSerializerTest, unsupportedCompression) {
+  const auto vector = makeTestVector(10);
+  options_->compressionKind = common::CompressionKind_SNAPPY;
+  VELOX_ASSERT_THROW(
+      serialize(vector), "Arrow IPC supports only LZ4 and ZSTD compression");
+}
+
+VELOX_INSTANTIATE_TEST_SUITE_P(
+    ArrowIpcSerializerTest,
+    ArrowIpcSerializerTest,
+    ::testing::Values(
+        common::CompressionKind_NONE,
+        common::CompressionKind_LZ4,
+        common::CompressionKind_ZSTD));
+
+} // namespace
+} // namespace facebook::velox::serializer
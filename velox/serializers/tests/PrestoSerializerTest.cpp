@@ -125,6 +125,8 @@ class PrestoSerializerTest
         serdeOptions == nullptr ? false : serdeOptions->preserveEncodings;
     serializer::presto::PrestoVectorSerde::PrestoOptions paramOptions{
         useLosslessTimestamp, kind, 0.8, nullsFirst, preserveEncodings};
+    paramOptions.adaptiveCompression =
+        serdeOptions != nullptr && serdeOptions->adaptiveCompression;
 
     return paramOptions;
   }
@@ -1458,6 +1460,203 @@ TEST_P(PrestoSerializerTest, ioBufRoundTrip) {
   }
 }
 
+TEST_P(PrestoSerializerTest, zeroCopy) {
+  auto rowVector = makeTestVector(1'000);
+  auto rowType = asRowType(rowVector->type());
+  std::ostringstream out;
+  serialize(rowVector, &out, nullptr);
+  const auto serialized = out.str();
+
+  auto paramOptions = getParamSerdeOptions(nullptr);
+  paramOptions.zeroCopy = true;
+  RowVectorPtr result;
+  {
+    auto input = std::make_shared<std::string>(serialized);
+    ByteRange byteRange{
+        reinterpret_cast<uint8_t*>(input->data()), (int32_t)input->size(), 0};
+    auto byteStream = std::make_unique<BufferInputStream>(
+        std::vector<ByteRange>{{byteRange}}, input);
+    serde_->deserialize(
+        byteStream.get(), pool_.get(), rowType, &result, 0, &paramOptions);
+  }
+  // The string payload is contiguous in the input, so it is referenced
+  // instead of copied. The input stays alive as long as 'result' references
+  // it.
+  if (GetParam() == common::CompressionKind_NONE) {
+    const auto& stringBuffers =
+        result->childAt(2)->asFlatVector<StringView>()->stringBuffers();
+    ASSERT_EQ(stringBuffers.size(), 1);
+    ASSERT_TRUE(stringBuffers[0]->isView());
+  }
+  assertEqualVectors(rowVector, result);
+
+  // Appending to the result copies the referenced values.
+  auto byteStream = toByteStream(serialized);
+  serde_->deserialize(
+      byteStream.get(),
+      pool_.get(),
+      rowType,
+      &result,
+      result->size(),
+      &paramOptions);
+  ASSERT_FALSE(result->childAt(0)->values()->isView());
+  assertEqualVectors(
+      rowVector, result->slice(rowVector->size(), rowVector->size()));
+
+  // Without a memory owner, the input is copied.
+  byteStream = toByteStream(serialized);
+  result = nullptr;
+  serde_->deserialize(
+      byteStream.get(), pool_.get(), rowType, &result, 0, &paramOptions);
+  ASSERT_FALSE(result->childAt(0)->values()->isView());
+  for (const auto& buffer :
+       result->childAt(2)->asFlatVector<StringView>()->stringBuffers()) {
+    ASSERT_FALSE(buffer->isView());
+  }
+  assertEqualVectors(rowVector, result);
+}
+
+TEST_P(PrestoSerializerTest, adaptiveCompression) {
+  if (GetParam() == common::CompressionKind_NONE) {
+    return;
+  }
+  constexpr vector_size_t kNumRows = 10'000;
+  folly::Random::DefaultGenerator rng(1);
+  // Random values do not compress, repeated ones do.
+  const auto random = makeRowVector({makeFlatVector<int64_t>(
+      kNumRows, [&](auto /*row*/) { return folly::Random::rand64(rng); })});
+  const auto repeated = makeRowVector(
+      {makeFlatVector<int64_t>(kNumRows, [](auto row) { return row % 3; })});
+  const auto rowType = asRowType(random->type());
+
+  serializer::presto::PrestoVectorSerde::PrestoOptions opts;
+  opts.adaptiveCompression = true;
+  auto paramOptions = getParamSerdeOptions(&opts);
+  StreamArena arena(pool_.get());
+  auto serializer = serde_->createIterativeSerializer(
+      rowType, kNumRows, &arena, &paramOptions);
+  const auto serializeAndCheck = [&](const RowVectorPtr& data) {
+    serializer->clear();
+    serializer->append(data);
+    std::ostringstream output;
+    OStreamOutputStream out(&output);
+    serializer->flush(&out);
+    assertEqualVectors(data, deserialize(rowType, output.str(), &opts));
+  };
+
+  // The codec only runs on samples of the random column.
+  serializeAndCheck(random);
+  auto stats = serializer->runtimeStats();
+  ASSERT_EQ(stats.count(IterativeVectorSerializer::kCompressedBytes), 0);
+  ASSERT_GT(
+      stats.at(IterativeVectorSerializer::kCompressionSkippedBytes).value, 0);
+  ASSERT_GT(stats.at(IterativeVectorSerializer::kCompressionNanos).value, 0);
+
+  // Pages of the repeated values get compressed once the column is
+  // resampled.
+  for (auto i = 0;
+       i <= serializer::presto::detail::CompressionEstimator::kResamplePages;
+       ++i) {
+    serializeAndCheck(repeated);
+  }
+  stats = serializer->runtimeStats();
+  ASSERT_LT(
+      stats.at(IterativeVectorSerializer::kCompressedBytes).value,
+      stats.at(IterativeVectorSerializer::kCompressionInputBytes).value);
+}
+
+TEST_P(PrestoSerializerTest, adaptiveCompressionNarrowColumns) {
+  if (GetParam() == common::CompressionKind_NONE) {
+    return;
+  }
+  // Each column is under kMinSampleBytes but together they compress well.
+  constexpr vector_size_t kNumRows = 100;
+  constexpr int32_t kNumColumns = 50;
+  std::vector<VectorPtr> columns;
+  for (auto i = 0; i < kNumColumns; ++i) {
+    columns.push_back(
+        makeFlatVector<int32_t>(kNumRows, [&](auto row) { return row % 2; }));
+  }
+  const auto data = makeRowVector(columns);
+  const auto rowType = asRowType(data->type());
+
+  serializer::presto::PrestoVectorSerde::PrestoOptions opts;
+  opts.adaptiveCompression = true;
+  auto paramOptions = getParamSerdeOptions(&opts);
+  StreamArena arena(pool_.get());
+  auto serializer = serde_->createIterativeSerializer(
+      rowType, kNumRows, &arena, &paramOptions);
+  serializer->append(data);
+  std::ostringstream output;
+  OStreamOutputStream out(&output);
+  serializer->flush(&out);
+  assertEqualVectors(data, deserialize(rowType, output.str(), &opts));
+
+  const auto stats = serializer->runtimeStats();
+  ASSERT_EQ(
+      stats.count(IterativeVectorSerializer::kCompressionSkippedBytes), 0);
+  ASSERT_LT(
+      stats.at(IterativeVectorSerializer::kCompressedBytes).value,
+      stats.at(IterativeVectorSerializer::kCompressionInputBytes).value);
+}
+
+TEST_P(PrestoSerializerTest, lowCardinalityStringsBatchVectorSerializer) {
+  constexpr vector_size_t kNumRows = 1'000;
+  const auto data = makeRowVector({
+      makeFlatVector<std::string>(
+          kNumRows,
+          [](auto row) { return fmt::format("a long string {}", row % 7); }),
+      makeFlatVector<std::string>(
+          kNumRows, [](auto row) { return fmt::format("value {}", row); }),
+      makeFlatVector<std::string>(
+          kNumRows,
+          [](auto row) { return fmt::format("value {}", row % 7); },
+          nullEvery(5)),
+  });
+  const auto rowType = asRowType(data->type());
+
+  serializer::presto::PrestoVectorSerde::PrestoOptions opts;
+  opts.adaptiveCompression = true;
+  std::ostringstream out;
+  serializeBatch(data, &out, &opts);
+  auto deserialized = deserialize(rowType, out.str(), &opts);
+  assertEqualVectors(data, deserialized);
+
+  // Only the column without nulls and with few distinct values is dictionary
+  // encoded.
+  ASSERT_EQ(
+      deserialized->childAt(0)->encoding(), VectorEncoding::Simple::DICTIONARY);
+  ASSERT_EQ(deserialized->childAt(0)->valueVector()->size(), 7);
+  ASSERT_EQ(deserialized->childAt(1)->encoding(), VectorEncoding::Simple::FLAT);
+  ASSERT_EQ(deserialized->childAt(2)->encoding(), VectorEncoding::Simple::FLAT);
+
+  // Serializing a subset of the rows only puts their values in the
+  // dictionary.
+  std::vector<IndexRange> ranges{{0, 100}, {500, 100}};
+  std::ostringstream rangesOut;
+  {
+    auto paramOptions = getParamSerdeOptions(&opts);
+    OStreamOutputStream output(&rangesOut);
+    Scratch scratch;
+    serde_->createBatchSerializer(pool_.get(), &paramOptions)
+        ->serialize(data, ranges, scratch, &output);
+  }
+  deserialized = deserialize(rowType, rangesOut.str(), &opts);
+  ASSERT_EQ(deserialized->size(), 200);
+  assertEqualVectors(data->slice(0, 100), deserialized->slice(0, 100));
+  assertEqualVectors(data->slice(500, 100), deserialized->slice(100, 100));
+  ASSERT_EQ(
+      deserialized->childAt(0)->encoding(), VectorEncoding::Simple::DICTIONARY);
+
+  // Encodings are kept as is with 'preserveEncodings'.
+  opts.preserveEncodings = true;
+  std::ostringstream preservedOut;
+  serializeBatch(data, &preservedOut, &opts);
+  deserialized = deserialize(rowType, preservedOut.str(), &opts);
+  assertEqualVectors(data, deserialized);
+  ASSERT_EQ(deserialized->childAt(0)->encoding(), VectorEncoding::Simple::FLAT);
+}
+
 TEST_P(PrestoSerializerTest, roundTrip) {
   VectorFuzzer::Options opts;
   opts.timestampPrecision =
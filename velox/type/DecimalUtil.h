@@ -459,6 +459,52 @@ class DecimalUtil {
     return sum;
   }
 
+  /// Sums a batch of decimal values, e.g. the inputs of sum() or avg() for one
+  /// group. Unlike addWithOverflow, add() has no branches: the low and high 64
+  /// bits of the values are summed separately, which cannot overflow for less
+  /// than 2^64 values, so that loops calling it can be vectorized. The carry
+  /// between the two sums and the overflow are computed once per batch in
+  /// addTo().
+  class BatchSum {
+   public:
+    FOLLY_ALWAYS_INLINE void add(int64_t value) {
+      high_ += value >> 63;
+      low_ += static_cast<uint64_t>(value);
+    }
+
+    FOLLY_ALWAYS_INLINE void add(int128_t value) {
+      high_ += static_cast<int64_t>(value >> 64);
+      low_ += static_cast<uint64_t>(value);
+    }
+
+    /// Adds the sum of the batch to 'sum' and returns the overflow. As for
+    /// addWithOverflow, the caller must sum up the overflow values and call
+    /// adjustSumForOverflow after processing all inputs.
+    int64_t addTo(int128_t& sum) const {
+      const int128_t high = high_ + static_cast<int128_t>(low_ >> 64);
+      const auto low = static_cast<uint64_t>(low_);
+      const __uint128_t value = (static_cast<__uint128_t>(high) << 64) | low;
+      int64_t overflow = 0;
+      int128_t remainder;
+      if (high == static_cast<int64_t>(high)) {
+        // The sum of the batch fits in 128 bits.
+        remainder = static_cast<int128_t>(value);
+      } else {
+        // The sum of the batch is overflow * 2^127 + remainder, with
+        // 0 <= remainder < 2^127.
+        overflow = static_cast<int64_t>(high >> 63);
+        remainder = static_cast<int128_t>(value & ~kOverflowMultiplier);
+      }
+      return overflow + addWithOverflow(sum, sum, remainder);
+    }
+
+   private:
+    // Sum of the high 64 bits of the values as signed numbers.
+    int128_t high_{0};
+    // Sum of the low 64 bits of the values as unsigned numbers.
+    __uint128_t low_{0};
+  };
+
   /// avg = (sum + overflow * kOverflowMultiplier) / count
   static void
   computeAverage(int128_t& avg, int128_t sum, int64_t count, int64_t overflow);
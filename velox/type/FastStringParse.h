@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+
+#include "velox/type/TimestampConversion.h"
+
+/// Parsers for the most common fixed formats of numbers and dates in strings.
+/// They test and convert 8 characters at a time with SWAR (SIMD within a
+/// register) arithmetic and accept only a strict subset of the formats the
+/// cast functions accept: the result is std::nullopt for anything else, and
+/// the caller falls back to the general parser, which also produces the
+/// error. Within that subset the result is the same as for every cast
+/// policy.
+namespace facebook::velox::util::fastparse {
+
+namespace detail {
+
+inline uint64_t loadEight(const char* data) {
+  uint64_t chunk;
+  std::memcpy(&chunk, data, sizeof(chunk));
+  return chunk;
+}
+
+/// Returns true if all 8 bytes of 'chunk' are ASCII digits.
+inline bool isEightDigits(uint64_t chunk) {
+  return ((chunk & 0xF0F0F0F0F0F0F0F0) |
+          (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) ==
+      0x3333333333333333;
+}
+
+/// Returns the value of the 8 ASCII digits in 'chunk', the first digit being
+/// the most significant. Assumes a little-endian platform.
+inline uint32_t parseEightDigits(uint64_t chunk) {
+  constexpr uint64_t kMask = 0x000000FF000000FF;
+  // 100 + (1000000 << 32).
+  constexpr uint64_t kMul1 = 0x000F424000000064;
+  // 1 + (10000 << 32).
+  constexpr uint64_t kMul2 = 0x0000271000000001;
+  chunk -= 0x3030303030303030;
+  chunk = (chunk * 10) + (chunk >> 8);
+  chunk = (((chunk & kMask) * kMul1) + (((chunk >> 16) & kMask) * kMul2)) >>
+      32;
+  return static_cast<uint32_t>(chunk);
+}
+
+/// Parses 1 to 18 ASCII digits. Returns false if any character is not a
+/// digit.
+inline bool parseDigits(const char* data, size_t size, int64_t& result) {
+  int64_t value = 0;
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    const auto chunk = loadEight(data + i);
+    if (!isEightDigits(chunk)) {
+      return false;
+    }
+    value = value * 100'000'000 + parseEightDigits(chunk);
+  }
+  for (; i < size; ++i) {
+    const auto digit = static_cast<uint8_t>(data[i] - '0');
+    if (digit > 9) {
+      return false;
+    }
+    value = value * 10 + digit;
+  }
+  result = value;
+  return true;
+}
+
+constexpr int64_t kPowersOfTen[] = {
+    1,
+    10,
+    100,
+    1'000,
+    10'000,
+    100'000,
+    1'000'000,
+    10'000'000,
+    100'000'000,
+    1'000'000'000,
+    10'000'000'000,
+    100'000'000'000,
+    1'000'000'000'000,
+    10'000'000'000'000,
+    100'000'000'000'000,
+    1'000'000'000'000'000,
+    10'000'000'000'000'000,
+    100'000'000'000'000'000,
+    1'000'000'000'000'000'000};
+
+} // namespace detail
+
+/// Maximum number of digits parsed without a check for overflow.
+constexpr size_t kMaxDigits = 18;
+
+/// Parses an integer of the form -?[0-9]{1,18} and returns it if it is in the
+/// range of T.
+template <typename T>
+std::optional<T> tryParseInteger(std::string_view input) {
+  static_assert(std::is_integral_v<T> && std::is_signed_v<T>);
+  const bool negative = !input.empty() && input[0] == '-';
+  const size_t numDigits = input.size() - negative;
+  if (numDigits == 0 || numDigits > kMaxDigits) {
+    return std::nullopt;
+  }
+  int64_t value;
+  if (!detail::parseDigits(input.data() + negative, numDigits, value)) {
+    return std::nullopt;
+  }
+  if (negative) {
+    value = -value;
+  }
+  if (value < std::numeric_limits<T>::min() ||
+      value > std::numeric_limits<T>::max()) {
+    return std::nullopt;
+  }
+  return static_cast<T>(value);
+}
+
+/// Parses a decimal of the form -?[0-9]+(\.[0-9]+)? that fits 'precision'
+/// and 'scale' without rounding, and returns its unscaled value if that has
+/// at most 18 digits.
+inline std::optional<int64_t>
+tryParseDecimal(std::string_view input, uint8_t precision, uint8_t scale) {
+  const bool negative = !input.empty() && input[0] == '-';
+  const char* data = input.data() + negative;
+  const size_t size = input.size() - negative;
+  const auto* point = static_cast<const char*>(std::memchr(data, '.', size));
+  const size_t numIntegerDigits = point ? point - data : size;
+  const size_t numFractionDigits = point ? size - numIntegerDigits - 1 : 0;
+  // The unscaled value has at most 'numIntegerDigits' + 'scale' digits.
+  if (numIntegerDigits == 0 || (point && numFractionDigits == 0) ||
+      numIntegerDigits + scale > kMaxDigits || numFractionDigits > scale ||
+      numIntegerDigits > static_cast<size_t>(precision - scale)) {
+    return std::nullopt;
+  }
+  int64_t integerPart;
+  if (!detail::parseDigits(data, numIntegerDigits, integerPart)) {
+    return std::nullopt;
+  }
+  int64_t fractionPart = 0;
+  if (numFractionDigits > 0 &&
+      !detail::parseDigits(point + 1, numFractionDigits, fractionPart)) {
+    return std::nullopt;
+  }
+  const int64_t value = integerPart * detail::kPowersOfTen[scale] +
+      fractionPart * detail::kPowersOfTen[scale - numFractionDigits];
+  return negative ? -value : value;
+}
+
+/// Parses a date of the form YYYY-MM-DD and returns the number of days since
+/// the epoch.
+inline std::optional<int32_t> tryParseDate(std::string_view input) {
+  if (input.size() != 10 || input[4] != '-' || input[7] != '-') {
+    return std::nullopt;
+  }
+  // Gathers YYYYMMDD into one word.
+  char digits[8];
+  std::memcpy(digits, input.data(), 4);
+  std::memcpy(digits + 4, input.data() + 5, 2);
+  std::memcpy(digits + 6, input.data() + 8, 2);
+  const auto chunk = detail::loadEight(digits);
+  if (!detail::isEightDigits(chunk)) {
+    return std::nullopt;
+  }
+  const int32_t yearMonthDay = detail::parseEightDigits(chunk);
+  const int32_t year = yearMonthDay / 10'000;
+  const int32_t month = yearMonthDay / 100 % 100;
+  const int32_t day = yearMonthDay % 100;
+  if (!isValidDate(year, month, day)) {
+    return std::nullopt;
+  }
+  const auto days = daysSinceEpochFromDate(year, month, day);
+  if (days.hasError()) {
+    return std::nullopt;
+  }
+  return static_cast<int32_t>(days.value());
+}
+
+} // namespace facebook::velox::util::fastparse
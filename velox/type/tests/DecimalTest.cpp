@@ -396,6 +396,58 @@ TEST(DecimalAggregateTest, adjustSumForOverflow) {
   EXPECT_FALSE(accumulator.adjustedSum().has_value());
 }
 
+TEST(DecimalAggregateTest, batchSum) {
+  // Returns the sum and the overflow calculated with addWithOverflow and with
+  // BatchSum, after adjusting both to the same representation.
+  auto testSum = [](const std::vector<int128_t>& values) {
+    int128_t expectedSum = 0;
+    int64_t expectedOverflow = 0;
+    DecimalUtil::BatchSum batchSum;
+    for (auto value : values) {
+      expectedOverflow +=
+          DecimalUtil::addWithOverflow(expectedSum, expectedSum, value);
+      batchSum.add(value);
+    }
+    int128_t sum = 0;
+    int64_t overflow = batchSum.addTo(sum);
+    EXPECT_EQ(
+        DecimalUtil::adjustSumForOverflow(sum, overflow),
+        DecimalUtil::adjustSumForOverflow(expectedSum, expectedOverflow));
+    int128_t average;
+    int128_t expectedAverage;
+    DecimalUtil::computeAverage(average, sum, values.size(), overflow);
+    DecimalUtil::computeAverage(
+        expectedAverage, expectedSum, values.size(), expectedOverflow);
+    EXPECT_EQ(average, expectedAverage);
+  };
+
+  testSum({1, 2, 3, -4});
+  testSum({-1, -2, -3});
+  testSum({DecimalUtil::kLongDecimalMax, DecimalUtil::kLongDecimalMax});
+  testSum({DecimalUtil::kLongDecimalMin, DecimalUtil::kLongDecimalMin});
+  testSum(
+      {DecimalUtil::kLongDecimalMax,
+       DecimalUtil::kLongDecimalMax,
+       DecimalUtil::kLongDecimalMin});
+  testSum(
+      {DecimalUtil::kLongDecimalMin,
+       DecimalUtil::kLongDecimalMin,
+       DecimalUtil::kLongDecimalMax});
+  testSum(std::vector<int128_t>(1'000, DecimalUtil::kLongDecimalMax));
+  testSum(std::vector<int128_t>(1'000, DecimalUtil::kLongDecimalMin));
+  testSum(std::vector<int128_t>(1'000, HugeInt::build(1, 0) - 1));
+
+  // Short decimals.
+  DecimalUtil::BatchSum batchSum;
+  for (auto i = 0; i < 1'000; ++i) {
+    batchSum.add(DecimalUtil::kShortDecimalMin);
+    batchSum.add(static_cast<int64_t>(i));
+  }
+  int128_t sum = 7;
+  EXPECT_EQ(batchSum.addTo(sum), 0);
+  EXPECT_EQ(sum, 7 + 1'000 * DecimalUtil::kShortDecimalMin + 499'500);
+}
+
 TEST(DecimalTest, rescaleDouble) {
   assertRescaleDouble(-3333.03, DECIMAL(10, 4), -33'330'300);
   assertRescaleDouble(-3333.03, DECIMAL(20, 1), -33'330);
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/type/FastStringParse.h"
+
+#include <gtest/gtest.h>
+
+namespace facebook::velox::util::fastparse {
+namespace {
+
+TEST(FastStringParseTest, integer) {
+  EXPECT_EQ(tryParseInteger<int64_t>("0"), 0);
+  EXPECT_EQ(tryParseInteger<int64_t>("-0"), 0);
+  EXPECT_EQ(tryParseInteger<int64_t>("12345678"), 12345678);
+  EXPECT_EQ(tryParseInteger<int64_t>("-123456789"), -123456789);
+  EXPECT_EQ(
+      tryParseInteger<int64_t>("999999999999999999"), 999'999'999'999'999'999);
+  EXPECT_EQ(tryParseInteger<int64_t>("000000000000000007"), 7);
+
+  // Too many digits for the fast path.
+  EXPECT_EQ(tryParseInteger<int64_t>("1000000000000000000"), std::nullopt);
+
+  EXPECT_EQ(tryParseInteger<int64_t>(""), std::nullopt);
+  EXPECT_EQ(tryParseInteger<int64_t>("-"), std::nullopt);
+  EXPECT_EQ(tryParseInteger<int64_t>("+1"), std::nullopt);
+  EXPECT_EQ(tryParseInteger<int64_t>(" 1"), std::nullopt);
+  EXPECT_EQ(tryParseInteger<int64_t>("1.0"), std::nullopt);
+  EXPECT_EQ(tryParseInteger<int64_t>("1234567a"), std::nullopt);
+  EXPECT_EQ(tryParseInteger<int64_t>("12345678/"), std::nullopt);
+  EXPECT_EQ(tryParseInteger<int64_t>("1234:5678"), std::nullopt);
+
+  EXPECT_EQ(tryParseInteger<int8_t>("127"), 127);
+  EXPECT_EQ(tryParseInteger<int8_t>("-128"), -128);
+  EXPECT_EQ(tryParseInteger<int8_t>("128"), std::nullopt);
+  EXPECT_EQ(tryParseInteger<int32_t>("-2147483648"), -2147483648);
+  EXPECT_EQ(tryParseInteger<int32_t>("2147483648"), std::nullopt);
+}
+
+TEST(FastStringParseTest, decimal) {
+  EXPECT_EQ(tryParseDecimal("12.34", 10, 2), 1234);
+  EXPECT_EQ(tryParseDecimal("-12.3", 10, 2), -1230);
+  EXPECT_EQ(tryParseDecimal("12", 10, 2), 1200);
+  EXPECT_EQ(tryParseDecimal("0.01", 3, 2), 1);
+  EXPECT_EQ(tryParseDecimal("12345678.12345678", 18, 8), 1234567812345678);
+
+  // Needs rounding.
+  EXPECT_EQ(tryParseDecimal("1.234", 10, 2), std::nullopt);
+  // Out of range.
+  EXPECT_EQ(tryParseDecimal("123", 4, 2), std::nullopt);
+  // Unscaled value too long for the fast path.
+  EXPECT_EQ(tryParseDecimal("1", 38, 18), std::nullopt);
+
+  EXPECT_EQ(tryParseDecimal("", 10, 2), std::nullopt);
+  EXPECT_EQ(tryParseDecimal(".5", 10, 2), std::nullopt);
+  EXPECT_EQ(tryParseDecimal("5.", 10, 2), std::nullopt);
+  EXPECT_EQ(tryParseDecimal("1.2.3", 10, 2), std::nullopt);
+  EXPECT_EQ(tryParseDecimal("1e2", 10, 2), std::nullopt);
+  EXPECT_EQ(tryParseDecimal("+1", 10, 2), std::nullopt);
+}
+
+TEST(FastStringParseTest, date) {
+  EXPECT_EQ(tryParseDate("1970-01-01"), 0);
+  EXPECT_EQ(tryParseDate("1969-12-31"), -1);
+  EXPECT_EQ(tryParseDate("2020-01-01"), 18262);
+  EXPECT_EQ(tryParseDate("2024-02-29"), 19782);
+  EXPECT_EQ(tryParseDate("1812-04-15"), -57604);
+
+  EXPECT_EQ(tryParseDate("2023-02-29"), std::nullopt);
+  EXPECT_EQ(tryParseDate("2023-00-10"), std::nullopt);
+  EXPECT_EQ(tryParseDate("2023-13-10"), std::nullopt);
+  EXPECT_EQ(tryParseDate("2023-12-32"), std::nullopt);
+  EXPECT_EQ(tryParseDate("2023-1-01"), std::nullopt);
+  EXPECT_EQ(tryParseDate("2023/01/01"), std::nullopt);
+  EXPECT_EQ(tryParseDate("2023-01-0a"), std::nullopt);
+  EXPECT_EQ(tryParseDate(" 2023-01-01"), std::nullopt);
+}
+
+} // namespace
+} // namespace facebook::velox::util::fastparse
@@ -16,6 +16,8 @@
 
 #include "velox/type/tz/TimeZoneMap.h"
 
+#include <algorithm>
+
 #include <boost/algorithm/string.hpp>
 #include <fmt/core.h>
 #include <folly/container/F14Map.h>
@@ -238,6 +240,10 @@ std::string normalizeTimeZone(const std::string& originalZoneId) {
   return originalZoneId;
 }
 
+// Offsets from UTC are within a day, so the UTC time of a local time is less
+// than this many seconds away from it.
+constexpr int64_t kMaxOffsetSeconds = 24 * 60 * 60;
+
 template <typename TDuration>
 void validateRangeImpl(time_point<TDuration> timePoint) {
   using namespace velox::date;
@@ -452,24 +458,115 @@ std::vector<int16_t> getTimeZoneIDs() {
   return ids;
 }
 
+int32_t TimeZone::TransitionTable::offsetAt(int64_t sysSeconds) const {
+  if (offsets.size() == 1) {
+    return offsets[0];
+  }
+  const auto it =
+      std::upper_bound(transitions.begin(), transitions.end(), sysSeconds);
+  return offsets[it - transitions.begin() - 1];
+}
+
+std::optional<int64_t> TimeZone::TransitionTable::tryToSys(
+    int64_t localSeconds) const {
+  if (!contains(localSeconds - kMaxOffsetSeconds) ||
+      !contains(localSeconds + kMaxOffsetSeconds)) {
+    return std::nullopt;
+  }
+  if (offsets.size() == 1) {
+    return localSeconds - offsets[0];
+  }
+
+  // Checks every period that overlaps the window in which the UTC time can be.
+  // The local time is ambiguous if it is in two periods and nonexistent if it
+  // is in none.
+  const size_t first = std::upper_bound(
+                           transitions.begin(),
+                           transitions.end(),
+                           localSeconds - kMaxOffsetSeconds) -
+      transitions.begin() - 1;
+  const size_t last = std::upper_bound(
+                          transitions.begin(),
+                          transitions.end(),
+                          localSeconds + kMaxOffsetSeconds) -
+      transitions.begin();
+  std::optional<int64_t> result;
+  for (auto i = first; i < last; ++i) {
+    const int64_t sysSeconds = localSeconds - offsets[i];
+    const int64_t end = i + 1 < transitions.size() ? transitions[i + 1] : kEnd;
+    if (sysSeconds >= transitions[i] && sysSeconds < end) {
+      if (result.has_value()) {
+        return std::nullopt;
+      }
+      result = sysSeconds;
+    }
+  }
+  return result;
+}
+
+const TimeZone::TransitionTable& TimeZone::transitionTable() const {
+  VELOX_DCHECK_NOT_NULL(tz_);
+  std::call_once(transitionTableOnce_, [&]() {
+    auto& table = transitionTable_;
+    date::sys_seconds time{seconds(TransitionTable::kBegin)};
+    const date::sys_seconds end{seconds(TransitionTable::kEnd)};
+    while (time < end) {
+      const auto info = tz_->get_info(time);
+      const int32_t offset = info.offset.count();
+      // Periods that only differ in name or in daylight savings time have the
+      // same offset.
+      if (table.offsets.empty() || table.offsets.back() != offset) {
+        table.transitions.push_back(time.time_since_epoch().count());
+        table.offsets.push_back(offset);
+      }
+      VELOX_CHECK(info.end > time);
+      time = info.end;
+    }
+    table.transitions.shrink_to_fit();
+    table.offsets.shrink_to_fit();
+  });
+  return transitionTable_;
+}
+
 TimeZone::seconds TimeZone::to_sys(
     TimeZone::seconds timestamp,
     TimeZone::TChoose choose) const {
+  if (tz_ != nullptr) {
+    if (auto sysSeconds = transitionTable().tryToSys(timestamp.count())) {
+      return seconds(*sysSeconds);
+    }
+  }
   return toSysImpl(timestamp, choose, tz_, offset_);
 }
 
 TimeZone::milliseconds TimeZone::to_sys(
     TimeZone::milliseconds timestamp,
     TimeZone::TChoose choose) const {
+  if (tz_ != nullptr) {
+    const auto localSeconds = std::chrono::floor<seconds>(timestamp);
+    if (auto sysSeconds =
+            transitionTable().tryToSys(localSeconds.count())) {
+      return timestamp - (localSeconds - seconds(*sysSeconds));
+    }
+  }
   return toSysImpl(timestamp, choose, tz_, offset_);
 }
 
 TimeZone::seconds TimeZone::to_local(TimeZone::seconds timestamp) const {
+  if (tz_ != nullptr && TransitionTable::contains(timestamp.count())) {
+    return timestamp + seconds(transitionTable().offsetAt(timestamp.count()));
+  }
   return toLocalImpl(timestamp, tz_, offset_);
 }
 
 TimeZone::milliseconds TimeZone::to_local(
     TimeZone::milliseconds timestamp) const {
+  if (tz_ != nullptr) {
+    const auto sysSeconds = std::chrono::floor<seconds>(timestamp).count();
+    if (TransitionTable::contains(sysSeconds)) {
+      return timestamp + seconds(transitionTable().offsetAt(sysSeconds));
+    }
+  }
   return toLocalImpl(timestamp, tz_, offset_);
 }
 
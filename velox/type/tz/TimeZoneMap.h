@@ -17,6 +17,8 @@
 #pragma once
 
 #include <chrono>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -144,6 +146,11 @@ class TimeZone {
   /// GMT), convert to the same instant in time as observed in the user local
   /// time represented by this object). Note that this conversion is not
   /// susceptible to the error above.
+  ///
+  /// Both conversions look up the offset in a table of the transitions of the
+  /// time zone between 1900 and 2100, built on first use. Conversions outside
+  /// of that range, and ambiguous or nonexistent local times, use the tzdb
+  /// library.
   seconds to_local(seconds timestamp) const;
   milliseconds to_local(milliseconds timestamp) const;
 
@@ -184,10 +191,43 @@ class TimeZone {
       TChoose choose = TChoose::kFail) const;
 
  private:
+  // Offsets of a time zone in [kBegin, kEnd) as a sorted array of the UTC
+  // times at which the offset changes. Most conversions are a binary search
+  // in 'transitions', or a single addition for time zones that have had one
+  // offset since 1900, e.g. "Etc/GMT+5".
+  struct TransitionTable {
+    // Seconds since epoch of 1900-01-01 and 2100-01-01.
+    static constexpr int64_t kBegin = -2'208'988'800;
+    static constexpr int64_t kEnd = 4'102'444'800;
+
+    // The offset from UTC in seconds is 'offsets[i]' from 'transitions[i]' up
+    // to 'transitions[i + 1]'. 'transitions[0]' is kBegin.
+    std::vector<int64_t> transitions;
+    std::vector<int32_t> offsets;
+
+    static bool contains(int64_t seconds) {
+      return seconds >= kBegin && seconds < kEnd;
+    }
+
+    // Returns the offset in seconds at 'sysSeconds' in [kBegin, kEnd).
+    int32_t offsetAt(int64_t sysSeconds) const;
+
+    // Returns the UTC time for local time 'localSeconds' if it is in the range
+    // of the table and is neither ambiguous nor nonexistent.
+    std::optional<int64_t> tryToSys(int64_t localSeconds) const;
+  };
+
+  // Returns the transition table, building it on the first call. Must not be
+  // called for offset time zones.
+  const TransitionTable& transitionTable() const;
+
   const tzdb::time_zone* tz_{nullptr};
   const std::chrono::minutes offset_{0};
   const std::string timeZoneName_;
   const int16_t timeZoneID_;
+
+  mutable std::once_flag transitionTableOnce_;
+  mutable TransitionTable transitionTable_;
 };
 
 } // namespace facebook::velox::tz
@@ -19,6 +19,7 @@
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/external/date/date.h"
+#include "velox/external/tzdb/time_zone.h"
 #include "velox/type/tz/TimeZoneMap.h"
 
 namespace facebook::velox::tz {
@@ -116,6 +117,76 @@ TEST(TimeZoneMapTest, offsetToSys) {
   EXPECT_NE(toSysTime("-07:00", ts), toSysTime("America/Los_Angeles", ts));
 }
 
+TEST(TimeZoneMapTest, transitionTable) {
+  // Compares conversions with the tzdb library around every hour from 1890 to
+  // 2110, which covers both sides of the range of the transition tables.
+  constexpr int64_t kBegin = -2'524'521'600;
+  constexpr int64_t kEnd = 4'417'977'600;
+  constexpr int64_t kStep = 3'600 * 11 + 17;
+
+  for (const auto* name :
+       {"America/Los_Angeles",
+        "Europe/London",
+        "Australia/Lord_Howe",
+        "Asia/Kolkata",
+        "Pacific/Apia",
+        "Etc/GMT+5",
+        "UTC"}) {
+    SCOPED_TRACE(name);
+    const auto* tz = locateZone(name);
+    const auto* zone = tz->tz();
+    ASSERT_NE(zone, nullptr);
+
+    for (auto time = kBegin; time < kEnd; time += kStep) {
+      const date::sys_seconds sysTime{seconds(time)};
+      ASSERT_EQ(
+          tz->to_local(seconds(time)),
+          zone->to_local(sysTime).time_since_epoch());
+      ASSERT_EQ(
+          tz->to_local(milliseconds(time * 1'000 - 1)),
+          zone->to_local(sysTime - milliseconds(1)).time_since_epoch());
+
+      const date::local_seconds localTime{seconds(time)};
+      const auto info = zone->get_info(localTime);
+      if (info.result == tzdb::local_info::unique) {
+        ASSERT_EQ(
+            tz->to_sys(seconds(time)),
+            zone->to_sys(localTime).time_since_epoch());
+        ASSERT_EQ(
+            tz->to_sys(milliseconds(time * 1'000 + 1)),
+            zone->to_sys(localTime + milliseconds(1)).time_since_epoch());
+      } else if (info.result == tzdb::local_info::ambiguous) {
+        ASSERT_EQ(
+            tz->to_sys(seconds(time), TimeZone::TChoose::kLatest),
+            zone->to_sys(localTime, tzdb::choose::latest).time_since_epoch());
+      }
+    }
+  }
+}
+
+TEST(TimeZoneMapTest, transitionTableDaylightSavings) {
+  const auto* tz = locateZone("America/Los_Angeles");
+
+  // 2024-03-10 02:30:00 does not exist.
+  EXPECT_THROW(
+      tz->to_sys(seconds(1710037800)), tzdb::nonexistent_local_time);
+
+  // 2024-11-03 01:30:00 is ambiguous.
+  EXPECT_THROW(tz->to_sys(seconds(1730597400)), tzdb::ambiguous_local_time);
+  EXPECT_EQ(
+      seconds(1730622600),
+      tz->to_sys(seconds(1730597400), TimeZone::TChoose::kEarliest));
+  EXPECT_EQ(
+      seconds(1730626200),
+      tz->to_sys(seconds(1730597400), TimeZone::TChoose::kLatest));
+
+  // One second before and after the transitions.
+  EXPECT_EQ(seconds(1710064799), tz->to_sys(seconds(1710035999)));
+  EXPECT_EQ(seconds(1710064800), tz->to_sys(seconds(1710039600)));
+  EXPECT_EQ(seconds(1710035999), tz->to_local(seconds(1710064799)));
+  EXPECT_EQ(seconds(1710039600), tz->to_local(seconds(1710064800)));
+}
+
 TEST(TimeZoneMapTest, timePointBoundary) {
   using namespace date;
 
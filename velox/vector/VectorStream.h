@@ -51,6 +51,10 @@ struct CompressionStats {
   // Bytes for which compression was not attempted because of past
   // non-performance.
   int64_t compressionSkippedBytes{0};
+
+  // Time spent compressing, including compressing samples to decide whether
+  // to compress.
+  uint64_t compressionNanos{0};
 };
 
 /// Serializer that can iteratively build up a buffer of serialized rows from
@@ -135,6 +139,8 @@ class IterativeVectorSerializer {
   /// The number of bytes that skip in-efficient compression.
   static inline const std::string kCompressionSkippedBytes{
       "compressionSkippedBytes"};
+  /// The time spent compressing.
+  static inline const std::string kCompressionNanos{"compressionNanos"};
 
   /// Returns serializer-dependent counters, e.g. about compression, data
   /// distribution, encoding etc.
@@ -204,6 +210,7 @@ class VectorSerde {
     kPresto,
     kCompactRow,
     kUnsafeRow,
+    kArrowIpc,
   };
 
   static std::string kindName(Kind type);